@@ -0,0 +1,25 @@
+-- Regression benchmark for the construction of classifiers with memory metering.
+-- Run it without '--snapshots' (restored classifiers aren't constructed) for a
+-- baseline and a changed build and compare both result directories with
+-- 'tools/compare_construction.py'.
+algLinSearch = createAlgorithm("../algorithms/lib/LinearSearch5tpl.so", {10000})
+algBitvector = createAlgorithm("../algorithms/lib/Bitvector5tpl.so", {10000})
+algTuples = createAlgorithm("../algorithms/lib/TupleSpace5tpl.so", {10000, 107})
+algHiCuts = createAlgorithm("../algorithms/lib/HiCuts5tpl.so", {10000, 36, 3.0})
+-- a checkpoint after each 20 headers stresses the snapshots of the memory registry
+algHiCutsFine = createAlgorithm("../algorithms/lib/HiCuts5tpl.so", {20, 36, 3.0})
+
+structureIPv4 = {32, 32, 16, 16, 8}
+
+dofile("examples/rules/rls_5tpl-acl1-1000.lua")
+
+hdrRandom = createRandomHeaders(20000, false, {
+  uniformDistribution(1, 0, 4294967295), uniformDistribution(2, 0, 4294967295),
+  uniformDistribution(3, 0, 65535), uniformDistribution(4, 0, 65535), uniformDistribution(5, 0, 255)
+})
+
+registerBenchmark("construction with acl1 classifier", algLinSearch, structureIPv4, rls_5tpl_acl1_1000, hdrRandom, 8, {warmup = 1})
+registerBenchmark("construction with acl1 classifier", algBitvector, structureIPv4, rls_5tpl_acl1_1000, hdrRandom, 8, {warmup = 1})
+registerBenchmark("construction with acl1 classifier", algTuples, structureIPv4, rls_5tpl_acl1_1000, hdrRandom, 8, {warmup = 1})
+registerBenchmark("construction with acl1 classifier", algHiCuts, structureIPv4, rls_5tpl_acl1_1000, hdrRandom, 8, {warmup = 1})
+registerBenchmark("construction with acl1 classifier", algHiCutsFine, structureIPv4, rls_5tpl_acl1_1000, hdrRandom, 8, {warmup = 1})
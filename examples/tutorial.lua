@@ -8,11 +8,14 @@
 			ruleAtomExact(<value>)
 			ruleAtomRange(<min_value>, <max_value>)
 			ruleAtomPrefix(<prefix_value>, <mask>)
+		loadClassBenchRules(<filename>)
 		ipv4Toi(ip)
 		maskToi(<maskbits>, [<totalBits>]) (default: totalBits=32)
 		createHeaderset()
 			addHeaderToHeaderset(<headerset>, <header>)
-		createRandomHeaders(<amount>, <output headers>, <distributions>)
+		loadHeaderTrace(<filename>)
+		loadPcap(<filename>, [<replay>], [<fields>]) (fields e.g. {"src_ip", "dst_ip", "src_port", "dst_port", "protocol"})
+		createRandomHeaders(<amount>, <output headers>, <distributions>) (output: true, false or "binary")
 			constantDistribution(<value>)
 			uniformDistribution(<seed>, <min>, <max>)
 			normalDistribution(<seed>, <mean>, <stddev>)
@@ -20,7 +23,25 @@
 			exponentialDistribution(<seed>, <lambda>)
 			cauchyDistribution(<seed>, <a>, <b>)
 			paretoDistribution(<seed>, <scale>, <shape>, <offset>)
-		registerBenchmark(<caption_text>, <algorithm>, <structure>, <rules>, <headers>, <amount_runs>)
+		createUpdateTrace(<headers_per_update>)
+			addRuleInsertion(<trace>, <index>, <rule>)
+			addRuleRemoval(<trace>, <index>)
+		createCacheLevel(<name>, <size>, <ways>, [<line_size>], [<policy>]) (policy: "lru" or "plru")
+		defaultCacheHierarchy()
+		registerBenchmark(<caption_text>, <algorithm>, <structure>, <rules>, <headers>, <amount_runs>, [<options>])
+			(options: {threads = <n>} measures additionally the throughput with <n> threads,
+			          {warmup = <n>} performs <n> runs before the measured ones, which are discarded,
+			          {cpu = <n>} pins the classifying thread to cpu <n>,
+			          {batch_size = <n>} generates (or reads from a trace) and classifies headers in batches of <n>,
+			          {native = false} includes the conversion of each header in the classification,
+			          {matches = true} writes the matched rule of each header to a file,
+			          {sampling = <n>} times only 1 in <n> headers inside the algorithm,
+			          {latency = true} reports percentiles of the lookup time per header,
+			          {counters = true} counts hardware events like cycles and cache misses,
+			          {updates = <trace>} replays rule updates after the classification,
+			          {cache = <levels>} simulates a cache hierarchy with the traced memory accesses,
+			          {access_trace = true} writes all traced memory accesses of each run to a file,
+			          {heap = true} measures all heap allocations while building the classifier and classifying)
 ]]
 
 -- Specify some classification algorithms
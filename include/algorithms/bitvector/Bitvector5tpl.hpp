@@ -57,6 +57,13 @@ public:
 
 	void classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) override;
 
+  size_t nativeHeaderSize() const override { return sizeof(Data5tpl::HeaderTuple); }
+
+  void convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) override;
+  void convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) override;
+
+  void classifyNative(const void* tuples, size_t count, uint32_t* out) override;
+
   void setRules(const Generic::RuleSet& ruleset) override;
 
 	void ruleAdded(uint32_t index, const Generic::Rule& rule) override;
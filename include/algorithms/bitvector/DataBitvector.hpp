@@ -11,7 +11,8 @@ namespace DataBitvector {
 
 /** Concrete type of storage for multiple bits. */
 typedef unsigned int StorageT;
-typedef Memory::MemTrace<StorageT> MemStorageT;
+/** Traced storage array, which is registered once for all of its elements. */
+typedef Memory::MemTraceBlock<StorageT> MemStorageT;
 
 /**
  * Holds each bit of the vector and provides functions for
@@ -25,7 +26,7 @@ class Bitvector {
   unsigned int _storageSize;
 
   /** container of variable size for all bits */
-  std::unique_ptr<MemStorageT[]> _storage;
+  MemStorageT _storage;
 
   /** Get machine dependent size of a single storage object. */
   inline unsigned int _getSizeStorageT() const { return sizeof(StorageT) * 8; }
@@ -40,7 +41,7 @@ class Bitvector {
    * @param bitpos to return the bit-position inside returned storage
    * @returns storage value with contained bit at bit-position 'bitpos'
    */
-  MemStorageT& _getStorageReference(unsigned int position, unsigned int& bitpos) const;
+  MemStorageT::Element _getStorageReference(unsigned int position, unsigned int& bitpos) const;
 
 protected:
 
@@ -3,6 +3,7 @@
 
 #include <generics/RuleSet.hpp>
 #include <generics/PacketHeader.hpp>
+#include <generics/PacketHeaderColumns.hpp>
 #include <algorithms/common/Data2tpl.hpp>
 
 /** Handles the conversion of values with variable length to target five-tuple type. */
@@ -39,6 +40,24 @@ public:
    * @param tuple reference to already created header tuple-object which will be filled
    */
 	static void convertHeader(const Generic::PacketHeaderLine& line, Data2tpl::HeaderTuple& tuple);
+
+  /**
+   * Converts a complete generic header set at once into a contiguous array
+   * of header tuples, e.g. for a native classification.
+   *
+   * @param data generic header data set
+   * @param tuples uninitialized memory for (at least) data.size() header tuples
+   */
+  static void convertHeaders(const Generic::PacketHeaderSet& data, Data2tpl::HeaderTuple* tuples);
+
+  /**
+   * Converts a complete columnar header set at once into a contiguous array
+   * of header tuples, without creating a generic header line per header.
+   *
+   * @param data columnar generic header data set
+   * @param tuples uninitialized memory for (at least) data.size() header tuples
+   */
+  static void convertHeaders(const Generic::PacketHeaderColumns& data, Data2tpl::HeaderTuple* tuples);
 };
 
 #endif
@@ -18,15 +18,26 @@ struct Parameters {
   Parameters(unsigned int b, double fac, unsigned int ruleCnt) : binth(b), spfac(fac), totalRules(ruleCnt) {}
 };
 
-/** Represents a simple numerical range with detection of overlapping. */
+/**
+ * Represents a simple numerical range with detection of overlapping. Both
+ * limits are traced together as one region, because trees contain millions
+ * of ranges.
+ */
 template <typename T>
 struct Range {
-  Memory::MemTrace<T> min;
-  Memory::MemTrace<T> max;
+  Memory::MemTraceRegion region;
+  Memory::MemTraceShared<T> min;
+  Memory::MemTraceShared<T> max;
 
-  Range(const T& minVal, const T& maxVal) : min(minVal), max(maxVal) {}
-  Range(T&& minVal, T&& maxVal) : min(minVal), max(maxVal) {}
-  Range(const Range<T>& other) : min(other.min), max(other.max) {}
+  Range(const T& minVal, const T& maxVal) : region(2 * sizeof(T)), min(region, minVal), max(region, maxVal) {}
+  Range(const Range<T>& other) : region(2 * sizeof(T)), min(region, other.min), max(region, other.max) {}
+
+  /** Copies only the limits, the region of this range is kept. */
+  inline Range<T>& operator=(const Range<T>& rhs) {
+    min = rhs.min;
+    max = rhs.max;
+    return *this;
+  }
 
   /** Overload less-operator for sorting of ranges */
   inline bool operator<(const Range<T>& rhs) const {
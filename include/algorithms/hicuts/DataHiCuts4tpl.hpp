@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <metering/memory/MemTrace.hpp>
+#include <generics/Snapshot.hpp>
 #include <algorithms/hicuts/DataHiCuts.hpp>
 #include <algorithms/common/Data4tpl.hpp>
 
@@ -121,6 +122,12 @@ public:
   void cut(unsigned int amount, bool& underrun);
 
   void removeRedundancy();
+
+  /** Appends this node and all its children to the image of a snapshot. */
+  void save(Generic::SnapshotWriter& image) const;
+
+  /** Restores a node and all its children from the image of a snapshot (rules are referenced by index). */
+  static TrieNodePtr load(Generic::SnapshotReader& image, const RulesVector& rules);
 };
 
 /** Iterates over all rules and determines how many disjunct rule check pairs in each dimension exist. */
@@ -144,6 +151,12 @@ public:
   /** Returns true, if found a matching rule for the given header. */
   bool search(const Data4tpl::HeaderTuple& header, unsigned int& index) const;
 
+  /** Appends the constructed trie to the image of a snapshot. */
+  void save(Generic::SnapshotWriter& image) const;
+
+  /** Restores a trie from the image of a snapshot instead of constructing it for the given rules. */
+  void load(Generic::SnapshotReader& image, const RulesVector& rules);
+
   void reset() { _root.reset(); }
 };
 } // namespace DataHiCuts4tpl
@@ -40,8 +40,19 @@ public:
 
 	void classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) override;
 
+  size_t nativeHeaderSize() const override { return sizeof(Data4tpl::HeaderTuple); }
+
+  void convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) override;
+  void convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) override;
+
+  void classifyNative(const void* tuples, size_t count, uint32_t* out) override;
+
   void setRules(const Generic::RuleSet& ruleset) override;
 
+  bool supportsSnapshots() const override { return true; }
+  void saveSnapshot(std::vector<uint8_t>& image) const override;
+  void loadSnapshot(const Generic::RuleSet& ruleset, const uint8_t* image, size_t size) override;
+
 	void ruleAdded(uint32_t index, const Generic::Rule& rule) override;
   
   void ruleRemoved(uint32_t index) override;
@@ -5,8 +5,12 @@
 #include <memory>
 #include <string>
 #include <generics/RuleSet.hpp>
-#include <generics/PacketHeader.hpp>
+#include <generics/PacketHeaderColumns.hpp>
 #include <configuration/RandomHeaderConfiguration.hpp>
+#include <configuration/RuleUpdateConfiguration.hpp>
+#include <configuration/PcapConfiguration.hpp>
+#include <configuration/CacheConfiguration.hpp>
+#include <configuration/SharedRuleSet.hpp>
 
 /** contains parameters to configure an algorithm */
 typedef std::vector<double> AlgorithmParameterSet;
@@ -17,7 +21,7 @@ typedef std::vector<unsigned int> FieldStructureSet;
 /**
  * Represents one benchmark with a certain algorithm, a ruleset and
  * headers as input. A benchmark is repeated, if number of runs is 
- * greater than one.
+ * greater than one. New members have to be stored by ConfigurationCache, too.
  */
 struct Benchmark {
   /** Unique identifier (will be set once by the configuration). */
@@ -31,23 +35,81 @@ struct Benchmark {
   FieldStructureSet fieldStructure;
   
   bool generateHeaders;
-  Generic::PacketHeaderSet headers;
+  /** Explicit headers, stored column by column according to fieldStructure (shared by all benchmarks with the same header set). */
+  std::shared_ptr<const Generic::PacketHeaderColumns> headers;
+  /** Path of a binary header trace, whose headers are streamed instead of explicit headers (see Generic::HeaderTraceReader). */
+  std::string headerTrace;
+  /** Number of headers in the header trace. */
+  unsigned int traceHeaders;
+  /** Packet capture, whose headers are streamed instead of explicit headers (see PcapSource). */
+  PcapConfiguration pcap;
   RandomHeaderConfiguration rndHeaderConfig;
   
   bool generateRules;
-  Generic::RuleSet rules;
+  /** Rules, which are shared by all benchmarks with the same rule set. */
+  std::shared_ptr<SharedRuleSet> rules;
   // RandomRuleConfiguration rndRuleConfig;
 
+  /** Rule updates, which are replayed after the classification (see BenchmarkExecutor::_replayUpdates). */
+  RuleUpdateConfiguration ruleUpdates;
+
   /** Defines how often the benchmark will be run. */
   unsigned int numberRuns;
 
-  Benchmark() : algParameter(), fieldStructure(), generateHeaders(false), headers(), rndHeaderConfig(), generateRules(false), rules(), numberRuns(1) {}
+  /** Number of runs before the measured runs, which are excluded from all results (e.g. to warm up caches). */
+  unsigned int warmupRuns;
+
+  /** Number of the cpu, to which the classifying thread is pinned (-1: not pinned). */
+  int cpuAffinity;
+
+  /** Number of worker threads for measuring the throughput of a concurrent classification (1: single-threaded only). */
+  unsigned int threads;
+
+  /** If true, headers are converted before classification, if supported by the algorithm (see Base::classifyNative). */
+  bool nativeClassification;
+
+  /** If true, the matched rule of each header is written to a file (otherwise, only a digest is compared between runs). */
+  bool outputMatches;
+
+  /** Only one out of this number of headers is timed inside the algorithm (1: each header is timed). */
+  unsigned int samplingRate;
+
+  /** If true, headers are classified once more one by one to record the distribution of lookup latencies. */
+  bool measureLatency;
+
+  /** If true, hardware events (cycles, cache misses, ...) are counted in addition to the runtime, if available. */
+  bool measureCounters;
+
+  /** Levels of a cache hierarchy, which is simulated with the addresses of all traced memory accesses (empty: no simulation). */
+  CacheConfiguration cache;
+
+  /** If true, all traced memory accesses of each testrun are written to a trace file (see Memory::AccessTraceWriter). */
+  bool traceAccesses;
+
+  /** If true, the real heap usage (all allocations with operator new) is measured while building the classifier and classifying. */
+  bool measureHeap;
+
+  Benchmark() : algParameter(), fieldStructure(), generateHeaders(false), headers(std::make_shared<Generic::PacketHeaderColumns>()), headerTrace(), traceHeaders(0), pcap(), rndHeaderConfig(), generateRules(false), rules(std::make_shared<SharedRuleSet>()), ruleUpdates(), numberRuns(1), warmupRuns(0), cpuAffinity(-1), threads(1), nativeClassification(true), outputMatches(false), samplingRate(1), measureLatency(false), measureCounters(false), cache(), traceAccesses(false), measureHeap(false) {}
+
+  /** Returns true, if headers are streamed from a binary header trace. */
+  inline bool hasHeaderTrace() const { return !headerTrace.empty(); }
+
+  /** Returns true, if headers are streamed from a packet capture. */
+  inline bool hasPcap() const { return !pcap.filename.empty(); }
+
+  /** Returns true, if headers are classified in batches from a generator, a header trace or a packet capture. */
+  inline bool streamsHeaders() const { return generateHeaders || hasHeaderTrace() || hasPcap(); }
 
-  /** Returns the total number of headers (random or explicit). */
-  inline unsigned int getHeaderNumber() const { return (generateHeaders ? rndHeaderConfig.totalHeaders : headers.size()); }
+  /** Returns the total number of headers (random, from a trace or a capture, or explicit). */
+  inline unsigned int getHeaderNumber() const { 
+    if (generateHeaders) return rndHeaderConfig.totalHeaders;
+    else if (hasHeaderTrace()) return traceHeaders;
+    else if (hasPcap()) return pcap.packets * pcap.replay;
+    return headers->size();
+  }
 
-  /** Returns the total number of rules (now: just explicit). */
-  inline unsigned int getRuleNumber() const { return (generateRules ? 0 : rules.size()); }
+  /** Returns the total number of rules (now: just explicit, without loading them). */
+  inline unsigned int getRuleNumber() const { return (generateRules ? 0 : rules->size()); }
 };
 
 /** Shortcut for a shared-ptr on a Benchmark-instance. */
@@ -0,0 +1,35 @@
+#ifndef CACHECONFIGURATION_INCLUDED
+#define CACHECONFIGURATION_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/** Holds the configuration of one level of a simulated cache hierarchy (see Memory::CacheSimulator). */
+struct CacheLevelConfiguration {
+  /** Replacement policy of a set: least recently used or tree-based pseudo-LRU. */
+  enum Policy { LRU = 0, PLRU = 1 };
+
+  /** Caption of the level in the results (e.g. "L1"). */
+  std::string name;
+
+  /** Capacity of the level in bytes. */
+  size_t size;
+
+  /** Number of lines in each set (associativity). */
+  unsigned int ways;
+
+  /** Size of a cache line in bytes (a power of two). */
+  unsigned int lineSize;
+
+  Policy policy;
+
+  CacheLevelConfiguration() : name(), size(0), ways(1), lineSize(64), policy(LRU) {}
+  CacheLevelConfiguration(const std::string& n, size_t s, unsigned int w, unsigned int l, Policy p) : 
+    name(n), size(s), ways(w), lineSize(l), policy(p) {}
+};
+
+/** All levels of a simulated cache hierarchy, beginning with the level next to the CPU (empty: no simulation). */
+typedef std::vector<CacheLevelConfiguration> CacheConfiguration;
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef CLASSBENCHLOADER_INCLUDED
+#define CLASSBENCHLOADER_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <generics/RuleSet.hpp>
+
+/**
+ * Parses a filter set in the format of ClassBench (one filter per line like
+ * "@10.0.0.0/8  192.168.1.0/24  0 : 65535  80 : 80  0x06/0xFF ...") and
+ * builds the rules directly, so large filter sets don't need to be converted
+ * into a Lua script first. The file is mapped into memory and split into
+ * chunks of whole lines, which are parsed by several threads.
+ *
+ * The header fields are taken in the order source address, destination
+ * address, source port, destination port and protocol, so a structure with
+ * 2, 4 or 5 fields can be used. A field must be at least as wide as its
+ * packet field (32, 32, 16, 16 and 8 bits) and at most 64 bits wide. Addresses
+ * become exact or prefix atoms, ports exact or range atoms and the protocol
+ * an exact atom (or a prefix atom, if it is masked, e.g. a wildcard).
+ */
+class ClassBenchLoader {
+  /** Throws an exception, if the structure doesn't fit the fields of a filter. */
+  static void _checkStructure(const std::vector<unsigned int>& structure);
+
+  /**
+   * Parses the lines of [begin, end) and appends their rules. Nothing is thrown
+   * (it runs in a thread of its own): a failure is stored in error instead and
+   * for an invalid filter, errorPosition is set to the start of its line.
+   */
+  static void _parseChunk(const char* begin, const char* end, const std::vector<unsigned int>& structure, Generic::RuleSet& rules, std::exception_ptr& error, const char*& errorPosition);
+
+public:
+  /**
+   * Appends the rules of a ClassBench filter set to a rule set, an exception
+   * is thrown, if the file is missing or contains an invalid filter (its line
+   * is reported on stderr) or if the structure doesn't fit.
+   *
+   * @param filename path of the filter set
+   * @param structure width in bits of each header field
+   * @param rules rule set, which is extended in the order of the file
+   * @param threads number of parsing threads (0: one per cpu)
+   * @return number of appended rules
+   */
+  static size_t load(const std::string& filename, const std::vector<unsigned int>& structure, Generic::RuleSet& rules, unsigned int threads = 0);
+
+  /**
+   * Returns the number of filters of a ClassBench file without parsing them,
+   * an exception is thrown, if the file is missing or the structure doesn't fit.
+   */
+  static size_t count(const std::string& filename, const std::vector<unsigned int>& structure);
+};
+
+#endif
+
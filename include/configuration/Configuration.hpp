@@ -20,9 +20,15 @@ class Configuration {
   std::string _progName;
   /** Collection of benchmark-configurations to run */
   BenchmarkSet _benchmarks;
+  /** Scripts, which were interpreted for this configuration (see ConfigurationCache) */
+  std::vector<std::string> _sourceFiles;
+  /** Files, which were only inspected for this configuration (e.g. header traces) */
+  std::vector<std::string> _dataFiles;
+  /** False, if the configuration depends on more than its files (e.g. on the current time) */
+  bool _cacheable;
 
 public:
-	Configuration() : _progRelPath(""), _progName("cate"), _benchmarks() {}
+	Configuration() : _progRelPath(""), _progName("cate"), _benchmarks(), _sourceFiles(), _dataFiles(), _cacheable(true) {}
 	~Configuration() {}
 
   inline void setProgRelativePath(const std::string& path) { _progRelPath = path; }
@@ -32,6 +38,17 @@ public:
   inline std::string getProgName() { return _progName; }
 
   inline BenchmarkSet& getBenchmarkSet() { return _benchmarks; }
+  inline const BenchmarkSet& getBenchmarkSet() const { return _benchmarks; }
+
+  /** Adds a script, whose content is part of the configuration (duplicates are ignored). */
+  void addSourceFile(const std::string& filename);
+  /** Adds a file, whose size is part of the configuration (duplicates are ignored). */
+  void addDataFile(const std::string& filename);
+  inline void setCacheable(bool cacheable) { _cacheable = cacheable; }
+
+  inline const std::vector<std::string>& getSourceFiles() const { return _sourceFiles; }
+  inline const std::vector<std::string>& getDataFiles() const { return _dataFiles; }
+  inline bool isCacheable() const { return _cacheable; }
 
   /** Assign a unique identifier to each benchmark. */
   void setBenchmarkIds();
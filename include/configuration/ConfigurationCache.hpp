@@ -0,0 +1,62 @@
+#ifndef CONFIGURATION_CACHE_INCLUDED
+#define CONFIGURATION_CACHE_INCLUDED
+
+#include <string>
+#include <cstdint>
+#include <configuration/Configuration.hpp>
+
+/**
+ * Keeps the parsed configuration of a Lua script as binary file in a
+ * directory, so that large suites (e.g. with thousands of explicit rules)
+ * are interpreted only once. The file lists all files, which the
+ * configuration depends on: the content of interpreted scripts is compared
+ * by its hash, while the size and modification time are compared for
+ * inspected files (e.g. header traces) and the program itself. If one of
+ * them changed, the cached configuration is ignored. Shared rule sets and
+ * header sets (see LuaConfigurator::shareRules) are stored only once.
+ */
+class ConfigurationCache {
+  /** path of the cache file (empty: cache is unavailable) */
+  std::string _filename;
+  /** path of the program, which created the configuration */
+  std::string _programFile;
+  /** identifies the configuration file, working directory and program */
+  uint64_t _key;
+
+public:
+  /**
+   * @param directory directory of the cache files
+   * @param configFile path of the Lua configuration (relative to the working directory)
+   * @param programFile path of the executed program
+   */
+  ConfigurationCache(const std::string& directory, const std::string& configFile, const std::string& programFile);
+  ~ConfigurationCache() {}
+
+  /**
+   * Returns the default directory for cache files ($XDG_CACHE_HOME/cate or
+   * ~/.cache/cate), which is created, if necessary. An empty string is
+   * returned, if it isn't available.
+   */
+  static std::string defaultDirectory();
+
+  /** Returns the path of the cache file. */
+  inline const std::string& filename() const { return _filename; }
+
+  /**
+   * Adds the benchmarks of the cached configuration, if none of its files
+   * has changed since it was stored.
+   *
+   * @return false, if no valid cache file exists (the configuration is unchanged)
+   */
+  bool load(Configuration& config) const;
+
+  /**
+   * Saves the benchmarks of an interpreted configuration into the cache
+   * file. An existing file is replaced atomically.
+   *
+   * @return false, if the configuration isn't cacheable or the file can't be written
+   */
+  bool store(const Configuration& config) const;
+};
+
+#endif
@@ -4,6 +4,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <utility>
+#include <cstdint>
 #include <configuration/Configuration.hpp>
 
 /**
@@ -19,13 +22,25 @@ class LuaConfigurator {
   /** helper function to avoid repeating same code in addDistribution* functions */
   void _pushBackRandomDistribution(unsigned int seed, const std::unique_ptr<RandomDistribution> dist);
 
-  /** Returns the index of the current top most rule of the last benchmark. */
-  int _getTopRuleIndex() const;
+  /** Rule sets and header sets of the suite by their Lua table (or file) and field structure, to share them between benchmarks. */
+  std::map<std::pair<const void*, FieldStructureSet>, std::shared_ptr<SharedRuleSet>> _ruleSets;
+  std::map<std::pair<std::string, FieldStructureSet>, std::shared_ptr<SharedRuleSet>> _classBenchSets;
+  std::map<std::pair<const void*, FieldStructureSet>, std::shared_ptr<Generic::PacketHeaderColumns>> _headerSets;
+
+  /** Rule set and header set of the last benchmark, to which rules and headers are added. */
+  std::shared_ptr<SharedRuleSet> _rules;
+  std::shared_ptr<Generic::PacketHeaderColumns> _headers;
+
+  /** If true, rule atoms are added to the last inserted rule of the update trace instead of the rule set. */
+  bool _atomsOfUpdate;
+
+  /** Returns the current top most rule of the last benchmark (or of its update trace). */
+  Generic::Rule& _getTopRule() const;
   /** Returns the configured width of the next to add rule atom. */
   size_t _getCurrentAtomWidth() const;
 
 public:
-  LuaConfigurator(std::shared_ptr<Configuration> cfg) : _config(cfg) {}
+  LuaConfigurator(std::shared_ptr<Configuration> cfg) : _config(cfg), _ruleSets(), _classBenchSets(), _headerSets(), _rules(), _headers(), _atomsOfUpdate(false) {}
   ~LuaConfigurator() {}
 
   void addBenchmark();
@@ -37,6 +52,14 @@ public:
 
   void addFieldStructure(unsigned int bitsize);
 
+  /**
+   * Lets the last benchmark share the rules of a previous benchmark with the
+   * same Lua table and field structure.
+   *
+   * @param table identity of the Lua table of the rule set
+   * @return true, if the rules are shared (they must not be added again)
+   */
+  bool shareRules(const void* table);
   void addRule();
   void addRuleAtomExact(unsigned int value);
   void addRuleAtomExact(std::string& value);
@@ -44,13 +67,23 @@ public:
   void addRuleAtomRange(std::string& min, std::string& max);
   void addRuleAtomPrefix(unsigned int prefix, unsigned int mask);
   void addRuleAtomPrefix(std::string& prefix, std::string& mask);
+  void loadClassBenchRules(const char* filename);
 
+  /** Like shareRules, but for a Lua table with explicit headers. */
+  bool shareHeaders(const void* table);
   void addHeader();
   void addHeaderValue(unsigned int value);
   void addHeaderValue(std::string& value);
 
+  void setHeaderTrace(const char* filename);
+
+  void setPcapFile(const char* filename);
+  void setPcapReplay(unsigned int times);
+  void addPcapField(const char* name);
+
   void setRandomHeaderNumber(unsigned int number);
-  void setRandomHeaderOutput(bool outputToFile);
+  void setRandomHeaderOutput(bool outputToFile, bool binary = false);
+  void setRandomHeaderBatchSize(unsigned int size);
   void addDistributionConstant(unsigned int value);
   void addDistributionConstant(std::string& value);
   void addDistributionUniform(unsigned int seed, unsigned int min, unsigned int max);
@@ -66,8 +99,28 @@ public:
   void addDistributionPareto(unsigned int seed, double scale, double shape, std::string& offset);
 
   void setNumberRuns(unsigned int number);
+  void setThreads(unsigned int number);
+  void setWarmupRuns(unsigned int number);
+  void setCpuAffinity(unsigned int cpu);
+  void setNativeClassification(bool native);
+  void setOutputMatches(bool output);
+  void setSamplingRate(unsigned int rate);
+  void setMeasureLatency(bool measure);
+  void setMeasureCounters(bool measure);
+  void addCacheLevel(const std::string& name, size_t size, unsigned int ways, unsigned int lineSize, const std::string& policy);
+  void setTraceAccesses(bool trace);
+  void setMeasureHeap(bool measure);
+
+  void setRuleUpdateInterval(unsigned int headers);
+  void addRuleInsertion(uint32_t index);
+  void addRuleRemoval(uint32_t index);
 
   void makeFullRelativePath(const std::string& postfix, std::string& result);
+
+  /** Adds a script, which was read by the interpreter (see Configuration::addSourceFile). */
+  void addSourceFile(const std::string& filename);
+  /** Marks the configuration as depending on more than its files (e.g. on the current time). */
+  void setCacheable(bool cacheable);
 };
 #endif
 
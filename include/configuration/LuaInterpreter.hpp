@@ -53,12 +53,18 @@ class LuaInterpreter {
 
   /*** The following are private configuration input-functions: ***/
 
+  /** Fetch the files, which were read by the script, and whether the configuration may be cached. */
+  static void fetchSourceFiles(lua_State* L);
+
   /** Iterate over all benchmarks and fetch their configuration. */
   static void iterBenchmarks(lua_State* L, int index);
 
   /** Fetch the configuration of one benchmark. */
   static void fetchBenchmark(lua_State* L, int index);
 
+  /** Fetch the optional settings of one benchmark. */
+  static void fetchOptions(lua_State* L, int index);
+
   /** Fetch the configuration of an algorithm. */
   static void fetchAlgorithm(lua_State* L, int index); 
 
@@ -77,9 +83,27 @@ class LuaInterpreter {
   /** Fetch the configuration of one rule atom. */
   static void fetchRuleAtom(lua_State* L, int index); 
 
+  /** Fetch a trace of rule updates (headers between updates and all updates). */
+  static void fetchUpdateTrace(lua_State* L, int index);
+
+  /** Iterate over all rule updates in a trace. */
+  static void iterUpdates(lua_State* L, int index);
+
+  /** Fetch the configuration of one rule update (insertion or removal). */
+  static void fetchUpdate(lua_State* L, int index);
+
+  /** Iterate over all levels of a simulated cache hierarchy. */
+  static void iterCacheLevels(lua_State* L, int index);
+
+  /** Fetch the configuration of one level of a simulated cache hierarchy. */
+  static void fetchCacheLevel(lua_State* L, int index);
+
   /** Iterate over header definition and determine its type. */
   static void iterHeaderDefinition(lua_State* L, int index);
 
+  /** Iterate over the names of packet fields of a replayed packet capture. */
+  static void iterPcapFields(lua_State* L, int index);
+
   /** Iterate over all explicit headers in the header set. */
   static void iterExplicitHeaders(lua_State* L, int index);
 
@@ -0,0 +1,25 @@
+#ifndef PCAPCONFIGURATION_INCLUDED
+#define PCAPCONFIGURATION_INCLUDED
+
+#include <string>
+#include <vector>
+
+/** Holds the configuration of a packet capture, whose headers are replayed (see PcapSource). */
+struct PcapConfiguration {
+  /** Path of the pcap or pcapng file. */
+  std::string filename;
+
+  /** Number of times, which all packets of the capture are classified in a row. */
+  unsigned int replay;
+
+  /** Name of the packet field for each header field (empty: default mapping of the header structure). */
+  std::vector<std::string> fields;
+
+  /** Number of usable packets (IPv4) in one pass over the capture. */
+  unsigned int packets;
+
+  PcapConfiguration() : filename(), replay(1), fields(), packets(0) {}
+};
+
+#endif
+
@@ -19,13 +19,19 @@ struct RandomHeaderConfiguration {
   /** If true, generated headers will be output to a file in results directory. */
   bool outputToFile;
 
+  /** If true, generated headers are output as binary header trace instead of csv (see Generic::HeaderTraceWriter). */
+  bool outputBinary;
+
+  /** Number of headers, which are generated (or read from a header trace) and classified at once. */
+  unsigned int batchSize;
+
   /** All configured random distributions per header field. */
   RandomDistributionSet distributions;
 
   /** Seed values for each random generator. */
   RandomGeneratorSeedSet seeds;
 
-  RandomHeaderConfiguration() : totalHeaders(0), outputToFile(false), distributions(), seeds() {}
+  RandomHeaderConfiguration() : totalHeaders(0), outputToFile(false), outputBinary(false), batchSize(1024), distributions(), seeds() {}
 };
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef RULEUPDATECONFIGURATION_INCLUDED
+#define RULEUPDATECONFIGURATION_INCLUDED
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <generics/Rule.hpp>
+
+/** A single change of the rule set: insertion or removal of a rule at a given position. */
+struct RuleUpdate {
+  enum Type { INSERT, REMOVE };
+
+  Type type;
+
+  /** Position of the rule in the current rule set (starting with 0). */
+  uint32_t index;
+
+  /** Rule to insert (empty for a removal). */
+  Generic::Rule rule;
+
+  RuleUpdate(Type t, uint32_t idx) : type(t), index(idx), rule() {}
+};
+
+/** Type of a vector with all rule updates in the order of their replay. */
+typedef std::vector<std::unique_ptr<RuleUpdate>> RuleUpdateTrace;
+
+/** Holds a trace of rule updates, which is replayed after all headers were classified. */
+struct RuleUpdateConfiguration {
+  /** Number of headers, which are classified before each update (0: no headers between updates). */
+  unsigned int headersPerUpdate;
+
+  /** All rule updates in the order of their replay. */
+  RuleUpdateTrace trace;
+
+  RuleUpdateConfiguration() : headersPerUpdate(0), trace() {}
+};
+
+#endif
+
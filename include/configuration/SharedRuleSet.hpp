@@ -0,0 +1,66 @@
+#ifndef SHAREDRULESET_INCLUDED
+#define SHAREDRULESET_INCLUDED
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <generics/RuleSet.hpp>
+
+/**
+ * Rule set of a benchmark suite, which is shared by all benchmarks with the
+ * same rules (see LuaConfigurator::shareRules), so it is converted and held
+ * in memory only once. Rules of a ClassBench file are loaded right before
+ * the first benchmark, which needs them (see ClassBenchLoader).
+ */
+class SharedRuleSet {
+  /** explicit rules or rules of the ClassBench file, once they are loaded */
+  Generic::RuleSet _rules;
+  /** path of a ClassBench file (empty for explicit rules) */
+  std::string _classBenchFile;
+  /** width in bits of each field of the rules of the ClassBench file */
+  std::vector<unsigned int> _structure;
+  /** number of rules of the ClassBench file */
+  size_t _fileRules;
+  /** true, if the rules of the ClassBench file were loaded */
+  bool _loaded;
+
+public:
+  /** Creates an empty set for explicit rules. */
+  SharedRuleSet() : _rules(), _classBenchFile(), _structure(), _fileRules(0), _loaded(true) {}
+
+  /**
+   * Creates a set for the rules of a ClassBench file, which are only counted
+   * here (an exception is thrown, if the file is missing or the structure doesn't fit).
+   */
+  SharedRuleSet(const std::string& classBenchFile, const std::vector<unsigned int>& structure);
+
+  /** Creates a set for the rules of a ClassBench file, whose filters were already counted (e.g. by a cached configuration). */
+  SharedRuleSet(const std::string& classBenchFile, const std::vector<unsigned int>& structure, size_t rules) : _rules(), _classBenchFile(classBenchFile), _structure(structure), _fileRules(rules), _loaded(false) {}
+
+  SharedRuleSet(const SharedRuleSet&) = delete;
+  SharedRuleSet& operator=(const SharedRuleSet&) = delete;
+
+  /** Returns the explicit rules for adding rules while the configuration is read. */
+  inline Generic::RuleSet& edit() { return _rules; }
+
+  /** Returns the rules, which are loaded first, if necessary (an exception is thrown for an invalid file). */
+  const Generic::RuleSet& get();
+
+  /** Returns the number of rules without loading them. */
+  inline size_t size() const { return (_classBenchFile.empty() ? _rules.size() : _fileRules); }
+
+  /** Returns true, if the rules are available without loading them. */
+  inline bool isLoaded() const { return _loaded; }
+
+  /** Returns the path of the ClassBench file (empty for explicit rules). */
+  inline const std::string& getClassBenchFile() const { return _classBenchFile; }
+
+  /** Returns the field structure of the rules of the ClassBench file. */
+  inline const std::vector<unsigned int>& getStructure() const { return _structure; }
+
+  /** Returns the explicit rules without loading a ClassBench file. */
+  inline const Generic::RuleSet& getExplicit() const { return _rules; }
+};
+
+#endif
+
@@ -3,15 +3,47 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include <generics/AlgFactory.hpp>
 #include <metering/memory/MemTrace.hpp>
 #include <metering/memory/MemManager.hpp>
 #include <metering/memory/MemTraceRegistry.hpp>
 #include <metering/LogTagManager.hpp>
+#include <metering/PerfManager.hpp>
+#include <metering/HeapMeter.hpp>
 #include <configuration/Benchmark.hpp>
 #include <evaluation/Evaluator.hpp>
 #include <evaluation/Results.hpp>
 #include <frontend/OutputResults.hpp>
+#include <generator/HeaderGenerator.hpp>
+#include <generics/HeaderTrace.hpp>
+#include <generator/PcapSource.hpp>
+#include <core/CpuEnvironment.hpp>
+#include <core/SnapshotCache.hpp>
+
+/** Suspends the time, memory and hardware metering, until the scope is left (also by an exception). */
+class MeteringSuspendGuard {
+  ChronoManager& _chrono;
+  Memory::MemManager& _memManager;
+  PerfManager& _perf;
+
+public:
+  MeteringSuspendGuard(ChronoManager& chrono, Memory::MemManager& memManager, PerfManager& perf) : 
+    _chrono(chrono), _memManager(memManager), _perf(perf) {
+    _chrono.setSuspended(true);
+    _memManager.setSuspended(true);
+    _perf.setSuspended(true);
+  }
+  ~MeteringSuspendGuard() {
+    _chrono.setSuspended(false);
+    _memManager.setSuspended(false);
+    _perf.setSuspended(false);
+  }
+
+  MeteringSuspendGuard(const MeteringSuspendGuard&) = delete;
+  MeteringSuspendGuard& operator=(const MeteringSuspendGuard&) = delete;
+};
 
 /** 
  * Prepares all relevant classes for the execution of a benchmark and triggers
@@ -29,6 +61,31 @@ class BenchmarkExecutor {
   OutputResults _resultsHandler;
   /** Stores all results of each run of a benchmark. */
   BenchmarkResults _results;
+  /** Keeps generated (or streamed) headers of the current run for a concurrent classification. */
+  Generic::PacketHeaderColumns _generatedHeaders;
+  /** Buffer for a batch of line-based headers, if the algorithm can't classify native headers. */
+  Generic::PacketHeaderSet _lineHeaders;
+  /** Buffer for headers in the native representation of the algorithm. */
+  std::vector<uint8_t> _nativeHeaders;
+  /** Buffer for indices of matched rules of a native classification. */
+  std::vector<uint32_t> _nativeIndices;
+  /** Pins the classifying thread to a cpu, if configured. */
+  CpuEnvironment _cpu;
+  /** True during warm-up runs, whose headers are neither written nor kept. */
+  bool _warmingUp;
+  /** Observed frequency of the classifying cpu after each testrun [MHz]. */
+  std::vector<double> _cpuFrequencies;
+  /** Cache of built classifiers (only set, if a directory for snapshots was given). */
+  std::unique_ptr<SnapshotCache> _snapshots;
+  /** Key of the classifier of the current benchmark in the snapshot cache. */
+  uint64_t _snapshotKey;
+  /** Number of runs (including warm-up), in which the classifier was loaded from or built for its snapshot. */
+  unsigned int _snapshotLoads;
+  unsigned int _snapshotBuilds;
+  /** Writes all traced memory accesses of the current testrun (only set, if requested). */
+  std::shared_ptr<Memory::AccessTraceWriter> _accessTrace;
+  /** Number of written accesses in each testrun. */
+  std::vector<uint64_t> _accessTraceRecords;
 
   /// Following are class-instances which will be constructed in call of "execute":
 
@@ -42,6 +99,10 @@ class BenchmarkExecutor {
   std::shared_ptr<ChronoManager> _chrono;
   /** Smart pointer to an instance of the LogTagManager to use. */
   std::shared_ptr<LogTagManager> _logger;
+  /** Smart pointer to an instance of the PerfManager to count hardware events (only opened on request). */
+  std::unique_ptr<PerfManager> _perf;
+  /** Smart pointer to an instance of the HeapMeter to measure the real heap usage (only enabled on request). */
+  std::unique_ptr<HeapMeter> _heap;
   
   /** Create an instance of an algorithm by loading the specified library file of an algorithm. */
   bool _loadAlgorithm();
@@ -55,28 +116,94 @@ class BenchmarkExecutor {
   /** Create a log tag manager to support custom log messages. */
   void _setupLogTagManager();
 
-  /** Classify a given header set and return matching indices. */
-  void _classifyHeaders(const Generic::PacketHeaderSet& headers, Generic::RuleIndexSet& indices);
+  /** Create a perf manager and open the hardware counters, if requested in the benchmark configuration. */
+  void _setupPerfManager();
+
+  /** Create a heap meter, which is enabled, if requested in the benchmark configuration. */
+  void _setupHeapMeter();
+
+  /** 
+   * Classify a given header set and pass matching indices to the sink. If supported by the algorithm, 
+   * all headers are converted first and only the native classification is measured. The suffix is
+   * appended to the names of the chrono-categories.
+   */
+  void _classifyHeaders(const Generic::PacketHeaderColumns& headers, MatchSink& matches, const std::string& suffix = "");
+
+  /**
+   * Classify the given headers once more, but one by one, and record the lookup time of each header
+   * in a latency histogram. The headers have to be classified by _classifyHeaders before, because 
+   * native headers are reused. Runtime and memory metering are suspended meanwhile.
+   */
+  void _measureLatencies(const Generic::PacketHeaderColumns& headers, const std::string& suffix);
 
-  /** Copy all contained indices from src to dest container. */
-  void _indicesPushBack(const Generic::RuleIndexSet& src, Generic::RuleIndexSet& dest);
+  /** Returns the timespan between both time-points without the cost of reading the clock [ns]. */
+  uint64_t _latencyWithoutOverhead(Chronoclock::time_point start, Chronoclock::time_point stop) const;
+
+  /**
+   * Set the rule set of the benchmark for the algorithm. If a snapshot cache is used and the
+   * algorithm supports it, the classifier is loaded from its snapshot or built and stored once.
+   */
+  void _setRules();
+
+  /** Classify all headers of a header trace or a packet capture batch by batch. */
+  template <class Source>
+  void _classifyStream(Source& source, MatchSink& matches);
 
   /** Generate headers and/or rules and classify headers with the instantiated algorithm. */
-  void _classify(Generic::RuleIndexSet& indices);
+  void _classify(MatchSink& matches);
+
+  /** Returns the next headers to classify between two rule updates (explicit headers, traces and captures are repeated). */
+  void _nextUpdateHeaders(Generic::PacketHeaderColumns& headers, HeaderGenerator* generator, const Generic::HeaderTraceReader* trace, PcapSource* capture, size_t& position) const;
+
+  /** Replay the configured trace of rule updates and measure the latency of each update. */
+  void _replayUpdates(UpdateResults& updates);
+
+  /** Returns true, if headers are classified concurrently in multiple threads in addition. */
+  bool _isParallel() const;
+
+  /** Copy generated or streamed headers into a separate set, which is kept for a concurrent classification. */
+  void _keepGeneratedHeaders(const Generic::PacketHeaderColumns& headers);
+
+  /** Classify all headers of the current run concurrently and measure the throughput. */
+  void _classifyParallel(const MatchSink& expected, ScalingResults& scaling);
 
   /** Output all given headers to file, if specified in benchmark configuration. */
-  void _outputHeadersToFile(const Generic::PacketHeaderSet& headers) const;
+  void _outputHeadersToFile(const Generic::PacketHeaderColumns& headers) const;
+
+  /** Pin the classifying thread to the configured cpu. */
+  void _pinThread();
+
+  /** Perform the configured warm-up runs, whose results are discarded. */
+  void _warmUp();
+
+  /** Create the trace file for all memory accesses of a testrun, if requested in the benchmark configuration. */
+  void _openAccessTrace(unsigned int run);
+
+  /** Write the remaining accesses of the current testrun and close its trace file. */
+  void _closeAccessTrace();
+
+  /** Add the written access traces to the benchmark information. */
+  void _accessTraceInfo(BenchmarkInfoVector& info) const;
+
+  /** Add the usage of the snapshot of the classifier to the benchmark information. */
+  void _snapshotInfo(BenchmarkInfoVector& info) const;
+
+  /** Add model, frequency and governor of the classifying cpu to the benchmark information. */
+  void _cpuInfo(BenchmarkInfoVector& info) const;
 
   /** Reset all members in order to perform another repetition. */
   void _resetSetup();
 
 public:
-	BenchmarkExecutor(const std::string& relPath, const std::string& resultsDir) : _benchmark(), _relativePath(relPath), _resultsDir(resultsDir), _resultsHandler(), _results(), _algWrapper(), _memManager(), _memRegistry(), _chrono() {}
+	BenchmarkExecutor(const std::string& relPath, const std::string& resultsDir) : _benchmark(), _relativePath(relPath), _resultsDir(resultsDir), _resultsHandler(), _results(), _generatedHeaders(), _lineHeaders(), _nativeHeaders(), _nativeIndices(), _cpu(), _warmingUp(false), _cpuFrequencies(), _snapshots(), _snapshotKey(0), _snapshotLoads(0), _snapshotBuilds(0), _accessTrace(), _accessTraceRecords(), _algWrapper(), _memManager(), _memRegistry(), _chrono(), _logger(), _perf(), _heap() {}
 	~BenchmarkExecutor() {}
 
   /** Sets the benchmark configuration (necessary for execution of a benchmark) */
 	void configure(std::shared_ptr<Benchmark> b);
 
+  /** Use a directory for snapshots of built classifiers, which are reused across runs and invocations. */
+  inline void setSnapshotDirectory(const std::string& dir) { _snapshots.reset(new SnapshotCache(dir)); }
+
   /** Setup all necessary instances, run specified benchmark, and output results. */
 	bool execute();
 };
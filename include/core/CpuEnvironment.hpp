@@ -0,0 +1,80 @@
+#ifndef CPU_ENVIRONMENT_INCLUDED
+#define CPU_ENVIRONMENT_INCLUDED
+
+#include <string>
+#include <vector>
+
+/**
+ * Pins the calling thread to a single cpu and reads properties of the cpus
+ * (model, frequency and governor), so that benchmark results are reproducible
+ * and comparable between machines. On other systems than Linux, pinning fails
+ * and all properties are reported as unknown.
+ */
+class CpuEnvironment {
+  /** cpus, on which the thread was allowed to run before pinning */
+  std::vector<unsigned int> _allowed;
+  /** cpu of the pinned thread (-1, if not pinned) */
+  int _cpu;
+
+  /** Restrict the calling thread to the given cpus. */
+  static bool _setAffinity(const std::vector<unsigned int>& cpus);
+
+public:
+  CpuEnvironment() : _allowed(), _cpu(-1) {}
+  /** The calling thread is unpinned, if it is still pinned. */
+  ~CpuEnvironment() { unpin(); }
+
+  /**
+   * Pins the calling thread to the given cpu.
+   *
+   * @param cpu number of the cpu (starting with 0)
+   * @return false, if the thread can't be pinned (e.g. cpu isn't available)
+   */
+  bool pin(unsigned int cpu);
+
+  /**
+   * Allows the calling thread to run on all cpus again, which were allowed
+   * before pinning. Threads created meanwhile inherit this affinity.
+   *
+   * @param avoidPinned if true, the pinned cpu is excluded (if others are available)
+   */
+  void release(bool avoidPinned = false);
+
+  /** Pins the calling thread again to the same cpu, after it was released. */
+  void repin();
+
+  /** Releases the calling thread and forgets the pinned cpu. */
+  inline void unpin() { release(); _cpu = -1; }
+
+  /** Returns the cpu of the pinned thread or -1, if not pinned. */
+  inline int getCpu() const { return _cpu; }
+
+  /** Returns the cpus, on which the calling thread is allowed to run (empty, if unknown). */
+  static std::vector<unsigned int> allowedCpus();
+
+  /** Returns the cpu, on which the calling thread is running currently (-1, if unknown). */
+  static int currentCpu();
+
+  /** Returns the model name of the cpus (empty, if unknown). */
+  static std::string model();
+
+  /** Returns the current frequency of the given cpu in MHz (0, if unknown). */
+  static double frequencyMHz(int cpu);
+
+  /** Returns the frequency scaling governor of the given cpu (empty, if unknown). */
+  static std::string governor(int cpu);
+};
+
+/** Unpins the calling thread, when the scope is left (also by an exception). */
+class CpuUnpinGuard {
+  CpuEnvironment& _cpu;
+
+public:
+  explicit CpuUnpinGuard(CpuEnvironment& cpu) : _cpu(cpu) {}
+  ~CpuUnpinGuard() { _cpu.unpin(); }
+
+  CpuUnpinGuard(const CpuUnpinGuard&) = delete;
+  CpuUnpinGuard& operator=(const CpuUnpinGuard&) = delete;
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PARALLEL_CLASSIFIER_INCLUDED
+#define PARALLEL_CLASSIFIER_INCLUDED
+
+#include <vector>
+#include <generics/Base.hpp>
+#include <generics/PacketHeader.hpp>
+#include <generics/RuleSet.hpp>
+
+/**
+ * Splits a header set into contiguous slices and classifies each slice in its
+ * own worker thread. All workers share one algorithm instance, whose classifier
+ * has to be built beforehand and is only read during classification. The
+ * throughput is measured for each worker and for all workers together.
+ */
+class ParallelClassifier {
+  /** algorithm instance which is shared by all worker threads */
+  Base* _algorithm;
+  /** number of worker threads */
+  unsigned int _threads;
+
+public:
+  ParallelClassifier(Base* algorithm, unsigned int threads);
+  ~ParallelClassifier() {}
+
+  /**
+   * Classify all headers with the configured number of worker threads.
+   *
+   * @param headers header set to classify (is split up temporarily and restored afterwards)
+   * @param indices container for indices of matched rules (in order of the headers)
+   * @param aggregateMpps is set to the throughput of all workers in million packets per second
+   * @param threadMpps is filled with the throughput of each worker in million packets per second
+   */
+  void classify(Generic::PacketHeaderSet& headers, Generic::RuleIndexSet& indices, double& aggregateMpps, std::vector<double>& threadMpps);
+};
+
+#endif
+
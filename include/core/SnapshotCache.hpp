@@ -0,0 +1,53 @@
+#ifndef SNAPSHOT_CACHE_INCLUDED
+#define SNAPSHOT_CACHE_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <generics/Base.hpp>
+#include <generics/RuleSet.hpp>
+
+/**
+ * Keeps the built classifiers of algorithms as files in a directory (see
+ * Base::saveSnapshot), so that an expensive construction (e.g. the trie of
+ * HiCuts) is done only once per algorithm, parameters and rule set, even
+ * across invocations. A file is mapped into memory with mmap for loading.
+ * Each file starts with a header (magic, version, key, size and checksum of
+ * the image), so that outdated or damaged files are ignored.
+ */
+class SnapshotCache {
+  /** directory of the snapshot files (with trailing slash) */
+  std::string _directory;
+
+public:
+  explicit SnapshotCache(const std::string& directory);
+  ~SnapshotCache() {}
+
+  /**
+   * Returns the key of a classifier, which depends on the library of the
+   * algorithm (name, size and modification time), its parameters and the
+   * rule set.
+   */
+  static uint64_t key(const std::string& algorithmFile, const std::vector<double>& params, const Generic::RuleSet& rules);
+
+  /** Returns the name of the snapshot file for a key. */
+  std::string filename(uint64_t key) const;
+
+  /**
+   * Sets the rules of the algorithm by loading its classifier from the
+   * snapshot file of the key.
+   *
+   * @return false, if no valid snapshot exists (the algorithm is unchanged)
+   */
+  bool load(uint64_t key, Base& algorithm, const Generic::RuleSet& rules) const;
+
+  /**
+   * Saves the classifier of the algorithm, which was built by setRules, into
+   * the snapshot file of the key. An existing file is replaced atomically.
+   *
+   * @return false, if the file can't be written
+   */
+  bool store(uint64_t key, const Base& algorithm) const;
+};
+
+#endif
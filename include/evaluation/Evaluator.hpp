@@ -23,15 +23,36 @@ class Evaluator {
   /** Calculate statistic values for each memory-group. */
   static void createMemoryStatistics(const BenchmarkResults& res, MemEvaluationGroups& mem);
 
-  /** Check if each testrun produced the same matching-indices. */
+  /** Check if each testrun produced the same matching-indices (by comparing their digests). */
   static bool compareIndices(const BenchmarkResults& res);
 
   /** Creates a histogram for rule-index-matches, generated by the algorithm. */
-  static void createHistogram(const Generic::RuleIndexSet& indices, unsigned int amountRules, std::vector<HistogramPair>& hist);
+  static void createHistogram(const MatchSink& matches, std::vector<HistogramPair>& hist);
   
   /** Copy all logged tags from each testrun to one single container. */
   static void joinLogTags(const BenchmarkResults& res, LogTagVector& tags);
 
+  /** Calculate mean throughput and scaling efficiency of a concurrent classification. */
+  static void createScalingStatistics(const BenchmarkResults& res, ScalingEvaluation& scaling);
+
+  /** Calculate latency statistics of rule updates and the throughput while updating. */
+  static void createUpdateStatistics(BenchmarkPtr b, const BenchmarkResults& res, UpdateEvaluation& updates);
+
+  /** Merges the latency histograms of all testruns and calculates percentiles for each latency group. */
+  static void createLatencyStatistics(const BenchmarkResults& res, LatencyEvaluations& latencies);
+
+  /** Calculates mean values of the hardware events of each category over all testruns. */
+  static void createCounterStatistics(const BenchmarkResults& res, CounterEvaluation& counters);
+
+  /** Calculates mean values of the simulated cache hits and misses of each memory group over all testruns. */
+  static void createCacheStatistics(const BenchmarkResults& res, CacheEvaluation& cache);
+
+  /** Calculates mean values of the heap usage of each phase over all testruns. */
+  static void createHeapStatistics(const BenchmarkResults& res, HeapEvaluation& heap);
+
+  /** Calculates the batch time per header and the mean time of sampled timespans over all testruns. */
+  static void createSamplingStatistics(BenchmarkPtr b, const BenchmarkResults& res, SamplingEvaluation& sampling);
+
 public:
 
   /** Evaluate a given benchmark with one or multiple testruns. */
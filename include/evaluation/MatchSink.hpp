@@ -0,0 +1,75 @@
+#ifndef MATCH_SINK_INCLUDED
+#define MATCH_SINK_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <generics/RuleSet.hpp>
+
+/**
+ * Consumes the indices of matched rules in the order of the classified
+ * headers. Instead of accumulating all indices of a testrun, the number of
+ * matches per rule and a digest of the whole index stream are updated on the
+ * fly. Two testruns produced the same indices, if their digests are equal.
+ * All indices are only kept, if explicitly requested (e.g. for an output).
+ */
+class MatchSink {
+  /** rolling 64-bit FNV-1a hash over the index stream (8 bytes per index, least significant first) */
+  uint64_t _digest;
+  /** number of consumed indices */
+  uint64_t _count;
+  /** number of headers, which matched no rule */
+  uint64_t _noMatch;
+  /** number of matches for each rule */
+  std::vector<uint64_t> _hits;
+  /** if true, all consumed indices are stored additionally */
+  bool _keepIndices;
+  Generic::RuleIndexSet _indices;
+
+public:
+  /** Offset basis of the FNV-1a hash, which is the digest of an empty index stream. */
+  static constexpr uint64_t emptyDigest() { return 14695981039346656037ULL; }
+
+  MatchSink() : _digest(emptyDigest()), _count(0), _noMatch(0), _hits(), _keepIndices(false), _indices() {}
+  /**
+   * @param numberRules size of the classified rule set (for the matches per rule)
+   * @param keepIndices if true, all indices are kept in addition to the digest
+   */
+  MatchSink(size_t numberRules, bool keepIndices);
+  ~MatchSink() {}
+
+  /** Consumes the index of the matched rule of a single header. */
+  inline void add(Generic::RuleSetSize index) {
+    uint64_t value = index;
+    for (unsigned int byte = 0; byte < sizeof(value); ++byte, value >>= 8)
+      _digest = (_digest ^ (value & 0xFF)) * 1099511628211ULL;
+    ++_count;
+
+    if (index < _hits.size()) ++_hits[index];
+    else if (index == Generic::noRuleIsMatching()) ++_noMatch;
+    else if (!_hits.empty()) throw "Index of a matched rule is outside of the rule set (MatchSink).";
+
+    if (_keepIndices) _indices.push_back(index);
+  }
+  /** Consumes the indices of a batch of headers. */
+  void add(const Generic::RuleIndexSet& indices);
+  /** Consumes the indices of a native classification (see Base::classifyNative). */
+  void add(const uint32_t* indices, size_t count);
+
+  /** Removes all consumed indices, but keeps the configuration. */
+  void clear();
+
+  /** Returns true, if both sinks consumed the same index stream. */
+  inline bool sameMatches(const MatchSink& other) const { return _count == other._count && _digest == other._digest; }
+
+  inline uint64_t size() const { return _count; }
+  inline uint64_t getDigest() const { return _digest; }
+  inline uint64_t getNoMatch() const { return _noMatch; }
+  inline const std::vector<uint64_t>& getHits() const { return _hits; }
+  inline bool keepsIndices() const { return _keepIndices; }
+  /** Returns all consumed indices (empty, if they are not kept). */
+  inline const Generic::RuleIndexSet& getIndices() const { return _indices; }
+};
+
+#endif
+
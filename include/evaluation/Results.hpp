@@ -5,20 +5,76 @@
 #include <vector>
 #include <utility>
 #include <string>
+#include <cstdint>
 #include <metering/time/ChronoManager.hpp>
 #include <metering/memory/MemManager.hpp>
+#include <metering/memory/CacheSimulator.hpp>
+#include <metering/PerfManager.hpp>
+#include <metering/HeapMeter.hpp>
 #include <generics/RuleSet.hpp>
 #include <evaluation/Statistics.hpp>
+#include <evaluation/MatchSink.hpp>
 
 /** Contains logged tags as strings. */
 typedef std::vector<std::string> LogTagVector;
 
+/** Throughput of a concurrent classification in one testrun (in million packets per second). */
+struct ScalingResults {
+  /** Number of worker threads (0, if no concurrent classification was done). */
+  unsigned int threads;
+  /** Throughput of one single worker thread with all headers. */
+  double referenceMpps;
+  /** Throughput of all worker threads together (all headers per wall-clock time). */
+  double aggregateMpps;
+  /** Throughput of each worker thread with its slice of headers. */
+  std::vector<double> threadMpps;
+
+  ScalingResults() : threads(0), referenceMpps(0), aggregateMpps(0), threadMpps() {}
+};
+
+/** Latencies of rule updates and the throughput of lookups while replaying a trace of rule updates. */
+struct UpdateResults {
+  /** Latency of each rule update in nanoseconds (in order of the trace). */
+  std::vector<uint64_t> latencies;
+  /** Number of headers, which were classified between rule updates. */
+  uint64_t headers;
+  /** Throughput of the classification before any rule update (in million packets per second). */
+  double baselineMpps;
+  /** Throughput of the classification between rule updates (in million packets per second). */
+  double updateMpps;
+
+  UpdateResults() : latencies(), headers(0), baselineMpps(0), updateMpps(0) {}
+};
+
+/** Batch timing and sampled timing of single headers of a testrun. */
+struct SamplingResults {
+  /** Time of classifying all headers in batches ('total') [ns]. */
+  double batchNanos;
+  /** Sampled stopwatches inside the algorithm. */
+  ChronoSamples samples;
+
+  SamplingResults() : batchNanos(0), samples() {}
+};
+
 /** Collects all results of one single testrun of a benchmark. */
 struct TestrunResults {
   ChronoResults chronoRes;
   Memory::MemResultGroups memRes;
-  Generic::RuleIndexSet indices;
+  /** Matched rules of all classified headers (as digest and number of matches per rule). */
+  MatchSink matches;
   LogTagVector logTags;
+  ScalingResults scaling;
+  UpdateResults updates;
+  /** Distribution of the lookup time per header for each latency group (only if requested). */
+  LatencyResults latencies;
+  /** Hardware events of each category (only if requested and available). */
+  PerfResults counters;
+  /** Sampled timing of single headers (only if a sampling rate is set). */
+  SamplingResults sampling;
+  /** Simulated cache hits and misses of each memory group (only if a cache is configured). */
+  Memory::CacheResults cache;
+  /** Heap usage of each phase (only if requested). */
+  HeapResults heap;
 };
 
 /** Contains results of each run of a benchmark. */
@@ -81,6 +137,140 @@ struct MemEvaluationGroup {
 /** Multiple different groups of the same result-category. */
 typedef std::vector<std::unique_ptr<MemEvaluationGroup>> MemEvaluationGroups;
 
+/** Container for all evaluation results of a concurrent classification. */
+struct ScalingEvaluation {
+  /** Number of worker threads (0, if no concurrent classification was done). */
+  unsigned int threads;
+  /** Throughput of one single worker thread [Mpps]. */
+  MeanValue referenceMpps;
+  /** Throughput of all worker threads together [Mpps]. */
+  MeanValue aggregateMpps;
+  /** Aggregate throughput divided by the number of threads times the reference throughput. */
+  MeanValue efficiency;
+  /** Throughput of each worker thread [Mpps]. */
+  std::vector<MeanValue> threadMpps;
+
+  ScalingEvaluation() : threads(0), referenceMpps(), aggregateMpps(), efficiency(), threadMpps() {}
+};
+
+/** Container for all evaluation results of a replayed trace of rule updates. */
+struct UpdateEvaluation {
+  /** Number of rule insertions in the trace. */
+  unsigned int inserts;
+  /** Number of rule removals in the trace. */
+  unsigned int removes;
+  /** Latency of all rule insertions of all testruns [ns] (only set, if inserts > 0). */
+  StatValues<double> insertLatency;
+  /** Latency of all rule removals of all testruns [ns] (only set, if removes > 0). */
+  StatValues<double> removeLatency;
+  /** Latency of each rule update in order of the trace [ns]. */
+  std::vector<MeanValue> latencies;
+  /** Number of headers, which were classified between rule updates in one testrun. */
+  uint64_t headers;
+  /** Throughput of the classification before any rule update [Mpps]. */
+  MeanValue baselineMpps;
+  /** Throughput of the classification between rule updates [Mpps]. */
+  MeanValue updateMpps;
+
+  UpdateEvaluation() : inserts(0), removes(0), insertLatency(), removeLatency(), latencies(), headers(0), baselineMpps(), updateMpps() {}
+};
+
+/** Latency percentiles of one latency group over the headers of all testruns [ns]. */
+struct LatencyEvaluation {
+  std::string name;
+  /** Number of recorded samples (headers of all testruns). */
+  uint64_t count;
+  double mean;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+  /** Cumulative distribution of all samples. */
+  std::vector<LatencyCdfPoint> cdf;
+
+  LatencyEvaluation() : name(), count(0), mean(0), p50(0), p90(0), p99(0), p999(0), max(0), cdf() {}
+};
+
+/** Contains the latency percentiles of all latency groups. */
+typedef std::vector<LatencyEvaluation> LatencyEvaluations;
+
+/** Hardware events of one category as mean values over all testruns. */
+struct CounterCategoryEvaluation {
+  std::string name;
+  /** one value for each event (same order as the event names) */
+  std::vector<MeanValue> values;
+
+  CounterCategoryEvaluation() : name(), values() {}
+};
+
+/** Contains the hardware events of all categories. */
+struct CounterEvaluation {
+  /** names of the counted events (empty, if no counters were available) */
+  std::vector<std::string> events;
+  std::vector<CounterCategoryEvaluation> categories;
+
+  CounterEvaluation() : events(), categories() {}
+};
+
+/** Simulated hits and misses of one cache level as mean values over all testruns. */
+struct CacheLevelEvaluation {
+  MeanValue hits;
+  MeanValue misses;
+  /** misses divided by all accesses of the level */
+  MeanValue missRatio;
+
+  CacheLevelEvaluation() : hits(), misses(), missRatio() {}
+};
+
+/** Contains the simulated hits and misses of each cache level for each memory group. */
+struct CacheEvaluation {
+  /** names of the simulated levels (empty, if no cache was simulated) */
+  std::vector<std::string> levels;
+  /** one entry for each memory group, with one value for each level */
+  std::vector<std::vector<CacheLevelEvaluation>> groups;
+
+  CacheEvaluation() : levels(), groups() {}
+};
+
+/** Heap usage of one phase as mean values over all testruns. */
+struct HeapPhaseEvaluation {
+  std::string name;
+  /** net growth of the heap [Bytes] */
+  MeanValue liveBytes;
+  /** highest net growth of the heap [Bytes] */
+  MeanValue peakBytes;
+  MeanValue allocations;
+  MeanValue deallocations;
+
+  HeapPhaseEvaluation() : name(), liveBytes(), peakBytes(), allocations(), deallocations() {}
+};
+
+/** Contains the heap usage of all phases (empty, if the heap wasn't measured). */
+typedef std::vector<HeapPhaseEvaluation> HeapEvaluation;
+
+/** Sampled timing of one stopwatch as mean values over all testruns. */
+struct SampledCategoryEvaluation {
+  std::string name;
+  /** Number of measured timespans per testrun. */
+  MeanValue samples;
+  /** Mean time of a measured timespan [ns]. */
+  MeanValue nanosPerSample;
+
+  SampledCategoryEvaluation() : name(), samples(), nanosPerSample() {}
+};
+
+/** Compares the batch timing with the sampled timing of single headers. */
+struct SamplingEvaluation {
+  /** One out of this number of headers was timed (0: no sampling). */
+  unsigned int rate;
+  /** Batch time per header [ns]. */
+  MeanValue batchNanosPerHeader;
+  std::vector<SampledCategoryEvaluation> categories;
+
+  SamplingEvaluation() : rate(0), batchNanosPerHeader(), categories() {}
+};
+
 /** Contains results of an evaluation of a single benchmark. */
 struct BenchmarkEvaluation {
   /** Contains general information about processed benchmark. */
@@ -95,7 +285,10 @@ struct BenchmarkEvaluation {
   /** True, if same indices produced during multiple testruns. */
   bool allIndicesMatch;
 
-  /** If all indices match, this contains the data. */
+  /** Digest of the indices of the first testrun (see MatchSink). */
+  uint64_t indicesDigest;
+
+  /** If all indices match and output of matches was requested, this contains the data. */
   Generic::RuleIndexSet indices;
 
   /** Contains data to produce a histogram with index-rule matches (only if all indices match between testruns). */
@@ -103,6 +296,27 @@ struct BenchmarkEvaluation {
 
   /** Contains logged tags during benchmark runs. */
   LogTagVector logTags;
+
+  /** Contains the throughput of a concurrent classification with multiple threads. */
+  ScalingEvaluation scaling;
+
+  /** Contains the latencies of rule updates and the throughput while updating. */
+  UpdateEvaluation updates;
+
+  /** Contains the distribution of lookup latencies per header (only if requested). */
+  LatencyEvaluations latencies;
+
+  /** Contains hardware events of each category (only if requested and available). */
+  CounterEvaluation counters;
+
+  /** Contains the batch timing and the sampled timing of single headers (only if sampled). */
+  SamplingEvaluation sampling;
+
+  /** Contains the simulated cache hits and misses of each memory group (only if a cache is configured). */
+  CacheEvaluation cache;
+
+  /** Contains the real heap usage of each phase (only if requested). */
+  HeapEvaluation heap;
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include <cmath> // sqrt
 #include <memory>
 #include <utility> // std::pair
+#include <cstdint>
 
 /** 
  * Contains elements of a typical measurement data series. 
@@ -92,14 +93,14 @@ struct MeanValue {
 
 
 /** Type for the user of a Histogram to get results. */
-typedef std::pair<unsigned int, unsigned int> HistogramPair;
+typedef std::pair<unsigned int, uint64_t> HistogramPair;
 
 /** Represents one histogram bin-object. */
 struct HistogramBin {
   /** ID of the histogram bin (e.g. index of an element) */
   unsigned int id;
   /** Counts the occurence of the elements in this bin for the histogram. */
-  unsigned int counter;
+  uint64_t counter;
 
   HistogramBin(unsigned int idVal) : id(idVal), counter(0) {}
   HistogramBin(const HistogramBin& other) : id(other.id), counter(other.counter) {}
@@ -117,6 +118,7 @@ struct HistogramBin {
   inline HistogramBin& operator++() { ++counter; return *this; }
   // HistogramBin++
   inline HistogramBin operator++(int) { HistogramBin res(*this); ++counter; return res; }
+  inline HistogramBin& operator+=(uint64_t times) { counter += times; return *this; }
 
   /** For returning results to the user. */
   inline HistogramPair getPair() { return std::make_pair(id, counter); }
@@ -133,6 +135,8 @@ public:
 
   /** Increment occurence counter for specified bin-id. */
   void occured(unsigned int id);
+  /** Increment occurence counter for specified bin-id by given number of occurences. */
+  void occured(unsigned int id, uint64_t times);
 
   /** Return a container with sorted histogram results. */
   void getSorted(std::vector<HistogramPair>& result) const;
@@ -0,0 +1,99 @@
+#ifndef ISOLATED_PROCESS_INCLUDED
+#define ISOLATED_PROCESS_INCLUDED
+
+#include <string>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <sys/types.h>
+
+/** Reason, why an isolated process has finished. */
+enum class ProcessOutcome : uint8_t {
+  OK = 0,
+  FAILED = 1, // task returned false or threw an exception
+  TIMEOUT = 2, // wall-clock limit exceeded
+  OOM = 3, // memory limit exceeded
+  CRASH = 4 // terminated by a signal or exited without reporting
+};
+
+/** Outcome of an isolated process as seen by the parent. */
+struct ProcessResult {
+  ProcessOutcome outcome;
+  /** signal, which terminated the process (0, if none) */
+  int signal;
+  /** wall-clock time from start until the process was reaped */
+  double seconds;
+  /** peak resident memory of the process in KiB */
+  uint64_t peakMemory;
+  /** message of a failed task (e.g. an exception) */
+  std::string message;
+
+  ProcessResult() : outcome(ProcessOutcome::CRASH), signal(0), seconds(0), peakMemory(0), message() {}
+};
+
+/**
+ * Executes a task in a forked child process, so that a crash, a runaway loop
+ * or leaked memory of the task don't affect the calling process. The child
+ * is limited in wall-clock time (SIGALRM) and in address space (RLIMIT_AS).
+ * It reports its outcome over a pipe in a compact binary record (magic,
+ * outcome, length of message, message), all other outcomes are derived from
+ * the wait status of the child.
+ */
+class IsolatedProcess {
+  /** wall-clock limit in seconds (0: unlimited) */
+  unsigned int _timeout;
+  /** limit of address space in bytes (0: unlimited) */
+  uint64_t _memoryLimit;
+  pid_t _pid;
+  /** read end of the pipe from the child */
+  int _pipe;
+  std::chrono::steady_clock::time_point _start;
+  ProcessResult _result;
+
+  /** Executed in the child: runs the task and reports its outcome (never returns). */
+  void _runChild(const std::function<bool(std::string&)>& task, const std::string& consoleFile, int pipe);
+
+  /** Reads the record of the child from the pipe and returns true, if it was complete. */
+  bool _readRecord();
+
+public:
+  /**
+   * @param timeout wall-clock limit in seconds (0: unlimited)
+   * @param memoryLimit limit of address space in bytes (0: unlimited)
+   */
+  IsolatedProcess(unsigned int timeout, uint64_t memoryLimit) : _timeout(timeout), _memoryLimit(memoryLimit), _pid(-1), _pipe(-1), _start(), _result() {}
+  /** Kills the child, if it is still running. */
+  ~IsolatedProcess();
+
+  IsolatedProcess(const IsolatedProcess&) = delete;
+  IsolatedProcess& operator=(const IsolatedProcess&) = delete;
+
+  /**
+   * Forks a child process, which executes the given task. The task returns
+   * false on failure and may set a message. All output of the child is
+   * redirected to the given file (if not empty).
+   *
+   * @return false, if no process could be created
+   */
+  bool start(const std::function<bool(std::string&)>& task, const std::string& consoleFile = "");
+
+  /**
+   * Evaluates the wait status of the terminated child (as returned by
+   * waitpid or wait4 in the parent).
+   *
+   * @param status wait status of the child
+   * @param peakMemory peak resident memory of the child in KiB
+   */
+  void finish(int status, uint64_t peakMemory);
+
+  /** Waits for this child to terminate and evaluates its outcome. */
+  void wait();
+
+  inline pid_t getPid() const { return _pid; }
+  inline const ProcessResult& getResult() const { return _result; }
+
+  /** Returns a short name of the outcome (e.g. for a report). */
+  static const char* outcomeName(ProcessOutcome outcome);
+};
+
+#endif
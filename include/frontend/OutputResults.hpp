@@ -7,7 +7,7 @@
 #include <metering/time/ChronoManager.hpp>
 #include <metering/memory/MemManager.hpp>
 #include <generics/RuleSet.hpp>
-#include <generics/PacketHeader.hpp>
+#include <generics/PacketHeaderColumns.hpp>
 #include <evaluation/Results.hpp>
 
 class OutputResults {
@@ -46,9 +46,30 @@ class OutputResults {
   /** Generate plots with memory-results. */
   void _htmlMemPlots(std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const MemEvaluationGroups& mem) const;
 
+  /** Generate a table with the real heap usage of each phase next to the allocations seen by the memory-trace. */
+  void _htmlHeap(const std::string& id, std::ostringstream& html, const HeapEvaluation& heap, const MemEvaluationGroups& mem) const;
+
   /** Generate a header-rules-histogram. */
   void _htmlHistogram(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const std::vector<HistogramPair>& hist) const;
 
+  /** Generate a table and a plot with the throughput of a concurrent classification. */
+  void _htmlScaling(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const ScalingEvaluation& scaling) const;
+
+  /** Generate a table with the latency of rule updates and the throughput while updating. */
+  void _htmlUpdates(const std::string& id, std::ostringstream& html, const UpdateEvaluation& updates) const;
+
+  /** Generate a table with latency percentiles and a plot with the cumulative distribution of each latency group. */
+  void _htmlLatency(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const LatencyEvaluations& latencies) const;
+
+  /** Generate a table with the hardware events of each category. */
+  void _htmlCounters(const std::string& id, std::ostringstream& html, const CounterEvaluation& counters) const;
+
+  /** Generate a table with the simulated cache hits and misses of each memory group and level. */
+  void _htmlCache(const std::string& id, std::ostringstream& html, const CacheEvaluation& cache) const;
+
+  /** Generate a table, which compares the batch timing with the sampled timing of single headers. */
+  void _htmlSampling(const std::string& id, std::ostringstream& html, const SamplingEvaluation& sampling) const;
+
   /** Set theme settings for jqplot. */
   void _jsSetTheme(std::ostringstream& str) const;
 
@@ -67,6 +88,9 @@ class OutputResults {
   /** Add js-code for a normal line-plot with two series. */
   void _jsLinePlot2(std::ostringstream& str, const std::string& divContainer, const std::string& dataVar1, const std::string& dataVar2, const std::string& s1label, const std::string& s2label, const std::string& title, const std::string& tickVar, const std::string& xlabel, const std::string& ylabel) const;
 
+  /** Add js-code for a line-plot of a cumulative distribution (data as pairs of x-value and fraction). */
+  void _jsCdfPlot(std::ostringstream& str, const std::string& divContainer, const std::string& dataVar, const std::string& title, const std::string& xlabel) const;
+
   /** Write js-code for an 1-dim. array-declaration. */
   void _jsArray1(std::ostringstream& str, const std::vector<std::string>& items, const std::string& name) const;
 
@@ -91,6 +115,27 @@ class OutputResults {
   /** Dump memory results in plain text to string. */
   void _csvMemory(std::ostringstream& str, const MemEvaluationGroups& mem) const;
 
+  /** Dump throughput results of a concurrent classification in plain text to string. */
+  void _csvScaling(std::ostringstream& str, const ScalingEvaluation& scaling) const;
+
+  /** Dump latencies of rule updates and the throughput while updating in plain text to string. */
+  void _csvUpdates(std::ostringstream& str, const UpdateEvaluation& updates) const;
+
+  /** Dump latency percentiles of each latency group in plain text to string. */
+  void _csvLatency(std::ostringstream& str, const LatencyEvaluations& latencies) const;
+
+  /** Dump hardware events of each category in plain text to string. */
+  void _csvCounters(std::ostringstream& str, const CounterEvaluation& counters) const;
+
+  /** Dump simulated cache hits and misses of each memory group and level in plain text to string. */
+  void _csvCache(std::ostringstream& str, const CacheEvaluation& cache) const;
+
+  /** Dump the heap usage of each phase in plain text to string. */
+  void _csvHeap(std::ostringstream& str, const HeapEvaluation& heap, const MemEvaluationGroups& mem) const;
+
+  /** Dump batch timing and sampled timing of single headers in plain text to string. */
+  void _csvSampling(std::ostringstream& str, const SamplingEvaluation& sampling) const;
+
 public:
   OutputResults() : _resultsDir(""), _relativeDir("") {}
   ~OutputResults() {}
@@ -103,8 +148,11 @@ public:
   /** Set pointer to benchmark object, for which results should be output. */
   inline void setBenchmark(BenchmarkPtr b) { _benchmark = b; }
 
-  /** Appends generated header data to a file with all headers. */
-  void headers(const Generic::PacketHeaderSet& headers) const;
+  /** Returns the path of the trace file for the memory accesses of a testrun. */
+  inline std::string accessTraceFilename(unsigned int run) const { return _resultsDir + _benchmark->id + "_accesses_" + std::to_string(run) + ".trace"; }
+
+  /** Appends generated header data to a file with all headers (csv or binary header trace). */
+  void headers(const Generic::PacketHeaderColumns& headers) const;
   
   /** Creates a summary of a benchmark execution with evaluation. */
   void evaluation(const BenchmarkEvaluation& eval) const;
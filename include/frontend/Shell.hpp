@@ -2,6 +2,12 @@
 #define SHELL_INCLUDED
 
 #include <string>
+#include <cstdint>
+#include <vector>
+#include <configuration/Configuration.hpp>
+#include <frontend/IsolatedProcess.hpp>
+
+class BenchmarkExecutor;
 
 namespace Frontend {
 
@@ -14,15 +20,57 @@ class Shell {
   std::string _configFile;
   /** Relative path to directory for saving results */
   std::string _resultsDir;
+  /** Number of worker threads for all benchmarks (0: use configured values) */
+  unsigned int _threads;
+  /** Number of benchmarks, which are executed concurrently in separate processes */
+  unsigned int _jobs;
+  /** If true, each benchmark is executed in a separate process */
+  bool _isolate;
+  /** Wall-clock limit of each benchmark process in seconds (0: unlimited) */
+  unsigned int _timeout;
+  /** Limit of address space of each benchmark process in bytes (0: unlimited) */
+  uint64_t _memoryLimit;
+  /** Directory for snapshots of built classifiers (empty: classifiers are always built) */
+  std::string _snapshotDir;
+  /** If true, the parsed configuration is cached until one of its files changes (see ConfigurationCache) */
+  bool _configCache;
+
+  /** Reads the configuration from the cache or by interpreting the Lua script and returns true on success. */
+  bool _readConfiguration(std::shared_ptr<Configuration>& config);
+
+  /** Executes a single benchmark and returns true on success. */
+  bool _execute(BenchmarkExecutor& texec, BenchmarkPtr& benchmark);
+
+  /** Executes all benchmarks one after another in this process. */
+  void _runSequential(BenchmarkSet& benchmarks);
+
+  /**
+   * Executes each benchmark in a forked process with its own memory registry
+   * and up to _jobs of them concurrently. Benchmarks without a configured cpu
+   * are pinned to a separate cpu per running process. The output of each
+   * process is written to '<id>_console.txt' and the outcome of all processes
+   * (e.g. timeout or crash) to '<timestamp>_outcomes.csv' in the results directory.
+   */
+  void _runIsolated(BenchmarkSet& benchmarks);
+
+  /** Writes the outcome of each benchmark process to a file in the results directory. */
+  void _writeOutcomes(const BenchmarkSet& benchmarks, const std::vector<ProcessResult>& results) const;
 
 public:
-	Shell() : _relativePath(""), _programName("cate"), _configFile(""), _resultsDir("") {}
+	Shell() : _relativePath(""), _programName("cate"), _configFile(""), _resultsDir(""), _threads(0), _jobs(1), _isolate(false), _timeout(0), _memoryLimit(0), _snapshotDir(""), _configCache(true) {}
 	~Shell() {}
 
   inline void setRelativePath(const std::string& path) { _relativePath = path; }
   inline void setProgramName(const std::string& name) { _programName = name; }
   inline void setConfigFile(const std::string& file) { _configFile = file; }
   inline void setResultsDir(const std::string& dir) { _resultsDir = dir; }
+  inline void setThreads(unsigned int threads) { _threads = threads; }
+  inline void setJobs(unsigned int jobs) { _jobs = (jobs > 0 ? jobs : 1); }
+  inline void setIsolation(bool isolate) { _isolate = isolate; }
+  inline void setTimeout(unsigned int seconds) { _timeout = seconds; }
+  inline void setMemoryLimit(uint64_t bytes) { _memoryLimit = bytes; }
+  inline void setSnapshotDir(const std::string& dir) { _snapshotDir = dir; }
+  inline void setConfigCache(bool cache) { _configCache = cache; }
   
   void run();
 };
@@ -5,6 +5,7 @@
 #include <memory>
 #include <configuration/Benchmark.hpp>
 #include <generics/PacketHeader.hpp>
+#include <generics/PacketHeaderColumns.hpp>
 #include <generator/RandomNumberGenerator.hpp>
 
 /** Contains all independent number generators each for one header field. */
@@ -23,8 +24,11 @@ class HeaderGenerator {
   /** holds all generators for header values generation */
   GeneratorSet _generators;
 
+  /** configured header data field structure */
+  FieldStructureSet _fields;
+
 public:
-  HeaderGenerator() : _configured(false), _generators() {}
+  HeaderGenerator() : _configured(false), _generators(), _fields() {}
   ~HeaderGenerator() {}
   
   /**
@@ -46,6 +50,15 @@ public:
    * @param output set for headers to generate (will be emptied before generation)
    */
   void generateHeaders(unsigned int amount, Generic::PacketHeaderSet& output);
+
+  /**
+   * Generates the same header values as above, but stores them column by
+   * column without any allocation per header.
+   *
+   * @param amount number of headers to generate
+   * @param output columns for headers to generate (will be emptied before generation)
+   */
+  void generateHeaders(unsigned int amount, Generic::PacketHeaderColumns& output);
 };
 
 #endif
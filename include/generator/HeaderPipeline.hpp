@@ -0,0 +1,71 @@
+#ifndef HEADERPIPELINE_INCLUDED
+#define HEADERPIPELINE_INCLUDED
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <generics/PacketHeaderColumns.hpp>
+#include <generator/HeaderGenerator.hpp>
+
+/**
+ * Generates headers in batches by a separate producer thread, while the
+ * caller classifies previously generated batches. Generated batches are
+ * stored in a bounded ring, so the producer is at most a few batches
+ * ahead. The order of headers is the same as with a sequential use of
+ * the HeaderGenerator, so generated headers are still reproducible.
+ */
+class HeaderPipeline {
+  /** configured generator, which is only used by the producer thread */
+  HeaderGenerator& _generator;
+  /** total number of headers to generate */
+  unsigned int _totalHeaders;
+  /** number of headers per batch (last batch may be smaller) */
+  unsigned int _batchSize;
+
+  /** bounded ring with generated batches */
+  std::vector<Generic::PacketHeaderColumns> _ring;
+  /** position of the next batch to consume */
+  size_t _head;
+  /** number of generated batches, which were not consumed yet */
+  size_t _filled;
+  /** becomes true, after the producer generated all headers */
+  bool _finished;
+  /** becomes true, if the consumer stops before all batches were consumed */
+  bool _cancelled;
+  /** holds an exception thrown during generation */
+  const char* _error;
+
+  std::mutex _mutex;
+  std::condition_variable _batchAvailable;
+  std::condition_variable _slotAvailable;
+  std::thread _producer;
+
+  /** Main loop of the producer thread. */
+  void _produce();
+
+public:
+  /**
+   * Starts the producer thread immediately.
+   *
+   * @param generator configured header generator
+   * @param totalHeaders number of headers to generate
+   * @param batchSize number of headers per batch
+   * @param depth number of batches, which can be generated in advance
+   */
+  HeaderPipeline(HeaderGenerator& generator, unsigned int totalHeaders, unsigned int batchSize, unsigned int depth = 2);
+  /** Stops the producer thread, even if not all batches were consumed. */
+  ~HeaderPipeline();
+
+  /**
+   * Waits for the next generated batch and hands it over. The memory of
+   * the former batch is reused by the producer thread.
+   *
+   * @param batch is swapped with the next batch of generated headers
+   * @return false, if all batches were consumed already
+   */
+  bool next(Generic::PacketHeaderColumns& batch);
+};
+
+#endif
+
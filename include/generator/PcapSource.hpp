@@ -0,0 +1,109 @@
+#ifndef PCAPSOURCE_INCLUDED
+#define PCAPSOURCE_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <generics/PacketHeaderColumns.hpp>
+#include <configuration/PcapConfiguration.hpp>
+
+/**
+ * Reads the headers of captured packets from a pcap or pcapng file, which is
+ * mapped into memory. Ethernet (with VLAN tags), Linux cooked and raw IP
+ * captures are parsed and each IPv4 packet yields one header, whose fields
+ * are taken from IPv4 and TCP/UDP/SCTP (ports are zero for other protocols,
+ * fragments and truncated packets). Other packets are skipped. Headers are
+ * decoded batch by batch, so a capture is never held in memory at once.
+ */
+class PcapSource {
+public:
+  /** Packet fields, which can be mapped to header fields. */
+  enum class Field : uint8_t {SRC_IP, DST_IP, SRC_PORT, DST_PORT, PROTOCOL, VLAN, TOS, TTL, LENGTH, TCP_FLAGS, ZERO};
+
+private:
+  /** mapped capture file */
+  const uint8_t* _mapping;
+  size_t _mappingSize;
+  /** packet field of each header field */
+  std::vector<Field> _fields;
+  /** width in bits of each header field */
+  std::vector<unsigned int> _structure;
+  /** number of passes over the capture */
+  unsigned int _replay;
+  /** current pass over the capture (starting with 0) */
+  unsigned int _pass;
+  /** number of headers of the current pass so far */
+  size_t _passHeaders;
+
+  /** true for pcapng, false for pcap */
+  bool _pcapng;
+  /** true, if numbers of the file (not of the packets) are in the other byte order */
+  bool _swapped;
+  /** offset of the next record or block */
+  size_t _offset;
+  /** link type of a pcap file or of each interface of the current pcapng section */
+  std::vector<uint16_t> _linkTypes;
+
+  /** Returns a number of the file in host byte order. */
+  uint16_t _read16(size_t offset) const;
+  uint32_t _read32(size_t offset) const;
+
+  /** Checks the file header and starts with the first packet. */
+  void _start();
+
+  /**
+   * Finds the next packet of the capture.
+   *
+   * @param data is set to the captured bytes of the packet
+   * @param length is set to the number of captured bytes
+   * @param linkType is set to the link type of the packet
+   * @return false, if the end of the capture was reached
+   */
+  bool _nextPacket(const uint8_t*& data, size_t& length, uint16_t& linkType);
+
+  /**
+   * Extracts all packet fields of a packet.
+   *
+   * @return false, if the packet is no IPv4 packet
+   */
+  static bool _parse(const uint8_t* data, size_t length, uint16_t linkType, uint64_t* values);
+
+public:
+  /**
+   * Maps the capture into memory, an exception is thrown, if it is missing or
+   * no valid capture or if the fields don't fit into the header structure.
+   *
+   * @param config capture, number of passes and mapping of fields
+   * @param structure width in bits of each header field
+   */
+  PcapSource(const PcapConfiguration& config, const std::vector<unsigned int>& structure);
+  ~PcapSource();
+
+  PcapSource(const PcapSource&) = delete;
+  PcapSource& operator=(const PcapSource&) = delete;
+
+  /**
+   * Replaces the headers of the batch with the headers of the next packets.
+   * After the last packet, the capture is replayed as configured.
+   *
+   * @param batch set for the headers (its memory is reused)
+   * @param count maximum number of headers in the batch
+   * @return false, if all passes over the capture are done
+   */
+  bool next(Generic::PacketHeaderColumns& batch, size_t count);
+
+  /** Starts with the first packet of the first pass again. */
+  void rewind();
+
+  /** Returns the number of IPv4 packets in a capture file (an exception is thrown, if it is no valid capture). */
+  static unsigned int countPackets(const std::string& filename);
+
+  /** Returns the packet field of a name (like "src_ip"), false is returned for an unknown name. */
+  static bool fieldByName(const std::string& name, Field& field);
+
+  /** Returns the width of a packet field in bits. */
+  static unsigned int fieldBits(Field field);
+};
+
+#endif
+
@@ -51,6 +51,10 @@ class RandomNumberGenerator {
   Generic::VarValue _distribConstant;
   /** Range values for uniform distribution. */
   Generic::VarValue _uniformMinVal, _uniformMaxVal;
+  /** Amount of values in uniform range, prepared as argument for '_engineBig'. */
+  mpz_class _uniformRange;
+  /** Reused for uniform samples, so that no multiprecision value is allocated per sample. */
+  mpz_class _uniformSample;
   /** Normal distribution instance. */
   std::normal_distribution<double> _distribNormal;
   /** Lognormal distribution instance. */
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <vector>
 #include <generics/PacketHeader.hpp>
+#include <generics/PacketHeaderColumns.hpp>
 #include <generics/RuleSet.hpp>
 #include <metering/memory/MemManager.hpp>
 #include <metering/time/ChronoManager.hpp>
@@ -18,6 +19,9 @@ protected:
   std::shared_ptr<Memory::MemManager> _mmanager;
   std::shared_ptr<ChronoManager> _chronomgr;
   std::shared_ptr<LogTagManager> _logger;
+  /** stopwatches for the conversion and classification of each single header (see ChronoManager::handle) */
+  ChronoHandle _chronoConvertHeader;
+  ChronoHandle _chronoClassify;
 
   /** Checks, if MemManager instance is assigned. */
   inline void checkMemMgr() { if (!_mmanager) throw "Set MemManager before using a filtering algorithm."; }
@@ -27,6 +31,7 @@ protected:
   inline void checkLogTagMgr() { if (!_logger) throw "Set LogTagManager before using a filtering algorithm."; }
   
 public:
+  Base() : _mmanager(), _chronomgr(), _logger(), _chronoConvertHeader(0), _chronoClassify(0) {}
 	virtual ~Base() {};
 
 	/**
@@ -38,6 +43,52 @@ public:
 	 */
 	virtual void classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) = 0;
 
+  /**
+   * Returns the size in bytes of one header in the native representation of
+   * the algorithm. If the algorithm doesn't support a native classification,
+   * zero is returned and only classify can be used.
+   */
+  virtual size_t nativeHeaderSize() const { return 0; }
+
+  /**
+   * Convert all generic headers at once into the native representation of
+   * the algorithm, which is used by classifyNative.
+   *
+   * @param data container with packet header data
+   * @param tuples buffer for data.size() native headers (of nativeHeaderSize() bytes each)
+   */
+  virtual void convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+    (void)data; (void)tuples;
+    throw "Native classification is not supported by this algorithm.";
+  }
+
+  /**
+   * Convert all headers of a columnar header set into the native representation.
+   * By default, the headers are copied into a line-based set for conversion, so
+   * algorithms should override this to read the columns directly.
+   *
+   * @param data columnar container with packet header data
+   * @param tuples buffer for data.size() native headers (of nativeHeaderSize() bytes each)
+   */
+  virtual void convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+    Generic::PacketHeaderSet lines;
+    data.toHeaderSet(lines, 0, data.size());
+    convertHeaders(lines, tuples);
+  }
+
+  /**
+   * Classify headers, which were already converted by convertHeaders. No
+   * conversion is done here, so only the matching itself is measured.
+   *
+   * @param tuples contiguous array of native headers
+   * @param count number of headers in the array
+   * @param out buffer for count indices of matched rules (Generic::noRuleIsMatchingNative, if none matches)
+   */
+  virtual void classifyNative(const void* tuples, size_t count, uint32_t* out) {
+    (void)tuples; (void)count; (void)out;
+    throw "Native classification is not supported by this algorithm.";
+  }
+
   /**
    * Set rules for algorithm and let it convert them to a native implementation, 
    * if needed. 
@@ -46,6 +97,37 @@ public:
    */
   virtual void setRules(const Generic::RuleSet& ruleset) = 0;
 
+  /**
+   * Returns true, if the algorithm can save its classifier, after it was built
+   * by setRules, and load it again instead of building it (see saveSnapshot).
+   */
+  virtual bool supportsSnapshots() const { return false; }
+
+  /**
+   * Serialize the classifier, which was built by setRules, into a flat and
+   * position-independent image (see Generic::SnapshotWriter).
+   *
+   * @param image buffer, to which the image is appended
+   */
+  virtual void saveSnapshot(std::vector<uint8_t>& image) const {
+    (void)image;
+    throw "Snapshots of the classifier are not supported by this algorithm.";
+  }
+
+  /**
+   * Set rules for algorithm like setRules, but restore the classifier from an
+   * image of saveSnapshot instead of building it. The image was saved for the
+   * same rule set and parameters.
+   *
+   * @param ruleset reference to a generic ruleset structure
+   * @param image image of the classifier (e.g. mapped from a file)
+   * @param size size of the image in bytes
+   */
+  virtual void loadSnapshot(const Generic::RuleSet& ruleset, const uint8_t* image, size_t size) {
+    (void)ruleset; (void)image; (void)size;
+    throw "Snapshots of the classifier are not supported by this algorithm.";
+  }
+
   /**
    * Add a new rule to the rule set at a specified index.
    *
@@ -85,7 +167,11 @@ public:
    *
    * @param c smart-pointer that points to a created ChronoManager instance.
    */
-  inline void setChronoManager(std::shared_ptr<ChronoManager> c) { _chronomgr = c; checkChronoMgr(); }
+  inline void setChronoManager(std::shared_ptr<ChronoManager> c) { 
+    _chronomgr = c; checkChronoMgr(); 
+    _chronoConvertHeader = _chronomgr->handle("convert header");
+    _chronoClassify = _chronomgr->handle("classify");
+  }
 
   /**
    * Set LogTagManager instance for storing custom log messages for debug or benchmarking.
@@ -0,0 +1,107 @@
+#ifndef HEADER_TRACE_INCLUDED
+#define HEADER_TRACE_INCLUDED
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <generics/PacketHeaderColumns.hpp>
+
+namespace Generic {
+
+/**
+ * Writes headers into a binary trace file, which is much smaller and faster
+ * to read than headers in a Lua script. The file starts with a header (magic,
+ * version, number of fields and the width of each field in bits), which is
+ * followed by packed records of a fixed size. Each field of a record takes the
+ * bytes of its column in PacketHeaderColumns (1, 2, 4 or 8) or the minimal
+ * number of bytes for fields with more than 64 bits, all in little endian.
+ * The number of records follows from the size of the file, so records can be
+ * appended at any time.
+ */
+class HeaderTraceWriter {
+  FILE* _file;
+  std::vector<unsigned int> _fieldBits;
+  /** size of a single record in bytes */
+  size_t _recordSize;
+  /** buffer for the encoded records of a header set */
+  std::vector<uint8_t> _buffer;
+
+public:
+  /**
+   * Opens a trace file for writing, an exception is thrown, if it can't be opened.
+   *
+   * @param filename path of the trace file
+   * @param fieldBits width in bits of each header field
+   * @param append if true, records are appended to an existing file with the same fields
+   */
+  HeaderTraceWriter(const std::string& filename, const std::vector<unsigned int>& fieldBits, bool append = false);
+  ~HeaderTraceWriter();
+
+  /** Appends all headers of a set with the structure of the trace. */
+  void write(const PacketHeaderColumns& headers);
+
+  /** Flushes and closes the file, an exception is thrown, if not all records were written. */
+  void close();
+};
+
+/**
+ * Reads headers from a binary trace file (see HeaderTraceWriter), which is
+ * mapped into memory. Headers are decoded batch by batch into columns, so a
+ * trace is streamed into the classification without holding all headers as
+ * PacketHeaderColumns at once.
+ */
+class HeaderTraceReader {
+  /** mapped trace file */
+  const uint8_t* _mapping;
+  size_t _mappingSize;
+  /** first record inside of the mapping */
+  const uint8_t* _records;
+  std::vector<unsigned int> _fieldBits;
+  /** size of each field inside of a record in bytes */
+  std::vector<size_t> _fieldBytes;
+  size_t _recordSize;
+  /** number of records */
+  size_t _size;
+  /** index of the next record returned by next */
+  size_t _position;
+
+public:
+  /** Maps a trace file into memory, an exception is thrown, if it is missing or invalid. */
+  explicit HeaderTraceReader(const std::string& filename);
+  ~HeaderTraceReader();
+
+  HeaderTraceReader(const HeaderTraceReader&) = delete;
+  HeaderTraceReader& operator=(const HeaderTraceReader&) = delete;
+
+  /** Returns the width in bits of each header field. */
+  inline const std::vector<unsigned int>& fieldBits() const { return _fieldBits; }
+  /** Returns the number of headers in the trace. */
+  inline size_t size() const { return _size; }
+
+  /**
+   * Decodes a range of headers and appends them to a header set, whose
+   * structure must match the trace.
+   *
+   * @param first index of the first header to read
+   * @param count maximum number of headers to read
+   * @param output set, to which the headers are appended
+   */
+  void read(size_t first, size_t count, PacketHeaderColumns& output) const;
+
+  /**
+   * Replaces the headers of the batch with the next headers of the trace.
+   *
+   * @param batch set for the headers (its memory is reused)
+   * @param count maximum number of headers in the batch
+   * @return false, if all headers of the trace were read already
+   */
+  bool next(PacketHeaderColumns& batch, size_t count);
+
+  /** Starts reading from the first header again. */
+  inline void rewind() { _position = 0; }
+};
+
+} // namespace Generic
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef PACKET_HEADER_COLUMNS_INCLUDED
+#define PACKET_HEADER_COLUMNS_INCLUDED
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <generics/VarValue.hpp>
+#include <generics/PacketHeader.hpp>
+
+namespace Generic {
+
+/**
+ * Stores a set of headers column by column: each header field is kept in
+ * one contiguous array, whose element type is chosen by the bit width of
+ * the field (8, 16, 32 or 64 bits). Compared to a PacketHeaderSet, no
+ * allocation per header or field is necessary and a header takes only the
+ * raw width of its fields. Fields wider than 64 bits are stored as VarValue.
+ */
+class PacketHeaderColumns {
+  struct Column {
+    /** configured width of the field in bits */
+    unsigned int bits;
+    /** size of one element in bytes (0, if stored in 'wide') */
+    size_t bytes;
+    /** contiguous elements of the field */
+    std::vector<uint8_t> data;
+    /** elements of fields with more than 64 bits */
+    std::vector<VarValue> wide;
+
+    Column(unsigned int b);
+  };
+
+  /** one column per header field */
+  std::vector<Column> _columns;
+  /** number of headers */
+  size_t _size;
+  /** number of fields of the last header, which were set by addValue */
+  size_t _filled;
+
+public:
+  /** Read-only view on a single header, which is returned by the iterator. */
+  class HeaderRef {
+    const PacketHeaderColumns* _headers;
+    size_t _row;
+
+  public:
+    HeaderRef(const PacketHeaderColumns* headers, size_t row) : _headers(headers), _row(row) {}
+
+    inline size_t size() const { return _headers->fields(); }
+    inline size_t index() const { return _row; }
+    /** Returns the value of a field (see PacketHeaderColumns::get). */
+    inline uint64_t get(size_t field) const { return _headers->get(_row, field); }
+    inline VarValue operator[](size_t field) const { return _headers->value(_row, field); }
+  };
+
+  /** Iterates over all headers in their order. */
+  class const_iterator {
+    const PacketHeaderColumns* _headers;
+    size_t _row;
+
+  public:
+    const_iterator(const PacketHeaderColumns* headers, size_t row) : _headers(headers), _row(row) {}
+
+    inline HeaderRef operator*() const { return HeaderRef(_headers, _row); }
+    inline const_iterator& operator++() { ++_row; return *this; }
+    inline bool operator==(const const_iterator& other) const { return _row == other._row && _headers == other._headers; }
+    inline bool operator!=(const const_iterator& other) const { return !(*this == other); }
+  };
+
+  PacketHeaderColumns() : _columns(), _size(0), _filled(0) {}
+  /** @param fieldBits width in bits of each header field */
+  PacketHeaderColumns(const std::vector<unsigned int>& fieldBits);
+  ~PacketHeaderColumns() {}
+
+  /** Removes all headers and sets a new structure of header fields. */
+  void setStructure(const std::vector<unsigned int>& fieldBits);
+  /** Removes all headers, but keeps the structure and the allocated memory. */
+  void clear();
+  /** Allocates memory for given number of headers in advance. */
+  void reserve(size_t headers);
+  /** Changes the number of headers, new headers have all fields set to zero. */
+  void resize(size_t headers);
+  void swap(PacketHeaderColumns& other);
+
+  inline size_t size() const { return _size; }
+  inline bool empty() const { return _size == 0; }
+  inline size_t fields() const { return _columns.size(); }
+  inline unsigned int fieldBits(size_t field) const { return _columns[field].bits; }
+
+  inline const_iterator begin() const { return const_iterator(this, 0); }
+  inline const_iterator end() const { return const_iterator(this, _size); }
+
+  /**
+   * Returns the value of a field without any multiprecision type, which is
+   * the fast path for conversions. Values of fields with more than 64 bits,
+   * which don't fit into 64 bits, are saturated to UINT64_MAX.
+   */
+  inline uint64_t get(size_t header, size_t field) const {
+    const Column& col = _columns[field];
+    const uint8_t* elem = col.data.data() + header * col.bytes;
+    switch (col.bytes) {
+      case 1: return *elem;
+      case 2: { uint16_t val; std::memcpy(&val, elem, sizeof(val)); return val; }
+      case 4: { uint32_t val; std::memcpy(&val, elem, sizeof(val)); return val; }
+      case 8: { uint64_t val; std::memcpy(&val, elem, sizeof(val)); return val; }
+      default: return (col.wide[header].fits_ulong_p() ? col.wide[header].get_ui() : UINT64_MAX);
+    }
+  }
+  /**
+   * Sets a field of at most 64 bits without any check or multiprecision type,
+   * which is the fast path for decoding headers. The value must fit into the field.
+   */
+  inline void put(size_t header, size_t field, uint64_t val) {
+    Column& col = _columns[field];
+    uint8_t* elem = col.data.data() + header * col.bytes;
+    switch (col.bytes) {
+      case 1: *elem = (uint8_t)val; break;
+      case 2: { uint16_t conv = (uint16_t)val; std::memcpy(elem, &conv, sizeof(conv)); break; }
+      case 4: { uint32_t conv = (uint32_t)val; std::memcpy(elem, &conv, sizeof(conv)); break; }
+      default: std::memcpy(elem, &val, sizeof(val));
+    }
+  }
+  /** Returns the value of a field in full precision. */
+  VarValue value(size_t header, size_t field) const;
+  /** Sets a field, an exception is thrown, if the value doesn't fit into the field. */
+  void set(size_t header, size_t field, const VarValue& val);
+
+  /** Appends a header with all fields set to zero, fields are set in order by addValue. */
+  void addHeader();
+  /** Sets the next field of the last header. */
+  void addValue(const VarValue& val);
+
+  /** Appends all headers of a line-based header set. */
+  void append(const PacketHeaderSet& headers);
+  /** Appends all headers of another set with the same structure. */
+  void append(const PacketHeaderColumns& headers);
+  /** Appends a range of headers (at most count headers from index first) of another set with the same structure. */
+  void append(const PacketHeaderColumns& headers, size_t first, size_t count);
+  /**
+   * Creates line-based headers for a range of headers, e.g. for algorithms
+   * without a native classification.
+   *
+   * @param output set for the copied headers (will be emptied before)
+   * @param first index of the first header to copy
+   * @param count maximum number of headers to copy
+   */
+  void toHeaderSet(PacketHeaderSet& output, size_t first, size_t count) const;
+};
+
+} // namespace Generic
+
+#endif
+
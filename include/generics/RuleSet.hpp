@@ -5,6 +5,7 @@
 #include <memory>
 #include <generics/Rule.hpp>
 #include <limits>
+#include <cstdint>
 
 namespace Generic {
 
@@ -16,6 +17,9 @@ typedef RuleSet::size_type RuleSetSize;
     
 constexpr RuleSetSize noRuleIsMatching() { return std::numeric_limits<Generic::RuleSetSize>::max(); }
 
+/** Is used by a native classification (see Base::classifyNative) for a header, which doesn't match a rule. */
+constexpr uint32_t noRuleIsMatchingNative() { return std::numeric_limits<uint32_t>::max(); }
+
 /** A collection of matching indices of rules created while filtering headers. */
 typedef std::vector<RuleSetSize> RuleIndexSet;
 
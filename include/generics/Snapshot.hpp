@@ -0,0 +1,88 @@
+#ifndef SNAPSHOT_INCLUDED
+#define SNAPSHOT_INCLUDED
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+namespace Generic {
+
+/** Initial value of a 64-bit FNV-1a hash. */
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+
+/** Updates a 64-bit FNV-1a hash with the given bytes (e.g. a checksum of an image). */
+inline uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i)
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  return hash;
+}
+
+/**
+ * Appends plain values to the flat image of a classifier (see Base::saveSnapshot).
+ * The image contains no pointers, so it can be loaded at any address. References
+ * between parts of a classifier (e.g. from a node to a rule) have to be stored
+ * as indices.
+ */
+class SnapshotWriter {
+  std::vector<uint8_t>& _image;
+
+public:
+  explicit SnapshotWriter(std::vector<uint8_t>& image) : _image(image) {}
+  ~SnapshotWriter() {}
+
+  template <typename T>
+  inline void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written to a snapshot.");
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    _image.insert(_image.end(), bytes, bytes + sizeof(T));
+  }
+
+  /** Appends a block of raw bytes (e.g. the characters of a string). */
+  inline void writeBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    _image.insert(_image.end(), bytes, bytes + size);
+  }
+
+  inline size_t size() const { return _image.size(); }
+};
+
+/**
+ * Reads plain values in the same order from the image of a classifier, which
+ * may be mapped from a file at any address (no alignment is required). Reading
+ * beyond the end of the image throws an exception.
+ */
+class SnapshotReader {
+  const uint8_t* _data;
+  size_t _size;
+  size_t _position;
+
+public:
+  SnapshotReader(const uint8_t* data, size_t size) : _data(data), _size(size), _position(0) {}
+  ~SnapshotReader() {}
+
+  template <typename T>
+  inline T read() {
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read from a snapshot.");
+    if (_size - _position < sizeof(T)) throw "Snapshot of the classifier is truncated (SnapshotReader).";
+    T value;
+    memcpy(&value, _data + _position, sizeof(T));
+    _position += sizeof(T);
+    return value;
+  }
+
+  /** Reads a block of raw bytes, which was written by SnapshotWriter::writeBytes. */
+  inline void readBytes(void* data, size_t size) {
+    if (_size - _position < size) throw "Snapshot of the classifier is truncated (SnapshotReader).";
+    memcpy(data, _data + _position, size);
+    _position += size;
+  }
+
+  /** Returns true, if all values of the image were read. */
+  inline bool atEnd() const { return _position == _size; }
+};
+
+} // namespace Generic
+#endif
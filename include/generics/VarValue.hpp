@@ -1,14 +1,161 @@
 #ifndef VAR_VALUE_INCLUDED
 #define VAR_VALUE_INCLUDED
 
+#include <cstdint>
+#include <climits>
+#include <memory>
+#include <string>
+#include <ostream>
 #include <gmpxx.h>
 
 namespace Generic {
 
-/** Use GMP library for multiprecision type with built-in math-operations. */
-typedef mpz_class VarValue;
+/**
+ * Multiprecision integer with built-in math-operations. Values, which fit
+ * into 64 bits (all header fields and rule atoms of common protocols), are
+ * stored inline and computed without the GMP library. Only wider or negative
+ * values spill to a heap-allocated mpz_class. Integer operations yield the
+ * same results as with a plain mpz_class.
+ */
+class VarValue {
+  /** holds the value, as long as no spilled value exists */
+  uint64_t _small;
+  /** holds the value, if it is wider than 64 bits or negative */
+  std::unique_ptr<mpz_class> _big;
 
-/** Due to internal signed representation of mpz_class, a proper negation is done with this function. */
+  /** Operations, which are done on the slow path. */
+  enum Operation { ADD, SUB, MUL, DIV, MOD, AND, OR, XOR, SHL, SHR, NEG, COM };
+
+  /** Stores given multiprecision value, inline if possible. */
+  void _assign(const mpz_class& val);
+  /** Parses given string with base detection like mpz_class (e.g. '0x' for hex values). */
+  void _assign(const char* str);
+  /** Stores a negative value or a value, which is too large for the inline representation. */
+  void _assignSigned(long long val);
+  void _assignDouble(double val);
+
+  inline bool _isSmall() const { return !_big; }
+
+  /** Computes the result of an operation with multiprecision values. */
+  static VarValue _compute(Operation op, const VarValue& lhs, const VarValue& rhs);
+  static VarValue _shift(Operation op, const VarValue& lhs, unsigned long bits);
+  static int _compare(const VarValue& lhs, const VarValue& rhs);
+
+public:
+  VarValue() : _small(0), _big() {}
+  VarValue(int val) : _small((uint64_t)val), _big() { if (val < 0) _assignSigned(val); }
+  VarValue(long val) : _small((uint64_t)val), _big() { if (val < 0) _assignSigned(val); }
+  VarValue(long long val) : _small((uint64_t)val), _big() { if (val < 0) _assignSigned(val); }
+  VarValue(unsigned int val) : _small(val), _big() {}
+  VarValue(unsigned long val) : _small(val), _big() {}
+  VarValue(unsigned long long val) : _small(val), _big() {}
+  VarValue(double val) : _small(0), _big() {
+    if (val >= 0.0 && val < 18446744073709551616.0) _small = (uint64_t)val; // truncate like mpz_class
+    else _assignDouble(val);
+  }
+  VarValue(const char* str) : _small(0), _big() { _assign(str); }
+  VarValue(const std::string& str) : _small(0), _big() { _assign(str.c_str()); }
+  VarValue(const mpz_class& val) : _small(0), _big() { _assign(val); }
+
+  VarValue(const VarValue& other) : _small(other._small), _big(other._big ? new mpz_class(*other._big) : nullptr) {}
+  VarValue(VarValue&& other) = default;
+  ~VarValue() {}
+
+  VarValue& operator=(const VarValue& other) {
+    _small = other._small;
+    if (!other._big) _big.reset();
+    else if (_big) *_big = *other._big;
+    else _big.reset(new mpz_class(*other._big));
+    return *this;
+  }
+  VarValue& operator=(VarValue&& other) = default;
+
+  /** Returns the least significant bits, which fit into an unsigned long (like mpz_class). */
+  inline unsigned long get_ui() const { return _isSmall() ? (unsigned long)_small : _big->get_ui(); }
+  inline double get_d() const { return _isSmall() ? (double)_small : _big->get_d(); }
+  inline bool fits_ushort_p() const { return _isSmall() && _small <= USHRT_MAX; }
+  inline bool fits_uint_p() const { return _isSmall() && _small <= UINT_MAX; }
+  inline bool fits_ulong_p() const { return _isSmall() && _small <= ULONG_MAX; }
+  /** Returns the value as multiprecision type (which is slow for inline values). */
+  mpz_class get_mpz() const;
+
+  friend inline VarValue operator+(const VarValue& lhs, const VarValue& rhs) {
+    uint64_t res;
+    if (lhs._isSmall() && rhs._isSmall() && !__builtin_add_overflow(lhs._small, rhs._small, &res)) return VarValue(res);
+    return _compute(ADD, lhs, rhs);
+  }
+  friend inline VarValue operator-(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall() && lhs._small >= rhs._small) return VarValue(lhs._small - rhs._small);
+    return _compute(SUB, lhs, rhs);
+  }
+  friend inline VarValue operator*(const VarValue& lhs, const VarValue& rhs) {
+    uint64_t res;
+    if (lhs._isSmall() && rhs._isSmall() && !__builtin_mul_overflow(lhs._small, rhs._small, &res)) return VarValue(res);
+    return _compute(MUL, lhs, rhs);
+  }
+  friend inline VarValue operator/(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall() && rhs._small != 0) return VarValue(lhs._small / rhs._small);
+    return _compute(DIV, lhs, rhs); // throws on a zero divisor
+  }
+  friend inline VarValue operator%(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall() && rhs._small != 0) return VarValue(lhs._small % rhs._small);
+    return _compute(MOD, lhs, rhs); // throws on a zero divisor
+  }
+  friend inline VarValue operator&(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall()) return VarValue(lhs._small & rhs._small);
+    return _compute(AND, lhs, rhs);
+  }
+  friend inline VarValue operator|(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall()) return VarValue(lhs._small | rhs._small);
+    return _compute(OR, lhs, rhs);
+  }
+  friend inline VarValue operator^(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall()) return VarValue(lhs._small ^ rhs._small);
+    return _compute(XOR, lhs, rhs);
+  }
+  friend inline VarValue operator<<(const VarValue& lhs, unsigned long bits) {
+    if (lhs._isSmall() && (bits == 0 || lhs._small == 0 || (bits < 64 && (lhs._small >> (64 - bits)) == 0))) return VarValue(bits < 64 ? lhs._small << bits : 0UL);
+    return _shift(SHL, lhs, bits);
+  }
+  friend inline VarValue operator>>(const VarValue& lhs, unsigned long bits) {
+    if (lhs._isSmall()) return VarValue(bits < 64 ? lhs._small >> bits : 0UL);
+    return _shift(SHR, lhs, bits);
+  }
+  /** Negative results are represented like mpz_class does (two's complement with infinite width). */
+  friend inline VarValue operator~(const VarValue& val) { return _compute(COM, val, val); }
+  friend inline VarValue operator-(const VarValue& val) {
+    if (val._isSmall() && val._small == 0) return VarValue();
+    return _compute(NEG, val, val);
+  }
+
+  VarValue& operator+=(const VarValue& rhs) { return *this = *this + rhs; }
+  VarValue& operator-=(const VarValue& rhs) { return *this = *this - rhs; }
+  VarValue& operator*=(const VarValue& rhs) { return *this = *this * rhs; }
+  VarValue& operator/=(const VarValue& rhs) { return *this = *this / rhs; }
+  VarValue& operator%=(const VarValue& rhs) { return *this = *this % rhs; }
+  VarValue& operator&=(const VarValue& rhs) { return *this = *this & rhs; }
+  VarValue& operator|=(const VarValue& rhs) { return *this = *this | rhs; }
+  VarValue& operator^=(const VarValue& rhs) { return *this = *this ^ rhs; }
+  VarValue& operator<<=(unsigned long bits) { return *this = *this << bits; }
+  VarValue& operator>>=(unsigned long bits) { return *this = *this >> bits; }
+
+  friend inline bool operator==(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall()) return lhs._small == rhs._small;
+    return _compare(lhs, rhs) == 0;
+  }
+  friend inline bool operator!=(const VarValue& lhs, const VarValue& rhs) { return !(lhs == rhs); }
+  friend inline bool operator<(const VarValue& lhs, const VarValue& rhs) {
+    if (lhs._isSmall() && rhs._isSmall()) return lhs._small < rhs._small;
+    return _compare(lhs, rhs) < 0;
+  }
+  friend inline bool operator>(const VarValue& lhs, const VarValue& rhs) { return rhs < lhs; }
+  friend inline bool operator<=(const VarValue& lhs, const VarValue& rhs) { return !(rhs < lhs); }
+  friend inline bool operator>=(const VarValue& lhs, const VarValue& rhs) { return !(lhs < rhs); }
+
+  friend std::ostream& operator<<(std::ostream& out, const VarValue& val);
+};
+
+/** Due to the signed representation of negative values, a proper negation is done with this function. */
 VarValue negateVarValue(const VarValue& val);
 
 } // namespace Generic
@@ -0,0 +1,73 @@
+#ifndef HEAPMETER_HPP
+#define HEAPMETER_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/** Heap usage of one phase (e.g. "set rules"). */
+struct HeapCounters {
+  /** net growth of the heap: allocated minus released bytes */
+  int64_t liveBytes;
+  /** highest net growth of the heap while the phase was active */
+  int64_t peakBytes;
+  uint64_t allocations;
+  uint64_t deallocations;
+
+  HeapCounters() : liveBytes(0), peakBytes(0), allocations(0), deallocations(0) {}
+};
+
+/** Heap usage of one named phase. */
+typedef std::pair<std::string, HeapCounters> HeapPhaseResult;
+/** Heap usage of all phases of a testrun (in order of their first start). */
+typedef std::vector<HeapPhaseResult> HeapResults;
+
+/**
+ * Measures the real heap footprint of the calling thread in named phases
+ * (e.g. building the classifier or classifying headers). In contrast to the
+ * MemManager, which only sees values wrapped in MemTrace, all allocations
+ * are counted: capacity of containers, nodes of maps and lists, control
+ * blocks of shared pointers and alignment of the allocator. This is done by
+ * replacing the global operator new and delete (see HeapMeter.cpp), which
+ * add the usable size of each block (malloc_usable_size) to the counters of
+ * the active phase. Only the thread, which started a phase, is metered, so
+ * worker threads and background threads don't distort the results.
+ * Allocations with malloc directly aren't seen.
+ *
+ * Like the ChronoManager, a phase can be started and stopped multiple times
+ * and all counters are accumulated. Phases must not be nested.
+ */
+class HeapMeter {
+  /** all phases in order of their first start */
+  HeapResults _phases;
+  /** true, while the counters of a phase are updated */
+  bool _active;
+  /** if false, all calls of start and stop are ignored */
+  bool _enabled;
+
+public:
+  HeapMeter() : _phases(), _active(false), _enabled(false) {}
+  ~HeapMeter() { stop(); }
+
+  HeapMeter(const HeapMeter&) = delete;
+  HeapMeter& operator=(const HeapMeter&) = delete;
+
+  /** Enable or disable the metering (disabled by default). */
+  inline void setEnabled(bool enabled) { _enabled = enabled; }
+  inline bool isEnabled() const { return _enabled; }
+
+  /** Starts counting the allocations of the calling thread for the phase with given name. */
+  void start(const std::string& phase);
+
+  /** Stops counting the allocations of the active phase (must be called by the same thread). */
+  void stop();
+
+  /** Copy the counters of all phases in the given container. */
+  void getAllResults(HeapResults& results) const;
+
+  /** Delete all phases. */
+  void reset();
+};
+
+#endif
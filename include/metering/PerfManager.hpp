@@ -0,0 +1,99 @@
+#ifndef PERFMANAGER_HPP
+#define PERFMANAGER_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+/** Counted hardware events of one category (same order as the event names). */
+typedef std::pair<std::string, std::vector<double>> CounterResult;
+/** A collection of category results. */
+typedef std::vector<CounterResult> CounterResults;
+
+/** Collects the hardware events of all categories of a testrun. */
+struct PerfResults {
+  /** names of the counted events (e.g. "cycles") */
+  std::vector<std::string> events;
+  CounterResults categories;
+
+  PerfResults() : events(), categories() {}
+};
+
+/**
+ * Counts hardware events (cycles, instructions, cache-, branch- and TLB-misses)
+ * of the calling thread with the Linux interface perf_event_open. Like the
+ * ChronoManager, events are accumulated in named categories between start and 
+ * stop. Each event is opened separately, so unsupported events are skipped.
+ * If no event is available (e.g. kernel.perf_event_paranoid is too restrictive
+ * or inside a container), all calls are ignored and no results are reported.
+ * Reading the counters needs a system call, so they should only be used for
+ * coarse categories (e.g. a batch of headers), not for each single header.
+ */
+class PerfManager {
+  /** an opened hardware event */
+  struct Counter {
+    std::string name;
+    int fd;
+  };
+
+  /** accumulated events of one category */
+  struct Category {
+    std::vector<double> startValues;
+    std::vector<double> totals;
+  };
+
+  /** all opened events */
+  std::vector<Counter> _counters;
+  /** holds all categories in use */
+  std::unordered_map<std::string, Category> _categories;
+  /** reason, why no events are available */
+  std::string _error;
+  /** if true, all calls of start and stop are ignored */
+  bool _suspended;
+
+  /** Read the current (scaled) value of each event. */
+  void _read(std::vector<double>& values) const;
+
+public:
+  PerfManager() : _counters(), _categories(), _error("not opened"), _suspended(false) {}
+  ~PerfManager() { close(); }
+
+  PerfManager(const PerfManager&) = delete;
+  PerfManager& operator=(const PerfManager&) = delete;
+
+  /**
+   * Open all supported hardware events for the calling thread.
+   *
+   * @return true, if at least one event is available
+   */
+  bool open();
+
+  /** Close all opened events. */
+  void close();
+
+  /** Returns true, if at least one hardware event is counted. */
+  inline bool isAvailable() const { return !_counters.empty(); }
+
+  /** Returns the reason, why no hardware events are available. */
+  inline const std::string& getError() const { return _error; }
+
+  /** Starts counting the events of the category with given name. */
+  void start(const std::string& key);
+
+  /** Stops counting the events of the category with given name and adds them to its total. */
+  void stop(const std::string& key);
+
+  /** Suspend or resume counting (e.g. while other threads classify). */
+  inline void setSuspended(bool suspended) { _suspended = suspended; }
+  inline bool isSuspended() const { return _suspended; }
+
+  /** Copy the event names and the totals of all categories in the given container. */
+  void getAllResults(PerfResults& results) const;
+
+  /** Delete all categories, but keep the events opened. */
+  void reset() { _categories.clear(); }
+};
+
+#endif
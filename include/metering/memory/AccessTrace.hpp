@@ -0,0 +1,165 @@
+#ifndef ACCESS_TRACE_INCLUDED
+#define ACCESS_TRACE_INCLUDED
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Memory {
+
+/** A single traced memory access. */
+struct AccessRecord {
+  /** first accessed byte */
+  uint64_t address;
+  /** number of headers, which were classified until the last checkpoint of the MemManager */
+  uint64_t header;
+  /** number of accessed bytes */
+  uint32_t bytes;
+  /** memory group of the accessed object */
+  uint32_t group;
+  bool write;
+};
+
+class AccessTraceWriter;
+
+/** Memory group, whose accesses are written to a trace (referenced by its MemTrace-instances). */
+struct AccessTraceGroup {
+  AccessTraceWriter* writer;
+  uint32_t id;
+};
+
+/**
+ * Writes the stream of all traced memory accesses into a binary file for an
+ * offline analysis (see AccessTraceReader). The file starts with a header
+ * (magic and version), which is followed by records of variable size: a
+ * flag byte (bit 0: write, bit 1: size follows, bit 2: group follows, bit 3:
+ * header counter follows) and the difference to the previous address. Size,
+ * group and the difference of the header counter are only stored, if they
+ * changed. All numbers are zigzag-encoded varints, so most records take two
+ * or three bytes.
+ *
+ * Accesses are only appended to a buffer by the metered thread, without any
+ * synchronization. A full buffer is handed over to a background thread,
+ * which encodes and writes it, while the next buffer is filled.
+ */
+class AccessTraceWriter {
+  FILE* _file;
+  /** records of the metered thread */
+  std::vector<AccessRecord> _buffer;
+  /** records, which are written by the background thread (empty: thread is idle) */
+  std::vector<AccessRecord> _pending;
+  size_t _capacity;
+  /** groups of the MemManager (a deque keeps their addresses) */
+  std::deque<AccessTraceGroup> _groups;
+  /** current value of the header counter */
+  uint64_t _header;
+  /** if true, accesses are ignored */
+  bool _suspended;
+  /** number of all appended records */
+  uint64_t _records;
+
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _changed;
+  bool _stop;
+  /** set by the background thread, if a write failed */
+  bool _failed;
+
+  /** previous record of the encoder (only used by the background thread) */
+  AccessRecord _last;
+  std::vector<uint8_t> _encoded;
+
+  /** Passes the buffer to the background thread, after it finished the previous one. */
+  void _handOver();
+
+  /** Encodes and writes pending buffers until the trace is closed. */
+  void _run();
+
+  /** Encodes records into the buffer for the file. */
+  void _encode(const std::vector<AccessRecord>& records);
+
+public:
+  /**
+   * Creates a trace file, an exception is thrown, if it can't be opened.
+   *
+   * @param filename path of the trace file
+   * @param bufferRecords number of records in each of both buffers
+   */
+  explicit AccessTraceWriter(const std::string& filename, size_t bufferRecords = 65536);
+
+  /** Closes the file, if this wasn't done before (errors are ignored). */
+  ~AccessTraceWriter();
+
+  AccessTraceWriter(const AccessTraceWriter&) = delete;
+  AccessTraceWriter& operator=(const AccessTraceWriter&) = delete;
+
+  /** Returns the group with the given id, which is created on first use. */
+  AccessTraceGroup& group(unsigned int id);
+
+  /**
+   * Appends an access to the trace.
+   *
+   * @param address first accessed byte
+   * @param bytes number of accessed bytes
+   * @param write true for a write access
+   * @param group group of the accessed object
+   */
+  inline void access(const void* address, size_t bytes, bool write, const AccessTraceGroup& group) {
+    if (_suspended) return;
+    AccessRecord record = { reinterpret_cast<uintptr_t>(address), _header, (uint32_t)bytes, group.id, write };
+    _buffer.push_back(record);
+    if (_buffer.size() >= _capacity) _handOver();
+  }
+
+  /** Sets the header counter of all following accesses. */
+  inline void setHeader(uint64_t header) { _header = header; }
+
+  /** Suspend or resume the tracing (e.g. while headers are classified again for other measurements). */
+  inline void setSuspended(bool suspended) { _suspended = suspended; }
+
+  /** Returns the number of appended records. */
+  inline uint64_t size() const { return _records + _buffer.size(); }
+
+  /** Writes all remaining records and closes the file, an exception is thrown, if not all records were written. */
+  void close();
+};
+
+/**
+ * Reads the records of an access trace (see AccessTraceWriter), which is
+ * mapped into memory.
+ */
+class AccessTraceReader {
+  const uint8_t* _mapping;
+  size_t _mappingSize;
+  /** position of the next record inside of the mapping */
+  size_t _position;
+  /** previous record, which the next one is relative to */
+  AccessRecord _last;
+
+public:
+  /** Maps a trace file into memory, an exception is thrown, if it is missing or invalid. */
+  explicit AccessTraceReader(const std::string& filename);
+  ~AccessTraceReader();
+
+  AccessTraceReader(const AccessTraceReader&) = delete;
+  AccessTraceReader& operator=(const AccessTraceReader&) = delete;
+
+  /**
+   * Decodes the next record, an exception is thrown, if it is truncated.
+   *
+   * @return false, if all records were read already
+   */
+  bool next(AccessRecord& record);
+
+  /** Starts reading from the first record again. */
+  void rewind();
+};
+
+} // namespace Memory
+#endif
@@ -0,0 +1,118 @@
+#ifndef CACHE_SIMULATOR_INCLUDED
+#define CACHE_SIMULATOR_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include <configuration/CacheConfiguration.hpp>
+
+namespace Memory {
+
+class CacheSimulator;
+
+/** Hits and misses of each level of a simulated cache hierarchy. */
+struct CacheCounts {
+  std::vector<size_t> hits;
+  std::vector<size_t> misses;
+};
+
+/** Counts of one memory group, which are updated by the accesses of its MemTrace-instances. */
+struct CacheGroup {
+  CacheSimulator* simulator;
+  CacheCounts counts;
+};
+
+/** Simulated cache hits and misses of a testrun. */
+struct CacheResults {
+  /** names of all levels (empty, if no cache was simulated) */
+  std::vector<std::string> levels;
+  /** counts of each memory group (in order of the group ids) */
+  std::vector<CacheCounts> groups;
+
+  CacheResults() : levels(), groups() {}
+};
+
+/**
+ * Simulates a hierarchy of set-associative caches with the addresses of all
+ * traced memory accesses, so that the locality of an algorithm is measured
+ * independent of the machine. Each level has its own size, associativity,
+ * line size and replacement policy (LRU or tree-based pseudo-LRU). An access
+ * is looked up level by level, until a level holds its line. The line is
+ * inserted in each level, which missed it (reads and writes alike, without
+ * write-backs). Accesses, which span multiple lines of the first level, count
+ * once per line. Hits and misses are counted per memory group of the MemManager.
+ */
+class CacheSimulator {
+  struct Level {
+    CacheLevelConfiguration config;
+    /** number of sets */
+    size_t sets;
+    /** log2 of the line size */
+    unsigned int lineShift;
+    /** number of each cached line plus one for each way of each set (0: invalid) */
+    std::vector<uint64_t> lines;
+    /** LRU: time of the last access of each line, PLRU: tree bits of each set */
+    std::vector<uint64_t> states;
+  };
+
+  std::vector<Level> _levels;
+  /** counters of each memory group (a deque keeps their addresses) */
+  std::deque<CacheGroup> _groups;
+  /** logical time for LRU */
+  uint64_t _clock;
+  /** if true, accesses are ignored */
+  bool _suspended;
+
+  /**
+   * Looks up a line in a level and inserts it on a miss.
+   *
+   * @return true, if the level held the line
+   */
+  bool _lookup(Level& level, uint64_t line);
+
+  /** Marks a way as most recently used in the tree bits of its set. */
+  static void _touchPlru(uint64_t& bits, unsigned int ways, unsigned int way);
+
+  /** Returns the way, which the tree bits of a set point to. */
+  static unsigned int _victimPlru(uint64_t bits, unsigned int ways);
+
+public:
+  /** Throws, if the configuration of a level is invalid. */
+  explicit CacheSimulator(const CacheConfiguration& config);
+  ~CacheSimulator() {}
+
+  CacheSimulator(const CacheSimulator&) = delete;
+  CacheSimulator& operator=(const CacheSimulator&) = delete;
+
+  /** Returns the counters of a memory group, which are created on first use. */
+  CacheGroup& group(unsigned int id);
+
+  /**
+   * Simulates an access of the given bytes at an address.
+   *
+   * @param address first accessed byte
+   * @param bytes number of accessed bytes
+   * @param group counters of the memory group of the accessed object
+   */
+  void access(const void* address, size_t bytes, CacheGroup& group);
+
+  /** Suspend or resume the simulation (e.g. while headers are classified again for other measurements). */
+  inline void setSuspended(bool suspended) { _suspended = suspended; }
+  inline bool isSuspended() const { return _suspended; }
+
+  /** Invalidates all lines and removes all counters (e.g. before the next testrun). */
+  void reset();
+
+  /**
+   * Copies the level names and counts of all groups in the given container.
+   *
+   * @param results container for the results
+   * @param groups minimum number of groups (groups without accesses are reported with zeros)
+   */
+  void getResults(CacheResults& results, unsigned int groups) const;
+};
+
+} // namespace Memory
+#endif
@@ -1,11 +1,14 @@
 #ifndef MEM_MANAGER_INCLUDED
 #define MEM_MANAGER_INCLUDED
 
+#include <deque>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 #include <metering/memory/Registry.hpp>
 #include <metering/memory/MemSnapshot.hpp>
+#include <metering/memory/MemTraceData.hpp>
+#include <metering/memory/CacheSimulator.hpp>
+#include <metering/memory/AccessTrace.hpp>
 #include <utility>
 
 namespace Memory {
@@ -34,17 +37,41 @@ typedef std::vector<std::unique_ptr<MemResultGroup>> MemResultGroups;
  * Central unit for organization of collecting of memory-data and storing it
  * for until the end of a measurement. MemTrace-instances will register themselves
  * so that their memory usage is tracked. Groups of multiple MemTraces can be defined
- * and help to seperate concerns for benchmark-evaluation.
+ * and help to seperate concerns for benchmark-evaluation. Registered instances only
+ * update their own counters on each access, which are added to their group on
+ * deregistration and summed up on checkpoints.
  */
 class MemManager : public Registry {
-  std::unordered_map<RegistryItem*, unsigned int> _mtraces;
+  /** A registered MemTrace-instance with the group it belongs to. */
+  struct Registered {
+    MemTraceData* data;
+    unsigned int groupId;
+  };
+  /** all registered MemTrace-instances, stored densely for summing them up on checkpoints */
+  std::vector<Registered> _mtraces;
   unsigned int _groupsTotal;
   unsigned int _currentGroupId;
   std::vector<MemSnapshotPtr> _history;
   MemSnapshotPtr _current;
+  bool _suspended;
+  /** simulated cache hierarchy for the addresses of all accesses (optional) */
+  std::shared_ptr<CacheSimulator> _cache;
+  /** trace file for all accesses of the current testrun (optional) */
+  std::shared_ptr<AccessTraceWriter> _trace;
+  /** backends of each group, which registered instances pass their accesses to (only used, if a backend is enabled) */
+  std::deque<MemTraceObserver> _observers;
+
+  /** Returns true, if given counters belong to an instance, which is registered here. */
+  bool _isRegistered(const MemTraceData& data) const;
+  /** Returns the backends of a group, which are created on first use. */
+  MemTraceObserver& _observer(unsigned int groupId);
+  /** Sets the current backends for a group. */
+  void _attachBackends(unsigned int groupId);
+  /** Adds the current values of all registered instances to the groups of a snapshot. */
+  void _addRegistered(MemSnapshot& snapshot) const;
 
 public:
-  MemManager() : _groupsTotal(1), _currentGroupId(0), _current(new MemSnapshot(0)) {}
+  MemManager() : _groupsTotal(1), _currentGroupId(0), _current(new MemSnapshot(0)), _suspended(false), _cache(), _trace(), _observers() {}
   ~MemManager() {}
 
   void reg(RegistryItem& item) override;
@@ -58,6 +85,46 @@ public:
 	 */
   void checkpoint(unsigned int headers);
 
+  /**
+   * Suspend or resume the creation of checkpoints. While suspended, calls of
+   * checkpoint, the cache simulation and the access trace are ignored (e.g. while an 
+   * algorithm classifies in multiple threads at once).
+   *
+   * @param suspended true to suspend, false to resume checkpoints
+   */
+  inline void setSuspended(bool suspended) { 
+    _suspended = suspended; 
+    if (_cache) _cache->setSuspended(suspended);
+    if (_trace) _trace->setSuspended(suspended);
+  }
+
+  /** Returns true, if the creation of checkpoints is currently suspended. */
+  inline bool isSuspended() const { return _suspended; }
+
+  /**
+   * Simulate a cache hierarchy with all accesses of MemTrace-instances, which are
+   * registered afterwards. The simulation is reset together with this instance.
+   *
+   * @param cache simulated cache hierarchy (nullptr: no simulation)
+   */
+  void setCacheSimulator(std::shared_ptr<CacheSimulator> cache);
+
+  /**
+   * Copies the simulated cache hits and misses of all groups to given container
+   * (no levels, if no cache is simulated).
+   *
+   * @param results provided container for the results
+   */
+  void getCacheResults(CacheResults& results) const;
+
+  /**
+   * Write all accesses of MemTrace-instances, which are registered afterwards, to a
+   * trace file. The trace is released on reset, so it covers a single testrun.
+   *
+   * @param trace writer of the trace file (nullptr: no trace)
+   */
+  void setAccessTrace(std::shared_ptr<AccessTraceWriter> trace);
+
   /**
    * Create a new group where all next registered MemTrace-instances will belong to.
    */
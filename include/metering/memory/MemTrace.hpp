@@ -34,13 +34,13 @@ public:
   MemTrace(const T& other) : T(other) {
     _metadata.alloc<T>();
     memRegistryPtr->reg(*this);
-    _metadata.write<T>();
+    _metadata.write<T>(static_cast<T*>(this));
   }
 
   MemTrace(T&& other) : T(other) {
     _metadata.alloc<T>();
     memRegistryPtr->reg(*this);
-    _metadata.write<T>();
+    _metadata.write<T>(static_cast<T*>(this));
   }
   
   inline ~MemTrace() { memRegistryPtr->dereg(*this); } 
@@ -71,13 +71,13 @@ public:
   MemTraceScalar(const T& other) : _member(other) {
     _metadata.alloc<T>();
     memRegistryPtr->reg(*this);
-    _metadata.write<T>();
+    _metadata.write<T>(&_member);
   }
 
   MemTraceScalar(T&& other) : _member(other) {
     _metadata.alloc<T>();
     memRegistryPtr->reg(*this);
-    _metadata.write<T>();
+    _metadata.write<T>(&_member);
   }
 
   inline ~MemTraceScalar() { memRegistryPtr->dereg(*this); }
@@ -88,28 +88,28 @@ public:
   T* getPtr() { return &_member; } 
 
   // allow implicit casting operations (work around const-ness to log mem access)
-  inline operator const T() const { const_cast<MemTraceData*>(&_metadata)->read<T>(); return _member; }
+  inline operator const T() const { const_cast<MemTraceData*>(&_metadata)->read<T>(&_member); return _member; }
 
   // unary arithmetic ops
-  inline MemTraceScalar<T>& operator++() { ++_member; _metadata.read<T>(); _metadata.write<T>(); return *this; } // prefix incr.
-  inline MemTraceScalar<T> operator++(int) { _metadata.read<T>(); _metadata.write<T>(); return MemTraceScalar<T>(_member++); } // postfix incr.
-  inline MemTraceScalar<T>& operator--() { --_member; _metadata.read<T>(); _metadata.write<T>(); return *this; } // prefix decr.
-  inline MemTraceScalar<T> operator--(int) { _metadata.read<T>(); _metadata.write<T>(); return MemTraceScalar<T>(_member--); } // postfix decr.
+  inline MemTraceScalar<T>& operator++() { ++_member; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; } // prefix incr.
+  inline MemTraceScalar<T> operator++(int) { _metadata.read<T>(&_member); _metadata.write<T>(&_member); return MemTraceScalar<T>(_member++); } // postfix incr.
+  inline MemTraceScalar<T>& operator--() { --_member; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; } // prefix decr.
+  inline MemTraceScalar<T> operator--(int) { _metadata.read<T>(&_member); _metadata.write<T>(&_member); return MemTraceScalar<T>(_member--); } // postfix decr.
 
   // binary arithmetic ops
-  inline MemTraceScalar<T>& operator+=(const T& rhs) { _member += rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator-=(const T& rhs) { _member -= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator*=(const T& rhs) { _member *= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator/=(const T& rhs) { _member /= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator%=(const T& rhs) { _member %= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator&=(const T& rhs) { _member &= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator^=(const T& rhs) { _member ^= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
-  inline MemTraceScalar<T>& operator|=(const T& rhs) { _member |= rhs; _metadata.read<T>(); _metadata.write<T>(); return *this; }
+  inline MemTraceScalar<T>& operator+=(const T& rhs) { _member += rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator-=(const T& rhs) { _member -= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator*=(const T& rhs) { _member *= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator/=(const T& rhs) { _member /= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator%=(const T& rhs) { _member %= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator&=(const T& rhs) { _member &= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator^=(const T& rhs) { _member ^= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
+  inline MemTraceScalar<T>& operator|=(const T& rhs) { _member |= rhs; _metadata.read<T>(&_member); _metadata.write<T>(&_member); return *this; }
   
   // unary operators
-  inline MemTraceScalar<T> operator-() { _metadata.read<T>(); return MemTraceScalar<T>(-_member); } 
-  inline MemTraceScalar<T> operator!() { _metadata.read<T>(); return MemTraceScalar<T>(!_member); } 
-  inline MemTraceScalar<T> operator~() { _metadata.read<T>(); return MemTraceScalar<T>(~_member); } 
+  inline MemTraceScalar<T> operator-() { _metadata.read<T>(&_member); return MemTraceScalar<T>(-_member); } 
+  inline MemTraceScalar<T> operator!() { _metadata.read<T>(&_member); return MemTraceScalar<T>(!_member); } 
+  inline MemTraceScalar<T> operator~() { _metadata.read<T>(&_member); return MemTraceScalar<T>(~_member); } 
 };
 
 template <> class MemTrace<bool> : public MemTraceScalar<bool> { 
@@ -118,7 +118,7 @@ public:
   MemTrace(const bool& other) : MemTraceScalar(other) {}
   MemTrace(bool&& other) : MemTraceScalar(other) {}
   MemTrace<bool>& operator=(bool rhs) { 
-    _member = rhs; _metadata.write<bool>();
+    _member = rhs; _metadata.write<bool>(&_member);
     return *this;
   }
 };
@@ -128,7 +128,7 @@ public:
   MemTrace(const char& other) : MemTraceScalar(other) {}
   MemTrace(char&& other) : MemTraceScalar(other) {}
   MemTrace<char>& operator=(char rhs) { 
-    _member = rhs; _metadata.write<char>();
+    _member = rhs; _metadata.write<char>(&_member);
     return *this;
   }
 };
@@ -138,7 +138,7 @@ public:
   MemTrace(const char16_t& other) : MemTraceScalar(other) {}
   MemTrace(char16_t&& other) : MemTraceScalar(other) {}
   MemTrace<char16_t>& operator=(char16_t rhs) { 
-    _member = rhs; _metadata.write<char16_t>();
+    _member = rhs; _metadata.write<char16_t>(&_member);
     return *this;
   }
 };
@@ -148,7 +148,7 @@ public:
   MemTrace(const char32_t& other) : MemTraceScalar(other) {}
   MemTrace(char32_t&& other) : MemTraceScalar(other) {}
   MemTrace<char32_t>& operator=(char32_t rhs) { 
-    _member = rhs; _metadata.write<char32_t>();
+    _member = rhs; _metadata.write<char32_t>(&_member);
     return *this;
   }
 };
@@ -158,7 +158,7 @@ public:
   MemTrace(const wchar_t& other) : MemTraceScalar(other) {}
   MemTrace(wchar_t&& other) : MemTraceScalar(other) {}
   MemTrace<wchar_t>& operator=(wchar_t rhs) { 
-    _member = rhs; _metadata.write<wchar_t>();
+    _member = rhs; _metadata.write<wchar_t>(&_member);
     return *this;
   }
 };
@@ -168,7 +168,7 @@ public:
   MemTrace(const signed char& other) : MemTraceScalar(other) {}
   MemTrace(signed char&& other) : MemTraceScalar(other) {}
   MemTrace<signed char>& operator=(signed char rhs) { 
-    _member = rhs; _metadata.write<signed char>();
+    _member = rhs; _metadata.write<signed char>(&_member);
     return *this;
   }
 };
@@ -179,7 +179,7 @@ public:
   MemTrace(const short int& other) : MemTraceScalar(other) {}
   MemTrace(short int&& other) : MemTraceScalar(other) {}
   MemTrace<short int>& operator=(short int rhs) { 
-    _member = rhs; _metadata.write<short int>();
+    _member = rhs; _metadata.write<short int>(&_member);
     return *this;
   }
 };
@@ -189,7 +189,7 @@ public:
   MemTrace(const int& other) : MemTraceScalar(other) {}
   MemTrace(int&& other) : MemTraceScalar(other) {}
   MemTrace<int>& operator=(int rhs) { 
-    _member = rhs; _metadata.write<int>();
+    _member = rhs; _metadata.write<int>(&_member);
     return *this;
   }
 };
@@ -199,7 +199,7 @@ public:
   MemTrace(const long int& other) : MemTraceScalar(other) {}
   MemTrace(long int&& other) : MemTraceScalar(other) {}
   MemTrace<long int>& operator=(long int rhs) { 
-    _member = rhs; _metadata.write<long int>();
+    _member = rhs; _metadata.write<long int>(&_member);
     return *this;
   }
 };
@@ -209,7 +209,7 @@ public:
   MemTrace(const long long int& other) : MemTraceScalar(other) {}
   MemTrace(long long int&& other) : MemTraceScalar(other) {}
   MemTrace<long long int>& operator=(long long int rhs) { 
-    _member = rhs; _metadata.write<long long int>();
+    _member = rhs; _metadata.write<long long int>(&_member);
     return *this;
   }
 };
@@ -219,7 +219,7 @@ public:
   MemTrace(const unsigned char& other) : MemTraceScalar(other) {}
   MemTrace(unsigned char&& other) : MemTraceScalar(other) {}
   MemTrace<unsigned char>& operator=(unsigned char rhs) { 
-    _member = rhs; _metadata.write<unsigned char>();
+    _member = rhs; _metadata.write<unsigned char>(&_member);
     return *this;
   }
 };
@@ -229,7 +229,7 @@ public:
   MemTrace(const unsigned short int& other) : MemTraceScalar(other) {}
   MemTrace(unsigned short int&& other) : MemTraceScalar(other) {}
   MemTrace<unsigned short int>& operator=(unsigned short int rhs) { 
-    _member = rhs; _metadata.write<unsigned short int>();
+    _member = rhs; _metadata.write<unsigned short int>(&_member);
     return *this;
   }
 };
@@ -239,7 +239,7 @@ public:
   MemTrace(const unsigned int& other) : MemTraceScalar(other) {}
   MemTrace(unsigned int&& other) : MemTraceScalar(other) {}
   MemTrace<unsigned int>& operator=(unsigned int rhs) { 
-    _member = rhs; _metadata.write<unsigned int>();
+    _member = rhs; _metadata.write<unsigned int>(&_member);
     return *this;
   }
 };
@@ -249,7 +249,7 @@ public:
   MemTrace(const unsigned long int& other) : MemTraceScalar(other) {}
   MemTrace(unsigned long int&& other) : MemTraceScalar(other) {}
   MemTrace<unsigned long int>& operator=(unsigned long int rhs) { 
-    _member = rhs; _metadata.write<unsigned long int>();
+    _member = rhs; _metadata.write<unsigned long int>(&_member);
     return *this;
   }
 };
@@ -259,7 +259,7 @@ public:
   MemTrace(const unsigned long long int& other) : MemTraceScalar(other) {}
   MemTrace(unsigned long long int&& other) : MemTraceScalar(other) {}
   MemTrace<unsigned long long int>& operator=(unsigned long long int rhs) { 
-    _member = rhs; _metadata.write<unsigned long long int>();
+    _member = rhs; _metadata.write<unsigned long long int>(&_member);
     return *this;
   }
 };
@@ -270,7 +270,7 @@ public:
   MemTrace(const float& other) : MemTraceScalar(other) {}
   MemTrace(float&& other) : MemTraceScalar(other) {}
   MemTrace<float>& operator=(float rhs) { 
-    _member = rhs; _metadata.write<float>();
+    _member = rhs; _metadata.write<float>(&_member);
     return *this;
   }
 };
@@ -280,7 +280,7 @@ public:
   MemTrace(const double& other) : MemTraceScalar(other) {}
   MemTrace(double&& other) : MemTraceScalar(other) {}
   MemTrace<double>& operator=(double rhs) { 
-    _member = rhs; _metadata.write<double>();
+    _member = rhs; _metadata.write<double>(&_member);
     return *this;
   }
 };
@@ -290,7 +290,7 @@ public:
   MemTrace(const long double& other) : MemTraceScalar(other) {}
   MemTrace(long double&& other) : MemTraceScalar(other) {}
   MemTrace<long double>& operator=(long double rhs) { 
-    _member = rhs; _metadata.write<long double>();
+    _member = rhs; _metadata.write<long double>(&_member);
     return *this;
   }
 };
@@ -317,7 +317,7 @@ public:
   MemTracePtr(T other) : _member(other) {
     _metadata.alloc<T>();
     memRegistryPtr->reg(*this);
-    _metadata.write<T>();
+    _metadata.write<T>(&_member);
   }
 
   inline ~MemTracePtr() { memRegistryPtr->dereg(*this); }
@@ -325,14 +325,14 @@ public:
   const RegistryData& getData() const override { return _metadata; }
 
   // allow implicit casting operations (work around const-ness to log mem access)
-  operator const T() const { const_cast<MemTraceData*>(&_metadata)->read<T>(); return _member; }
+  operator const T() const { const_cast<MemTraceData*>(&_metadata)->read<T>(&_member); return _member; }
 
-  inline decltype(*_member)& operator*() { _metadata.read<T>(); return *_member; }
+  inline decltype(*_member)& operator*() { _metadata.read<T>(&_member); return *_member; }
   
-  T operator->() { _metadata.read<T>(); return _member; }
-  const T operator->() const { const_cast<MemTraceData*>(&_metadata)->read<T>(); return _member; }
+  T operator->() { _metadata.read<T>(&_member); return _member; }
+  const T operator->() const { const_cast<MemTraceData*>(&_metadata)->read<T>(&_member); return _member; }
 
-  inline decltype(_member[0])& operator[](int idx) { _metadata.read<T>(); return _member[idx]; }
+  inline decltype(_member[0])& operator[](int idx) { _metadata.read<T>(&_member); return _member[idx]; }
 };
 
 /** 
@@ -366,8 +366,8 @@ public:
 
   const RegistryData& getData() const override { return _metadata; }
 
-  inline T& operator[](int idx) { _metadata.read<T>(); return _member[idx]; }
-  inline const T& operator[](int idx) const { const_cast<MemTraceData*>(&_metadata)->read<T>(); return _member[idx]; }
+  inline T& operator[](int idx) { _metadata.read<T>(&_member[idx]); return _member[idx]; }
+  inline const T& operator[](int idx) const { const_cast<MemTraceData*>(&_metadata)->read<T>(&_member[idx]); return _member[idx]; }
 };
 
 /** 
@@ -379,6 +379,112 @@ public:
   inline MemTrace() : MemTraceArr<T, N>() {}
 };
 
+/**
+ * Counters of a region with multiple traced values (e.g. the members of a small
+ * struct or the elements of an array), which is registered only once with the
+ * allocated bytes of all its values. This avoids one registration per value for
+ * objects, which are created in large numbers. The values of a region are
+ * accessed with MemTraceShared or MemTraceBlock.
+ */
+class MemTraceRegion : public RegistryItem {
+  MemTraceData _metadata;
+
+public:
+  /** @param bytes allocated bytes of all values in the region */
+  explicit MemTraceRegion(size_t bytes) {
+    _metadata.allocBytes = bytes;
+    memRegistryPtr->reg(*this);
+  }
+  MemTraceRegion(const MemTraceRegion&) = delete;
+  MemTraceRegion& operator=(const MemTraceRegion&) = delete;
+
+  inline ~MemTraceRegion() { memRegistryPtr->dereg(*this); }
+
+  const RegistryData& getData() const override { return _metadata; }
+
+  /** Returns the counters, which are shared by all values of the region. */
+  inline MemTraceData& getCounters() const { return const_cast<MemTraceData&>(_metadata); }
+
+  /**
+   * Replaces the allocation of the region (e.g. after reallocating an array),
+   * like the destruction of the old values and the creation of new ones.
+   *
+   * @param bytes allocated bytes of all new values in the region
+   */
+  void reset(size_t bytes) {
+    memRegistryPtr->dereg(*this);
+    _metadata = MemTraceData();
+    _metadata.allocBytes = bytes;
+    memRegistryPtr->reg(*this);
+  }
+};
+
+/**
+ * A wrapper for a scalar value, whose allocation and accesses are counted by
+ * the region it belongs to (e.g. all members of a struct). In contrast to
+ * MemTrace it isn't registered itself and has to be bound to a region on
+ * construction. Assignments only copy the wrapped value.
+ */
+template <typename T>
+class MemTraceShared {
+  T _member;
+  MemTraceData* _metadata;
+
+public:
+  MemTraceShared(const MemTraceRegion& region, const T& value) : _member(value), _metadata(&region.getCounters()) {
+    _metadata->write<T>(&_member);
+  }
+  MemTraceShared(const MemTraceShared<T>&) = delete;
+
+  // allow implicit casting operations
+  inline operator const T() const { _metadata->read<T>(&_member); return _member; }
+
+  inline MemTraceShared<T>& operator=(const T& rhs) { _member = rhs; _metadata->write<T>(&_member); return *this; }
+  inline MemTraceShared<T>& operator=(const MemTraceShared<T>& rhs) { return (*this = static_cast<const T>(rhs)); }
+};
+
+/**
+ * A traced array of variable size, which is registered once as region with all
+ * of its elements. Accesses of elements are counted through a light-weight
+ * reference, which is returned by the index operator.
+ */
+template <typename T>
+class MemTraceBlock {
+  std::unique_ptr<T[]> _member;
+  size_t _size;
+  MemTraceRegion _region;
+
+public:
+  /** Reference to a single element, which counts its accesses in the region. */
+  class Element {
+    T& _value;
+    MemTraceData& _metadata;
+
+  public:
+    Element(T& value, MemTraceData& metadata) : _value(value), _metadata(metadata) {}
+
+    inline operator const T() const { _metadata.read<T>(&_value); return _value; }
+    inline Element& operator=(const T& rhs) { _value = rhs; _metadata.write<T>(&_value); return *this; }
+    inline Element& operator=(const Element& rhs) { return (*this = static_cast<const T>(rhs)); }
+    inline Element& operator&=(const T& rhs) { _value &= rhs; _metadata.read<T>(&_value); _metadata.write<T>(&_value); return *this; }
+    inline Element& operator|=(const T& rhs) { _value |= rhs; _metadata.read<T>(&_value); _metadata.write<T>(&_value); return *this; }
+  };
+
+  /** @param size number of (value-initialized) elements */
+  explicit MemTraceBlock(size_t size) : _member(new T[size]()), _size(size), _region(size * sizeof(T)) {}
+
+  inline size_t size() const { return _size; }
+
+  /** Replaces all elements with a new array of the given size. */
+  void reset(size_t size) {
+    _member.reset(new T[size]());
+    _size = size;
+    _region.reset(size * sizeof(T));
+  }
+
+  inline Element operator[](size_t idx) const { return Element(_member[idx], _region.getCounters()); }
+};
+
 
 #else // in case MemTrace-functionality is disabled
 
@@ -665,6 +771,43 @@ class MemTrace<T[N]> : public MemTraceArr<T, N> {
 public:
   inline MemTrace() : MemTraceArr<T, N>() {}
 };
+
+class MemTraceRegion : public RegistryItem {
+public:
+  explicit MemTraceRegion(size_t) {}
+  MemTraceRegion(const MemTraceRegion&) = delete;
+  MemTraceRegion& operator=(const MemTraceRegion&) = delete;
+  ~MemTraceRegion() {}
+  const RegistryData& getData() const override { return _memTraceDataDummy; }
+  inline MemTraceData& getCounters() const { return _memTraceDataDummy; }
+  void reset(size_t) {}
+};
+
+template <typename T>
+class MemTraceShared {
+  T _member;
+
+public:
+  MemTraceShared(const MemTraceRegion&, const T& value) : _member(value) {}
+  MemTraceShared(const MemTraceShared<T>&) = delete;
+  inline operator const T() const { return _member; }
+  inline MemTraceShared<T>& operator=(const T& rhs) { _member = rhs; return *this; }
+  inline MemTraceShared<T>& operator=(const MemTraceShared<T>& rhs) { _member = rhs._member; return *this; }
+};
+
+template <typename T>
+class MemTraceBlock {
+  std::unique_ptr<T[]> _member;
+  size_t _size;
+
+public:
+  typedef T& Element;
+
+  explicit MemTraceBlock(size_t size) : _member(new T[size]()), _size(size) {}
+  inline size_t size() const { return _size; }
+  void reset(size_t size) { _member.reset(new T[size]()); _size = size; }
+  inline T& operator[](size_t idx) const { return _member[idx]; }
+};
 #endif // MemTrace enabled/disabled
 
 } // namespace Memory
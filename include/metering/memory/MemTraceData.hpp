@@ -3,34 +3,87 @@
 
 #include <cstddef>
 #include <metering/memory/Registry.hpp>
+#include <metering/memory/CacheSimulator.hpp>
+#include <metering/memory/AccessTrace.hpp>
 
 namespace Memory {
 
+/** Backends of a memory group, which receive the address of each access (see MemManager). */
+struct MemTraceObserver {
+  /** counters of the group in a simulated cache hierarchy (optional) */
+  CacheGroup* cache;
+  /** group in a trace file (optional) */
+  AccessTraceGroup* trace;
+
+  MemTraceObserver() : cache(nullptr), trace(nullptr) {}
+
+  /** Passes an access of the given bytes at an address to all backends. */
+  void access(const void* address, size_t bytes, bool write);
+};
+
 struct MemTraceData : public RegistryData {
+  /** index of an instance, which isn't registered */
+  static const size_t unregistered = static_cast<size_t>(-1);
+
   size_t allocBytes; // total allocation size
   size_t totalBytes; // total number of bytes accessed
   size_t count; // number of accesses, just increment on each
   size_t wBytes; // number of bytes in write accesses
   size_t countWrite; // number of write accesses, incr. on each write access
+  /** position in the registry of MemManager (set while registered) */
+  size_t index;
+  /** backends of the group (set by MemManager while registered, if any backend is enabled) */
+  MemTraceObserver* observer;
 
-  MemTraceData() : allocBytes(0), totalBytes(0), count(0), wBytes(0), countWrite(0) {}
+  MemTraceData() : allocBytes(0), totalBytes(0), count(0), wBytes(0), countWrite(0), index(unregistered), observer(nullptr) {}
+
+  /** A copy isn't registered, so it doesn't belong to a group. */
+  MemTraceData(const MemTraceData& other) : allocBytes(other.allocBytes), totalBytes(other.totalBytes), count(other.count),
+    wBytes(other.wBytes), countWrite(other.countWrite), index(unregistered), observer(nullptr) {}
+
+  /** Copies the counters only, the registration of this instance is kept. */
+  MemTraceData& operator=(const MemTraceData& other) {
+    allocBytes = other.allocBytes;
+    totalBytes = other.totalBytes;
+    count = other.count;
+    wBytes = other.wBytes;
+    countWrite = other.countWrite;
+    return *this;
+  }
   
   template <typename T>
-  void alloc() { allocBytes += sizeof(T); }
+  void alloc() { alloc<T>(1); }
   template <typename T>
   void alloc(size_t number) { allocBytes += number*sizeof(T); }
 
   template <typename T>
-  void read() { totalBytes += sizeof(T); ++count; }
+  void read(const void* address) { read<T>(address, 1); }
   template <typename T>
-  void write() { totalBytes += sizeof(T); ++count; wBytes += sizeof(T); ++countWrite; }
+  void write(const void* address) { write<T>(address, 1); }
 
   template <typename T>
-  void read(size_t number) { totalBytes += number*sizeof(T); count += number; }
+  void read(const void* address, size_t number) { 
+    totalBytes += number*sizeof(T); count += number; 
+    observe(address, number*sizeof(T), false);
+  }
   template <typename T>
-  void write(size_t number) { totalBytes += number*sizeof(T); count += number; wBytes += number*sizeof(T); countWrite += number; }
+  void write(const void* address, size_t number) { 
+    totalBytes += number*sizeof(T); count += number; wBytes += number*sizeof(T); countWrite += number; 
+    observe(address, number*sizeof(T), true);
+  }
+
+  /**
+   * Passes an access to the backends of the group. Only a build with 'MEMTRACE_BACKENDS'
+   * checks for them, so that accesses don't pay for disabled backends in other builds.
+   */
+  inline void observe(const void* address, size_t bytes, bool write) {
+#ifdef MEMTRACE_BACKENDS
+    if (observer) observer->access(address, bytes, write);
+#else
+    (void)address; (void)bytes; (void)write;
+#endif
+  }
 };
 
 } // namespace Memory
 #endif
-
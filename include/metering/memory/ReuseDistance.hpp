@@ -0,0 +1,77 @@
+#ifndef REUSE_DISTANCE_INCLUDED
+#define REUSE_DISTANCE_INCLUDED
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include <metering/memory/AccessTrace.hpp>
+
+namespace Memory {
+
+/**
+ * Histogram of the reuse distances of a stream of memory accesses (e.g. of
+ * an access trace). The reuse distance of an access is the number of distinct
+ * cache lines, which were accessed since the last access of the same line. A
+ * fully associative LRU cache with n lines hits all accesses with a distance
+ * below n. Accesses, which span multiple lines, count once per line. The
+ * distances are counted in buckets of powers of two: bucket 0 holds distance
+ * 0, bucket i holds distances from 2^(i-1) up to 2^i - 1.
+ */
+class ReuseDistance {
+  unsigned int _lineShift;
+  /** time of the last access of each line */
+  std::unordered_map<uint64_t, uint64_t> _lastAccess;
+  /** Fenwick tree over time, which marks the last access of each line */
+  std::vector<uint32_t> _tree;
+  /** number of looked up lines (position of the next access in the tree) */
+  uint64_t _time;
+  uint64_t _accesses;
+  /** accesses of lines, which weren't accessed before */
+  uint64_t _coldAccesses;
+  std::vector<uint64_t> _buckets;
+
+  void _add(uint64_t time, int32_t delta);
+
+  /** Returns the number of marked accesses up to (including) given time. */
+  uint64_t _prefix(uint64_t time) const;
+
+  /** Renumbers the last accesses of all lines, if the tree is full. */
+  void _compact();
+
+  void _accessLine(uint64_t line);
+
+public:
+  /** Throws, if the line size is not a power of two. */
+  explicit ReuseDistance(unsigned int lineSize = 64);
+  ~ReuseDistance() {}
+
+  /** Adds an access of the given bytes at an address. */
+  void access(uint64_t address, uint32_t bytes);
+
+  /**
+   * Adds all records of an access trace, optionally only those of one memory group.
+   *
+   * @param trace reader, from whose current position on all records are read
+   * @param group only records of this group are added (negative: all records)
+   */
+  void add(AccessTraceReader& trace, int group = -1);
+
+  /** Returns the number of all line accesses. */
+  inline uint64_t accesses() const { return _accesses; }
+
+  /** Returns the number of accesses of lines, which weren't accessed before (infinite reuse distance). */
+  inline uint64_t coldAccesses() const { return _coldAccesses; }
+
+  /** Returns the number of accesses in each bucket (without cold accesses). */
+  inline const std::vector<uint64_t>& buckets() const { return _buckets; }
+
+  /** Returns the smallest distance of a bucket. */
+  static inline uint64_t bucketMin(size_t bucket) { return (bucket == 0 ? 0 : (uint64_t)1 << (bucket - 1)); }
+
+  /** Returns the largest distance of a bucket. */
+  static inline uint64_t bucketMax(size_t bucket) { return (bucket == 0 ? 0 : ((uint64_t)1 << bucket) - 1); }
+};
+
+} // namespace Memory
+#endif
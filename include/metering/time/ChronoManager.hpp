@@ -5,28 +5,78 @@
 #include <string>
 #include <vector>
 #include <metering/time/Chronograph.hpp>
+#include <metering/time/LatencyHistogram.hpp>
+
+/** identifies a stopwatch of a ChronoManager without a lookup of its name */
+typedef size_t ChronoHandle;
 
 /** one single chronometer group-result */
 typedef std::pair<std::string, unsigned int> ChronoResult; 
 /** a collection of group results */
 typedef std::vector<ChronoResult> ChronoResults; 
 
+/** Sampled measurements of one group: name, measured and skipped timespans, measured time [ns]. */
+struct ChronoSample {
+  std::string name;
+  uint64_t laps;
+  uint64_t skipped;
+  double nanos;
+};
+/** a collection of sampled group results */
+typedef std::vector<ChronoSample> ChronoSamples;
+
+/** latency distribution of one group */
+typedef std::pair<std::string, LatencyHistogram> LatencyResult;
+/** a collection of latency distributions */
+typedef std::vector<LatencyResult> LatencyResults;
+
 /**
  * Represents an interface to multiple stopwatches, which can be used in parallel.
  * Each stopwatch gets a string as the tag to use it. Measured timespans can be
  * fetched in different dimensions (seconds, milliseconds nad microseconds).
+ * For frequent measurements (e.g. per header), the tag is resolved once to a
+ * handle, so that start and stop don't need to look up the stopwatch.
  */
 class ChronoManager {
-  /** holds all stopwatches in use */
-  std::unordered_map<std::string, ChronographPtr> _chronos;
+  /** holds all stopwatches in use, indexed by their handles */
+  std::vector<Chronograph> _chronos;
+  /** maps the name of each stopwatch to its handle */
+  std::unordered_map<std::string, ChronoHandle> _handles;
+  /** cost of reading the clock, which is subtracted from each timespan [ns] */
+  uint64_t _overhead;
+  /** only timespans below this random threshold are measured with handles (all, if maximum) */
+  uint64_t _sampleThreshold;
+  /** state of the pseudo-random generator for sampling (xorshift) */
+  uint64_t _sampleState;
+  /** holds a latency histogram for each group, which records single samples */
+  std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>> _histograms;
+  /** if true, all calls of start and stop are ignored */
+  bool _suspended;
+
+  /** Returns the stopwatch with given name, if it was started (otherwise nullptr). */
+  const Chronograph* _find(const std::string& key) const;
+
+  /** Fixed seed, so that the same timespans are sampled in each testrun. */
+  static constexpr uint64_t _sampleSeed() { return 0x9E3779B97F4A7C15ULL; }
+
+  /** Returns true, if the next timespan is measured (decided pseudo-randomly). */
+  inline bool _sampleNext() {
+    if (_sampleThreshold == UINT64_MAX) return true;
+    _sampleState ^= _sampleState << 13;
+    _sampleState ^= _sampleState >> 7;
+    _sampleState ^= _sampleState << 17;
+    return _sampleState < _sampleThreshold;
+  }
 
 public:
+  ChronoManager() : _chronos(), _handles(), _overhead(Chronograph::calibrate()), _sampleThreshold(UINT64_MAX), _sampleState(_sampleSeed()), _histograms(), _suspended(false) {}
+
   /**
    * Starts the stopwatch with given name.
    *
    * @param key name of the stopwatch to start as string.
    */
-  void start(std::string key);
+  void start(const std::string& key);
 
   /**
    * Stops the stopwatch with given name. Second immediate call of stop
@@ -35,7 +85,47 @@ public:
    *
    * @param key name of the stopwatch to stop as string.
    */
-  void stop(std::string key);
+  void stop(const std::string& key);
+
+  /**
+   * Returns the handle of the stopwatch with given name, which is created if
+   * necessary. Handles stay valid, until the ChronoManager is destroyed.
+   *
+   * @param key name of the stopwatch as string.
+   */
+  ChronoHandle handle(const std::string& key);
+
+  /**
+   * Starts the stopwatch with given handle (see handle). If sampling is set,
+   * only a pseudo-random sample of the timespans is measured.
+   */
+  inline void start(ChronoHandle h) { 
+    if (_suspended) return;
+    if (_sampleNext()) _chronos[h].start();
+    else _chronos[h].skip();
+  }
+
+  /** Stops the stopwatch with given handle, which has to be started before. */
+  inline void stop(ChronoHandle h) { if (!_suspended) _chronos[h].stop(_overhead); }
+
+  /** Returns true, if a stopwatch with given name was started at least once. */
+  bool contains(const std::string& key) const;
+
+  /**
+   * Measure only one out of n timespans of stopwatches used with handles
+   * (e.g. for each header), which are chosen pseudo-randomly to avoid aliasing
+   * with periodic header traces. Totals of these stopwatches are estimated from
+   * the measured samples. Stopwatches used with names are always measured.
+   *
+   * @param n sampling rate (1: all timespans are measured)
+   */
+  void setSampling(unsigned int n);
+
+  /** Returns the measured and skipped timespans of all stopwatches, which were sampled. */
+  void getAllSamples(ChronoSamples& samples) const;
+
+  /** Returns the cost of reading the clock, which is subtracted from each measured timespan. */
+  inline uint64_t getOverhead() const { return _overhead; }
 
   /** Returns the total timespan of all stopwatch-instances in seconds */
   unsigned int getTimeSec();
@@ -47,13 +137,13 @@ public:
   double getTimeNano();
 
   /** Returns the total timespan of a single stopwatch-instance in seconds */
-  unsigned int getTimeSec(std::string key);
+  unsigned int getTimeSec(const std::string& key);
   /** Returns the total timespan of a single stopwatch-instance in milliseconds */
-  unsigned int getTimeMilli(std::string key);
+  unsigned int getTimeMilli(const std::string& key);
   /** Returns the total timespan of a single stopwatch-instance in microseconds */
-  unsigned int getTimeMicro(std::string key);
+  unsigned int getTimeMicro(const std::string& key);
   /** Returns the total timespan of a single stopwatch-instance in nanoseconds */
-  double getTimeNano(std::string key);
+  double getTimeNano(const std::string& key);
 
   /**
    * Pack each result value of all groups in the given container and return them.
@@ -65,8 +155,35 @@ public:
    */
   void getAllResults(ChronoResults& results, unsigned int divisor = 1);
 
-  /** Change back to initial state, all recorded times are deleted. */
-  void reset() { _chronos.clear(); }
+  /**
+   * Records a single latency sample (e.g. the lookup time of one header) in
+   * the histogram of given group. In contrast to start and stop, not only
+   * the total is kept, but the distribution of all samples.
+   *
+   * @param key name of the latency group
+   * @param nanos duration of the sample in nanoseconds
+   */
+  void record(const std::string& key, uint64_t nanos);
+
+  /** Adds all samples of a histogram to the histogram of given group (e.g. recorded by a worker). */
+  void record(const std::string& key, const LatencyHistogram& samples);
+
+  /** Copy the histograms of all latency groups in the given container. */
+  void getAllLatencies(LatencyResults& results) const;
+
+  /**
+   * Suspend or resume all stopwatches. While suspended, calls of start and stop
+   * are ignored (e.g. while an algorithm classifies in multiple threads at once).
+   *
+   * @param suspended true to suspend, false to resume time metering
+   */
+  inline void setSuspended(bool suspended) { _suspended = suspended; }
+
+  /** Returns true, if time metering is currently suspended. */
+  inline bool isSuspended() const { return _suspended; }
+
+  /** Change back to initial state, all recorded times are deleted (handles stay valid). */
+  void reset();
 };
 
 #endif
@@ -3,9 +3,9 @@
 
 #include <chrono>
 #include <memory>
-#include <generics/VarValue.hpp>
+#include <cstdint>
 
-typedef std::chrono::high_resolution_clock Chronoclock;
+typedef std::chrono::steady_clock Chronoclock;
 /** 
  * Represents a single stopwatch for measuring the performance of a 
  * specified aspect of an algorithm's benchmark run.
@@ -14,24 +14,75 @@ class Chronograph {
   /** holds the time-point of stopwatch-start */
   Chronoclock::time_point _start;
 
-  /** holds result time of the stopwatch in nanoseconds (multi-precision type) */
-  Generic::VarValue _total;
+  /** holds result time of the stopwatch in nanoseconds */
+  uint64_t _total;
+
+  /** true, if the stopwatch was started at least once since the last reset */
+  bool _started;
+
+  /** number of measured timespans */
+  uint64_t _laps;
+  /** number of timespans, which were not measured (see skip) */
+  uint64_t _skipped;
+  /** true, if the current timespan is not measured */
+  bool _skipping;
 
 public:
-  Chronograph() : _total(0) {}
+  Chronograph() : _start(), _total(0), _started(false), _laps(0), _skipped(0), _skipping(false) {}
   /** Start the stopwatch */
-  void start() { _start = Chronoclock::now(); }
-  /** Stop the stopwatch and sum previous timespanup in total duration. */
-  void stop();
+  inline void start() { _start = Chronoclock::now(); _started = true; _skipping = false; }
+  /**
+   * Start a timespan without measuring it (e.g. if only a sample of all
+   * timespans is measured). The following stop is ignored, but the timespan
+   * is counted to estimate the total time.
+   */
+  inline void skip() { _started = true; _skipping = true; ++_skipped; }
+  /**
+   * Stop the stopwatch and sum previous timespan up in total duration.
+   *
+   * @param overhead nanoseconds to subtract from the timespan (cost of reading the clock)
+   */
+  inline void stop(uint64_t overhead = 0) {
+    if (_skipping) return;
+
+    Chronoclock::time_point now = Chronoclock::now();
+    uint64_t span = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _start).count();
+    _total += (span > overhead ? span - overhead : 0);
+    ++_laps;
+    _start = now; // for lap-like functionality
+  }
+  /** Set total measured time back to zero. */
+  inline void reset() { _total = 0; _started = false; _laps = 0; _skipped = 0; _skipping = false; }
+
+  /** Returns true, if the stopwatch was started since the last reset. */
+  inline bool isStarted() const { return _started; }
 
   /** Return total measured time in seconds. */
-  inline unsigned int getTotalSec() { return (unsigned int)(getTotalMillisec() / 1000.0); }
+  inline unsigned int getTotalSec() const { return (unsigned int)(getTotalMillisec() / 1000.0); }
   /** Return total measured time in milliseconds. */
-  inline unsigned int getTotalMillisec() { return (unsigned int)(getTotalMicrosec() / 1000.0); }
+  inline unsigned int getTotalMillisec() const { return (unsigned int)(getTotalMicrosec() / 1000.0); }
   /** Return total measured time in microseconds. */
-  inline unsigned int getTotalMicrosec() { return (unsigned int)(getTotalNanosec() / 1000.0); }
-  /** Return total measured time in nanoseconds. */ 
-  inline double getTotalNanosec() { return _total.get_d(); }
+  inline unsigned int getTotalMicrosec() const { return (unsigned int)(getTotalNanosec() / 1000.0); }
+  /** 
+   * Return total measured time in nanoseconds. If timespans were skipped, the
+   * total is estimated from the measured ones.
+   */ 
+  inline double getTotalNanosec() const { 
+    if (_skipped == 0 || _laps == 0) return (double)_total;
+    return (double)_total * (_laps + _skipped) / _laps;
+  }
+  /** Return the sum of only the measured timespans in nanoseconds. */
+  inline double getMeasuredNanosec() const { return (double)_total; }
+  /** Return the number of measured timespans. */
+  inline uint64_t getLaps() const { return _laps; }
+  /** Return the number of skipped timespans. */
+  inline uint64_t getSkipped() const { return _skipped; }
+
+  /**
+   * Returns the smallest timespan between two consecutive readings of the clock
+   * in nanoseconds, which is contained in each measured timespan additionally.
+   */
+  static uint64_t calibrate();
 };
 
 typedef std::unique_ptr<Chronograph> ChronographPtr;
@@ -0,0 +1,87 @@
+#ifndef LATENCY_HISTOGRAM_INCLUDED
+#define LATENCY_HISTOGRAM_INCLUDED
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/** One point of a cumulative distribution: (latency in nanoseconds, fraction of samples up to it). */
+typedef std::pair<uint64_t, double> LatencyCdfPoint;
+
+/**
+ * Counts latency samples (in nanoseconds) in logarithmic buckets like a HDR
+ * histogram: values below 128 are counted exactly, larger values in 64 linear
+ * sub-buckets per power of two. So each reported value has a relative error
+ * of less than 1.6%, while the memory footprint is constant (independent of
+ * the number of samples) and recording a sample takes only a few instructions.
+ */
+class LatencyHistogram {
+  /** number of bits of a value, which are kept exactly (7 bits: below 128) */
+  static constexpr unsigned int SUB_BITS = 7;
+  static constexpr uint64_t SUB_COUNT = (1ULL << SUB_BITS);
+  static constexpr uint64_t HALF_COUNT = (SUB_COUNT >> 1);
+  static constexpr size_t BUCKETS = SUB_COUNT + (64 - SUB_BITS) * HALF_COUNT;
+
+  /** counter of samples per bucket */
+  std::vector<uint64_t> _counts;
+  /** number of all samples */
+  uint64_t _total;
+  /** smallest and largest sample (exact values) */
+  uint64_t _min;
+  uint64_t _max;
+  /** sum of all samples for the mean value */
+  double _sum;
+
+  /** Returns the bucket of a value. */
+  static inline size_t _bucket(uint64_t value) {
+    if (value < SUB_COUNT) return (size_t)value;
+    unsigned int shift = (63 - __builtin_clzll(value)) - (SUB_BITS - 1); // keep the 7 most significant bits
+    return (size_t)(SUB_COUNT + (shift - 1) * HALF_COUNT + ((value >> shift) - HALF_COUNT));
+  }
+
+  /** Returns the largest value, which is counted in the given bucket. */
+  static uint64_t _highestValue(size_t bucket);
+
+public:
+  LatencyHistogram() : _counts(BUCKETS, 0), _total(0), _min(UINT64_MAX), _max(0), _sum(0) {}
+  ~LatencyHistogram() {}
+
+  /** Adds a sample (e.g. the lookup time of a single header). */
+  inline void record(uint64_t nanos) { record(nanos, 1); }
+
+  /** Adds the same sample multiple times. */
+  inline void record(uint64_t nanos, uint64_t count) {
+    if (count == 0) return;
+    _counts[_bucket(nanos)] += count;
+    _total += count;
+    _sum += (double)nanos * count;
+    if (nanos < _min) _min = nanos;
+    if (nanos > _max) _max = nanos;
+  }
+
+  /** Adds all samples of another histogram. */
+  void merge(const LatencyHistogram& other);
+
+  /** Removes all samples. */
+  void reset();
+
+  inline uint64_t count() const { return _total; }
+  inline uint64_t minimum() const { return (_total > 0 ? _min : 0); }
+  inline uint64_t maximum() const { return _max; }
+  inline double mean() const { return (_total > 0 ? _sum / _total : 0); }
+
+  /**
+   * Returns the latency, which is not exceeded by the given percentage of
+   * all samples (e.g. 99.9), within the precision of the buckets.
+   *
+   * @param percentile value between 0 and 100
+   */
+  uint64_t valueAtPercentile(double percentile) const;
+
+  /** Returns the cumulative distribution with one point per non-empty bucket. */
+  void getCdf(std::vector<LatencyCdfPoint>& cdf) const;
+};
+
+#endif
+
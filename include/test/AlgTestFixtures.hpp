@@ -5,6 +5,7 @@
 #include <memory>
 #include <generics/RuleSet.hpp>
 #include <generics/PacketHeader.hpp>
+#include <generics/Base.hpp>
 #include <metering/memory/MemManager.hpp>
 #include <metering/memory/MemTrace.hpp>
 #include <metering/memory/MemTraceRegistry.hpp>
@@ -51,6 +52,9 @@ public:
   /** Evaluates the 1024 indices after a classification run. */
   static void evalIndicesSet1024(Generic::RuleIndexSet& indices);
 
+  /** Converts all headers and classifies them with the native interface of an algorithm. */
+  static void classifyNative(Base& alg, const Generic::PacketHeaderSet& packets, Generic::RuleIndexSet& indices);
+
   /** Creates and setups necessary Memory and Chronograph instances. */
   static void setupMemChrono(MemChronoSetup& setup);
 };
@@ -3,7 +3,8 @@ ALG_COMM_SRCS_DIR	= $(ALG_SRCS_DIR)common/
 
 ALG_OBJ_BASE		= $(CATE_OBJ_DIR)Base.o
 ALG_OBJ_VARVALUE	= $(CATE_OBJ_DIR)VarValue.o
-ALG_OBJ_BASIC		= $(ALG_OBJ_BASE) $(ALG_OBJ_VARVALUE)
+ALG_OBJ_COLUMNS		= $(CATE_OBJ_DIR)PacketHeaderColumns.o
+ALG_OBJ_BASIC		= $(ALG_OBJ_BASE) $(ALG_OBJ_VARVALUE) $(ALG_OBJ_COLUMNS)
 
 ALG_OBJ_TPL			= $(ALG_OBJ_DIR)Data%tpl.o $(ALG_OBJ_DIR)Converter%tpl.o
 
@@ -10,38 +10,60 @@ OBJ_MEM		= \
 	$(CATE_OBJ_DIR)Registry.o \
 	$(CATE_OBJ_DIR)MemTraceRegistry.o \
 	$(CATE_OBJ_DIR)MemSnapshot.o \
+	$(CATE_OBJ_DIR)CacheSimulator.o \
+	$(CATE_OBJ_DIR)AccessTrace.o \
+	$(CATE_OBJ_DIR)ReuseDistance.o \
 
 OBJ_CHRONO	= \
 	$(CATE_OBJ_DIR)ChronoManager.o \
-	$(CATE_OBJ_DIR)Chronograph.o
+	$(CATE_OBJ_DIR)Chronograph.o \
+	$(CATE_OBJ_DIR)LatencyHistogram.o
 
 OBJ_DATA	= \
 	$(CATE_OBJ_DIR)VarValue.o \
+	$(CATE_OBJ_DIR)PacketHeaderColumns.o \
+	$(CATE_OBJ_DIR)HeaderTrace.o \
+	$(CATE_OBJ_DIR)PcapSource.o \
+	$(CATE_OBJ_DIR)ClassBenchLoader.o \
+	$(CATE_OBJ_DIR)SharedRuleSet.o \
 	$(CATE_OBJ_DIR)RuleSet.o \
 	$(CATE_OBJ_DIR)RuleAtom.o \
 	$(CATE_OBJ_DIR)Benchmark.o \
 	$(CATE_OBJ_DIR)Configuration.o \
 	$(CATE_OBJ_DIR)Statistics.o \
+	$(CATE_OBJ_DIR)MatchSink.o \
 	$(CATE_OBJ_DIR)Results.o
 
 OBJ_RNDGEN	= \
 	$(CATE_OBJ_DIR)RandomNumberGenerator.o \
 	$(CATE_OBJ_DIR)HeaderGenerator.o \
+	$(CATE_OBJ_DIR)HeaderPipeline.o \
 	$(CATE_OBJ_DIR)RandomHeaderConfiguration.o
 
 OBJ_LOGTAG	= \
 	$(CATE_OBJ_DIR)LogTagManager.o
 
+OBJ_PERF	= \
+	$(CATE_OBJ_DIR)PerfManager.o
+
+OBJ_HEAP	= \
+	$(CATE_OBJ_DIR)HeapMeter.o
+
 # all object files for main-program
-OBJFILES	= $(OBJ_MEM) $(OBJ_CHRONO) $(OBJ_DATA) $(OBJ_RNDGEN) $(OBJ_LOGTAG)\
+OBJFILES	= $(OBJ_MEM) $(OBJ_CHRONO) $(OBJ_DATA) $(OBJ_RNDGEN) $(OBJ_LOGTAG) $(OBJ_PERF) $(OBJ_HEAP)\
 	$(CATE_OBJ_DIR)main.o \
 	$(CATE_OBJ_DIR)AlgFactory.o \
 	$(CATE_OBJ_DIR)LuaInterpreter.o \
 	$(CATE_OBJ_DIR)LuaConfigurator.o \
+	$(CATE_OBJ_DIR)ConfigurationCache.o \
 	$(CATE_OBJ_DIR)Shell.o \
+	$(CATE_OBJ_DIR)IsolatedProcess.o \
 	$(CATE_OBJ_DIR)Web.o \
 	$(CATE_OBJ_DIR)FilesysHelper.o \
 	$(CATE_OBJ_DIR)BenchmarkExecutor.o \
+	$(CATE_OBJ_DIR)ParallelClassifier.o \
+	$(CATE_OBJ_DIR)CpuEnvironment.o \
+	$(CATE_OBJ_DIR)SnapshotCache.o \
 	$(CATE_OBJ_DIR)OutputResults.o \
 	$(CATE_OBJ_DIR)Evaluator.o
 
@@ -62,7 +84,7 @@ build_cate: $(CATE_EXEC) copy_files
 
 $(CATE_EXEC): build_libs $(OBJFILES) 
 	$(MKDIR)
-	$(CC) $(CFLAGS) $(OBJFILES) -o $@ $(LUA_LIB_A) $(GMP_BUILD_XXA) $(GMP_BUILD_A) -ldl
+	$(CC) $(CFLAGS) $(OBJFILES) -o $@ $(LUA_LIB_A) $(GMP_BUILD_XXA) $(GMP_BUILD_A) -ldl -pthread
 
 # general targets for compiling the object files
 $(CATE_OBJ_DIR)%.o: $(SRCDIR)generics/%.cpp $(INCLUDE)/generics/%.hpp 
@@ -16,7 +16,8 @@ TEST_SET_4	= $(OBJ_MEM) \
 	$(TEST_OBJ_DIR)MemTrace.o 
 
 TEST_SET_5	= $(OBJ_CHRONO) \
-	$(TEST_OBJ_DIR)ChronoManager.o
+	$(TEST_OBJ_DIR)ChronoManager.o \
+	$(TEST_OBJ_DIR)LatencyHistogram.o
 
 TEST_SET_6	= $(CATE_OBJ_DIR)FilesysHelper.o \
 	$(TEST_OBJ_DIR)FilesysHelper.o
@@ -27,6 +28,7 @@ TEST_SET_7	= $(OBJ_DATA) \
 
 TEST_SET_8	= $(OBJ_RNDGEN) \
 	$(TEST_OBJ_DIR)HeaderGenerator.o \
+	$(TEST_OBJ_DIR)HeaderPipeline.o \
 	$(TEST_OBJ_DIR)RandomNumberGenerator.o 
 
 TEST_SET_9	= $(OBJ_DATA) \
@@ -36,9 +38,54 @@ TEST_SET_9	= $(OBJ_DATA) \
 TEST_SET_10	= $(OBJ_LOGTAG) \
 	$(TEST_OBJ_DIR)LogTagManager.o
 
+TEST_SET_11	= $(OBJ_MEM) $(OBJ_CHRONO) $(OBJ_DATA) \
+	$(CATE_OBJ_DIR)ParallelClassifier.o \
+	$(TEST_OBJ_DIR)ParallelClassifier.o
+
+TEST_SET_12	= $(OBJ_DATA) \
+	$(TEST_OBJ_DIR)PacketHeaderColumns.o
+
+TEST_SET_13	= $(OBJ_DATA) \
+	$(TEST_OBJ_DIR)MatchSink.o
+
+TEST_SET_14	= $(OBJ_PERF) \
+	$(TEST_OBJ_DIR)PerfManager.o
+
+TEST_SET_15	= $(CATE_OBJ_DIR)CpuEnvironment.o \
+	$(TEST_OBJ_DIR)CpuEnvironment.o
+
+TEST_SET_16	= $(CATE_OBJ_DIR)IsolatedProcess.o \
+	$(TEST_OBJ_DIR)IsolatedProcess.o
+
+TEST_SET_17	= $(OBJ_DATA) \
+	$(CATE_OBJ_DIR)SnapshotCache.o \
+	$(TEST_OBJ_DIR)SnapshotCache.o
+
+TEST_SET_18	= $(OBJ_DATA) \
+	$(TEST_OBJ_DIR)HeaderTrace.o
+
+TEST_SET_19	= $(OBJ_DATA) \
+	$(TEST_OBJ_DIR)PcapSource.o
+
+TEST_SET_20	= $(OBJ_DATA) \
+	$(TEST_OBJ_DIR)ClassBenchLoader.o
+
+TEST_SET_21	= $(OBJ_DATA) \
+	$(CATE_OBJ_DIR)ConfigurationCache.o \
+	$(TEST_OBJ_DIR)ConfigurationCache.o
+
+TEST_SET_22	= $(OBJ_MEM) \
+	$(TEST_OBJ_DIR)CacheSimulator.o
+
+TEST_SET_23	= $(OBJ_MEM) \
+	$(TEST_OBJ_DIR)AccessTrace.o
+
+TEST_SET_24	= $(OBJ_HEAP) \
+	$(TEST_OBJ_DIR)HeapMeter.o
+
 
 # all object files for unit tests (algorithms excluded)
-TEST_OBJS	= $(sort $(TEST_SET_1) $(TEST_SET_2) $(TEST_SET_3) $(TEST_SET_4) $(TEST_SET_5) $(TEST_SET_6) $(TEST_SET_7) $(TEST_SET_8) $(TEST_SET_9) $(TEST_SET_10))
+TEST_OBJS	= $(sort $(TEST_SET_1) $(TEST_SET_2) $(TEST_SET_3) $(TEST_SET_4) $(TEST_SET_5) $(TEST_SET_6) $(TEST_SET_7) $(TEST_SET_8) $(TEST_SET_9) $(TEST_SET_10) $(TEST_SET_11) $(TEST_SET_12) $(TEST_SET_13) $(TEST_SET_14) $(TEST_SET_15) $(TEST_SET_16) $(TEST_SET_17) $(TEST_SET_18) $(TEST_SET_19) $(TEST_SET_20) $(TEST_SET_21) $(TEST_SET_22) $(TEST_SET_23) $(TEST_SET_24))
 
 
 .PHONY: utest 
@@ -47,6 +94,9 @@ TEST_OBJS	= $(sort $(TEST_SET_1) $(TEST_SET_2) $(TEST_SET_3) $(TEST_SET_4) $(TES
 utest: $(TEST_EXEC_DIR)$(APPNAME)_unittests $(TEST_RUNNER)
 	$(TEST_RUNNER) $< -v
 
+# unit tests cover the backends of memtrace too (all MemTrace-instances are part of test files)
+$(TEST_EXEC_DIR)$(APPNAME)_unittests: TEST_C_FLAGS += $(MEMBACKENDS)
+
 # build complete test suite for CATE
 $(TEST_EXEC_DIR)$(APPNAME)_unittests: $(TEST_BUILD_SO) $(INCLUDE)/libunittest build_gmp $(TEST_OBJS)
 	$(MKDIR)
@@ -9,6 +9,8 @@ CC 			= g++
 # -Wl,--export-dynamic  => add all symbols to dynamic symbol table, needed to access from dlopened-algorithm-library to global variables (memRegistryPtr)
 # -D MEMTRACE_DISABLED => memtrace functionality will be disabled, for exact chronograph-results
 MEMDISABLE	= -D MEMTRACE_DISABLED
+# -D MEMTRACE_BACKENDS => memtrace passes each access to the cache simulation and access traces, if they are enabled
+MEMBACKENDS	= -D MEMTRACE_BACKENDS
 CFLAGS 		= -O3 -Wall -Wextra -Werror -pedantic -std=c++11 -fPIC -fmax-errors=3 -Wl,--export-dynamic
 
 # -shared => produce a shared object, which can be linked to other objects
@@ -82,6 +82,33 @@ void Bitvector10tpl::constructProjections() {
 }
 
 void Bitvector10tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data10tpl::HeaderTuple> tuples(data.size(), Data10tpl::HeaderTuple(0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter10tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void Bitvector10tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector10tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector10tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataBitvector;
 
 	unsigned int matchIndex;
@@ -92,19 +119,16 @@ void Bitvector10tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rul
     !_dim6 || !_dim7 || !_dim8 || !_dim9 || !_dim10)
     throw "Bitvector10tpl: One of the lookup structures is not set.";
 
-  Data10tpl::HeaderTuple tpl(0, 0, 0, 0, 0, 0, 0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data10tpl::HeaderTuple* headerTuples = static_cast<const Data10tpl::HeaderTuple*>(tuples);
 
   Bitvector bv0(_rules.size());
 
   Range<uint32_t> searchKey32(0, 0);
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter10tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data10tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 
     searchKey32.min = tpl.v1;
     searchKey32.max = tpl.v1;
@@ -147,15 +171,16 @@ void Bitvector10tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rul
     bv0 &= _dim10->search(searchKey32);
 
     matchIndex = bv0.getFirstSetBit();
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = matchIndex;
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void Bitvector10tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
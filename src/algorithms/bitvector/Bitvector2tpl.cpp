@@ -66,6 +66,33 @@ void Bitvector2tpl::constructProjections() {
 }
 
 void Bitvector2tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data2tpl::HeaderTuple> tuples(data.size(), Data2tpl::HeaderTuple(0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter2tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void Bitvector2tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter2tpl::convertHeaders(data, static_cast<Data2tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector2tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter2tpl::convertHeaders(data, static_cast<Data2tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector2tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataBitvector;
 
 	unsigned int matchIndex;
@@ -75,19 +102,16 @@ void Bitvector2tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
   if (!_dimIpSrc || !_dimIpDest)
     throw "Bitvector2tpl: One of the lookup structures is not set.";
 
-  Data2tpl::HeaderTuple tpl(0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data2tpl::HeaderTuple* headerTuples = static_cast<const Data2tpl::HeaderTuple*>(tuples);
 
   Bitvector bv0(_rules.size());
 
   Range<uint32_t> searchKey32(0, 0);
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter2tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data2tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 
     searchKey32.min = tpl.addrSrc;
     searchKey32.max = tpl.addrSrc;
@@ -98,15 +122,16 @@ void Bitvector2tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
     bv0 &= _dimIpDest->search(searchKey32);
 
     matchIndex = bv0.getFirstSetBit();
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = matchIndex;
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void Bitvector2tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -70,28 +70,52 @@ void Bitvector4tpl::constructProjections() {
 }
 
 void Bitvector4tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data4tpl::HeaderTuple> tuples(data.size(), Data4tpl::HeaderTuple(0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter4tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void Bitvector4tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector4tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector4tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataBitvector;
 
 	unsigned int matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  if (!_dim1 || !_dim1 || !_dim3 || !_dim4)
+  if (!_dim1 || !_dim2 || !_dim3 || !_dim4)
     throw "Bitvector4tpl: One of the lookup structures is not set.";
 
-  Data4tpl::HeaderTuple tpl(0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data4tpl::HeaderTuple* headerTuples = static_cast<const Data4tpl::HeaderTuple*>(tuples);
 
   Bitvector bv0(_rules.size());
 
   Range<uint32_t> searchKey32(0, 0);
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter4tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data4tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 
     searchKey32.min = tpl.v1;
     searchKey32.max = tpl.v1;
@@ -110,15 +134,16 @@ void Bitvector4tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
     bv0 &= _dim4->search(searchKey32);
 
     matchIndex = bv0.getFirstSetBit();
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = matchIndex;
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void Bitvector4tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -72,6 +72,33 @@ void Bitvector5tpl::constructProjections() {
 }
 
 void Bitvector5tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data5tpl::HeaderTuple> tuples(data.size(), Data5tpl::HeaderTuple(0, 0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter5tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void Bitvector5tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter5tpl::convertHeaders(data, static_cast<Data5tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector5tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter5tpl::convertHeaders(data, static_cast<Data5tpl::HeaderTuple*>(tuples));
+}
+
+void Bitvector5tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataBitvector;
 
 	unsigned long int matchIndex;
@@ -81,8 +108,7 @@ void Bitvector5tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
   if (!_dimIpSrc || !_dimIpDest || !_dimPortSrc || !_dimPortDest || !_dimProtocol)
     throw "Bitvector5tpl: One of the lookup structures is not set.";
 
-  Data5tpl::HeaderTuple tpl(0, 0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data5tpl::HeaderTuple* headerTuples = static_cast<const Data5tpl::HeaderTuple*>(tuples);
 
   Bitvector bv0(_rules.size());
   //Bitvector bv1(_rules.size());
@@ -91,12 +117,10 @@ void Bitvector5tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
   Range<uint16_t> searchKey16(0, 0);
   Range<uint8_t> searchKey8(0, 0);
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter5tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data5tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 
     searchKey32.min = tpl.addrSrc;
     searchKey32.max = tpl.addrSrc;
@@ -119,15 +143,16 @@ void Bitvector5tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rule
     bv0 &= _dimProtocol->search(searchKey8);
 
     matchIndex = bv0.getFirstSetBit();
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = (matchIndex < Generic::noRuleIsMatchingNative() ? (uint32_t)matchIndex : Generic::noRuleIsMatchingNative());
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void Bitvector5tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -2,7 +2,7 @@
 
 using namespace DataBitvector;
 
-MemStorageT& Bitvector::_getStorageReference(unsigned int position, unsigned int& bitpos) const {
+MemStorageT::Element Bitvector::_getStorageReference(unsigned int position, unsigned int& bitpos) const {
   // calculate positions to fetch bit from
   unsigned int storagepos = position / _getSizeStorageT();
   bitpos = position % _getSizeStorageT();
@@ -12,12 +12,12 @@ MemStorageT& Bitvector::_getStorageReference(unsigned int position, unsigned int
   return _storage[storagepos];
 }
 
-Bitvector::Bitvector(unsigned int size) : _size(size), _storageSize(_calcStorageSize(size)), _storage(new MemStorageT[_storageSize]) {
+Bitvector::Bitvector(unsigned int size) : _size(size), _storageSize(_calcStorageSize(size)), _storage(_storageSize) {
   // initialize all array elements with zeros
   for (unsigned int i = 0; i < _storageSize; _storage[i++] = 0);
 }
 
-Bitvector::Bitvector(const Bitvector& other) : _size(other.getSize()), _storageSize(other.getStorageSize()), _storage(new MemStorageT[_storageSize]) {
+Bitvector::Bitvector(const Bitvector& other) : _size(other.getSize()), _storageSize(other.getStorageSize()), _storage(_storageSize) {
   // copy all Storage elements
   for (unsigned int i = 0; i < _storageSize; ++i) {
     _storage[i] = other.getStorage(i);
@@ -30,7 +30,7 @@ Bitvector& Bitvector::operator=(const Bitvector& other) {
   if (_storageSize != other.getStorageSize()) {
     // create new storage array for this instance
     _storageSize = other.getStorageSize();
-    _storage.reset(new MemStorageT[_storageSize]);
+    _storage.reset(_storageSize);
   }
   _size = other.getSize();
 
@@ -76,13 +76,13 @@ StorageT Bitvector::getStorage(unsigned int position) const {
 
 void Bitvector::setBit(unsigned int position) {
   unsigned int bitpos;
-  MemStorageT& value = _getStorageReference(position, bitpos);
+  MemStorageT::Element value = _getStorageReference(position, bitpos);
   value |= (StorageT)1 << bitpos;
 }
 
 bool Bitvector::getBit(unsigned int position) {
   unsigned int bitpos;
-  MemStorageT& value = _getStorageReference(position, bitpos);
+  MemStorageT::Element value = _getStorageReference(position, bitpos);
   return (value & ((StorageT)1 << bitpos)) > 0;
 }
 
@@ -1,5 +1,6 @@
 #include <algorithms/common/Converter10tpl.hpp>
 #include <cstdint>
+#include <new>
 
 template <>
 void Converter10tpl::convertRuleAtom<uint32_t>(Generic::RuleAtom* varAtom, std::unique_ptr<Data10tpl::RuleAtom<uint32_t>>& specAtom) {
@@ -214,3 +215,50 @@ void Converter10tpl::convertHeader(const Generic::PacketHeaderLine& line, Data10
   tuple.v10 = (uint32_t)line[9]->value.get_ui();
 }
 
+void Converter10tpl::convertHeaders(const Generic::PacketHeaderSet& data, Data10tpl::HeaderTuple* tuples) {
+  for (Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr, ++tuples) {
+    new (tuples) Data10tpl::HeaderTuple(0, 0, 0, 0, 0, 0, 0, 0, 0, 0); // construct in place
+    convertHeader(**lineItr, *tuples);
+  }
+}
+
+void Converter10tpl::convertHeaders(const Generic::PacketHeaderColumns& data, Data10tpl::HeaderTuple* tuples) {
+  if (data.fields() < 10) 
+    throw "Header data has insufficent amount of fields (required are 10).";
+
+  for (size_t hdr = 0; hdr < data.size(); ++hdr, ++tuples) {
+    uint64_t v1 = data.get(hdr, 0);
+    uint64_t v2 = data.get(hdr, 1);
+    uint64_t v3 = data.get(hdr, 2);
+    uint64_t v4 = data.get(hdr, 3);
+    uint64_t v5 = data.get(hdr, 4);
+    uint64_t v6 = data.get(hdr, 5);
+    uint64_t v7 = data.get(hdr, 6);
+    uint64_t v8 = data.get(hdr, 7);
+    uint64_t v9 = data.get(hdr, 8);
+    uint64_t v10 = data.get(hdr, 9);
+    if (v1 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v1 exceeds expected size.";
+    if (v2 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v2 exceeds expected size.";
+    if (v3 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v3 exceeds expected size.";
+    if (v4 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v4 exceeds expected size.";
+    if (v5 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v5 exceeds expected size.";
+    if (v6 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v6 exceeds expected size.";
+    if (v7 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v7 exceeds expected size.";
+    if (v8 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v8 exceeds expected size.";
+    if (v9 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v9 exceeds expected size.";
+    if (v10 > UINT32_MAX) 
+      throw "Converter10tpl: Conversion of header failed: v10 exceeds expected size.";
+
+    new (tuples) Data10tpl::HeaderTuple((uint32_t)v1, (uint32_t)v2, (uint32_t)v3, (uint32_t)v4, (uint32_t)v5, (uint32_t)v6, (uint32_t)v7, (uint32_t)v8, (uint32_t)v9, (uint32_t)v10); // construct in place
+  }
+}
+
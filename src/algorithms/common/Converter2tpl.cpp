@@ -1,5 +1,6 @@
 #include <algorithms/common/Converter2tpl.hpp>
 #include <cstdint>
+#include <new>
 
 template <>
 void Converter2tpl::convertRuleAtom<uint32_t>(Generic::RuleAtom* varAtom, std::unique_ptr<Data2tpl::RuleAtom<uint32_t>>& specAtom) {
@@ -157,3 +158,27 @@ void Converter2tpl::convertHeader(const Generic::PacketHeaderLine& line, Data2tp
   tuple.addrSrc = (uint32_t)line[0]->value.get_ui();
   tuple.addrDest = (uint32_t)line[1]->value.get_ui();
 }
+
+void Converter2tpl::convertHeaders(const Generic::PacketHeaderSet& data, Data2tpl::HeaderTuple* tuples) {
+  for (Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr, ++tuples) {
+    new (tuples) Data2tpl::HeaderTuple(0, 0); // construct in place
+    convertHeader(**lineItr, *tuples);
+  }
+}
+
+void Converter2tpl::convertHeaders(const Generic::PacketHeaderColumns& data, Data2tpl::HeaderTuple* tuples) {
+  if (data.fields() < 2) 
+    throw "Header data has insufficent amount of fields (required are 2).";
+
+  for (size_t hdr = 0; hdr < data.size(); ++hdr, ++tuples) {
+    uint64_t addrSrc = data.get(hdr, 0);
+    uint64_t addrDest = data.get(hdr, 1);
+    if (addrSrc > UINT32_MAX) 
+      throw "Converter2tpl: Conversion of header failed: ip src exceeds expected size.";
+    if (addrDest > UINT32_MAX) 
+      throw "Converter2tpl: Conversion of header failed: ip dst exceeds expected size.";
+
+    new (tuples) Data2tpl::HeaderTuple((uint32_t)addrSrc, (uint32_t)addrDest); // construct in place
+  }
+}
+
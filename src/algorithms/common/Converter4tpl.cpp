@@ -1,5 +1,6 @@
 #include <algorithms/common/Converter4tpl.hpp>
 #include <cstdint>
+#include <new>
 
 template <>
 void Converter4tpl::convertRuleAtom<uint32_t>(Generic::RuleAtom* varAtom, std::unique_ptr<Data4tpl::RuleAtom<uint32_t>>& specAtom) {
@@ -171,3 +172,33 @@ void Converter4tpl::convertHeader(const Generic::PacketHeaderLine& line, Data4tp
   tuple.v3 = (uint32_t)line[2]->value.get_ui();
   tuple.v4 = (uint32_t)line[3]->value.get_ui();
 }
+
+void Converter4tpl::convertHeaders(const Generic::PacketHeaderSet& data, Data4tpl::HeaderTuple* tuples) {
+  for (Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr, ++tuples) {
+    new (tuples) Data4tpl::HeaderTuple(0, 0, 0, 0); // construct in place
+    convertHeader(**lineItr, *tuples);
+  }
+}
+
+void Converter4tpl::convertHeaders(const Generic::PacketHeaderColumns& data, Data4tpl::HeaderTuple* tuples) {
+  if (data.fields() < 4) 
+    throw "Header data has insufficent amount of fields (required are 4).";
+
+  for (size_t hdr = 0; hdr < data.size(); ++hdr, ++tuples) {
+    uint64_t v1 = data.get(hdr, 0);
+    uint64_t v2 = data.get(hdr, 1);
+    uint64_t v3 = data.get(hdr, 2);
+    uint64_t v4 = data.get(hdr, 3);
+    if (v1 > UINT32_MAX) 
+      throw "Converter4tpl: Conversion of header failed: val 1 exceeds expected size.";
+    if (v2 > UINT32_MAX) 
+      throw "Converter4tpl: Conversion of header failed: val 2 exceeds expected size.";
+    if (v3 > UINT32_MAX) 
+      throw "Converter4tpl: Conversion of header failed: val 3 exceeds expected size.";
+    if (v4 > UINT32_MAX) 
+      throw "Converter4tpl: Conversion of header failed: val 4 exceeds expected size.";
+
+    new (tuples) Data4tpl::HeaderTuple((uint32_t)v1, (uint32_t)v2, (uint32_t)v3, (uint32_t)v4); // construct in place
+  }
+}
+
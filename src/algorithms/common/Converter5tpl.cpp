@@ -1,5 +1,6 @@
 #include <algorithms/common/Converter5tpl.hpp>
 #include <cstdint>
+#include <new>
 
 template <>
 void Converter5tpl::convertRuleAtom<uint32_t>(Generic::RuleAtom* varAtom, std::unique_ptr<Data5tpl::RuleAtom<uint32_t>>& specAtom) {
@@ -169,7 +170,7 @@ void Converter5tpl::convertHeader(const Generic::PacketHeaderLine& line, Data5tp
     throw "Converter5tpl: Conversion of header failed: port src exceeds expected size.";
   if (!line[3]->value.fits_ushort_p()) 
     throw "Converter5tpl: Conversion of header failed: port dst exceeds expected size.";
-  if (!line[4]->value.fits_ushort_p()) 
+  if (!line[4]->value.fits_ushort_p() || line[4]->value.get_ui() > UINT8_MAX) 
     throw "Converter5tpl: Conversion of header failed: protocol exceeds expected size.";
 
   tuple.addrSrc = (uint32_t)line[0]->value.get_ui();
@@ -178,3 +179,36 @@ void Converter5tpl::convertHeader(const Generic::PacketHeaderLine& line, Data5tp
   tuple.portDest = (uint16_t)line[3]->value.get_ui();
   tuple.protocol = (uint8_t)line[4]->value.get_ui();
 }
+
+void Converter5tpl::convertHeaders(const Generic::PacketHeaderSet& data, Data5tpl::HeaderTuple* tuples) {
+  for (Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr, ++tuples) {
+    new (tuples) Data5tpl::HeaderTuple(0, 0, 0, 0, 0); // construct in place
+    convertHeader(**lineItr, *tuples);
+  }
+}
+
+void Converter5tpl::convertHeaders(const Generic::PacketHeaderColumns& data, Data5tpl::HeaderTuple* tuples) {
+  if (data.fields() < 5) 
+    throw "Header data has insufficent amount of fields (required are 5).";
+
+  for (size_t hdr = 0; hdr < data.size(); ++hdr, ++tuples) {
+    uint64_t addrSrc = data.get(hdr, 0);
+    uint64_t addrDest = data.get(hdr, 1);
+    uint64_t portSrc = data.get(hdr, 2);
+    uint64_t portDest = data.get(hdr, 3);
+    uint64_t protocol = data.get(hdr, 4);
+    if (addrSrc > UINT32_MAX) 
+      throw "Converter5tpl: Conversion of header failed: ip src exceeds expected size.";
+    if (addrDest > UINT32_MAX) 
+      throw "Converter5tpl: Conversion of header failed: ip dst exceeds expected size.";
+    if (portSrc > UINT16_MAX) 
+      throw "Converter5tpl: Conversion of header failed: port src exceeds expected size.";
+    if (portDest > UINT16_MAX) 
+      throw "Converter5tpl: Conversion of header failed: port dst exceeds expected size.";
+    if (protocol > UINT8_MAX) 
+      throw "Converter5tpl: Conversion of header failed: protocol exceeds expected size.";
+
+    new (tuples) Data5tpl::HeaderTuple((uint32_t)addrSrc, (uint32_t)addrDest, (uint16_t)portSrc, (uint16_t)portDest, (uint8_t)protocol); // construct in place
+  }
+}
+
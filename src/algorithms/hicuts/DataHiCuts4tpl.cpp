@@ -255,6 +255,64 @@ bool TrieNode::search(const Data4tpl::HeaderTuple& header, unsigned int& index)
   }
 }
 
+void TrieNode::save(Generic::SnapshotWriter& image) const {
+  image.write<uint32_t>(_cutDimension);
+  image.write<uint32_t>(_cutPieceSize);
+  image.write<uint32_t>(_boxDim1.min);
+  image.write<uint32_t>(_boxDim1.max);
+  image.write<uint32_t>(_boxDim2.min);
+  image.write<uint32_t>(_boxDim2.max);
+  image.write<uint32_t>(_boxDim3.min);
+  image.write<uint32_t>(_boxDim3.max);
+  image.write<uint32_t>(_boxDim4.min);
+  image.write<uint32_t>(_boxDim4.max);
+
+  // rules are shared between nodes, so only their index is stored
+  image.write<uint32_t>(_rules.size());
+  for (RulesVector::const_iterator itr(_rules.cbegin()); itr != _rules.cend(); ++itr)
+    image.write<uint32_t>((*itr)->index);
+
+  image.write<uint32_t>(_children.size());
+  for (TrieNodesVector::const_iterator itr(_children.cbegin()); itr != _children.cend(); ++itr) {
+    image.write<uint8_t>(*itr ? 1 : 0); // empty children were freed
+    if (*itr) (*itr)->save(image);
+  }
+}
+
+TrieNodePtr TrieNode::load(Generic::SnapshotReader& image, const RulesVector& rules) {
+  unsigned int cutDimension = image.read<uint32_t>();
+  unsigned int cutPieceSize = image.read<uint32_t>();
+  uint32_t box1min = image.read<uint32_t>();
+  uint32_t box1max = image.read<uint32_t>();
+  uint32_t box2min = image.read<uint32_t>();
+  uint32_t box2max = image.read<uint32_t>();
+  uint32_t box3min = image.read<uint32_t>();
+  uint32_t box3max = image.read<uint32_t>();
+  uint32_t box4min = image.read<uint32_t>();
+  uint32_t box4max = image.read<uint32_t>();
+
+  TrieNodePtr node(new TrieNode(box1min, box1max, box2min, box2max, box3min, box3max, box4min, box4max));
+  node->_cutDimension = cutDimension;
+  node->_cutPieceSize = cutPieceSize;
+
+  uint32_t ruleCount = image.read<uint32_t>();
+  for (uint32_t r = 0; r < ruleCount; ++r) {
+    uint32_t index = image.read<uint32_t>();
+    if (index >= rules.size()) throw "Error in DataHiCuts4tpl: Rule index of snapshot is outside of the rule set!";
+    node->_rules.push_back(rules[index]);
+  }
+
+  uint32_t childCount = image.read<uint32_t>();
+  for (uint32_t c = 0; c < childCount; ++c) {
+    if (image.read<uint8_t>() != 0)
+      node->_children.push_back(load(image, rules));
+    else
+      node->_children.push_back(TrieNodePtr());
+  }
+
+  return node;
+}
+
 namespace DataHiCuts4tpl {
 void countDisjunctPairs(const RulesVector& rules, std::vector<unsigned int>& results) {
   // contain disjunct pair counters per dimension (results)
@@ -302,3 +360,14 @@ bool Trie::search(const Data4tpl::HeaderTuple& header, unsigned int& index) cons
     return false; // no trie was constructed before
 }
 
+void Trie::save(Generic::SnapshotWriter& image) const {
+  image.write<uint8_t>(_root ? 1 : 0);
+  if (_root) _root->save(image);
+}
+
+void Trie::load(Generic::SnapshotReader& image, const RulesVector& rules) {
+  _params.totalRules = rules.size();
+  _root.reset();
+  if (image.read<uint8_t>() != 0)
+    _root = TrieNode::load(image, rules);
+}
@@ -63,36 +63,90 @@ void HiCuts10tpl::setRules(const Generic::RuleSet& ruleset) {
   _mmanager->checkpoint(0);
 }
 
+void HiCuts10tpl::saveSnapshot(std::vector<uint8_t>& image) const {
+  Generic::SnapshotWriter writer(image);
+  _searchTrie.save(writer);
+}
+
+void HiCuts10tpl::loadSnapshot(const Generic::RuleSet& ruleset, const uint8_t* image, size_t size) {
+  using namespace DataHiCuts10tpl;
+
+  // convert rules (kept for rule updates)
+  _chronomgr->start("convert classifier");
+	for (unsigned int ruleItr = 0; ruleItr < ruleset.size(); ++ruleItr) {
+    convertRule(*(ruleset[ruleItr].get()), ruleItr, _rules.end());
+  }
+
+  _searchTrie.setParameters(_binth, _spfac);
+
+  // restore trie instead of constructing it
+  _chronomgr->start("load trie");
+  Generic::SnapshotReader reader(image, size);
+  _searchTrie.load(reader, _rules);
+  _chronomgr->stop("load trie");
+
+  _chronomgr->stop("convert classifier");
+  if (!reader.atEnd()) throw "HiCuts10tpl: Snapshot of the trie contains unexpected data.";
+
+  // set memory-checkpoint
+  _mmanager->checkpoint(0);
+}
+
 void HiCuts10tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data10tpl::HeaderTuple> tuples(data.size(), Data10tpl::HeaderTuple(0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter10tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void HiCuts10tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void HiCuts10tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void HiCuts10tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataHiCuts10tpl;
 
 	unsigned int matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data10tpl::HeaderTuple tpl(0, 0, 0, 0, 0, 0, 0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data10tpl::HeaderTuple* headerTuples = static_cast<const Data10tpl::HeaderTuple*>(tuples);
   bool foundMatch = false;
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter10tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data10tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
     foundMatch = _searchTrie.search(tpl, matchIndex);
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
     if (foundMatch)
-      indices.push_back(matchIndex);
+      out[hdrIdx] = matchIndex;
     else
-      indices.push_back(Generic::noRuleIsMatching());
+      out[hdrIdx] = Generic::noRuleIsMatchingNative();
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void HiCuts10tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -64,36 +64,90 @@ void HiCuts4tpl::setRules(const Generic::RuleSet& ruleset) {
   _mmanager->checkpoint(0);
 }
 
+void HiCuts4tpl::saveSnapshot(std::vector<uint8_t>& image) const {
+  Generic::SnapshotWriter writer(image);
+  _searchTrie.save(writer);
+}
+
+void HiCuts4tpl::loadSnapshot(const Generic::RuleSet& ruleset, const uint8_t* image, size_t size) {
+  using namespace DataHiCuts4tpl;
+
+  // convert rules (kept for rule updates)
+  _chronomgr->start("convert classifier");
+	for (unsigned int ruleItr = 0; ruleItr < ruleset.size(); ++ruleItr) {
+    convertRule(*(ruleset[ruleItr].get()), ruleItr, _rules.end());
+  }
+
+  _searchTrie.setParameters(_binth, _spfac);
+
+  // restore trie instead of constructing it
+  _chronomgr->start("load trie");
+  Generic::SnapshotReader reader(image, size);
+  _searchTrie.load(reader, _rules);
+  _chronomgr->stop("load trie");
+
+  _chronomgr->stop("convert classifier");
+  if (!reader.atEnd()) throw "HiCuts4tpl: Snapshot of the trie contains unexpected data.";
+
+  // set memory-checkpoint
+  _mmanager->checkpoint(0);
+}
+
 void HiCuts4tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data4tpl::HeaderTuple> tuples(data.size(), Data4tpl::HeaderTuple(0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter4tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void HiCuts4tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void HiCuts4tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void HiCuts4tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
   using namespace DataHiCuts4tpl;
 
 	unsigned int matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data4tpl::HeaderTuple tpl(0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  const Data4tpl::HeaderTuple* headerTuples = static_cast<const Data4tpl::HeaderTuple*>(tuples);
   bool foundMatch = false;
 
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.cbegin()); lineItr != data.cend(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter4tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data4tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
     foundMatch = _searchTrie.search(tpl, matchIndex);
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
     if (foundMatch)
-      indices.push_back(matchIndex);
+      out[hdrIdx] = matchIndex;
     else
-      indices.push_back(Generic::noRuleIsMatching());
+      out[hdrIdx] = Generic::noRuleIsMatchingNative();
 
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void HiCuts4tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
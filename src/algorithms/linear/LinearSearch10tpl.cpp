@@ -27,30 +27,55 @@ void LinearSearch10tpl::setRules(const Generic::RuleSet& ruleset) {
 }
 
 void LinearSearch10tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data10tpl::HeaderTuple> tuples(data.size(), Data10tpl::HeaderTuple(0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter10tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void LinearSearch10tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void LinearSearch10tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter10tpl::convertHeaders(data, static_cast<Data10tpl::HeaderTuple*>(tuples));
+}
+
+void LinearSearch10tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
 	bool ruleMatched;
 	uint32_t matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data10tpl::HeaderTuple tpl(0, 0, 0, 0, 0, 0, 0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.begin()); lineItr != data.end(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter10tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+  const Data10tpl::HeaderTuple* headerTuples = static_cast<const Data10tpl::HeaderTuple*>(tuples);
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data10tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 	  ruleMatched = _rules->match(tpl, matchIndex);
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    if (ruleMatched) indices.push_back(matchIndex);
-    else indices.push_back(Generic::noRuleIsMatching());
+    if (ruleMatched) out[hdrIdx] = matchIndex;
+    else out[hdrIdx] = Generic::noRuleIsMatchingNative();
     
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void LinearSearch10tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
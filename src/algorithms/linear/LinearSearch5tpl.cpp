@@ -27,30 +27,55 @@ void LinearSearch5tpl::setRules(const Generic::RuleSet& ruleset) {
 }
 
 void LinearSearch5tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data5tpl::HeaderTuple> tuples(data.size(), Data5tpl::HeaderTuple(0, 0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter5tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void LinearSearch5tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter5tpl::convertHeaders(data, static_cast<Data5tpl::HeaderTuple*>(tuples));
+}
+
+void LinearSearch5tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter5tpl::convertHeaders(data, static_cast<Data5tpl::HeaderTuple*>(tuples));
+}
+
+void LinearSearch5tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
 	bool ruleMatched;
 	uint32_t matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data5tpl::HeaderTuple tpl(0, 0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.begin()); lineItr != data.end(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter5tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+  const Data5tpl::HeaderTuple* headerTuples = static_cast<const Data5tpl::HeaderTuple*>(tuples);
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data5tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
 	  ruleMatched = _rules->match(tpl, matchIndex);
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    if (ruleMatched) indices.push_back(matchIndex);
-    else indices.push_back(Generic::noRuleIsMatching());
+    if (ruleMatched) out[hdrIdx] = matchIndex;
+    else out[hdrIdx] = Generic::noRuleIsMatchingNative();
     
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void LinearSearch5tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -104,22 +104,45 @@ void TupleSpace2tpl::setRules(const Generic::RuleSet& ruleset) {
 }
 
 void TupleSpace2tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data2tpl::HeaderTuple> tuples(data.size(), Data2tpl::HeaderTuple(0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter2tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void TupleSpace2tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter2tpl::convertHeaders(data, static_cast<Data2tpl::HeaderTuple*>(tuples));
+}
+
+void TupleSpace2tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter2tpl::convertHeaders(data, static_cast<Data2tpl::HeaderTuple*>(tuples));
+}
+
+void TupleSpace2tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
 	unsigned long int matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data2tpl::HeaderTuple tpl(0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.begin()); lineItr != data.end(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter2tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+  const Data2tpl::HeaderTuple* headerTuples = static_cast<const Data2tpl::HeaderTuple*>(tuples);
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data2tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
     matchIndex = Generic::noRuleIsMatching();
-    unsigned long int currIndex = matchIndex;;
+    unsigned long int currIndex = matchIndex;
 
-    //_chronomgr->start("classify(hash)");
 	  for(auto itrMap(_maps.begin()); itrMap != _maps.end(); ++itrMap) {
       if (matchIndex > (*itrMap)->getMinIndex()) { // naive tuple pruning
         currIndex = (*itrMap)->lookup(tpl);
@@ -127,12 +150,10 @@ void TupleSpace2tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rul
         if (currIndex < matchIndex) matchIndex = currIndex;
       }
     }
-    //_chronomgr->stop("classify(hash)");
      
     // search also in list of "expanded rules"
     if (matchIndex > _expandMinIdx) {
 
-      //_chronomgr->start("classify(lin)");
       for (auto it = _expandRules.begin(); it != _expandRules.end(); ++it) {
         if (std::get<1>(*it)->match(tpl)) {
           currIndex = std::get<0>(*it); 
@@ -142,18 +163,18 @@ void TupleSpace2tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rul
           break;
         }
       }
-      //_chronomgr->stop("classify(lin)");
     }
 
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = (matchIndex < Generic::noRuleIsMatchingNative() ? (uint32_t)matchIndex : Generic::noRuleIsMatchingNative());
     
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void TupleSpace2tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -116,20 +116,44 @@ void TupleSpace4tpl::setRules(const Generic::RuleSet& ruleset) {
 }
 
 void TupleSpace4tpl::classify(const Generic::PacketHeaderSet& data, Generic::RuleIndexSet& indices) {
+  checkMemMgr(); // assert that MemManager instance is referenced
+
+  // convert all headers and match them natively
+  std::vector<Data4tpl::HeaderTuple> tuples(data.size(), Data4tpl::HeaderTuple(0, 0, 0, 0));
+  for (size_t hdrIdx = 0; hdrIdx < data.size(); ++hdrIdx) {
+    _chronomgr->start(_chronoConvertHeader);
+    Converter4tpl::convertHeader(*data[hdrIdx], tuples[hdrIdx]);
+    _chronomgr->stop(_chronoConvertHeader);
+  }
+
+  std::vector<uint32_t> matches(data.size());
+  classifyNative(tuples.data(), tuples.size(), matches.data());
+
+	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
+  for (auto itr = matches.begin(); itr != matches.end(); ++itr)
+    indices.push_back(*itr == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *itr);
+}
+
+void TupleSpace4tpl::convertHeaders(const Generic::PacketHeaderSet& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void TupleSpace4tpl::convertHeaders(const Generic::PacketHeaderColumns& data, void* tuples) {
+  Converter4tpl::convertHeaders(data, static_cast<Data4tpl::HeaderTuple*>(tuples));
+}
+
+void TupleSpace4tpl::classifyNative(const void* tuples, size_t count, uint32_t* out) {
 	unsigned long int matchIndex;
  
   checkMemMgr(); // assert that MemManager instance is referenced
   
-  Data4tpl::HeaderTuple tpl(0, 0, 0, 0); // for conversion
-	if (!indices.empty()) indices.clear(); // if caller forgot to empty set
-	for(Generic::PacketHeaderSet::const_iterator lineItr(data.begin()); lineItr != data.end(); ++lineItr) {
-    _chronomgr->start("convert header");
-    Converter4tpl::convertHeader(**lineItr, tpl); 
-    _chronomgr->stop("convert header");
+  const Data4tpl::HeaderTuple* headerTuples = static_cast<const Data4tpl::HeaderTuple*>(tuples);
+	for (size_t hdrIdx = 0; hdrIdx < count; ++hdrIdx) {
+    const Data4tpl::HeaderTuple& tpl = headerTuples[hdrIdx]; // already converted
 
-    _chronomgr->start("classify");
+    _chronomgr->start(_chronoClassify);
     matchIndex = Generic::noRuleIsMatching();
-    unsigned long int currIndex = matchIndex;;
+    unsigned long int currIndex = matchIndex;
 
 	  for(auto itrMap(_maps.begin()); itrMap != _maps.end(); ++itrMap) {
       if (matchIndex > (*itrMap)->getMinIndex()) { // naive tuple pruning
@@ -153,15 +177,16 @@ void TupleSpace4tpl::classify(const Generic::PacketHeaderSet& data, Generic::Rul
       }
     }
 
-    _chronomgr->stop("classify");
+    _chronomgr->stop(_chronoClassify);
 
-    indices.push_back(matchIndex);
+    out[hdrIdx] = (matchIndex < Generic::noRuleIsMatchingNative() ? (uint32_t)matchIndex : Generic::noRuleIsMatchingNative());
     
     headerProcessed(); // set recurrent checkpoints
 	}
 }
 
 void TupleSpace4tpl::headerProcessed() {
+  if (_mmanager->isSuspended()) return; // concurrent classification, don't count
   ++_cntHeadersAfterCheckpoint;
 
   if (_cntHeadersAfterCheckpoint >= _settingHeadersPerCheckpoint) {
@@ -0,0 +1,265 @@
+#include <configuration/ClassBenchLoader.hpp>
+#include <generics/RuleAtom.hpp>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Generic;
+
+/** width in bits of source address, destination address, source port, destination port and protocol */
+static const unsigned int PACKET_BITS[] = {32, 32, 16, 16, 8};
+/** number of packet fields of a filter */
+static const size_t PACKET_FIELDS = sizeof(PACKET_BITS) / sizeof(PACKET_BITS[0]);
+/** smaller files are parsed by a single thread */
+static const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+static inline uint64_t bitMask(unsigned int bits) {
+  return bits >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << bits) - 1;
+}
+
+/** Returns the mask of a prefix atom, which also covers the header field bits above the packet field. */
+static inline uint64_t prefixMask(uint64_t packetMask, unsigned int packetBits, unsigned int width) {
+  return (bitMask(width) & ~bitMask(packetBits)) | packetMask;
+}
+
+static inline void skipBlanks(const char*& pos, const char* end) {
+  while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) ++pos;
+}
+
+/** Parses a decimal number up to max, false is returned for an invalid number. */
+static inline bool parseDecimal(const char*& pos, const char* end, uint64_t max, uint64_t& val) {
+  const char* begin = pos;
+  val = 0;
+  while (pos < end && *pos >= '0' && *pos <= '9') {
+    val = val * 10 + (*pos - '0');
+    if (val > max) return false;
+    ++pos;
+  }
+  return pos != begin;
+}
+
+/** Parses a hexadecimal number with a leading '0x' up to max. */
+static inline bool parseHex(const char*& pos, const char* end, uint64_t max, uint64_t& val) {
+  if (end - pos < 3 || pos[0] != '0' || (pos[1] != 'x' && pos[1] != 'X')) return false;
+  pos += 2;
+
+  const char* begin = pos;
+  val = 0;
+  for (; pos < end; ++pos) {
+    unsigned int digit;
+    if (*pos >= '0' && *pos <= '9') digit = *pos - '0';
+    else if (*pos >= 'a' && *pos <= 'f') digit = *pos - 'a' + 10;
+    else if (*pos >= 'A' && *pos <= 'F') digit = *pos - 'A' + 10;
+    else break;
+    val = (val << 4) | digit;
+    if (val > max) return false;
+  }
+  return pos != begin;
+}
+
+static inline bool expect(const char*& pos, const char* end, char c) {
+  if (pos >= end || *pos != c) return false;
+  ++pos;
+  return true;
+}
+
+/** Parses an address with prefix length (like 10.0.0.0/8) into an atom. */
+static bool parseAddress(const char*& pos, const char* end, unsigned int width, Rule& rule) {
+  uint64_t addr = 0, byte, length;
+  for (int i = 0; i < 4; ++i) {
+    if ((i > 0 && !expect(pos, end, '.')) || !parseDecimal(pos, end, 255, byte)) return false;
+    addr = (addr << 8) | byte;
+  }
+  if (!expect(pos, end, '/') || !parseDecimal(pos, end, 32, length)) return false;
+
+  if (length == 32)
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact(VarValue((unsigned long long)addr), width)));
+  else {
+    uint64_t mask = prefixMask(bitMask(32) & ~bitMask(32 - length), 32, width);
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomPrefix(VarValue((unsigned long long)addr), VarValue((unsigned long long)mask), width)));
+  }
+  return true;
+}
+
+/** Parses a port range (like 1024 : 65535) into an atom. */
+static bool parsePorts(const char*& pos, const char* end, unsigned int width, Rule& rule) {
+  uint64_t low, high;
+  if (!parseDecimal(pos, end, 65535, low)) return false;
+  skipBlanks(pos, end);
+  if (!expect(pos, end, ':')) return false;
+  skipBlanks(pos, end);
+  if (!parseDecimal(pos, end, 65535, high) || low > high) return false;
+
+  if (low == high)
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact(VarValue((unsigned long long)low), width)));
+  else
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomRange(VarValue((unsigned long long)low), VarValue((unsigned long long)high), width)));
+  return true;
+}
+
+/** Parses a protocol with mask (like 0x06/0xFF) into an atom. */
+static bool parseProtocol(const char*& pos, const char* end, unsigned int width, Rule& rule) {
+  uint64_t protocol, mask;
+  if (!parseHex(pos, end, 255, protocol) || !expect(pos, end, '/') || !parseHex(pos, end, 255, mask)) return false;
+
+  if (mask == 0xFF)
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact(VarValue((unsigned long long)protocol), width)));
+  else // a masked protocol (0x00/0x00 is a wildcard)
+    rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomPrefix(VarValue((unsigned long long)(protocol & mask)), VarValue((unsigned long long)prefixMask(mask, 8, width)), width)));
+  return true;
+}
+
+void ClassBenchLoader::_parseChunk(const char* begin, const char* end, const std::vector<unsigned int>& structure, RuleSet& rules, std::exception_ptr& error, const char*& errorPosition) {
+  try {
+    const char* pos = begin;
+    while (pos < end) {
+      const char* lineEnd = std::find(pos, end, '\n');
+      skipBlanks(pos, lineEnd);
+
+      if (pos < lineEnd) { // empty lines are skipped
+        const char* line = pos;
+        std::unique_ptr<Rule> rule(new Rule);
+        rule->reserve(structure.size());
+
+        // all fields are checked, but only the fields of the structure become atoms
+        Rule ignored;
+        bool valid = expect(pos, lineEnd, '@');
+        for (size_t field = 0; valid && field < PACKET_FIELDS; ++field) {
+          bool used = field < structure.size();
+          unsigned int width = used ? structure[field] : PACKET_BITS[field];
+          Rule& target = used ? *rule : ignored;
+
+          skipBlanks(pos, lineEnd);
+          if (field < 2) valid = parseAddress(pos, lineEnd, width, target);
+          else if (field < 4) valid = parsePorts(pos, lineEnd, width, target);
+          else valid = parseProtocol(pos, lineEnd, width, target);
+        }
+        // further columns (e.g. the flags) are ignored
+        if (valid && pos < lineEnd && *pos != ' ' && *pos != '\t' && *pos != '\r') valid = false;
+
+        if (!valid) {
+          error = std::make_exception_ptr("Invalid filter in ClassBench file (ClassBenchLoader::load).");
+          errorPosition = line;
+          return;
+        }
+        rules.push_back(std::move(rule));
+      }
+      pos = lineEnd + 1;
+    }
+  } catch (...) { // e.g. std::bad_alloc
+    error = std::current_exception();
+    errorPosition = nullptr;
+  }
+}
+
+void ClassBenchLoader::_checkStructure(const std::vector<unsigned int>& structure) {
+  if (structure.size() != 2 && structure.size() != 4 && structure.size() != PACKET_FIELDS)
+    throw "ClassBench filters need a structure with 2, 4 or 5 fields (ClassBenchLoader).";
+  for (size_t field = 0; field < structure.size(); ++field) {
+    if (structure[field] < PACKET_BITS[field] || structure[field] > 64)
+      throw "Field of the structure doesn't fit a ClassBench filter field (ClassBenchLoader).";
+  }
+}
+
+size_t ClassBenchLoader::count(const std::string& filename, const std::vector<unsigned int>& structure) {
+  _checkStructure(structure);
+
+  FILE* file = fopen(filename.c_str(), "r");
+  if (!file) throw "Failed to open the ClassBench file (ClassBenchLoader::count).";
+
+  // each filter starts with '@' as first non-blank character of a line
+  size_t filters = 0;
+  bool lineStart = true;
+  for (int c = fgetc(file); c != EOF; c = fgetc(file)) {
+    if (c == '\n') lineStart = true;
+    else if (lineStart && c == '@') {
+      ++filters;
+      lineStart = false;
+    } else if (c != ' ' && c != '\t' && c != '\r') lineStart = false;
+  }
+  fclose(file);
+  return filters;
+}
+
+size_t ClassBenchLoader::load(const std::string& filename, const std::vector<unsigned int>& structure, RuleSet& rules, unsigned int threads) {
+  _checkStructure(structure);
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw "Failed to open the ClassBench file (ClassBenchLoader::load).";
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw "Failed to read the size of the ClassBench file (ClassBenchLoader::load).";
+  }
+  size_t size = info.st_size;
+  if (size == 0) {
+    close(fd);
+    return 0;
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) throw "Failed to map the ClassBench file (ClassBenchLoader::load).";
+  madvise(mapping, size, MADV_SEQUENTIAL);
+  const char* data = (const char*)mapping;
+  const char* end = data + size;
+
+  // split into chunks of whole lines, so each thread appends complete rules
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = (unsigned int)std::min<size_t>(threads, size / MIN_CHUNK_SIZE + 1);
+  std::vector<const char*> bounds(1, data);
+  for (unsigned int chunk = 1; chunk < threads; ++chunk) {
+    const char* bound = std::max(bounds.back(), data + size / threads * chunk);
+    bound = std::find(bound, end, '\n');
+    if (bound < end) ++bound;
+    bounds.push_back(bound);
+  }
+  bounds.push_back(end);
+
+  size_t chunks = bounds.size() - 1;
+  std::vector<RuleSet> parsed(chunks);
+  std::vector<std::exception_ptr> errors(chunks);
+  std::vector<const char*> positions(chunks, nullptr);
+  std::vector<std::thread> pool;
+  for (size_t chunk = 1; chunk < chunks; ++chunk) {
+    try {
+      pool.push_back(std::thread(&ClassBenchLoader::_parseChunk, bounds[chunk], bounds[chunk + 1], std::cref(structure), std::ref(parsed[chunk]), std::ref(errors[chunk]), std::ref(positions[chunk])));
+    } catch (...) { // no more threads: the running ones must be joined before leaving
+      for (std::vector<std::thread>::iterator iter(pool.begin()); iter != pool.end(); ++iter)
+        iter->join();
+      munmap(mapping, size);
+      throw;
+    }
+  }
+  _parseChunk(bounds[0], bounds[1], structure, parsed[0], errors[0], positions[0]);
+  for (std::vector<std::thread>::iterator iter(pool.begin()); iter != pool.end(); ++iter)
+    iter->join();
+
+  for (size_t chunk = 0; chunk < chunks; ++chunk) {
+    if (errors[chunk]) {
+      const char* line = positions[chunk];
+      if (line) {
+        std::cerr << "Invalid ClassBench filter in line " << std::count(data, line, '\n') + 1 << " of " << filename << ": "
+          << std::string(line, std::find(line, end, '\n')) << std::endl;
+      }
+      munmap(mapping, size);
+      std::rethrow_exception(errors[chunk]);
+    }
+  }
+  munmap(mapping, size);
+
+  size_t count = 0;
+  for (size_t chunk = 0; chunk < chunks; ++chunk)
+    count += parsed[chunk].size();
+  rules.reserve(rules.size() + count);
+  for (size_t chunk = 0; chunk < chunks; ++chunk)
+    std::move(parsed[chunk].begin(), parsed[chunk].end(), std::back_inserter(rules));
+  return count;
+}
+
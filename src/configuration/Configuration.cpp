@@ -1,5 +1,6 @@
 #include <configuration/Configuration.hpp>
 #include <chrono>
+#include <algorithm>
 
 void Configuration::setBenchmarkIds() {
   using namespace std::chrono;
@@ -15,3 +16,13 @@ void Configuration::setBenchmarkIds() {
   }
 }
 
+
+void Configuration::addSourceFile(const std::string& filename) {
+  if (std::find(_sourceFiles.begin(), _sourceFiles.end(), filename) == _sourceFiles.end())
+    _sourceFiles.push_back(filename);
+}
+
+void Configuration::addDataFile(const std::string& filename) {
+  if (std::find(_dataFiles.begin(), _dataFiles.end(), filename) == _dataFiles.end())
+    _dataFiles.push_back(filename);
+}
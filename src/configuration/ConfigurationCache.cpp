@@ -0,0 +1,601 @@
+#include <configuration/ConfigurationCache.hpp>
+#include <generics/Snapshot.hpp>
+#include <generics/RuleAtom.hpp>
+#include <map>
+#include <vector>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Generic;
+
+/** header at the beginning of each cache file */
+struct ConfigurationFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint64_t size;
+  uint64_t checksum;
+};
+
+/** magic number of a cache file ("CCFG") */
+static const uint32_t CONFIGURATION_MAGIC = 0x47464343;
+/** is increased, if the format of the file or of a benchmark changes */
+static const uint32_t CONFIGURATION_VERSION = 4;
+
+/** how a file, which the configuration depends on, is compared */
+enum DependencyType : uint8_t { CONTENT, STATUS };
+
+/** Computes the hash of the content of a file, false is returned, if it can't be read. */
+static bool contentHash(const std::string& filename, uint64_t& hash) {
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (!file) return false;
+
+  hash = FNV_OFFSET;
+  char buffer[65536];
+  size_t bytes;
+  while ((bytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    hash = fnv1a(hash, buffer, bytes);
+  bool valid = !ferror(file);
+  fclose(file);
+  return valid;
+}
+
+/** Returns size and modification time (in ns) of a file, false is returned, if it doesn't exist. */
+static bool fileStatus(const std::string& filename, uint64_t& size, uint64_t& modified) {
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0) return false;
+  size = st.st_size;
+  modified = (uint64_t)st.st_mtim.tv_sec * 1000000000ULL + st.st_mtim.tv_nsec;
+  return true;
+}
+
+/*** Writing and reading of single values. */
+static void writeString(SnapshotWriter& out, const std::string& str) {
+  out.write<uint64_t>(str.size());
+  out.writeBytes(str.data(), str.size());
+}
+
+static std::string readString(SnapshotReader& in) {
+  std::string str(in.read<uint64_t>(), '\0');
+  if (!str.empty()) in.readBytes(&str[0], str.size());
+  return str;
+}
+
+static void writeValue(SnapshotWriter& out, const VarValue& value) {
+  // wide values are rare, so they are kept as decimal string
+  if (value.fits_ulong_p()) {
+    out.write<uint8_t>(0);
+    out.write<uint64_t>(value.get_ui());
+  } else {
+    out.write<uint8_t>(1);
+    writeString(out, value.get_mpz().get_str(10));
+  }
+}
+
+static VarValue readValue(SnapshotReader& in) {
+  if (in.read<uint8_t>() == 0) return VarValue((unsigned long long)in.read<uint64_t>());
+  return VarValue(readString(in));
+}
+
+template <typename T>
+static void writeVector(SnapshotWriter& out, const std::vector<T>& values) {
+  out.write<uint64_t>(values.size());
+  for (typename std::vector<T>::const_iterator iter(values.cbegin()); iter != values.cend(); ++iter)
+    out.write<T>(*iter);
+}
+
+template <typename T>
+static void readVector(SnapshotReader& in, std::vector<T>& values) {
+  values.resize(in.read<uint64_t>());
+  for (typename std::vector<T>::iterator iter(values.begin()); iter != values.end(); ++iter)
+    *iter = in.read<T>();
+}
+
+/*** Writing and reading of rules, headers and random distributions. */
+static void writeRule(SnapshotWriter& out, const Rule& rule) {
+  out.write<uint64_t>(rule.size());
+  for (Rule::const_iterator iter(rule.cbegin()); iter != rule.cend(); ++iter) {
+    const RuleAtom* atom = iter->get();
+    out.write<uint8_t>(atom->getType());
+    switch (atom->getType()) {
+      case RuleAtom::Type::EXACT: {
+        const RuleAtomExact* exact = static_cast<const RuleAtomExact*>(atom);
+        out.write<uint64_t>(exact->width);
+        writeValue(out, exact->value);
+        break;
+      }
+      case RuleAtom::Type::RANGE: {
+        const RuleAtomRange* range = static_cast<const RuleAtomRange*>(atom);
+        out.write<uint64_t>(range->width);
+        writeValue(out, range->minValue);
+        writeValue(out, range->maxValue);
+        break;
+      }
+      case RuleAtom::Type::PREFIX: {
+        const RuleAtomPrefix* prefix = static_cast<const RuleAtomPrefix*>(atom);
+        out.write<uint64_t>(prefix->width);
+        writeValue(out, prefix->prefix);
+        writeValue(out, prefix->mask);
+        break;
+      }
+    }
+  }
+}
+
+static void readRule(SnapshotReader& in, Rule& rule) {
+  size_t atoms = in.read<uint64_t>();
+  rule.reserve(atoms);
+  for (size_t i = 0; i < atoms; ++i) {
+    uint8_t type = in.read<uint8_t>();
+    size_t width = in.read<uint64_t>();
+    VarValue first(readValue(in));
+    if (type == RuleAtom::Type::EXACT) {
+      rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact(first, width)));
+      continue;
+    }
+    VarValue second(readValue(in));
+    if (type == RuleAtom::Type::RANGE)
+      rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomRange(first, second, width)));
+    else if (type == RuleAtom::Type::PREFIX)
+      rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomPrefix(first, second, width)));
+    else
+      throw "Invalid type of rule atom in cached configuration (ConfigurationCache::load).";
+  }
+}
+
+static void writeRuleSet(SnapshotWriter& out, const SharedRuleSet& rules) {
+  // rules of a ClassBench file are loaded right before the benchmark, like without cache
+  bool classBench = !rules.getClassBenchFile().empty();
+  out.write<uint8_t>(classBench);
+  if (classBench) {
+    writeString(out, rules.getClassBenchFile());
+    writeVector(out, rules.getStructure());
+    out.write<uint64_t>(rules.size());
+    return;
+  }
+
+  const RuleSet& explicitRules = rules.getExplicit();
+  out.write<uint64_t>(explicitRules.size());
+  for (RuleSet::const_iterator iter(explicitRules.cbegin()); iter != explicitRules.cend(); ++iter)
+    writeRule(out, **iter);
+}
+
+static std::shared_ptr<SharedRuleSet> readRuleSet(SnapshotReader& in) {
+  if (in.read<uint8_t>() != 0) {
+    std::string file(readString(in));
+    std::vector<unsigned int> structure;
+    readVector(in, structure);
+    size_t size = in.read<uint64_t>();
+    return std::make_shared<SharedRuleSet>(file, structure, size);
+  }
+
+  std::shared_ptr<SharedRuleSet> rules(std::make_shared<SharedRuleSet>());
+  size_t size = in.read<uint64_t>();
+  rules->edit().reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    std::unique_ptr<Rule> rule(new Rule);
+    readRule(in, *rule);
+    rules->edit().push_back(std::move(rule));
+  }
+  return rules;
+}
+
+static void writeHeaders(SnapshotWriter& out, const PacketHeaderColumns& headers) {
+  std::vector<unsigned int> bits;
+  for (size_t field = 0; field < headers.fields(); ++field)
+    bits.push_back(headers.fieldBits(field));
+  writeVector(out, bits);
+  out.write<uint64_t>(headers.size());
+
+  // column by column like in memory
+  for (size_t field = 0; field < headers.fields(); ++field) {
+    for (size_t header = 0; header < headers.size(); ++header) {
+      if (bits[field] <= 64) out.write<uint64_t>(headers.get(header, field));
+      else writeValue(out, headers.value(header, field));
+    }
+  }
+}
+
+static std::shared_ptr<PacketHeaderColumns> readHeaders(SnapshotReader& in) {
+  std::vector<unsigned int> bits;
+  readVector(in, bits);
+  std::shared_ptr<PacketHeaderColumns> headers(std::make_shared<PacketHeaderColumns>(bits));
+  headers->resize(in.read<uint64_t>());
+
+  for (size_t field = 0; field < bits.size(); ++field) {
+    for (size_t header = 0; header < headers->size(); ++header) {
+      if (bits[field] <= 64) headers->put(header, field, in.read<uint64_t>());
+      else headers->set(header, field, readValue(in));
+    }
+  }
+  return headers;
+}
+
+static void writeDistribution(SnapshotWriter& out, const RandomDistribution& dist) {
+  out.write<uint8_t>(dist.getType());
+  switch (dist.getType()) {
+    case RandomDistribution::CONSTANT:
+      writeValue(out, static_cast<const RandomDistConstant&>(dist).value);
+      break;
+    case RandomDistribution::UNIFORM:
+      writeValue(out, static_cast<const RandomDistUniform&>(dist).minValue);
+      writeValue(out, static_cast<const RandomDistUniform&>(dist).maxValue);
+      break;
+    case RandomDistribution::NORMAL:
+      writeValue(out, static_cast<const RandomDistNormal&>(dist).mean);
+      writeValue(out, static_cast<const RandomDistNormal&>(dist).stddev);
+      break;
+    case RandomDistribution::LOGNORMAL:
+      writeValue(out, static_cast<const RandomDistLognormal&>(dist).m);
+      writeValue(out, static_cast<const RandomDistLognormal&>(dist).s);
+      break;
+    case RandomDistribution::EXPONENTIAL:
+      out.write<double>(static_cast<const RandomDistExponential&>(dist).lambda);
+      break;
+    case RandomDistribution::CAUCHY:
+      writeValue(out, static_cast<const RandomDistCauchy&>(dist).a);
+      out.write<double>(static_cast<const RandomDistCauchy&>(dist).b);
+      break;
+    case RandomDistribution::PARETO:
+      out.write<double>(static_cast<const RandomDistPareto&>(dist).scale);
+      out.write<double>(static_cast<const RandomDistPareto&>(dist).shape);
+      writeValue(out, static_cast<const RandomDistPareto&>(dist).offset);
+      break;
+  }
+}
+
+static std::unique_ptr<RandomDistribution> readDistribution(SnapshotReader& in) {
+  uint8_t type = in.read<uint8_t>();
+  switch (type) {
+    case RandomDistribution::CONSTANT: {
+      VarValue value(readValue(in));
+      return std::unique_ptr<RandomDistribution>(new RandomDistConstant(value));
+    }
+    case RandomDistribution::UNIFORM: {
+      VarValue min(readValue(in));
+      VarValue max(readValue(in));
+      return std::unique_ptr<RandomDistribution>(new RandomDistUniform(min, max));
+    }
+    case RandomDistribution::NORMAL: {
+      VarValue mean(readValue(in));
+      VarValue stddev(readValue(in));
+      return std::unique_ptr<RandomDistribution>(new RandomDistNormal(mean, stddev));
+    }
+    case RandomDistribution::LOGNORMAL: {
+      VarValue m(readValue(in));
+      VarValue s(readValue(in));
+      return std::unique_ptr<RandomDistribution>(new RandomDistLognormal(m, s));
+    }
+    case RandomDistribution::EXPONENTIAL:
+      return std::unique_ptr<RandomDistribution>(new RandomDistExponential(in.read<double>()));
+    case RandomDistribution::CAUCHY: {
+      VarValue a(readValue(in));
+      double b = in.read<double>();
+      return std::unique_ptr<RandomDistribution>(new RandomDistCauchy(a, b));
+    }
+    case RandomDistribution::PARETO: {
+      double scale = in.read<double>();
+      double shape = in.read<double>();
+      VarValue offset(readValue(in));
+      return std::unique_ptr<RandomDistribution>(new RandomDistPareto(scale, shape, offset));
+    }
+  }
+  throw "Invalid type of random distribution in cached configuration (ConfigurationCache::load).";
+}
+
+/*** Writing and reading of a whole benchmark (except its id). */
+static void writeBenchmark(SnapshotWriter& out, const Benchmark& benchmark, uint32_t ruleSet, uint32_t headerSet) {
+  writeString(out, benchmark.caption);
+  writeString(out, benchmark.algFilename);
+  writeVector(out, benchmark.algParameter);
+  writeVector(out, benchmark.fieldStructure);
+
+  out.write<uint8_t>(benchmark.generateHeaders);
+  out.write<uint32_t>(headerSet);
+  writeString(out, benchmark.headerTrace);
+  out.write<uint32_t>(benchmark.traceHeaders);
+
+  writeString(out, benchmark.pcap.filename);
+  out.write<uint32_t>(benchmark.pcap.replay);
+  out.write<uint64_t>(benchmark.pcap.fields.size());
+  for (std::vector<std::string>::const_iterator iter(benchmark.pcap.fields.cbegin()); iter != benchmark.pcap.fields.cend(); ++iter)
+    writeString(out, *iter);
+  out.write<uint32_t>(benchmark.pcap.packets);
+
+  const RandomHeaderConfiguration& rnd = benchmark.rndHeaderConfig;
+  out.write<uint32_t>(rnd.totalHeaders);
+  out.write<uint8_t>(rnd.outputToFile);
+  out.write<uint8_t>(rnd.outputBinary);
+  out.write<uint32_t>(rnd.batchSize);
+  writeVector(out, rnd.seeds);
+  out.write<uint64_t>(rnd.distributions.size());
+  for (RandomDistributionSet::const_iterator iter(rnd.distributions.cbegin()); iter != rnd.distributions.cend(); ++iter)
+    writeDistribution(out, **iter);
+
+  out.write<uint8_t>(benchmark.generateRules);
+  out.write<uint32_t>(ruleSet);
+  out.write<uint32_t>(benchmark.ruleUpdates.headersPerUpdate);
+  out.write<uint64_t>(benchmark.ruleUpdates.trace.size());
+  for (RuleUpdateTrace::const_iterator iter(benchmark.ruleUpdates.trace.cbegin()); iter != benchmark.ruleUpdates.trace.cend(); ++iter) {
+    out.write<uint8_t>((*iter)->type);
+    out.write<uint32_t>((*iter)->index);
+    writeRule(out, (*iter)->rule);
+  }
+
+  out.write<uint32_t>(benchmark.numberRuns);
+  out.write<uint32_t>(benchmark.warmupRuns);
+  out.write<int32_t>(benchmark.cpuAffinity);
+  out.write<uint32_t>(benchmark.threads);
+  out.write<uint8_t>(benchmark.nativeClassification);
+  out.write<uint8_t>(benchmark.outputMatches);
+  out.write<uint32_t>(benchmark.samplingRate);
+  out.write<uint8_t>(benchmark.measureLatency);
+  out.write<uint8_t>(benchmark.measureCounters);
+
+  out.write<uint64_t>(benchmark.cache.size());
+  for (CacheConfiguration::const_iterator iter(benchmark.cache.cbegin()); iter != benchmark.cache.cend(); ++iter) {
+    writeString(out, iter->name);
+    out.write<uint64_t>(iter->size);
+    out.write<uint32_t>(iter->ways);
+    out.write<uint32_t>(iter->lineSize);
+    out.write<uint8_t>(iter->policy);
+  }
+  out.write<uint8_t>(benchmark.traceAccesses);
+  out.write<uint8_t>(benchmark.measureHeap);
+}
+
+static BenchmarkPtr readBenchmark(SnapshotReader& in, const std::vector<std::shared_ptr<SharedRuleSet>>& ruleSets, const std::vector<std::shared_ptr<PacketHeaderColumns>>& headerSets) {
+  BenchmarkPtr benchmark(std::make_shared<Benchmark>());
+  benchmark->caption = readString(in);
+  benchmark->algFilename = readString(in);
+  readVector(in, benchmark->algParameter);
+  readVector(in, benchmark->fieldStructure);
+
+  benchmark->generateHeaders = in.read<uint8_t>() != 0;
+  uint32_t headerSet = in.read<uint32_t>();
+  if (headerSet >= headerSets.size()) throw "Invalid header set in cached configuration (ConfigurationCache::load).";
+  benchmark->headers = headerSets[headerSet];
+  benchmark->headerTrace = readString(in);
+  benchmark->traceHeaders = in.read<uint32_t>();
+
+  benchmark->pcap.filename = readString(in);
+  benchmark->pcap.replay = in.read<uint32_t>();
+  benchmark->pcap.fields.resize(in.read<uint64_t>());
+  for (std::vector<std::string>::iterator iter(benchmark->pcap.fields.begin()); iter != benchmark->pcap.fields.end(); ++iter)
+    *iter = readString(in);
+  benchmark->pcap.packets = in.read<uint32_t>();
+
+  RandomHeaderConfiguration& rnd = benchmark->rndHeaderConfig;
+  rnd.totalHeaders = in.read<uint32_t>();
+  rnd.outputToFile = in.read<uint8_t>() != 0;
+  rnd.outputBinary = in.read<uint8_t>() != 0;
+  rnd.batchSize = in.read<uint32_t>();
+  readVector(in, rnd.seeds);
+  size_t distributions = in.read<uint64_t>();
+  for (size_t i = 0; i < distributions; ++i)
+    rnd.distributions.push_back(readDistribution(in));
+
+  benchmark->generateRules = in.read<uint8_t>() != 0;
+  uint32_t ruleSet = in.read<uint32_t>();
+  if (ruleSet >= ruleSets.size()) throw "Invalid rule set in cached configuration (ConfigurationCache::load).";
+  benchmark->rules = ruleSets[ruleSet];
+  benchmark->ruleUpdates.headersPerUpdate = in.read<uint32_t>();
+  size_t updates = in.read<uint64_t>();
+  for (size_t i = 0; i < updates; ++i) {
+    RuleUpdate::Type type = (in.read<uint8_t>() == RuleUpdate::INSERT ? RuleUpdate::INSERT : RuleUpdate::REMOVE);
+    std::unique_ptr<RuleUpdate> update(new RuleUpdate(type, in.read<uint32_t>()));
+    readRule(in, update->rule);
+    benchmark->ruleUpdates.trace.push_back(std::move(update));
+  }
+
+  benchmark->numberRuns = in.read<uint32_t>();
+  benchmark->warmupRuns = in.read<uint32_t>();
+  benchmark->cpuAffinity = in.read<int32_t>();
+  benchmark->threads = in.read<uint32_t>();
+  benchmark->nativeClassification = in.read<uint8_t>() != 0;
+  benchmark->outputMatches = in.read<uint8_t>() != 0;
+  benchmark->samplingRate = in.read<uint32_t>();
+  benchmark->measureLatency = in.read<uint8_t>() != 0;
+  benchmark->measureCounters = in.read<uint8_t>() != 0;
+
+  benchmark->cache.resize(in.read<uint64_t>());
+  for (CacheConfiguration::iterator iter(benchmark->cache.begin()); iter != benchmark->cache.end(); ++iter) {
+    iter->name = readString(in);
+    iter->size = in.read<uint64_t>();
+    iter->ways = in.read<uint32_t>();
+    iter->lineSize = in.read<uint32_t>();
+    iter->policy = (in.read<uint8_t>() == CacheLevelConfiguration::PLRU ? CacheLevelConfiguration::PLRU : CacheLevelConfiguration::LRU);
+  }
+  benchmark->traceAccesses = in.read<uint8_t>() != 0;
+  benchmark->measureHeap = in.read<uint8_t>() != 0;
+  return benchmark;
+}
+
+ConfigurationCache::ConfigurationCache(const std::string& directory, const std::string& configFile, const std::string& programFile) : _filename(), _programFile(programFile), _key(0) {
+  // relative paths in the configuration depend on the working directory
+  char cwd[PATH_MAX];
+  if (directory.empty() || !getcwd(cwd, sizeof(cwd))) return;
+
+  std::string id(std::string(cwd) + '\0' + configFile + '\0' + programFile);
+  _key = fnv1a(FNV_OFFSET, id.data(), id.size());
+
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.config", (unsigned long long)_key);
+  _filename = directory + (directory.back() == '/' ? "" : "/") + name;
+}
+
+std::string ConfigurationCache::defaultDirectory() {
+  std::string dir;
+  const char* base = getenv("XDG_CACHE_HOME");
+  if (base && *base)
+    dir = base;
+  else {
+    const char* home = getenv("HOME");
+    if (!home || !*home) return "";
+    dir = std::string(home) + "/.cache";
+  }
+
+  mkdir(dir.c_str(), 0755); // may exist already
+  dir += "/cate";
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return "";
+  return dir + "/";
+}
+
+bool ConfigurationCache::load(Configuration& config) const {
+  if (_filename.empty()) return false;
+  int fd = open(_filename.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ConfigurationFileHeader)) {
+    close(fd);
+    return false;
+  }
+
+  size_t size = st.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // mapping stays valid
+  if (mapping == MAP_FAILED) return false;
+
+  const uint8_t* data = static_cast<const uint8_t*>(mapping);
+  const uint8_t* image = data + sizeof(ConfigurationFileHeader);
+  ConfigurationFileHeader header;
+  memcpy(&header, data, sizeof(header));
+
+  if (header.magic != CONFIGURATION_MAGIC || header.version != CONFIGURATION_VERSION || header.key != _key ||
+    header.size != size - sizeof(header) || header.checksum != fnv1a(FNV_OFFSET, image, header.size)) {
+    munmap(mapping, size);
+    return false;
+  }
+
+  std::vector<std::string> sourceFiles, dataFiles;
+  BenchmarkSet benchmarks;
+  bool valid = true;
+  try {
+    SnapshotReader in(image, header.size);
+
+    // each file must be unchanged
+    size_t dependencies = in.read<uint64_t>();
+    for (size_t i = 0; i < dependencies && valid; ++i) {
+      uint8_t type = in.read<uint8_t>();
+      std::string file(readString(in));
+      uint64_t first = in.read<uint64_t>(), second = in.read<uint64_t>();
+      uint64_t current[2] = {0, 0};
+      if (type == CONTENT) {
+        valid = contentHash(file, current[0]) && current[0] == first;
+        sourceFiles.push_back(file);
+      } else {
+        valid = fileStatus(file, current[0], current[1]) && current[0] == first && current[1] == second;
+        if (file != _programFile) dataFiles.push_back(file);
+      }
+    }
+
+    if (valid) {
+      std::vector<std::shared_ptr<SharedRuleSet>> ruleSets(in.read<uint64_t>());
+      for (size_t i = 0; i < ruleSets.size(); ++i)
+        ruleSets[i] = readRuleSet(in);
+      std::vector<std::shared_ptr<PacketHeaderColumns>> headerSets(in.read<uint64_t>());
+      for (size_t i = 0; i < headerSets.size(); ++i)
+        headerSets[i] = readHeaders(in);
+
+      size_t number = in.read<uint64_t>();
+      for (size_t i = 0; i < number; ++i)
+        benchmarks.push_back(readBenchmark(in, ruleSets, headerSets));
+      valid = in.atEnd();
+    }
+  } catch (const char* ex) {
+    valid = false; // e.g. truncated by an older version
+  }
+  munmap(mapping, size);
+  if (!valid) return false;
+
+  // the configuration is only changed for a valid file
+  config.getBenchmarkSet().insert(config.getBenchmarkSet().end(), benchmarks.begin(), benchmarks.end());
+  for (std::vector<std::string>::const_iterator iter(sourceFiles.cbegin()); iter != sourceFiles.cend(); ++iter)
+    config.addSourceFile(*iter);
+  for (std::vector<std::string>::const_iterator iter(dataFiles.cbegin()); iter != dataFiles.cend(); ++iter)
+    config.addDataFile(*iter);
+  return true;
+}
+
+bool ConfigurationCache::store(const Configuration& config) const {
+  if (_filename.empty() || !config.isCacheable()) return false;
+
+  std::vector<uint8_t> image;
+  SnapshotWriter out(image);
+
+  // files are compared with their state after the interpretation
+  const std::vector<std::string>& sourceFiles = config.getSourceFiles();
+  std::vector<std::string> statusFiles(config.getDataFiles());
+  statusFiles.push_back(_programFile);
+  out.write<uint64_t>(sourceFiles.size() + statusFiles.size());
+  for (std::vector<std::string>::const_iterator iter(sourceFiles.cbegin()); iter != sourceFiles.cend(); ++iter) {
+    uint64_t hash;
+    if (!contentHash(*iter, hash)) return false;
+    out.write<uint8_t>(CONTENT);
+    writeString(out, *iter);
+    out.write<uint64_t>(hash);
+    out.write<uint64_t>(0);
+  }
+  for (std::vector<std::string>::const_iterator iter(statusFiles.cbegin()); iter != statusFiles.cend(); ++iter) {
+    uint64_t fileSize, modified;
+    if (!fileStatus(*iter, fileSize, modified)) return false;
+    out.write<uint8_t>(STATUS);
+    writeString(out, *iter);
+    out.write<uint64_t>(fileSize);
+    out.write<uint64_t>(modified);
+  }
+
+  // shared sets are stored once and referenced by their index
+  const BenchmarkSet& benchmarks = config.getBenchmarkSet();
+  std::map<const SharedRuleSet*, uint32_t> ruleSets;
+  std::map<const PacketHeaderColumns*, uint32_t> headerSets;
+  std::vector<const SharedRuleSet*> ruleOrder;
+  std::vector<const PacketHeaderColumns*> headerOrder;
+  for (BenchmarkSet::const_iterator iter(benchmarks.cbegin()); iter != benchmarks.cend(); ++iter) {
+    if (ruleSets.insert(std::make_pair((*iter)->rules.get(), (uint32_t)ruleOrder.size())).second)
+      ruleOrder.push_back((*iter)->rules.get());
+    if (headerSets.insert(std::make_pair((*iter)->headers.get(), (uint32_t)headerOrder.size())).second)
+      headerOrder.push_back((*iter)->headers.get());
+  }
+
+  out.write<uint64_t>(ruleOrder.size());
+  for (std::vector<const SharedRuleSet*>::const_iterator iter(ruleOrder.cbegin()); iter != ruleOrder.cend(); ++iter)
+    writeRuleSet(out, **iter);
+  out.write<uint64_t>(headerOrder.size());
+  for (std::vector<const PacketHeaderColumns*>::const_iterator iter(headerOrder.cbegin()); iter != headerOrder.cend(); ++iter)
+    writeHeaders(out, **iter);
+
+  out.write<uint64_t>(benchmarks.size());
+  for (BenchmarkSet::const_iterator iter(benchmarks.cbegin()); iter != benchmarks.cend(); ++iter)
+    writeBenchmark(out, **iter, ruleSets[(*iter)->rules.get()], headerSets[(*iter)->headers.get()]);
+
+  ConfigurationFileHeader header;
+  header.magic = CONFIGURATION_MAGIC;
+  header.version = CONFIGURATION_VERSION;
+  header.key = _key;
+  header.size = image.size();
+  header.checksum = fnv1a(FNV_OFFSET, image.data(), image.size());
+
+  // write to a temporary file first, so that a concurrent run never reads a partial file
+  std::string temporary(_filename + "." + std::to_string(getpid()));
+  FILE* file = fopen(temporary.c_str(), "wb");
+  if (!file) return false;
+
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    (image.empty() || fwrite(image.data(), image.size(), 1, file) == 1);
+  written = (fclose(file) == 0) && written;
+
+  if (!written || rename(temporary.c_str(), _filename.c_str()) != 0) {
+    remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
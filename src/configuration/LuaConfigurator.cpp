@@ -1,11 +1,20 @@
 #include <configuration/LuaConfigurator.hpp>
 #include <limits>
 #include <configuration/RandomHeaderConfiguration.hpp>
+#include <generics/HeaderTrace.hpp>
+#include <generator/PcapSource.hpp>
+#include <configuration/ClassBenchLoader.hpp>
 
 using namespace Generic;
 
 void LuaConfigurator::addBenchmark() { 
   _config->getBenchmarkSet().push_back(std::make_shared<Benchmark>());
+
+  // rules and headers are added to own sets, unless they are shared with a previous benchmark
+  _rules = std::make_shared<SharedRuleSet>();
+  _headers = std::make_shared<PacketHeaderColumns>();
+  _config->getBenchmarkSet().back()->rules = _rules;
+  _config->getBenchmarkSet().back()->headers = _headers;
 }
 
 /*** Handle general information of Benchmark. */
@@ -25,84 +34,155 @@ void LuaConfigurator::addFieldStructure(unsigned int bitsize) {
 }
 
 /*** Handle rules and rule atoms. */
+bool LuaConfigurator::shareRules(const void* table) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  // atoms depend on the field widths, so a rule set is only shared with the same structure
+  std::pair<const void*, FieldStructureSet> key(table, benchmark->fieldStructure);
+  std::map<std::pair<const void*, FieldStructureSet>, std::shared_ptr<SharedRuleSet>>::const_iterator found(_ruleSets.find(key));
+  if (found == _ruleSets.end()) {
+    _ruleSets[key] = _rules;
+    return false;
+  }
+  benchmark->rules = found->second;
+  return true;
+}
+
 void LuaConfigurator::addRule() { 
   std::unique_ptr<Rule> rule(new Rule);
-  _config->getBenchmarkSet().back()->rules.push_back(std::move(rule));
+  _rules->edit().push_back(std::move(rule));
+  _atomsOfUpdate = false;
 }
 
-int LuaConfigurator::_getTopRuleIndex() const {
-  return _config->getBenchmarkSet().back()->rules.size() - 1;
+Rule& LuaConfigurator::_getTopRule() const {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+  if (_atomsOfUpdate) return benchmark->ruleUpdates.trace.back()->rule;
+  return *(_rules->edit().back());
 }
 
 size_t LuaConfigurator::_getCurrentAtomWidth() const {
   // lookup width of current rule atom
-  int topRuleAtomIdx = _config->getBenchmarkSet().back()->rules[_getTopRuleIndex()]->size();
+  size_t topRuleAtomIdx = _getTopRule().size();
   return _config->getBenchmarkSet().back()->fieldStructure[topRuleAtomIdx];
 }
 
 void LuaConfigurator::addRuleAtomExact(unsigned int value) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomExact> atom(new RuleAtomExact(value, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
 }
 
 void LuaConfigurator::addRuleAtomExact(std::string& value) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomExact> atom(new RuleAtomExact(value, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
 }
 
 void LuaConfigurator::addRuleAtomRange(unsigned int min, unsigned int max) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomRange> atom(new RuleAtomRange(min, max, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
 }
 
 void LuaConfigurator::addRuleAtomRange(std::string& min, std::string& max) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomRange> atom(new RuleAtomRange(min, max, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
 }
 
 void LuaConfigurator::addRuleAtomPrefix(unsigned int prefix, unsigned int mask) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomPrefix> atom(new RuleAtomPrefix(prefix, mask, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
 }
 
 void LuaConfigurator::addRuleAtomPrefix(std::string& prefix, std::string& mask) {
-  int topRuleIdx = _getTopRuleIndex();
   size_t width = _getCurrentAtomWidth();
 
   std::unique_ptr<RuleAtomPrefix> atom(new RuleAtomPrefix(prefix, mask, width));
-  _config->getBenchmarkSet().back()->rules[topRuleIdx]->push_back(std::move(atom));
+  _getTopRule().push_back(std::move(atom));
+}
+
+void LuaConfigurator::loadClassBenchRules(const char* filename) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  // filters are only counted here, they are loaded before the first benchmark, which needs them
+  std::pair<std::string, FieldStructureSet> key(filename, benchmark->fieldStructure);
+  std::shared_ptr<SharedRuleSet>& rules = _classBenchSets[key];
+  if (!rules) rules = std::make_shared<SharedRuleSet>(filename, benchmark->fieldStructure);
+  benchmark->rules = rules;
+  _config->addDataFile(filename);
+  _atomsOfUpdate = false;
 }
 
 /*** Handle headers and random header generation. */
+bool LuaConfigurator::shareHeaders(const void* table) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  std::pair<const void*, FieldStructureSet> key(table, benchmark->fieldStructure);
+  std::map<std::pair<const void*, FieldStructureSet>, std::shared_ptr<PacketHeaderColumns>>::const_iterator found(_headerSets.find(key));
+  if (found == _headerSets.end()) {
+    _headerSets[key] = _headers;
+    return false;
+  }
+  benchmark->headers = found->second;
+  return true;
+}
+
 void LuaConfigurator::addHeader() { 
-  std::unique_ptr<PacketHeaderLine> line(new PacketHeaderLine);
-  _config->getBenchmarkSet().back()->headers.push_back(std::move(line));
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  // columns are typed by the field structure, which is known before the first header
+  if (_headers->empty())
+    _headers->setStructure(benchmark->fieldStructure);
+  _headers->addHeader();
 }
 
 void LuaConfigurator::addHeaderValue(unsigned int value) { 
-  std::unique_ptr<PacketHeaderAtom> headerAtom(new PacketHeaderAtom(value));
-  _config->getBenchmarkSet().back()->headers.back()->push_back(std::move(headerAtom));
+  _headers->addValue(VarValue(value));
 }
 
 void LuaConfigurator::addHeaderValue(std::string& value) { 
-  std::unique_ptr<PacketHeaderAtom> headerAtom(new PacketHeaderAtom(value));
+  _headers->addValue(VarValue(value));
+}
+
+void LuaConfigurator::setHeaderTrace(const char* filename) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  // headers are only counted here, they are streamed from the trace during the benchmark
+  HeaderTraceReader trace(filename);
+  if (trace.size() > std::numeric_limits<unsigned int>::max())
+    throw "Header trace contains too many headers (LuaConfigurator::setHeaderTrace).";
 
-  _config->getBenchmarkSet().back()->headers.back()->push_back(std::move(headerAtom));
+  benchmark->headerTrace = filename;
+  benchmark->traceHeaders = trace.size();
+  _config->addDataFile(filename);
+}
+
+void LuaConfigurator::setPcapFile(const char* filename) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  // packets are only counted here, they are streamed from the capture during the benchmark
+  benchmark->pcap.filename = filename;
+  benchmark->pcap.packets = PcapSource::countPackets(filename);
+  _config->addDataFile(filename);
+}
+
+void LuaConfigurator::setPcapReplay(unsigned int times) {
+  BenchmarkPtr& benchmark = _config->getBenchmarkSet().back();
+
+  if (benchmark->pcap.packets > 0 && times > std::numeric_limits<unsigned int>::max() / benchmark->pcap.packets)
+    throw "Replayed packet capture contains too many headers (LuaConfigurator::setPcapReplay).";
+  benchmark->pcap.replay = times;
+}
+
+void LuaConfigurator::addPcapField(const char* name) {
+  _config->getBenchmarkSet().back()->pcap.fields.push_back(name);
 }
 
 void LuaConfigurator::setRandomHeaderNumber(unsigned int number) {
@@ -112,8 +192,13 @@ void LuaConfigurator::setRandomHeaderNumber(unsigned int number) {
   _config->getBenchmarkSet().back()->rndHeaderConfig.totalHeaders = number;
 }
 
-void LuaConfigurator::setRandomHeaderOutput(bool outputToFile) {
+void LuaConfigurator::setRandomHeaderOutput(bool outputToFile, bool binary) {
   _config->getBenchmarkSet().back()->rndHeaderConfig.outputToFile = outputToFile;
+  _config->getBenchmarkSet().back()->rndHeaderConfig.outputBinary = binary;
+}
+
+void LuaConfigurator::setRandomHeaderBatchSize(unsigned int size) {
+  _config->getBenchmarkSet().back()->rndHeaderConfig.batchSize = size;
 }
 
 void LuaConfigurator::_pushBackRandomDistribution(unsigned int seed, std::unique_ptr<RandomDistribution> dist) {
@@ -210,7 +295,76 @@ void LuaConfigurator::setNumberRuns(unsigned int number) {
   _config->getBenchmarkSet().back()->numberRuns = number;
 }
 
+void LuaConfigurator::setThreads(unsigned int number) {
+  _config->getBenchmarkSet().back()->threads = number;
+}
+
+void LuaConfigurator::setWarmupRuns(unsigned int number) {
+  _config->getBenchmarkSet().back()->warmupRuns = number;
+}
+
+void LuaConfigurator::setCpuAffinity(unsigned int cpu) {
+  _config->getBenchmarkSet().back()->cpuAffinity = cpu;
+}
+
+void LuaConfigurator::setNativeClassification(bool native) {
+  _config->getBenchmarkSet().back()->nativeClassification = native;
+}
+
+void LuaConfigurator::setOutputMatches(bool output) {
+  _config->getBenchmarkSet().back()->outputMatches = output;
+}
+
+void LuaConfigurator::setSamplingRate(unsigned int rate) {
+  _config->getBenchmarkSet().back()->samplingRate = rate;
+}
+
+void LuaConfigurator::setMeasureLatency(bool measure) {
+  _config->getBenchmarkSet().back()->measureLatency = measure;
+}
+
+void LuaConfigurator::setMeasureCounters(bool measure) {
+  _config->getBenchmarkSet().back()->measureCounters = measure;
+}
+
+void LuaConfigurator::addCacheLevel(const std::string& name, size_t size, unsigned int ways, unsigned int lineSize, const std::string& policy) {
+  CacheLevelConfiguration::Policy p = (policy == "plru" ? CacheLevelConfiguration::PLRU : CacheLevelConfiguration::LRU);
+  _config->getBenchmarkSet().back()->cache.push_back(CacheLevelConfiguration(name, size, ways, lineSize, p));
+}
+
+void LuaConfigurator::setTraceAccesses(bool trace) {
+  _config->getBenchmarkSet().back()->traceAccesses = trace;
+}
+
+void LuaConfigurator::setMeasureHeap(bool measure) {
+  _config->getBenchmarkSet().back()->measureHeap = measure;
+}
+
+/*** Handle a trace of rule updates. */
+void LuaConfigurator::setRuleUpdateInterval(unsigned int headers) {
+  _config->getBenchmarkSet().back()->ruleUpdates.headersPerUpdate = headers;
+}
+
+void LuaConfigurator::addRuleInsertion(uint32_t index) {
+  std::unique_ptr<RuleUpdate> update(new RuleUpdate(RuleUpdate::INSERT, index));
+  _config->getBenchmarkSet().back()->ruleUpdates.trace.push_back(std::move(update));
+  _atomsOfUpdate = true; // following rule atoms belong to the inserted rule
+}
+
+void LuaConfigurator::addRuleRemoval(uint32_t index) {
+  std::unique_ptr<RuleUpdate> update(new RuleUpdate(RuleUpdate::REMOVE, index));
+  _config->getBenchmarkSet().back()->ruleUpdates.trace.push_back(std::move(update));
+}
+
 void LuaConfigurator::makeFullRelativePath(const std::string& postfix, std::string& result) {
   result = _config->getProgRelativePath() + postfix;
 }
 
+void LuaConfigurator::addSourceFile(const std::string& filename) {
+  _config->addSourceFile(filename);
+}
+
+void LuaConfigurator::setCacheable(bool cacheable) {
+  _config->setCacheable(cacheable);
+}
+
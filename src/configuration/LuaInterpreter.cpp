@@ -108,6 +108,7 @@ int LuaInterpreter::inProtectedMode(lua_State* L) {
 
     if (lua_istable(L, base+1)) { // check if configuration was returned
       iterBenchmarks(L, base+1); // iterate over all benchmarks in suite
+      fetchSourceFiles(L);
     } else { // error: no configuration set
       errorOccurred = true;
     }
@@ -123,6 +124,24 @@ int LuaInterpreter::inProtectedMode(lua_State* L) {
   return 1;
 }
 
+void LuaInterpreter::fetchSourceFiles(lua_State* L) {
+  lua_getglobal(L, "_CATE_sourceFiles");
+  if (lua_istable(L, -1)) {
+    int tblIdx = lua_gettop(L);
+    lua_pushnil(L); // first key
+    while (lua_next(L, tblIdx) != 0) {
+      if (lua_type(L, -1) == LUA_TSTRING) configurator->addSourceFile(lua_tostring(L, -1));
+      else configurator->setCacheable(false); // unknown file
+      lua_pop(L, 1);
+    }
+  }
+  lua_pop(L, 1);
+
+  lua_getglobal(L, "_CATE_cacheable");
+  if (!lua_toboolean(L, -1)) configurator->setCacheable(false);
+  lua_pop(L, 1);
+}
+
 void LuaInterpreter::iterBenchmarks(lua_State* L, int index) {
   lua_pushnil(L); // first key
   while(lua_next(L, index) != 0 && !errorOccurred) {
@@ -167,7 +186,14 @@ void LuaInterpreter::fetchBenchmark(lua_State* L, int index) {
       errorOccurred = true;
     }
     else if (key == 4 && lua_istable(L, valIdx)) { // ruleset
-      iterRules(L, valIdx);
+      lua_getfield(L, valIdx, "classbench");
+      std::string classBench(lua_isstring(L, -1) ? lua_tostring(L, -1) : "");
+      lua_pop(L, 1);
+
+      if (!classBench.empty()) // rule set of loadClassBenchRules
+        configurator->loadClassBenchRules(classBench.c_str());
+      else if (!configurator->shareRules(lua_topointer(L, valIdx))) // convert each rule set only once
+        iterRules(L, valIdx);
     }
     else if (key == 4) {
       l_message("No ruleset for benchmark found.");
@@ -187,6 +213,51 @@ void LuaInterpreter::fetchBenchmark(lua_State* L, int index) {
       l_message("Number of runs is not defined. Set default value of 1 run.");
       configurator->setNumberRuns(1);
     }
+    else if (key == 7 && lua_istable(L, valIdx)) { // optional settings
+      fetchOptions(L, valIdx);
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
+void LuaInterpreter::fetchOptions(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int valIdx = lua_gettop(L);
+    // do not use lua_tostring on non-string keys, as it would confuse lua_next
+    std::string key(lua_type(L, -2) == LUA_TSTRING ? lua_tostring(L, -2) : "");
+
+    if (key == "threads" && lua_isnumber(L, valIdx)) // number of worker threads
+      configurator->setThreads(lua_tounsigned(L, valIdx));
+    else if (key == "warmup" && lua_isnumber(L, valIdx)) // runs excluded from the results
+      configurator->setWarmupRuns(lua_tounsigned(L, valIdx));
+    else if (key == "cpu" && lua_isnumber(L, valIdx)) // pin classifying thread to a cpu
+      configurator->setCpuAffinity(lua_tounsigned(L, valIdx));
+    else if (key == "batch_size" && lua_isnumber(L, valIdx)) // number of headers generated at once
+      configurator->setRandomHeaderBatchSize(lua_tounsigned(L, valIdx));
+    else if (key == "native" && lua_isboolean(L, valIdx)) // classify converted headers
+      configurator->setNativeClassification(lua_toboolean(L, valIdx));
+    else if (key == "matches" && lua_isboolean(L, valIdx)) // output matched rule of each header
+      configurator->setOutputMatches(lua_toboolean(L, valIdx));
+    else if (key == "sampling" && lua_isnumber(L, valIdx)) // time only 1-in-n headers
+      configurator->setSamplingRate(lua_tounsigned(L, valIdx));
+    else if (key == "latency" && lua_isboolean(L, valIdx)) // record lookup time of each header
+      configurator->setMeasureLatency(lua_toboolean(L, valIdx));
+    else if (key == "counters" && lua_isboolean(L, valIdx)) // count hardware events
+      configurator->setMeasureCounters(lua_toboolean(L, valIdx));
+    else if (key == "updates" && lua_istable(L, valIdx)) // replay a trace of rule updates
+      fetchUpdateTrace(L, valIdx);
+    else if (key == "cache" && lua_istable(L, valIdx)) // simulate a cache hierarchy
+      iterCacheLevels(L, valIdx);
+    else if (key == "access_trace" && lua_isboolean(L, valIdx)) // write all traced memory accesses to a file
+      configurator->setTraceAccesses(lua_toboolean(L, valIdx));
+    else if (key == "heap" && lua_isboolean(L, valIdx)) // measure all allocations on the heap
+      configurator->setMeasureHeap(lua_toboolean(L, valIdx));
+    else {
+      l_message("Invalid benchmark option found (unknown key or value).");
+      errorOccurred = true;
+    }
 
     lua_pop(L, 1); // remove value, keep key for next iteration
   }
@@ -337,10 +408,127 @@ void LuaInterpreter::fetchRuleAtom(lua_State* L, int index) {
   }
 }
 
+void LuaInterpreter::fetchUpdateTrace(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int key = lua_tointeger(L, -2); // key is at index -2, value at index -1
+    int tblIdx = lua_gettop(L);
+
+    if (key == 1 && lua_isnumber(L, tblIdx)) // headers to classify before each update
+      configurator->setRuleUpdateInterval(lua_tounsigned(L, tblIdx));
+    else if (key == 2 && lua_istable(L, tblIdx)) // all updates
+      iterUpdates(L, tblIdx);
+    else {
+      l_message("Invalid trace of rule updates found (table structure doesn't match expectations).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
+void LuaInterpreter::iterCacheLevels(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int tblIdx = lua_gettop(L);
+
+    if (lua_istable(L, tblIdx)) {
+      fetchCacheLevel(L, tblIdx);
+    } else {
+      l_message("Invalid cache level definition found (not a table).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
+void LuaInterpreter::fetchCacheLevel(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  std::string name, policy;
+  size_t size = 0;
+  unsigned int ways = 0, lineSize = 0;
+
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int key = lua_tointeger(L, -2); // key is at index -2, value at index -1
+    int tblIdx = lua_gettop(L);
+
+    if (key == 1 && lua_isstring(L, tblIdx)) // caption
+      name = lua_tostring(L, tblIdx);
+    else if (key == 2 && lua_isnumber(L, tblIdx)) // capacity in bytes
+      size = (size_t)lua_tonumber(L, tblIdx);
+    else if (key == 3 && lua_isnumber(L, tblIdx)) // associativity
+      ways = lua_tounsigned(L, tblIdx);
+    else if (key == 4 && lua_isnumber(L, tblIdx)) // line size in bytes
+      lineSize = lua_tounsigned(L, tblIdx);
+    else if (key == 5 && lua_isstring(L, tblIdx)) // replacement policy
+      policy = lua_tostring(L, tblIdx);
+    else {
+      l_message("Invalid cache level found (table structure doesn't match expectations).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+
+  if (!errorOccurred) configurator->addCacheLevel(name, size, ways, lineSize, policy);
+}
+
+void LuaInterpreter::iterUpdates(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int tblIdx = lua_gettop(L);
+
+    if (lua_istable(L, tblIdx)) {
+      fetchUpdate(L, tblIdx);
+    } else {
+      l_message("Invalid rule update definition found (not a table).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
+void LuaInterpreter::fetchUpdate(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+  unsigned int updateType = 0;
+
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int key = lua_tointeger(L, -2); // key is at index -2, value at index -1
+    int tblIdx = lua_gettop(L);
+
+    if (key == 1 && lua_isnumber(L, tblIdx)) { // update type
+      updateType = lua_tounsigned(L, tblIdx);
+    }
+    else if (key == 2 && lua_isnumber(L, tblIdx)) { // index of the rule
+      if (updateType == 0) // insertion, rule atoms follow
+        configurator->addRuleInsertion(lua_tounsigned(L, tblIdx));
+      else if (updateType == 1) // removal
+        configurator->addRuleRemoval(lua_tounsigned(L, tblIdx));
+      else {
+        l_message("Invalid rule update type found (not insertion nor removal).");
+        errorOccurred = true;
+      }
+    }
+    else if (key == 3 && updateType == 0 && lua_istable(L, tblIdx)) { // inserted rule
+      fetchRule(L, tblIdx);
+    }
+    else {
+      l_message("Invalid rule update found (table structure doesn't match expectations).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
 void LuaInterpreter::iterHeaderDefinition(lua_State* L, int index) {
   lua_pushnil(L); // first key
   bool isRandomHeader = false;
   bool isExactHeader = false;
+  bool isTraceHeader = false;
+  bool isPcapHeader = false;
 
   while(lua_next(L, index) != 0 && !errorOccurred) {
     int key = lua_tointeger(L, -2); // key is at index -2, value at index -1
@@ -349,6 +537,8 @@ void LuaInterpreter::iterHeaderDefinition(lua_State* L, int index) {
     if (key == 1 && lua_isstring(L, tblIdx)) { // type-marker
       std::string cmpExact("exact");
       std::string cmpRandom("random");
+      std::string cmpTrace("trace");
+      std::string cmpPcap("pcap");
 
       if (cmpExact.compare(lua_tostring(L, tblIdx)) == 0) { 
         // get exact header values
@@ -356,23 +546,50 @@ void LuaInterpreter::iterHeaderDefinition(lua_State* L, int index) {
       } else if (cmpRandom.compare(lua_tostring(L, tblIdx)) == 0) {
         // get random header values
         isRandomHeader = true;
+      } else if (cmpTrace.compare(lua_tostring(L, tblIdx)) == 0) {
+        // stream headers from a binary trace
+        isTraceHeader = true;
+      } else if (cmpPcap.compare(lua_tostring(L, tblIdx)) == 0) {
+        // stream headers from a packet capture
+        isPcapHeader = true;
       } else {
-        l_message("Invalid header definition found (not exact nor random values).");
+        l_message("Invalid header definition found (not exact, random, trace nor pcap values).");
         errorOccurred = true;
       }
     }
     else if (key == 2 && isExactHeader && lua_istable(L, tblIdx)) { 
-      // analyze table structure with explicit header values
-      iterExplicitHeaders(L, tblIdx);
+      // analyze table structure with explicit header values (only once per header set)
+      if (!configurator->shareHeaders(lua_topointer(L, tblIdx)))
+        iterExplicitHeaders(L, tblIdx);
     }
     else if (key == 2 && isRandomHeader && lua_isnumber(L, tblIdx)) { 
       // number of headers to generate
       configurator->setRandomHeaderNumber(lua_tounsigned(L, tblIdx));
     } 
+    else if (key == 2 && isTraceHeader && lua_isstring(L, tblIdx)) {
+      // path of the header trace
+      configurator->setHeaderTrace(lua_tostring(L, tblIdx));
+    }
+    else if (key == 2 && isPcapHeader && lua_isstring(L, tblIdx)) {
+      // path of the packet capture
+      configurator->setPcapFile(lua_tostring(L, tblIdx));
+    }
+    else if (key == 3 && isPcapHeader && lua_isnumber(L, tblIdx)) {
+      // number of passes over the capture
+      configurator->setPcapReplay(lua_tounsigned(L, tblIdx));
+    }
+    else if (key == 4 && isPcapHeader && lua_istable(L, tblIdx)) {
+      // packet field of each header field
+      iterPcapFields(L, tblIdx);
+    }
     else if (key == 3 && isRandomHeader && lua_isboolean(L, tblIdx)) {
       // output headers to file
       configurator->setRandomHeaderOutput(lua_toboolean(L, tblIdx));
     }
+    else if (key == 3 && isRandomHeader && lua_isstring(L, tblIdx)) {
+      // output headers to a binary trace ("binary")
+      configurator->setRandomHeaderOutput(true, true);
+    }
     else if (key == 4 && isRandomHeader && lua_istable(L, tblIdx)) { 
       // distributions
       iterDistributions(L, tblIdx);
@@ -385,6 +602,23 @@ void LuaInterpreter::iterHeaderDefinition(lua_State* L, int index) {
   }
 }
 
+void LuaInterpreter::iterPcapFields(lua_State* L, int index) {
+  lua_pushnil(L); // first key
+
+  while(lua_next(L, index) != 0 && !errorOccurred) {
+    int tblIdx = lua_gettop(L);
+
+    if (lua_isstring(L, tblIdx)) { 
+      configurator->addPcapField(lua_tostring(L, tblIdx));
+    } else {
+      l_message("Invalid packet field found (not a string).");
+      errorOccurred = true;
+    }
+
+    lua_pop(L, 1); // remove value, keep key for next iteration
+  }
+}
+
 void LuaInterpreter::iterExplicitHeaders(lua_State* L, int index) {
   lua_pushnil(L); // first key
 
@@ -673,6 +907,10 @@ void LuaInterpreter::prepareScript(const std::string& userConfig, std::string& s
   // read file into string
   if (!FilesysHelper::readFile(userConfig, config)) throw "Error when reading user-configuration lua-script";
 
+  configurator->addSourceFile(preFile);
+  configurator->addSourceFile(userConfig);
+  configurator->addSourceFile(postFile);
+
   // merge all files into complete script
   script = "-- This is the merged file for CATE-configuration.\n\n";
   script.append(pre);
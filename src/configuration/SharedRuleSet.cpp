@@ -0,0 +1,19 @@
+#include <configuration/SharedRuleSet.hpp>
+#include <configuration/ClassBenchLoader.hpp>
+
+SharedRuleSet::SharedRuleSet(const std::string& classBenchFile, const std::vector<unsigned int>& structure) : SharedRuleSet(classBenchFile, structure, 0) {
+  _fileRules = ClassBenchLoader::count(_classBenchFile, _structure);
+}
+
+const Generic::RuleSet& SharedRuleSet::get() {
+  if (!_loaded) {
+    ClassBenchLoader::load(_classBenchFile, _structure, _rules);
+    if (_rules.size() != _fileRules) { // filters are only counted by their first character before
+      _rules.clear(); // each further call fails, too
+      throw "ClassBench file was changed after reading the configuration (SharedRuleSet::get).";
+    }
+    _loaded = true;
+  }
+  return _rules;
+}
+
@@ -1,6 +1,13 @@
 #include <core/BenchmarkExecutor.hpp>
+#include <core/ParallelClassifier.hpp>
 #include <generator/HeaderGenerator.hpp>
+#include <generator/HeaderPipeline.hpp>
+#include <generics/HeaderTrace.hpp>
+#include <generator/PcapSource.hpp>
 #include <iostream>
+#include <limits>
+#include <algorithm>
+#include <chrono>
 
 bool BenchmarkExecutor::_loadAlgorithm() {
   // create algorithms instance
@@ -21,10 +28,25 @@ void BenchmarkExecutor::_setupMemManager() {
   _memRegistry = std::make_shared<Memory::MemTraceRegistry>(_memManager);
   Memory::memRegistryPtr = _memRegistry; // for registering MemTrace-instances
   _algWrapper->getAlgorithm()->setMemManager(_memManager);
+
+  if (!_benchmark->cache.empty()) {
+#if defined(MEMTRACE_DISABLED) || !defined(MEMTRACE_BACKENDS)
+    std::cout << "Cache simulation is only available with memory metering and its backends (build_all_backends). " <<
+      "Continuing without it." << std::endl;
+#else
+    _memManager->setCacheSimulator(std::make_shared<Memory::CacheSimulator>(_benchmark->cache));
+#endif
+  }
+#if defined(MEMTRACE_DISABLED) || !defined(MEMTRACE_BACKENDS)
+  if (_benchmark->traceAccesses)
+    std::cout << "Access traces are only available with memory metering and its backends (build_all_backends). " <<
+      "Continuing without them." << std::endl;
+#endif
 }
 
 void BenchmarkExecutor::_setupChronoManager() {
   _chrono = std::make_shared<ChronoManager>();
+  _chrono->setSampling(_benchmark->samplingRate);
   _algWrapper->getAlgorithm()->setChronoManager(_chrono);
 }
 
@@ -33,69 +55,415 @@ void BenchmarkExecutor::_setupLogTagManager() {
   _algWrapper->getAlgorithm()->setLogTagManager(_logger);
 }
 
-void BenchmarkExecutor::_classifyHeaders(const Generic::PacketHeaderSet& headers, Generic::RuleIndexSet& indices) {
-  _chrono->start("total");
-  _algWrapper->getAlgorithm()->classify(headers, indices);
-  _chrono->stop("total");
+void BenchmarkExecutor::_setupPerfManager() {
+  _perf.reset(new PerfManager);
+  if (_benchmark->measureCounters && !_perf->open())
+    std::cout << "Hardware performance counters are not available (" << _perf->getError() << "). " <<
+      "Continuing without them." << std::endl;
 }
 
-void BenchmarkExecutor::_indicesPushBack(const Generic::RuleIndexSet& src, Generic::RuleIndexSet& dest) {
-  for(Generic::RuleIndexSet::const_iterator iter(src.begin()); iter != src.end(); ++iter)
-    dest.push_back(*iter);
+void BenchmarkExecutor::_setupHeapMeter() {
+  _heap.reset(new HeapMeter);
+  _heap->setEnabled(_benchmark->measureHeap);
 }
 
-void BenchmarkExecutor::_classify(Generic::RuleIndexSet& indices) {
-  if (_benchmark->generateHeaders) { // generate header data
-    const unsigned int BATCH_SIZE = 1024;
+void BenchmarkExecutor::_classifyHeaders(const Generic::PacketHeaderColumns& headers, MatchSink& matches, const std::string& suffix) {
+  const std::string total("total" + suffix);
+  const std::string convert("convert header" + suffix);
+  const std::string classify("classify" + suffix);
+  Base* algorithm = _algWrapper->getAlgorithm();
+  size_t headerSize = (_benchmark->nativeClassification ? algorithm->nativeHeaderSize() : 0);
 
-    Generic::PacketHeaderSet headers;
+  if (headerSize == 0) { // conversion of each header is part of the classification
+    // line-based headers are created in batches only, to keep the memory footprint low
+    size_t batchSize = (_benchmark->rndHeaderConfig.batchSize > 0 ? _benchmark->rndHeaderConfig.batchSize : headers.size());
     Generic::RuleIndexSet indicesBatch;
-    HeaderGenerator hdrGenerator;
 
-    hdrGenerator.configure(_benchmark->fieldStructure, _benchmark->rndHeaderConfig);
-    unsigned int headerCnt;
+    for (size_t first = 0; first < headers.size(); first += batchSize) {
+      headers.toHeaderSet(_lineHeaders, first, batchSize);
+
+      _perf->start(total);
+      _chrono->start(total);
+      _heap->start(classify);
+      algorithm->classify(_lineHeaders, indicesBatch);
+      _heap->stop();
+      _chrono->stop(total);
+      _perf->stop(total);
 
-    for (headerCnt = 0; (headerCnt + BATCH_SIZE) < _benchmark->rndHeaderConfig.totalHeaders; headerCnt += BATCH_SIZE) {
-      hdrGenerator.generateHeaders(BATCH_SIZE, headers);
+      matches.add(indicesBatch);
+    }
+    _lineHeaders.clear();
 
-      _classifyHeaders(headers, indicesBatch);
+    if (_benchmark->measureLatency) _measureLatencies(headers, suffix);
+    return;
+  }
 
-      // copy resulting indices to container for all indices
-      _indicesPushBack(indicesBatch, indices);
+  // convert all headers up front
+  _perf->start(convert);
+  _chrono->start(convert);
+  _nativeHeaders.resize(headers.size() * headerSize);
+  algorithm->convertHeaders(headers, _nativeHeaders.data());
+  _chrono->stop(convert);
+  _perf->stop(convert);
+
+  _nativeIndices.resize(headers.size());
+  _perf->start(total);
+  _chrono->start(total);
+  _heap->start(classify);
+  algorithm->classifyNative(_nativeHeaders.data(), headers.size(), _nativeIndices.data());
+  _heap->stop();
+  _chrono->stop(total);
+  _perf->stop(total);
+
+  matches.add(_nativeIndices.data(), headers.size());
+
+  if (_benchmark->measureLatency) _measureLatencies(headers, suffix);
+}
 
-      _outputHeadersToFile(headers); // output headers
+void BenchmarkExecutor::_measureLatencies(const Generic::PacketHeaderColumns& headers, const std::string& suffix) {
+  Base* algorithm = _algWrapper->getAlgorithm();
+  size_t headerSize = (_benchmark->nativeClassification ? algorithm->nativeHeaderSize() : 0);
+  LatencyHistogram latencies;
+  Generic::RuleIndexSet index;
+  uint32_t nativeIndex;
+
+  { // the additional lookups must not distort the regular time and memory results
+    MeteringSuspendGuard suspendGuard(*_chrono, *_memManager, *_perf);
+    for (size_t i = 0; i < headers.size(); ++i) {
+      if (headerSize == 0) {
+        headers.toHeaderSet(_lineHeaders, i, 1); // conversion isn't measured
+
+        Chronoclock::time_point start = Chronoclock::now();
+        algorithm->classify(_lineHeaders, index);
+        Chronoclock::time_point stop = Chronoclock::now();
+        latencies.record(_latencyWithoutOverhead(start, stop));
+      } else { // headers are still converted from the regular classification
+        Chronoclock::time_point start = Chronoclock::now();
+        algorithm->classifyNative(_nativeHeaders.data() + i * headerSize, 1, &nativeIndex);
+        Chronoclock::time_point stop = Chronoclock::now();
+        latencies.record(_latencyWithoutOverhead(start, stop));
+      }
     }
+  }
+  _lineHeaders.clear();
+
+  _chrono->record("lookup" + suffix, latencies);
+}
+
+uint64_t BenchmarkExecutor::_latencyWithoutOverhead(Chronoclock::time_point start, Chronoclock::time_point stop) const {
+  uint64_t span = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  return (span > _chrono->getOverhead() ? span - _chrono->getOverhead() : 0);
+}
+
+template <class Source>
+void BenchmarkExecutor::_classifyStream(Source& source, MatchSink& matches) {
+  Generic::PacketHeaderColumns headers;
+  size_t batchSize = std::max(1u, _benchmark->rndHeaderConfig.batchSize);
+
+  while (source.next(headers, batchSize)) {
+    _classifyHeaders(headers, matches);
+    _keepGeneratedHeaders(headers);
+  }
+}
+
+void BenchmarkExecutor::_classify(MatchSink& matches) {
+  if (_benchmark->generateHeaders) { // generate header data
+    Generic::PacketHeaderColumns headers;
+    HeaderGenerator hdrGenerator;
+
+    hdrGenerator.configure(_benchmark->fieldStructure, _benchmark->rndHeaderConfig);
 
-    // handle remaining headers
-    unsigned int headerRemaining = (_benchmark->rndHeaderConfig.totalHeaders - headerCnt);
+    // next batch is generated by a separate thread, while the current one is classified
+    // (the producer must not run on the cpu of the pinned thread, so it is released meanwhile)
+    _cpu.release(true);
+    HeaderPipeline pipeline(hdrGenerator, _benchmark->rndHeaderConfig.totalHeaders, _benchmark->rndHeaderConfig.batchSize);
+    _cpu.repin();
 
-    if (headerRemaining > 0) {
-      hdrGenerator.generateHeaders(headerRemaining, headers);
-      _classifyHeaders(headers, indicesBatch);
-      
-      // copy resulting indices to container for all indices
-      _indicesPushBack(indicesBatch, indices);
+    while (pipeline.next(headers)) {
+      _classifyHeaders(headers, matches); // indices of each batch are streamed into the sink
 
       _outputHeadersToFile(headers); // output headers
+      _keepGeneratedHeaders(headers);
     }
 
+  } else if (_benchmark->hasHeaderTrace()) { // stream headers from the mapped trace
+    Generic::HeaderTraceReader trace(_benchmark->headerTrace);
+    if (trace.fieldBits() != _benchmark->fieldStructure)
+      throw "Fields of the header trace do not match the header structure (BenchmarkExecutor::_classify).";
+    _classifyStream(trace, matches);
+
+  } else if (_benchmark->hasPcap()) { // stream headers of the captured packets
+    PcapSource capture(_benchmark->pcap, _benchmark->fieldStructure);
+    _classifyStream(capture, matches);
+
   } else { // feed with given header data
-    _classifyHeaders(_benchmark->headers, indices);
+    _classifyHeaders(*_benchmark->headers, matches);
+  }
+
+}
+
+void BenchmarkExecutor::_nextUpdateHeaders(Generic::PacketHeaderColumns& headers, HeaderGenerator* generator, const Generic::HeaderTraceReader* trace, PcapSource* capture, size_t& position) const {
+  unsigned int amount = _benchmark->ruleUpdates.headersPerUpdate;
+  if (generator != nullptr) { // random headers with the configured distributions
+    generator->generateHeaders(amount, headers);
+    return;
+  }
+  if (capture != nullptr) { // captured packets are replayed endlessly
+    capture->next(headers, amount);
+    return;
+  }
+
+  // explicit headers (or those of a trace) are classified repeatedly in their order
+  const Generic::PacketHeaderColumns& source = *_benchmark->headers;
+  size_t total = (trace != nullptr ? trace->size() : source.size());
+  headers.setStructure(_benchmark->fieldStructure);
+  if (total == 0) return;
+
+  headers.reserve(amount);
+  while (headers.size() < amount) {
+    if (position >= total) position = 0;
+    size_t count = std::min<size_t>(amount - headers.size(), total - position);
+    if (trace != nullptr) trace->read(position, count, headers);
+    else headers.append(source, position, count);
+    position += count;
+  }
+}
+
+void BenchmarkExecutor::_replayUpdates(UpdateResults& updates) {
+  const RuleUpdateConfiguration& config = _benchmark->ruleUpdates;
+  if (config.trace.empty()) return;
+
+  Base* algorithm = _algWrapper->getAlgorithm();
+  Generic::PacketHeaderColumns headers;
+  MatchSink matches; // indices refer to a changing rule set, so they aren't evaluated
+  std::unique_ptr<HeaderGenerator> generator;
+  std::unique_ptr<Generic::HeaderTraceReader> trace;
+  std::unique_ptr<PcapSource> capture;
+  size_t position = 0;
+
+  if (_benchmark->generateHeaders && config.headersPerUpdate > 0) {
+    generator.reset(new HeaderGenerator);
+    generator->configure(_benchmark->fieldStructure, _benchmark->rndHeaderConfig);
+  }
+  else if (_benchmark->hasHeaderTrace() && config.headersPerUpdate > 0) {
+    trace.reset(new Generic::HeaderTraceReader(_benchmark->headerTrace));
+  }
+  else if (_benchmark->hasPcap() && config.headersPerUpdate > 0) {
+    PcapConfiguration endless(_benchmark->pcap);
+    endless.replay = std::numeric_limits<unsigned int>::max();
+    capture.reset(new PcapSource(endless, _benchmark->fieldStructure));
+  }
+
+  for (RuleUpdateTrace::const_iterator iter(config.trace.cbegin()); iter != config.trace.cend(); ++iter) {
+    // lookups with the current state of the rule set
+    if (config.headersPerUpdate > 0) {
+      _nextUpdateHeaders(headers, generator.get(), trace.get(), capture.get(), position);
+      _classifyHeaders(headers, matches, " (updates)");
+      updates.headers += headers.size();
+    }
+
+    _perf->start("rule update");
+    _chrono->start("rule update");
+    _heap->start("rule update");
+    Chronoclock::time_point start = Chronoclock::now();
+    if ((*iter)->type == RuleUpdate::INSERT)
+      algorithm->ruleAdded((*iter)->index, (*iter)->rule);
+    else
+      algorithm->ruleRemoved((*iter)->index);
+    Chronoclock::time_point stop = Chronoclock::now();
+    _heap->stop();
+    _chrono->stop("rule update");
+    _perf->stop("rule update");
+
+    updates.latencies.push_back(_latencyWithoutOverhead(start, stop));
   }
 
-  // feed with changes of rules
-  // TODO
+  // throughput in Mpps is the number of headers per microsecond
+  if (_chrono->contains("total") && _chrono->getTimeNano("total") > 0)
+    updates.baselineMpps = _benchmark->getHeaderNumber() * 1000.0 / _chrono->getTimeNano("total");
+  if (_chrono->contains("total (updates)") && _chrono->getTimeNano("total (updates)") > 0)
+    updates.updateMpps = updates.headers * 1000.0 / _chrono->getTimeNano("total (updates)");
 }
 
-void BenchmarkExecutor::_outputHeadersToFile(const Generic::PacketHeaderSet& headers) const {
-  if (_benchmark->rndHeaderConfig.outputToFile) {
+bool BenchmarkExecutor::_isParallel() const {
+#ifdef MEMTRACE_DISABLED
+  return (_benchmark->threads > 1);
+#else
+  return false; // MemTrace-instances can't be shared between threads
+#endif
+}
+
+void BenchmarkExecutor::_keepGeneratedHeaders(const Generic::PacketHeaderColumns& headers) {
+  if (!_isParallel() || _warmingUp) return;
+
+  if (_generatedHeaders.empty()) _generatedHeaders.setStructure(_benchmark->fieldStructure);
+  _generatedHeaders.append(headers);
+}
+
+void BenchmarkExecutor::_classifyParallel(const MatchSink& expected, ScalingResults& scaling) {
+  const Generic::PacketHeaderColumns& source = (_benchmark->streamsHeaders() ? _generatedHeaders : *_benchmark->headers);
+  Generic::PacketHeaderSet headers; // workers classify line-based headers
+  source.toHeaderSet(headers, 0, source.size());
+  Base* algorithm = _algWrapper->getAlgorithm();
+  Generic::RuleIndexSet indices;
+  std::vector<double> referenceMpps;
+
+  { // metering isn't thread-safe: suspend it, while the classifier is shared
+    MeteringSuspendGuard suspendGuard(*_chrono, *_memManager, *_perf);
+    _cpu.release(); // worker threads must not inherit the pinning
+    try {
+      ParallelClassifier(algorithm, 1).classify(headers, indices, scaling.referenceMpps, referenceMpps);
+      ParallelClassifier(algorithm, _benchmark->threads).classify(headers, indices, scaling.aggregateMpps, scaling.threadMpps);
+    } catch (...) {
+      _cpu.repin();
+      throw;
+    }
+    _cpu.repin();
+  }
+
+  scaling.threads = _benchmark->threads;
+  _generatedHeaders.clear();
+
+  MatchSink matches(_benchmark->rules->size(), false);
+  matches.add(indices);
+  if (!matches.sameMatches(expected))
+    std::cerr << "Matching indices of the concurrent classification differ from the single-threaded classification!" << std::endl;
+}
+
+void BenchmarkExecutor::_setRules() {
+  Base* algorithm = _algWrapper->getAlgorithm();
+  if (!_snapshots || !algorithm->supportsSnapshots()) {
+    _heap->start("set rules");
+    algorithm->setRules(_benchmark->rules->get());
+    _heap->stop();
+    return;
+  }
+
+  // a loaded classifier takes the same heap as a built one
+  _heap->start("set rules");
+  bool loaded = _snapshots->load(_snapshotKey, *algorithm, _benchmark->rules->get());
+  _heap->stop();
+  if (loaded) {
+    ++_snapshotLoads;
+    return;
+  }
+
+  // build once and keep it for all further runs
+  _heap->start("set rules");
+  algorithm->setRules(_benchmark->rules->get());
+  _heap->stop();
+  ++_snapshotBuilds;
+  if (!_snapshots->store(_snapshotKey, *algorithm))
+    std::cout << "Failed to store the snapshot of the classifier in '" << _snapshots->filename(_snapshotKey) << "'." << std::endl;
+}
+
+void BenchmarkExecutor::_openAccessTrace(unsigned int run) {
+#if !defined(MEMTRACE_DISABLED) && defined(MEMTRACE_BACKENDS)
+  if (!_benchmark->traceAccesses) return;
+  try {
+    _accessTrace = std::make_shared<Memory::AccessTraceWriter>(_resultsHandler.accessTraceFilename(run));
+    _memManager->setAccessTrace(_accessTrace);
+  } catch (const char* ex) {
+    std::cout << "Failed to create the access trace '" << _resultsHandler.accessTraceFilename(run) << "'. Reason: " << ex << std::endl;
+  }
+#else
+  (void)run;
+#endif
+}
+
+void BenchmarkExecutor::_closeAccessTrace() {
+  if (!_accessTrace) return;
+  _accessTraceRecords.push_back(_accessTrace->size());
+  try {
+    _accessTrace->close();
+  } catch (const char* ex) {
+    std::cout << "Failed to write the access trace of run " << _accessTraceRecords.size() << ". Reason: " << ex << std::endl;
+  }
+  _accessTrace.reset();
+}
+
+void BenchmarkExecutor::_accessTraceInfo(BenchmarkInfoVector& info) const {
+  if (_accessTraceRecords.empty()) return;
+
+  std::string records;
+  for (size_t run = 0; run < _accessTraceRecords.size(); ++run)
+    records += (run > 0 ? ", " : "") + std::to_string(_accessTraceRecords[run]);
+  info.push_back(std::make_pair("access traces", _benchmark->id + "_accesses_<run>.trace (" + records + " accesses)"));
+}
+
+void BenchmarkExecutor::_snapshotInfo(BenchmarkInfoVector& info) const {
+  if (_snapshotLoads + _snapshotBuilds == 0) return;
+
+  info.push_back(std::make_pair("classifier snapshot", _snapshots->filename(_snapshotKey) + " (built in " + 
+    std::to_string(_snapshotBuilds) + ", loaded in " + std::to_string(_snapshotLoads) + " of " + 
+    std::to_string(_snapshotBuilds + _snapshotLoads) + " runs)"));
+}
+
+void BenchmarkExecutor::_outputHeadersToFile(const Generic::PacketHeaderColumns& headers) const {
+  if (_benchmark->rndHeaderConfig.outputToFile && !_warmingUp) {
     _resultsHandler.headers(headers);
   }
 }
 
+void BenchmarkExecutor::_pinThread() {
+  if (_benchmark->cpuAffinity < 0) return;
+
+  if (!_cpu.pin(_benchmark->cpuAffinity))
+    std::cout << "Failed to pin the classifying thread to cpu " << _benchmark->cpuAffinity << 
+      ". Continuing without pinning." << std::endl;
+}
+
+void BenchmarkExecutor::_warmUp() {
+  for (unsigned int i = 0; i < _benchmark->warmupRuns; ++i) {
+    std::cout << "Warm-up run " << std::to_string(i+1) << " of " << 
+      std::to_string(_benchmark->warmupRuns) << std::flush;
+
+    _warmingUp = true;
+    try {
+      _setRules();
+      MatchSink matches(_benchmark->rules->size(), false); // indices aren't evaluated
+      _classify(matches);
+    } catch (const char* ex) {
+      _warmingUp = false;
+      throw ex;
+    }
+    _warmingUp = false;
+
+    _resetSetup(); // discard all results of the warm-up
+    std::cout << "\xd" << std::flush;
+  }
+}
+
+void BenchmarkExecutor::_cpuInfo(BenchmarkInfoVector& info) const {
+  int cpu = (_cpu.getCpu() >= 0 ? _cpu.getCpu() : CpuEnvironment::currentCpu());
+
+  std::string model = CpuEnvironment::model();
+  if (!model.empty()) info.push_back(std::make_pair("cpu model", model));
+
+  std::string affinity = (cpu >= 0 ? std::to_string(cpu) : "unknown");
+  affinity += (_cpu.getCpu() >= 0 ? " (pinned)" : " (not pinned, last used)");
+  info.push_back(std::make_pair("cpu", affinity));
+
+  // range of the observed frequencies after each testrun
+  if (!_cpuFrequencies.empty()) {
+    double minimum = *std::min_element(_cpuFrequencies.cbegin(), _cpuFrequencies.cend());
+    double maximum = *std::max_element(_cpuFrequencies.cbegin(), _cpuFrequencies.cend());
+    std::string frequency = (minimum > 0 ? std::to_string((unsigned int)minimum) : "unknown");
+    if ((unsigned int)minimum != (unsigned int)maximum) frequency += " - " + std::to_string((unsigned int)maximum);
+    if (minimum > 0) frequency += " MHz";
+    info.push_back(std::make_pair("cpu frequency", frequency));
+  }
+
+  std::string governor = CpuEnvironment::governor(cpu);
+  info.push_back(std::make_pair("cpu governor", (governor.empty() ? "unknown" : governor)));
+}
+
 void BenchmarkExecutor::_resetSetup() {
   _memManager->reset();
+  _closeAccessTrace(); // the manager doesn't pass accesses to it anymore
   _chrono->reset();
+  _perf->reset();
+  _heap->reset();
   _logger->reset();
   _algWrapper->getAlgorithm()->reset();
   _resultsHandler.setBenchmark(_benchmark); // create a new filename
@@ -110,29 +478,74 @@ void BenchmarkExecutor::configure(std::shared_ptr<Benchmark> b) {
 }
 
 bool BenchmarkExecutor::execute() {
+  // rules of a file are loaded with the first benchmark, which needs them, and shared with all others
+  _benchmark->rules->get();
+
   if (!_loadAlgorithm()) return false; // create algorithm instance
 
   _results.clear(); // remove previous results
+  _accessTraceRecords.clear();
   _setupMemManager();
   _setupChronoManager(); 
   _setupLogTagManager(); 
+  _setupPerfManager();
+  _setupHeapMeter();
   // set algorithm parameters
   _algWrapper->getAlgorithm()->setParameters(_benchmark->algParameter);
 
+#ifndef MEMTRACE_DISABLED
+  if (_benchmark->threads > 1)
+    std::cout << "Concurrent classification with " << _benchmark->threads << " threads is only " <<
+      "available with disabled memory metering (build_all_nomem). Using a single thread." << std::endl;
+#endif
+
+  // snapshots of the classifier are identified by algorithm, parameters and rule set
+  _snapshotLoads = 0;
+  _snapshotBuilds = 0;
+  if (_snapshots && _algWrapper->getAlgorithm()->supportsSnapshots())
+    _snapshotKey = SnapshotCache::key(_relativePath + _benchmark->algFilename, _benchmark->algParameter, _benchmark->rules->get());
+
+  // pin the classifying thread and warm up caches, before anything is measured
+  // (the pin is released on every path, so a failed benchmark doesn't pin the next one)
+  CpuUnpinGuard unpinGuard(_cpu);
+  _pinThread();
+  _cpuFrequencies.clear();
+  _warmUp();
+
   for (unsigned int i = 0; i < _benchmark->numberRuns; ++i) {
     std::unique_ptr<TestrunResults> runResults(new TestrunResults);
     std::cout << "Run test " << std::to_string(i+1) << " of " << 
       std::to_string(_benchmark->numberRuns) << std::flush;
     
+    // trace all memory accesses of this run (including building the classifier)
+    _openAccessTrace(i + 1);
+
     // set rule set
-    _algWrapper->getAlgorithm()->setRules(_benchmark->rules);
+    _setRules();
 
     // organize header data and classify header
-    _classify(runResults->indices);
+    // full indices are only kept for an output of the first run, otherwise just their digest
+    runResults->matches = MatchSink(_benchmark->rules->size(), (_benchmark->outputMatches && i == 0));
+    _classify(runResults->matches);
+
+    // classify same headers again with multiple threads for throughput and scaling
+    if (_isParallel())
+      _classifyParallel(runResults->matches, runResults->scaling);
+
+    // change the rule set as given by the trace of rule updates
+    _replayUpdates(runResults->updates);
 
     // get results from chrono- and memory-manager
     _chrono->getAllResults(runResults->chronoRes);
+    _chrono->getAllLatencies(runResults->latencies);
+    _perf->getAllResults(runResults->counters);
+    _heap->getAllResults(runResults->heap);
+    if (_benchmark->samplingRate > 1) {
+      runResults->sampling.batchNanos = (_chrono->contains("total") ? _chrono->getTimeNano("total") : 0);
+      _chrono->getAllSamples(runResults->sampling.samples);
+    }
     _memManager->getMemResultGroups(runResults->memRes);
+    _memManager->getCacheResults(runResults->cache);
     // copy results from log tag manager
     for (auto iter = _logger->getTags().cbegin(); iter != _logger->getTags().cend(); ++iter) {
       std::string logline;
@@ -141,8 +554,9 @@ bool BenchmarkExecutor::execute() {
       logline.append((*iter)->tag);
       runResults->logTags.push_back(logline);
     }
-    
+
     _results.push_back(std::move(runResults)); // save results
+    _cpuFrequencies.push_back(CpuEnvironment::frequencyMHz(_cpu.getCpu() >= 0 ? _cpu.getCpu() : CpuEnvironment::currentCpu()));
 
     _resetSetup(); // reset for next repetition
 
@@ -156,6 +570,10 @@ bool BenchmarkExecutor::execute() {
   // evaluate all stored results
   BenchmarkEvaluation evaluation;
   Evaluator::evalBenchmark(_benchmark, _results, evaluation);
+  _cpuInfo(evaluation.benchmarkInfo);
+  _snapshotInfo(evaluation.benchmarkInfo);
+  _accessTraceInfo(evaluation.benchmarkInfo);
+  _cpu.unpin(); // next benchmark may use another cpu
   _resultsHandler.evaluation(evaluation);
 
   return true;
@@ -0,0 +1,122 @@
+#include <core/CpuEnvironment.hpp>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+
+bool CpuEnvironment::_setAffinity(const std::vector<unsigned int>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::vector<unsigned int>::const_iterator iter(cpus.cbegin()); iter != cpus.cend(); ++iter)
+    if (*iter < CPU_SETSIZE) CPU_SET(*iter, &set);
+
+  return sched_setaffinity(0, sizeof(set), &set) == 0; // 0: calling thread
+}
+
+bool CpuEnvironment::pin(unsigned int cpu) {
+  if (_cpu < 0) { // keep the affinity from before the first pinning
+    _allowed = allowedCpus();
+    if (_allowed.empty()) return false;
+  }
+
+  if (!_setAffinity(std::vector<unsigned int>(1, cpu))) return false;
+  _cpu = cpu;
+  return true;
+}
+
+std::vector<unsigned int> CpuEnvironment::allowedCpus() {
+  std::vector<unsigned int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+
+  for (unsigned int i = 0; i < CPU_SETSIZE; ++i)
+    if (CPU_ISSET(i, &set)) cpus.push_back(i);
+  return cpus;
+}
+
+int CpuEnvironment::currentCpu() {
+  return sched_getcpu();
+}
+
+#else
+
+bool CpuEnvironment::_setAffinity(const std::vector<unsigned int>&) {
+  return false;
+}
+
+bool CpuEnvironment::pin(unsigned int) {
+  return false;
+}
+
+std::vector<unsigned int> CpuEnvironment::allowedCpus() {
+  return std::vector<unsigned int>();
+}
+
+int CpuEnvironment::currentCpu() {
+  return -1;
+}
+
+#endif
+
+void CpuEnvironment::release(bool avoidPinned) {
+  if (_cpu < 0) return;
+
+  std::vector<unsigned int> cpus;
+  for (std::vector<unsigned int>::const_iterator iter(_allowed.cbegin()); iter != _allowed.cend(); ++iter)
+    if (!avoidPinned || (int)*iter != _cpu) cpus.push_back(*iter);
+  if (cpus.empty()) cpus = _allowed; // the pinned cpu is the only one
+
+  _setAffinity(cpus);
+}
+
+void CpuEnvironment::repin() {
+  if (_cpu >= 0) _setAffinity(std::vector<unsigned int>(1, _cpu));
+}
+
+std::string CpuEnvironment::model() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0 && line.find(':') != std::string::npos)
+      return line.substr(line.find(':') + 2);
+  }
+  return "";
+}
+
+double CpuEnvironment::frequencyMHz(int cpu) {
+  if (cpu < 0) return 0;
+
+  // current frequency from cpufreq in kHz
+  std::ifstream scaling("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_cur_freq");
+  double kHz = 0;
+  if (scaling >> kHz && kHz > 0) return kHz / 1000.0;
+
+  // otherwise, use the frequency reported for the processor in cpuinfo
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  int processor = -1;
+  while (std::getline(cpuinfo, line)) {
+    size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+
+    if (line.compare(0, 9, "processor") == 0)
+      std::istringstream(line.substr(colon + 1)) >> processor;
+    else if (line.compare(0, 7, "cpu MHz") == 0 && processor == cpu) {
+      double mhz = 0;
+      std::istringstream(line.substr(colon + 1)) >> mhz;
+      return mhz;
+    }
+  }
+  return 0;
+}
+
+std::string CpuEnvironment::governor(int cpu) {
+  if (cpu < 0) return "";
+
+  std::ifstream scaling("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor");
+  std::string name;
+  scaling >> name;
+  return name;
+}
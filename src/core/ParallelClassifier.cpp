@@ -0,0 +1,99 @@
+#include <core/ParallelClassifier.hpp>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <thread>
+#include <metering/time/Chronograph.hpp>
+
+namespace {
+
+/** Holds the slice of headers and the results of one worker thread. */
+struct Worker {
+  Generic::PacketHeaderSet headers;
+  Generic::RuleIndexSet indices;
+  double microsec;
+  const char* error;
+
+  Worker() : headers(), indices(), microsec(0), error(nullptr) {}
+};
+
+/** Returns the elapsed time since start in microseconds. */
+inline double elapsedMicrosec(const Chronoclock::time_point& start) {
+  return std::chrono::duration<double, std::micro>(Chronoclock::now() - start).count();
+}
+
+/** Headers per microsecond equal million packets per second. */
+inline double calcMpps(size_t headers, double microsec) { return (microsec > 0 ? headers / microsec : 0); }
+
+} // namespace
+
+ParallelClassifier::ParallelClassifier(Base* algorithm, unsigned int threads) : _algorithm(algorithm), _threads(threads) {
+  if (_algorithm == nullptr) throw "No algorithm instance given (ParallelClassifier).";
+  if (_threads == 0) throw "At least one worker thread is necessary (ParallelClassifier).";
+}
+
+void ParallelClassifier::classify(Generic::PacketHeaderSet& headers, Generic::RuleIndexSet& indices, double& aggregateMpps, std::vector<double>& threadMpps) {
+  std::vector<Worker> workers(_threads);
+
+  // hand over contiguous slices of (almost) equal size to the workers
+  size_t total = headers.size();
+  size_t pos = 0;
+  for (unsigned int w = 0; w < _threads; ++w) {
+    size_t sliceSize = total / _threads + (w < total % _threads ? 1 : 0);
+    workers[w].headers.reserve(sliceSize);
+    for (size_t i = 0; i < sliceSize; ++i)
+      workers[w].headers.push_back(std::move(headers[pos++]));
+  }
+
+  std::atomic<unsigned int> ready(0);
+  std::atomic<bool> go(false);
+  std::vector<std::thread> pool;
+  bool spawnFailed = false;
+
+  for (unsigned int w = 0; w < _threads && !spawnFailed; ++w) {
+    Worker& worker = workers[w];
+    try {
+      pool.push_back(std::thread([this, &worker, &ready, &go]() {
+        ++ready;
+        while (!go) std::this_thread::yield(); // start all workers at once
+
+        Chronoclock::time_point start = Chronoclock::now();
+        try {
+          _algorithm->classify(worker.headers, worker.indices);
+        } catch (const char* ex) {
+          worker.error = ex;
+        }
+        worker.microsec = elapsedMicrosec(start);
+      }));
+    } catch (const std::system_error&) {
+      spawnFailed = true;
+    }
+  }
+
+  // wait until all workers are ready, then measure wall-clock time of all
+  while (!spawnFailed && ready < pool.size()) std::this_thread::yield();
+  Chronoclock::time_point start = Chronoclock::now();
+  go = true;
+  for (std::vector<std::thread>::iterator iter(pool.begin()); iter != pool.end(); ++iter)
+    iter->join();
+  double wallMicrosec = elapsedMicrosec(start);
+
+  // restore header set and collect indices in order of headers
+  const char* error = (spawnFailed ? "Failed to create worker threads (ParallelClassifier)." : nullptr);
+  pos = 0;
+  indices.clear();
+  indices.reserve(total);
+  threadMpps.clear();
+  for (std::vector<Worker>::iterator iter(workers.begin()); iter != workers.end(); ++iter) {
+    for (Generic::PacketHeaderSet::iterator line(iter->headers.begin()); line != iter->headers.end(); ++line)
+      headers[pos++] = std::move(*line);
+
+    indices.insert(indices.end(), iter->indices.cbegin(), iter->indices.cend());
+    threadMpps.push_back(calcMpps(iter->headers.size(), iter->microsec));
+    if (error == nullptr) error = iter->error;
+  }
+
+  if (error != nullptr) throw error;
+  aggregateMpps = calcMpps(total, wallMicrosec);
+}
+
@@ -0,0 +1,130 @@
+#include <core/SnapshotCache.hpp>
+#include <generics/Snapshot.hpp>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** header at the beginning of each snapshot file */
+struct SnapshotFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint64_t size;
+  uint64_t checksum;
+};
+
+/** magic number of a snapshot file ("CSNP") */
+static const uint32_t SNAPSHOT_MAGIC = 0x504e5343;
+/** is increased, if the format of the header changes */
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+SnapshotCache::SnapshotCache(const std::string& directory) : _directory(directory) {
+  if (!_directory.empty() && _directory.back() != '/') _directory += '/';
+}
+
+uint64_t SnapshotCache::key(const std::string& algorithmFile, const std::vector<double>& params, const Generic::RuleSet& rules) {
+  std::ostringstream str;
+
+  // a rebuilt library may construct another classifier
+  size_t slash = algorithmFile.find_last_of('/');
+  str << (slash == std::string::npos ? algorithmFile : algorithmFile.substr(slash + 1));
+  struct stat st;
+  if (stat(algorithmFile.c_str(), &st) == 0)
+    str << ":" << st.st_size << ":" << st.st_mtime;
+  str << ";";
+
+  // the exact bits of each parameter, as a decimal output would round them
+  for (std::vector<double>::const_iterator iter(params.cbegin()); iter != params.cend(); ++iter) {
+    uint64_t bits;
+    memcpy(&bits, &*iter, sizeof(bits));
+    str << std::hex << bits << std::dec << ",";
+  }
+  str << ";";
+
+  Generic::VarValue min, max;
+  for (Generic::RuleSet::const_iterator rule(rules.cbegin()); rule != rules.cend(); ++rule) {
+    for (Generic::Rule::const_iterator atom((*rule)->cbegin()); atom != (*rule)->cend(); ++atom) {
+      (*atom)->toRange(min, max);
+      str << (int)(*atom)->getType() << (*atom)->isWildcard() << ":" << min << "-" << max << ",";
+    }
+    str << ";";
+  }
+
+  std::string text(str.str());
+  return Generic::fnv1a(Generic::FNV_OFFSET, text.data(), text.size());
+}
+
+std::string SnapshotCache::filename(uint64_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.snapshot", (unsigned long long)key);
+  return _directory + name;
+}
+
+bool SnapshotCache::load(uint64_t key, Base& algorithm, const Generic::RuleSet& rules) const {
+  int fd = open(filename(key).c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotFileHeader)) {
+    close(fd);
+    return false;
+  }
+
+  size_t size = st.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // mapping stays valid
+  if (mapping == MAP_FAILED) return false;
+
+  const uint8_t* data = static_cast<const uint8_t*>(mapping);
+  const uint8_t* image = data + sizeof(SnapshotFileHeader);
+  SnapshotFileHeader header;
+  memcpy(&header, data, sizeof(header));
+
+  bool valid = header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION && header.key == key &&
+    header.size == size - sizeof(header) && header.checksum == Generic::fnv1a(Generic::FNV_OFFSET, image, header.size);
+
+  if (valid) {
+    try {
+      algorithm.loadSnapshot(rules, image, header.size);
+    } catch (const char* ex) {
+      munmap(mapping, size);
+      throw ex;
+    }
+  }
+
+  munmap(mapping, size);
+  return valid;
+}
+
+bool SnapshotCache::store(uint64_t key, const Base& algorithm) const {
+  std::vector<uint8_t> image;
+  algorithm.saveSnapshot(image);
+
+  SnapshotFileHeader header;
+  header.magic = SNAPSHOT_MAGIC;
+  header.version = SNAPSHOT_VERSION;
+  header.key = key;
+  header.size = image.size();
+  header.checksum = Generic::fnv1a(Generic::FNV_OFFSET, image.data(), image.size());
+
+  // write to a temporary file first, so that concurrent benchmarks never read a partial snapshot
+  std::string name(filename(key));
+  std::string temporary(name + "." + std::to_string(getpid()));
+  FILE* file = fopen(temporary.c_str(), "wb");
+  if (!file) return false;
+
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+    (image.empty() || fwrite(image.data(), image.size(), 1, file) == 1);
+  written = (fclose(file) == 0) && written;
+
+  if (!written || rename(temporary.c_str(), name.c_str()) != 0) {
+    remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
@@ -1,6 +1,10 @@
 #include <evaluation/Evaluator.hpp>
 #include <utility>
 #include <string>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <algorithm>
 #include <evaluation/Statistics.hpp>
 
 void Evaluator::generateBenchmarkInfo(BenchmarkPtr b, BenchmarkInfoVector& info) {
@@ -26,19 +30,35 @@ void Evaluator::generateBenchmarkInfo(BenchmarkPtr b, BenchmarkInfoVector& info)
   info.push_back(std::make_pair("fields", fieldStructure));
 
   // number of rules in classifier
-  std::string classifierSize(std::to_string(b->rules.size()) + " rules");
+  std::string classifierSize(std::to_string(b->rules->size()) + " rules");
   info.push_back(std::make_pair("classifier", classifierSize));
 
   // number of explicit or random generated headers
   std::string numberHeaders = std::to_string(b->getHeaderNumber());
   if (b->generateHeaders) { // random header generation
     numberHeaders += " randomly generated";
+  } else if (b->hasHeaderTrace()) {
+    numberHeaders += " from trace " + b->headerTrace;
+  } else if (b->hasPcap()) {
+    numberHeaders += " from capture " + b->pcap.filename + (b->pcap.replay > 1 ? " (replayed " + std::to_string(b->pcap.replay) + " times)" : "");
   } else {
     numberHeaders += " items";
   }
   info.push_back(std::make_pair("headers", numberHeaders));
 
   info.push_back(std::make_pair( "testruns", std::to_string(b->numberRuns) ));
+  info.push_back(std::make_pair( "threads", std::to_string(b->threads) ));
+  if (b->samplingRate > 1)
+    info.push_back(std::make_pair( "sampling", "1 in " + std::to_string(b->samplingRate) + " headers timed" ));
+  if (b->warmupRuns > 0)
+    info.push_back(std::make_pair( "warm-up runs", std::to_string(b->warmupRuns) ));
+
+  // number of replayed rule updates
+  if (b->ruleUpdates.trace.size() > 0) {
+    std::string ruleUpdates = std::to_string(b->ruleUpdates.trace.size()) + " (" + 
+      std::to_string(b->ruleUpdates.headersPerUpdate) + " headers before each update)";
+    info.push_back(std::make_pair( "rule updates", ruleUpdates ));
+  }
 }
 
 void Evaluator::createChronoMeasurements(const BenchmarkResults& res, ChronoEvaluation& chrono) {
@@ -192,31 +212,23 @@ bool Evaluator::compareIndices(const BenchmarkResults& res) {
   // trivial case: no testruns
   if (res.size() == 0) return true;
 
-  // iterate over all runs and compare number of indices
-  unsigned int numberIndices = res[0]->indices.size();
+  // compare number and digest of indices of first testrun with each other run
   for (BenchmarkResults::const_iterator trItr(res.cbegin() + 1); trItr != res.cend(); ++trItr) {
-    if ((*trItr)->indices.size() != numberIndices) return false;
-  }
-
-  // compare indices of first testrun with each other run
-  for (unsigned int i = 0; i < numberIndices; ++i) {
-    for (BenchmarkResults::const_iterator trItr(res.cbegin() + 1); trItr != res.cend(); ++trItr) {
-      if (res[0]->indices[i] != (*trItr)->indices[i]) return false;
-    }
+    if (!res[0]->matches.sameMatches((*trItr)->matches)) return false;
   }
 
   return true;
 }
 
-void Evaluator::createHistogram(const Generic::RuleIndexSet& indices, unsigned int numberRules, std::vector<HistogramPair>& hist) {
-  if (numberRules == 0) return; // no rules, no histogram
+void Evaluator::createHistogram(const MatchSink& matches, std::vector<HistogramPair>& hist) {
+  const std::vector<uint64_t>& hits = matches.getHits();
+  if (hits.size() == 0) return; // no rules, no histogram
 
-  Histogram h(numberRules);
+  Histogram h(hits.size());
 
-  // iterate over all indices
-  for (Generic::RuleIndexSet::const_iterator iter(indices.cbegin()); iter != indices.cend(); ++iter) {
-    if ((*iter) < Generic::noRuleIsMatching()) h.occured((*iter));
-  }
+  // matches per rule were already counted during classification
+  for (unsigned int id = 0; id < hits.size(); ++id)
+    h.occured(id, hits[id]);
 
   h.getSorted(hist);
 }
@@ -230,6 +242,236 @@ void Evaluator::joinLogTags(const BenchmarkResults& res, LogTagVector& tags) {
   }
 }
 
+void Evaluator::createScalingStatistics(const BenchmarkResults& res, ScalingEvaluation& scaling) {
+  // stop here, if no concurrent classification was done
+  if (res.size() == 0 || res[0]->scaling.threads == 0) return;
+
+  unsigned int threads = res[0]->scaling.threads;
+  Series<double> sReference;
+  Series<double> sAggregate;
+  Series<double> sEfficiency;
+  std::vector<Series<double>> sThreads(threads);
+
+  // iterate over all testruns
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    const ScalingResults& runScaling = (*trItr)->scaling;
+    if (runScaling.threads != threads || runScaling.threadMpps.size() != threads)
+      throw "The number of worker threads differs between testruns (Evaluator::createScalingStatistics).";
+
+    sReference.data.push_back(runScaling.referenceMpps);
+    sAggregate.data.push_back(runScaling.aggregateMpps);
+    sEfficiency.data.push_back( (runScaling.referenceMpps > 0 ? runScaling.aggregateMpps / (threads * runScaling.referenceMpps) : 0) );
+
+    for (unsigned int t = 0; t < threads; ++t)
+      sThreads[t].data.push_back(runScaling.threadMpps[t]);
+  }
+
+  scaling.threads = threads;
+  scaling.referenceMpps = MeanValue(sReference);
+  scaling.aggregateMpps = MeanValue(sAggregate);
+  scaling.efficiency = MeanValue(sEfficiency);
+  for (std::vector<Series<double>>::const_iterator iter(sThreads.cbegin()); iter != sThreads.cend(); ++iter)
+    scaling.threadMpps.push_back(MeanValue(*iter));
+}
+
+void Evaluator::createUpdateStatistics(BenchmarkPtr b, const BenchmarkResults& res, UpdateEvaluation& updates) {
+  const RuleUpdateTrace& trace = b->ruleUpdates.trace;
+
+  // stop here, if no rule updates were replayed
+  if (res.size() == 0 || trace.size() == 0) return;
+
+  Series<double> sInsert;
+  Series<double> sRemove;
+  Series<double> sBaseline;
+  Series<double> sUpdate;
+  std::vector<Series<double>> sLatencies(trace.size());
+
+  // iterate over all testruns
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    const UpdateResults& runUpdates = (*trItr)->updates;
+    if (runUpdates.latencies.size() != trace.size())
+      throw "The number of rule updates differs from the configured trace (Evaluator::createUpdateStatistics).";
+
+    for (unsigned int i = 0; i < trace.size(); ++i) {
+      double latency = runUpdates.latencies[i];
+      if (trace[i]->type == RuleUpdate::INSERT) sInsert.data.push_back(latency);
+      else sRemove.data.push_back(latency);
+      sLatencies[i].data.push_back(latency);
+    }
+
+    sBaseline.data.push_back(runUpdates.baselineMpps);
+    sUpdate.data.push_back(runUpdates.updateMpps);
+  }
+
+  updates.inserts = sInsert.data.size() / res.size();
+  updates.removes = sRemove.data.size() / res.size();
+  if (updates.inserts > 0) updates.insertLatency = StatValues<double>(sInsert);
+  if (updates.removes > 0) updates.removeLatency = StatValues<double>(sRemove);
+  for (std::vector<Series<double>>::const_iterator iter(sLatencies.cbegin()); iter != sLatencies.cend(); ++iter)
+    updates.latencies.push_back(MeanValue(*iter));
+
+  updates.headers = res[0]->updates.headers;
+  updates.baselineMpps = MeanValue(sBaseline);
+  updates.updateMpps = MeanValue(sUpdate);
+}
+
+void Evaluator::createLatencyStatistics(const BenchmarkResults& res, LatencyEvaluations& latencies) {
+  // histograms of the same group are merged over all testruns, ordered by name
+  std::map<std::string, LatencyHistogram> merged;
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    for (LatencyResults::const_iterator iter((*trItr)->latencies.cbegin()); iter != (*trItr)->latencies.cend(); ++iter)
+      merged[iter->first].merge(iter->second);
+  }
+
+  for (std::map<std::string, LatencyHistogram>::const_iterator iter(merged.cbegin()); iter != merged.cend(); ++iter) {
+    const LatencyHistogram& hist = iter->second;
+    LatencyEvaluation latency;
+    latency.name = iter->first;
+    latency.count = hist.count();
+    latency.mean = hist.mean();
+    latency.p50 = hist.valueAtPercentile(50);
+    latency.p90 = hist.valueAtPercentile(90);
+    latency.p99 = hist.valueAtPercentile(99);
+    latency.p999 = hist.valueAtPercentile(99.9);
+    latency.max = hist.maximum();
+    hist.getCdf(latency.cdf);
+    latencies.push_back(latency);
+  }
+}
+
+void Evaluator::createCounterStatistics(const BenchmarkResults& res, CounterEvaluation& counters) {
+  // stop here, if no hardware events were counted
+  if (res.size() == 0 || res[0]->counters.events.empty()) return;
+  counters.events = res[0]->counters.events;
+
+  // collect values of each category and event over all testruns, ordered by name
+  std::map<std::string, std::vector<Series<double>>> series;
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    const PerfResults& runCounters = (*trItr)->counters;
+    if (runCounters.events != counters.events)
+      throw "The counted hardware events differ between testruns (Evaluator::createCounterStatistics).";
+
+    for (CounterResults::const_iterator iter(runCounters.categories.cbegin()); iter != runCounters.categories.cend(); ++iter) {
+      std::vector<Series<double>>& categorySeries = series[iter->first];
+      categorySeries.resize(counters.events.size());
+      for (size_t i = 0; i < iter->second.size() && i < categorySeries.size(); ++i)
+        categorySeries[i].data.push_back(iter->second[i]);
+    }
+  }
+
+  for (auto iter(series.cbegin()); iter != series.cend(); ++iter) {
+    CounterCategoryEvaluation category;
+    category.name = iter->first;
+    for (std::vector<Series<double>>::const_iterator event(iter->second.cbegin()); event != iter->second.cend(); ++event)
+      category.values.push_back(MeanValue(*event));
+    counters.categories.push_back(category);
+  }
+}
+
+void Evaluator::createCacheStatistics(const BenchmarkResults& res, CacheEvaluation& cache) {
+  // stop here, if no cache was simulated
+  if (res.size() == 0 || res[0]->cache.levels.empty()) return;
+  cache.levels = res[0]->cache.levels;
+  const size_t levels = cache.levels.size();
+
+  // collect hits, misses and miss ratio of each group and level over all testruns
+  std::vector<std::vector<Series<double>>> hits, misses, ratios;
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    const Memory::CacheResults& runCache = (*trItr)->cache;
+    if (runCache.levels != cache.levels)
+      throw "The simulated cache levels differ between testruns (Evaluator::createCacheStatistics).";
+
+    for (size_t group = 0; group < runCache.groups.size(); ++group) {
+      if (group >= hits.size()) {
+        hits.resize(group + 1, std::vector<Series<double>>(levels));
+        misses.resize(group + 1, std::vector<Series<double>>(levels));
+        ratios.resize(group + 1, std::vector<Series<double>>(levels));
+      }
+      const Memory::CacheCounts& counts = runCache.groups[group];
+      for (size_t level = 0; level < levels; ++level) {
+        double accesses = counts.hits[level] + counts.misses[level];
+        hits[group][level].data.push_back(counts.hits[level]);
+        misses[group][level].data.push_back(counts.misses[level]);
+        ratios[group][level].data.push_back(accesses > 0 ? counts.misses[level] / accesses : 0);
+      }
+    }
+  }
+
+  for (size_t group = 0; group < hits.size(); ++group) {
+    std::vector<CacheLevelEvaluation> groupEval(levels);
+    for (size_t level = 0; level < levels; ++level) {
+      // a group without accesses in some testruns counts zeros there
+      hits[group][level].data.resize(res.size(), 0);
+      misses[group][level].data.resize(res.size(), 0);
+      ratios[group][level].data.resize(res.size(), 0);
+      groupEval[level].hits = MeanValue(hits[group][level]);
+      groupEval[level].misses = MeanValue(misses[group][level]);
+      groupEval[level].missRatio = MeanValue(ratios[group][level]);
+    }
+    cache.groups.push_back(groupEval);
+  }
+}
+
+void Evaluator::createHeapStatistics(const BenchmarkResults& res, HeapEvaluation& heap) {
+  // collect the counters of each phase over all testruns (in order of their first start)
+  std::vector<std::string> names;
+  std::vector<std::vector<Series<double>>> series; // live, peak, allocations, deallocations
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    for (HeapResults::const_iterator iter((*trItr)->heap.cbegin()); iter != (*trItr)->heap.cend(); ++iter) {
+      size_t phase = std::find(names.cbegin(), names.cend(), iter->first) - names.cbegin();
+      if (phase == names.size()) {
+        names.push_back(iter->first);
+        series.push_back(std::vector<Series<double>>(4));
+      }
+      series[phase][0].data.push_back(iter->second.liveBytes);
+      series[phase][1].data.push_back(iter->second.peakBytes);
+      series[phase][2].data.push_back(iter->second.allocations);
+      series[phase][3].data.push_back(iter->second.deallocations);
+    }
+  }
+
+  for (size_t phase = 0; phase < names.size(); ++phase) {
+    // a phase, which wasn't started in some testruns, counts zeros there
+    for (size_t i = 0; i < series[phase].size(); ++i) series[phase][i].data.resize(res.size(), 0);
+
+    HeapPhaseEvaluation eval;
+    eval.name = names[phase];
+    eval.liveBytes = MeanValue(series[phase][0]);
+    eval.peakBytes = MeanValue(series[phase][1]);
+    eval.allocations = MeanValue(series[phase][2]);
+    eval.deallocations = MeanValue(series[phase][3]);
+    heap.push_back(eval);
+  }
+}
+
+void Evaluator::createSamplingStatistics(BenchmarkPtr b, const BenchmarkResults& res, SamplingEvaluation& sampling) {
+  // stop here, if each header was timed
+  if (res.size() == 0 || b->samplingRate <= 1 || b->getHeaderNumber() == 0) return;
+  sampling.rate = b->samplingRate;
+
+  Series<double> sBatch;
+  std::map<std::string, std::pair<Series<double>, Series<double>>> sCategories; // samples, time per sample
+  for (BenchmarkResults::const_iterator trItr(res.cbegin()); trItr != res.cend(); ++trItr) {
+    const SamplingResults& runSampling = (*trItr)->sampling;
+    sBatch.data.push_back(runSampling.batchNanos / b->getHeaderNumber());
+
+    for (ChronoSamples::const_iterator iter(runSampling.samples.cbegin()); iter != runSampling.samples.cend(); ++iter) {
+      std::pair<Series<double>, Series<double>>& category = sCategories[iter->name];
+      category.first.data.push_back(iter->laps);
+      category.second.data.push_back(iter->laps > 0 ? iter->nanos / iter->laps : 0);
+    }
+  }
+
+  sampling.batchNanosPerHeader = MeanValue(sBatch);
+  for (auto iter(sCategories.cbegin()); iter != sCategories.cend(); ++iter) {
+    SampledCategoryEvaluation category;
+    category.name = iter->first;
+    category.samples = MeanValue(iter->second.first);
+    category.nanosPerSample = MeanValue(iter->second.second);
+    sampling.categories.push_back(category);
+  }
+}
+
 void Evaluator::evalBenchmark(BenchmarkPtr b, const BenchmarkResults& res, BenchmarkEvaluation& eval) {
 
   // gain all general information on benchmark and pack into container
@@ -249,20 +491,44 @@ void Evaluator::evalBenchmark(BenchmarkPtr b, const BenchmarkResults& res, Bench
   
   // Indices: compare them between testruns
   eval.allIndicesMatch = compareIndices(res);
+  eval.indicesDigest = (res.size() > 0 ? res[0]->matches.getDigest() : MatchSink::emptyDigest());
+  std::ostringstream digest;
+  digest << "0x" << std::hex << std::setw(16) << std::setfill('0') << eval.indicesDigest;
+  eval.benchmarkInfo.push_back(std::make_pair("matches digest", digest.str()));
 
   // further index evaluation only make sense, if generated indices match
-  if (eval.allIndicesMatch) { 
-    // Indices: copy matches once to output them later
-    if (res.size() > 0)
-      eval.indices = res[0]->indices;
+  if (eval.allIndicesMatch && res.size() > 0) { 
+    // Indices: copy matches once to output them later (only kept on request)
+    eval.indices = res[0]->matches.getIndices();
 
     // Indices: create histogram with distribution on rules
-    createHistogram(eval.indices, b->rules.size(), eval.histogram);
+    createHistogram(res[0]->matches, eval.histogram);
   }
 
   // Log Tags: join all logged entries
   joinLogTags(res, eval.logTags);
 
+  // Threads: throughput and scaling of a concurrent classification
+  createScalingStatistics(res, eval.scaling);
+
+  // Rule updates: latency of updates and throughput in between
+  createUpdateStatistics(b, res, eval.updates);
+
+  // Latency: percentiles of the lookup time per header
+  createLatencyStatistics(res, eval.latencies);
+
+  // Hardware counters: mean values of each category
+  createCounterStatistics(res, eval.counters);
+
+  // Cache simulation: mean hits and misses of each memory group and level
+  createCacheStatistics(res, eval.cache);
+
+  // Heap: mean usage of each phase
+  createHeapStatistics(res, eval.heap);
+
+  // Sampling: batch timing compared to sampled timing of single headers
+  createSamplingStatistics(b, res, eval.sampling);
+
 
   // TODO calculate mean of matchings per rule 
 }
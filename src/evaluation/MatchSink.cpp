@@ -0,0 +1,24 @@
+#include <evaluation/MatchSink.hpp>
+
+MatchSink::MatchSink(size_t numberRules, bool keepIndices) : _digest(emptyDigest()), _count(0), _noMatch(0), _hits(numberRules, 0), _keepIndices(keepIndices), _indices() {}
+
+void MatchSink::add(const Generic::RuleIndexSet& indices) {
+  for (Generic::RuleIndexSet::const_iterator iter(indices.cbegin()); iter != indices.cend(); ++iter)
+    add(*iter);
+}
+
+void MatchSink::add(const uint32_t* indices, size_t count) {
+  // same digest as for generic indices: map the native no-match value
+  for (size_t i = 0; i < count; ++i)
+    add(indices[i] == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : (Generic::RuleSetSize)indices[i]);
+}
+
+void MatchSink::clear() {
+  _digest = emptyDigest();
+  _count = 0;
+  _noMatch = 0;
+  for (std::vector<uint64_t>::iterator iter(_hits.begin()); iter != _hits.end(); ++iter)
+    *iter = 0;
+  _indices.clear();
+}
+
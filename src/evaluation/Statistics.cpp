@@ -12,6 +12,12 @@ void Histogram::occured(unsigned int id) {
 
   ++(*_bins[id]);
 }
+
+void Histogram::occured(unsigned int id, uint64_t times) {
+  if (id >= _bins.size()) throw "Histogram: Occurence id is outside bin-bounds.";
+
+  *_bins[id] += times;
+}
   
 void Histogram::getSorted(std::vector<HistogramPair>& result) const {
   // create a copy of current bins
@@ -0,0 +1,189 @@
+#include <frontend/IsolatedProcess.hpp>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <new>
+#include <exception>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+/** magic number at the beginning of each record ("CATE") */
+static const uint32_t RECORD_MAGIC = 0x45544143;
+/** size of a record without message: magic, outcome and length of message */
+static const size_t RECORD_HEADER = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint16_t);
+/** longest message, which is reported */
+static const size_t RECORD_MESSAGE = 1024;
+
+IsolatedProcess::~IsolatedProcess() {
+  if (_pid > 0) {
+    kill(_pid, SIGKILL);
+    waitpid(_pid, nullptr, 0);
+  }
+  if (_pipe >= 0) close(_pipe);
+}
+
+bool IsolatedProcess::start(const std::function<bool(std::string&)>& task, const std::string& consoleFile) {
+  if (_pid > 0) throw "Process was already started (IsolatedProcess::start).";
+
+  int fds[2];
+  if (pipe(fds) != 0) return false;
+
+  // child must not repeat buffered output of the parent
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(stdout);
+
+  _result = ProcessResult();
+  _start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  else if (pid == 0) {
+    close(fds[0]);
+    _runChild(task, consoleFile, fds[1]);
+  }
+
+  close(fds[1]); // only the child writes, so EOF follows its termination
+  _pid = pid;
+  _pipe = fds[0];
+  return true;
+}
+
+void IsolatedProcess::_runChild(const std::function<bool(std::string&)>& task, const std::string& consoleFile, int pipe) {
+  if (!consoleFile.empty()) {
+    int fd = open(consoleFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+      close(fd);
+    }
+  }
+
+  if (_memoryLimit > 0) {
+    struct rlimit limit;
+    limit.rlim_cur = limit.rlim_max = _memoryLimit;
+    setrlimit(RLIMIT_AS, &limit);
+  }
+  if (_timeout > 0) alarm(_timeout); // default action of SIGALRM terminates the process
+
+  ProcessOutcome outcome = ProcessOutcome::FAILED;
+  std::string message;
+  try {
+    if (task(message)) outcome = ProcessOutcome::OK;
+  } catch (const std::bad_alloc&) {
+    outcome = ProcessOutcome::OOM;
+    message = "memory limit exceeded";
+  } catch (const char* ex) {
+    message = ex;
+  } catch (const std::exception& ex) {
+    message = ex.what();
+  }
+
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(stdout);
+
+  // write record: magic, outcome, length of message, message
+  uint16_t length = (message.size() < RECORD_MESSAGE ? message.size() : RECORD_MESSAGE);
+  uint8_t outcomeCode = (uint8_t)outcome;
+  char record[RECORD_HEADER + RECORD_MESSAGE];
+  memcpy(record, &RECORD_MAGIC, sizeof(uint32_t));
+  memcpy(record + sizeof(uint32_t), &outcomeCode, sizeof(uint8_t));
+  memcpy(record + sizeof(uint32_t) + sizeof(uint8_t), &length, sizeof(uint16_t));
+  memcpy(record + RECORD_HEADER, message.data(), length);
+
+  size_t written = 0;
+  while (written < RECORD_HEADER + length) {
+    ssize_t result = write(pipe, record + written, RECORD_HEADER + length - written);
+    if (result < 0 && errno == EINTR) continue;
+    if (result <= 0) break;
+    written += result;
+  }
+  close(pipe);
+
+  _exit(outcome == ProcessOutcome::OK ? EXIT_SUCCESS : EXIT_FAILURE); // skip cleanup of the parent's state
+}
+
+bool IsolatedProcess::_readRecord() {
+  char record[RECORD_HEADER + RECORD_MESSAGE];
+  size_t received = 0;
+  while (received < sizeof(record)) {
+    ssize_t result = read(_pipe, record + received, sizeof(record) - received);
+    if (result < 0 && errno == EINTR) continue;
+    if (result <= 0) break;
+    received += result;
+  }
+
+  if (received < RECORD_HEADER) return false;
+
+  uint32_t magic;
+  uint8_t outcomeCode;
+  uint16_t length;
+  memcpy(&magic, record, sizeof(uint32_t));
+  memcpy(&outcomeCode, record + sizeof(uint32_t), sizeof(uint8_t));
+  memcpy(&length, record + sizeof(uint32_t) + sizeof(uint8_t), sizeof(uint16_t));
+  if (magic != RECORD_MAGIC || outcomeCode > (uint8_t)ProcessOutcome::CRASH || received != RECORD_HEADER + length)
+    return false;
+
+  _result.outcome = (ProcessOutcome)outcomeCode;
+  _result.message.assign(record + RECORD_HEADER, length);
+  return true;
+}
+
+void IsolatedProcess::finish(int status, uint64_t peakMemory) {
+  if (_pid <= 0) throw "Process was not started (IsolatedProcess::finish).";
+
+  _result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+  _result.peakMemory = peakMemory;
+
+  bool reported = _readRecord();
+  close(_pipe);
+  _pipe = -1;
+  _pid = -1;
+
+  if (WIFSIGNALED(status)) {
+    _result.signal = WTERMSIG(status);
+    if (_result.signal == SIGALRM) {
+      _result.outcome = ProcessOutcome::TIMEOUT;
+      _result.message = "wall-clock limit of " + std::to_string(_timeout) + " s exceeded";
+    }
+    else {
+      _result.outcome = ProcessOutcome::CRASH;
+      _result.message = std::string("terminated by signal ") + std::to_string(_result.signal) + " (" + strsignal(_result.signal) + ")";
+    }
+  }
+  else if (!reported) {
+    _result.outcome = ProcessOutcome::CRASH;
+    _result.message = "exited with status " + std::to_string(WEXITSTATUS(status)) + " without reporting";
+  }
+}
+
+void IsolatedProcess::wait() {
+  if (_pid <= 0) throw "Process was not started (IsolatedProcess::wait).";
+
+  int status = 0;
+  struct rusage usage;
+  while (wait4(_pid, &status, 0, &usage) < 0) {
+    if (errno != EINTR) throw "Failed to wait for the process (IsolatedProcess::wait).";
+  }
+  finish(status, usage.ru_maxrss);
+}
+
+const char* IsolatedProcess::outcomeName(ProcessOutcome outcome) {
+  switch (outcome) {
+    case ProcessOutcome::OK: return "ok";
+    case ProcessOutcome::FAILED: return "failed";
+    case ProcessOutcome::TIMEOUT: return "timeout";
+    case ProcessOutcome::OOM: return "OOM";
+    default: return "crash";
+  }
+}
+
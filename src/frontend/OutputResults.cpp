@@ -3,7 +3,9 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 #include <frontend/FilesysHelper.hpp>
+#include <generics/HeaderTrace.hpp>
 
 void OutputResults::filenameNotification(const std::string& filename, const std::string& description) const {
   // inform user about written file
@@ -289,6 +291,21 @@ void OutputResults::_jsLinePlot2(std::ostringstream& str, const std::string& div
     "}));" << std::endl;
 }
 
+void OutputResults::_jsCdfPlot(std::ostringstream& str, const std::string& divContainer, const std::string& dataVar, const std::string& title, const std::string& xlabel) const {
+  str << "$.jqplot('" << divContainer << "', [" << dataVar << 
+    "], $.extend(true, {}, themeSettings, { title: '" << title << "', " <<
+    "seriesDefaults: { showMarker: false }, " <<
+    "axes: { xaxis: {	min: 0, " << 
+		"label: '" << xlabel << "', " <<
+    "labelOptions: { fontFamily: 'Helvetica', fontSize: '12pt'	} }, " <<
+    "yaxis: {	label: 'Fraction of headers',	min: 0, max: 1, " <<
+    "tickOptions: { formatString: '%.2f' }, " <<
+    "labelRenderer: $.jqplot.CanvasAxisLabelRenderer , " <<
+    "labelOptions: { fontFamily: 'Helvetica',	fontSize: '12pt' } } }, " <<
+    "cursor: { show: true, zoom: true }" <<
+    "}));" << std::endl;
+}
+
 void OutputResults::_jsArray1(std::ostringstream& str, const std::vector<std::string>& items, const std::string& name) const {
   str << "var " << name << " = [ ";
   for (std::vector<std::string>::const_iterator iter(items.cbegin()); iter != items.cend(); ++iter) {
@@ -525,8 +542,9 @@ void OutputResults::_htmlMemPlots(std::ostringstream& html, std::ostringstream&
 }
 
 void OutputResults::_htmlHistogram(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const std::vector<HistogramPair>& hist) const {
-  html << "<h2>Matches-Histogram</h2>" << std::endl <<
-    "<p>See the matching results (rule indices for each processed header) in <a href=\"" << id << "_matches.csv\">plain csv</a>.</p>" << std::endl;
+  html << "<h2>Matches-Histogram</h2>" << std::endl;
+  if (_benchmark->outputMatches)
+    html << "<p>See the matching results (rule indices for each processed header) in <a href=\"" << id << "_matches.csv\">plain csv</a>.</p>" << std::endl;
   
   // place plotbox in html
   std::string divHist = "hist_matches";
@@ -551,6 +569,275 @@ void OutputResults::_htmlHistogram(const std::string& id, std::ostringstream& ht
   arrData2.clear();
 }
 
+void OutputResults::_htmlScaling(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const ScalingEvaluation& scaling) const {
+  html << "<h2>Multi-threaded Classification</h2>" << std::endl <<
+    "<p>Headers were split up between " << scaling.threads << " threads sharing the same classifier. " <<
+    "All values are mean-values taken over all testruns. See the results in <a href=\"" << id << 
+    "_scaling.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Measurement</strong></td>" <<
+    "<td><strong>Mean value</strong></td>" <<
+    "<td><strong>Std. deviation</strong></td></tr>" << std::endl <<
+    "<tr><td>Throughput with 1 thread [Mpps]</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.referenceMpps.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.referenceMpps.stddev << "</td></tr>" << std::endl <<
+    "<tr><td>Throughput with " << scaling.threads << " threads [Mpps]</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.aggregateMpps.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.aggregateMpps.stddev << "</td></tr>" << std::endl <<
+    "<tr><td>Scaling efficiency</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.efficiency.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << scaling.efficiency.stddev << "</td></tr>" << std::endl;
+
+  unsigned int threadCnt = 1;
+  for (std::vector<MeanValue>::const_iterator iter(scaling.threadMpps.cbegin()); iter != scaling.threadMpps.cend(); ++iter) {
+    html << "<tr><td>Throughput of thread " << threadCnt++ << " [Mpps]</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << iter->mean << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << iter->stddev << "</td></tr>" << std::endl;
+  }
+  html << "</table>" << std::endl;
+
+  // place plotbox in html
+  unsigned int divWidth = 200 + scaling.threadMpps.size() * 20; // make dependend on number of threads
+  html << "<div id=\"scaling_threads\" style=\"margin-top:20px; margin-left:20px; width:" << 
+    std::to_string(divWidth) << "px; height:400px;\"></div>" << "<hr />" << std::endl;
+
+  // create plot-code
+  _jsBarPlot(plots, "scaling_threads", "scaling_threads_mpps", 
+    "Throughput of each thread", 
+    "scaling_threads_ticks", "Thread", "Throughput [Mpps]");
+
+  // create plot-data
+  std::vector<std::string> arrTicks, arrContent;
+  threadCnt = 1;
+  for (std::vector<MeanValue>::const_iterator iter(scaling.threadMpps.cbegin()); iter != scaling.threadMpps.cend(); ++iter) {
+    arrTicks.push_back("'" + std::to_string(threadCnt++) + "'");
+    arrContent.push_back(std::to_string(iter->mean));
+  }
+  _jsArray1(data, arrTicks, "scaling_threads_ticks");
+  _jsArray1(data, arrContent, "scaling_threads_mpps");
+}
+
+void OutputResults::_htmlUpdates(const std::string& id, std::ostringstream& html, const UpdateEvaluation& updates) const {
+  html << "<h2>Rule Updates</h2>" << std::endl <<
+    "<p>A trace of " << updates.inserts << " rule insertions and " << updates.removes << " rule removals was replayed " <<
+    "after the classification, with " << updates.headers << " headers classified in between. " <<
+    "Latencies are taken over all updates of all testruns. See the latency of each update in <a href=\"" << id << 
+    "_updates.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Measurement</strong></td>" <<
+    "<td><strong>Minimum</strong></td>" <<
+    "<td><strong>Maximum</strong></td>" <<
+    "<td><strong>Mean value</strong></td>" <<
+    "<td><strong>Median</strong></td>" <<
+    "<td><strong>Std. deviation</strong></td></tr>" << std::endl;
+
+  if (updates.inserts > 0) {
+    html << "<tr><td>Latency of insertion [ns]</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.insertLatency.minimum << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.insertLatency.maximum << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << updates.insertLatency.mean << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.insertLatency.median << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << updates.insertLatency.stddev << "</td></tr>" << std::endl;
+  }
+  if (updates.removes > 0) {
+    html << "<tr><td>Latency of removal [ns]</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.removeLatency.minimum << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.removeLatency.maximum << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << updates.removeLatency.mean << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << updates.removeLatency.median << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << updates.removeLatency.stddev << "</td></tr>" << std::endl;
+  }
+  html << "</table>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\" style=\"margin-top:20px;\">" <<
+    "<tr><td><strong>Measurement</strong></td>" <<
+    "<td><strong>Mean value</strong></td>" <<
+    "<td><strong>Std. deviation</strong></td></tr>" << std::endl <<
+    "<tr><td>Throughput before updates [Mpps]</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << updates.baselineMpps.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << updates.baselineMpps.stddev << "</td></tr>" << std::endl <<
+    "<tr><td>Throughput between updates [Mpps]</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << updates.updateMpps.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << updates.updateMpps.stddev << "</td></tr>" << std::endl <<
+    "</table><hr />" << std::endl;
+}
+
+void OutputResults::_htmlLatency(const std::string& id, std::ostringstream& html, std::ostringstream& data, std::ostringstream& plots, const LatencyEvaluations& latencies) const {
+  html << "<h2>Lookup Latency</h2>" << std::endl <<
+    "<p>Headers were classified once more one by one to measure the lookup time of each header. " <<
+    "Percentiles are taken over all headers of all testruns and are exact up to 1.6%. " <<
+    "See the percentiles in <a href=\"" << id << "_latency.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Category</strong></td>" <<
+    "<td><strong>Headers</strong></td>" <<
+    "<td><strong>Mean value [ns]</strong></td>" <<
+    "<td><strong>p50 [ns]</strong></td>" <<
+    "<td><strong>p90 [ns]</strong></td>" <<
+    "<td><strong>p99 [ns]</strong></td>" <<
+    "<td><strong>p99.9 [ns]</strong></td>" <<
+    "<td><strong>Maximum [ns]</strong></td></tr>" << std::endl;
+
+  for (LatencyEvaluations::const_iterator iter(latencies.cbegin()); iter != latencies.cend(); ++iter) {
+    html << "<tr><td>" << iter->name << "</td>" <<
+      "<td>" << iter->count << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << iter->mean << "</td>" <<
+      "<td>" << iter->p50 << "</td>" <<
+      "<td>" << iter->p90 << "</td>" <<
+      "<td>" << iter->p99 << "</td>" <<
+      "<td>" << iter->p999 << "</td>" <<
+      "<td>" << iter->max << "</td></tr>" << std::endl;
+  }
+  html << "</table>" << std::endl;
+
+  // one plot with the cumulative distribution for each category
+  unsigned int groupCnt = 0;
+  for (LatencyEvaluations::const_iterator iter(latencies.cbegin()); iter != latencies.cend(); ++iter, ++groupCnt) {
+    std::string divCdf = "latency_cdf_" + std::to_string(groupCnt);
+    std::string varNameCdf = "latency_cdf_" + std::to_string(groupCnt);
+
+    // place plotbox in html
+    html << "<div id=\"" << divCdf << "\" style=\"margin-top:20px; margin-left:20px; width:600px; height:400px;\"></div>" << std::endl;
+
+    // create plot-code
+    _jsCdfPlot(plots, divCdf, varNameCdf, "Cumulative distribution of " + iter->name, "Latency [ns]");
+
+    // create plot-data
+    std::vector<std::string> arrLatency, arrFraction;
+    for (std::vector<LatencyCdfPoint>::const_iterator point(iter->cdf.cbegin()); point != iter->cdf.cend(); ++point) {
+      arrLatency.push_back(std::to_string(point->first));
+      arrFraction.push_back(std::to_string(point->second));
+    }
+    _jsArray2(data, arrLatency, arrFraction, varNameCdf);
+  }
+  html << "<hr />" << std::endl;
+}
+
+void OutputResults::_htmlCounters(const std::string& id, std::ostringstream& html, const CounterEvaluation& counters) const {
+  // instructions per cycle are derived, if both events were counted
+  std::vector<std::string>::const_iterator cycles = std::find(counters.events.cbegin(), counters.events.cend(), "cycles");
+  std::vector<std::string>::const_iterator instructions = std::find(counters.events.cbegin(), counters.events.cend(), "instructions");
+  bool showIpc = (cycles != counters.events.cend() && instructions != counters.events.cend());
+
+  html << "<h2>Hardware Counters</h2>" << std::endl <<
+    "<p>Hardware events were counted in user space for each category. All values are mean-values taken over " <<
+    "all testruns. See the standard deviations in <a href=\"" << id << "_counters.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Category</strong></td>";
+  for (std::vector<std::string>::const_iterator iter(counters.events.cbegin()); iter != counters.events.cend(); ++iter)
+    html << "<td><strong>" << *iter << "</strong></td>";
+  if (showIpc) html << "<td><strong>Instructions per cycle</strong></td>";
+  html << "</tr>" << std::endl;
+
+  for (std::vector<CounterCategoryEvaluation>::const_iterator iter(counters.categories.cbegin()); iter != counters.categories.cend(); ++iter) {
+    html << "<tr><td>" << iter->name << "</td>";
+    for (std::vector<MeanValue>::const_iterator value(iter->values.cbegin()); value != iter->values.cend(); ++value)
+      html << "<td>" << std::setprecision(0) << std::fixed << value->mean << "</td>";
+
+    if (showIpc) {
+      double cycleCount = iter->values[cycles - counters.events.cbegin()].mean;
+      double instructionCount = iter->values[instructions - counters.events.cbegin()].mean;
+      html << "<td>" << std::setprecision(3) << std::fixed << (cycleCount > 0 ? instructionCount / cycleCount : 0) << "</td>";
+    }
+    html << "</tr>" << std::endl;
+  }
+  html << "</table><hr />" << std::endl;
+}
+
+void OutputResults::_htmlCache(const std::string& id, std::ostringstream& html, const CacheEvaluation& cache) const {
+  html << "<h2>Simulated Cache</h2>" << std::endl <<
+    "<p>All traced memory accesses were replayed on a simulated cache hierarchy (" << cache.levels.size() << " levels). " <<
+    "The hits and misses of each level are counted per memory group. All values are mean-values taken over " <<
+    "all testruns. See the standard deviations in <a href=\"" << id << "_cache.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Group</strong></td>";
+  for (std::vector<std::string>::const_iterator iter(cache.levels.cbegin()); iter != cache.levels.cend(); ++iter)
+    html << "<td><strong>" << *iter << " hits</strong></td><td><strong>" << *iter << " misses</strong></td>" <<
+      "<td><strong>" << *iter << " miss ratio</strong></td>";
+  html << "</tr>" << std::endl;
+
+  for (size_t group = 0; group < cache.groups.size(); ++group) {
+    html << "<tr><td>" << group << "</td>";
+    for (std::vector<CacheLevelEvaluation>::const_iterator level(cache.groups[group].cbegin()); level != cache.groups[group].cend(); ++level) {
+      html << "<td>" << std::setprecision(0) << std::fixed << level->hits.mean << "</td>" <<
+        "<td>" << std::setprecision(0) << std::fixed << level->misses.mean << "</td>" <<
+        "<td>" << std::setprecision(4) << std::fixed << level->missRatio.mean << "</td>";
+    }
+    html << "</tr>" << std::endl;
+  }
+  html << "</table><hr />" << std::endl;
+}
+
+/** Returns the bytes allocated in MemTrace-instances of all groups after building the classifier (first checkpoint), or a negative value without memory results. */
+static double memTraceBuildBytes(const MemEvaluationGroups& mem) {
+  double bytes = -1;
+  for (MemEvaluationGroups::const_iterator iter(mem.cbegin()); iter != mem.cend(); ++iter) {
+    if ((*iter)->allocBytes.empty()) continue;
+    bytes = std::max(bytes, 0.0) + (*iter)->allocBytes.front().second->mean;
+  }
+  return bytes;
+}
+
+void OutputResults::_htmlHeap(const std::string& id, std::ostringstream& html, const HeapEvaluation& heap, const MemEvaluationGroups& mem) const {
+  double memTraceBytes = memTraceBuildBytes(mem);
+  html << "<h2>Heap Usage</h2>" << std::endl <<
+    "<p>All allocations with operator new of the classifying thread were counted with their usable size " <<
+    "(including container capacity, nodes, control blocks and alignment). Live bytes are the net growth of the " <<
+    "heap in each phase, peak bytes its highest growth. For comparison, the last column shows the bytes allocated " <<
+    "in MemTrace-instances of all groups after building the classifier. In a build with memory metering, the " <<
+    "heap contains the MemTrace-registry, too. All values are mean-values taken over all testruns. " <<
+    "See the standard deviations in <a href=\"" << id << "_heap.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Phase</strong></td>" <<
+    "<td><strong>Live [Bytes]</strong></td>" <<
+    "<td><strong>Peak [Bytes]</strong></td>" <<
+    "<td><strong>Allocations</strong></td>" <<
+    "<td><strong>Deallocations</strong></td>" <<
+    "<td><strong>MemTrace allocated [Bytes]</strong></td></tr>" << std::endl;
+
+  for (HeapEvaluation::const_iterator iter(heap.cbegin()); iter != heap.cend(); ++iter) {
+    html << "<tr><td>" << iter->name << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << iter->liveBytes.mean << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << iter->peakBytes.mean << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << iter->allocations.mean << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << iter->deallocations.mean << "</td>";
+    if (iter->name == "set rules" && memTraceBytes >= 0)
+      html << "<td>" << std::setprecision(0) << std::fixed << memTraceBytes << "</td>";
+    else
+      html << "<td>-</td>";
+    html << "</tr>" << std::endl;
+  }
+  html << "</table><hr />" << std::endl;
+}
+
+void OutputResults::_htmlSampling(const std::string& id, std::ostringstream& html, const SamplingEvaluation& sampling) const {
+  html << "<h2>Sampled Timing</h2>" << std::endl <<
+    "<p>Inside the algorithm, only one out of " << sampling.rate << " headers was timed (chosen pseudo-randomly), " <<
+    "while all headers were timed in batches. Runtimes of the sampled categories are estimated from the samples. " <<
+    "The difference between both is spent outside of the sampled categories (e.g. loop, storing results and instrumentation). " <<
+    "All values are mean-values taken over all testruns. See the results in <a href=\"" << id << "_sampling.csv\">plain csv</a>.</p>" << std::endl <<
+    "<table border=\"1\" cellpadding=\"5\" cellspacing=\"0\">" <<
+    "<tr><td><strong>Measurement</strong></td>" <<
+    "<td><strong>Time per header [ns]</strong></td>" <<
+    "<td><strong>Std. deviation</strong></td>" <<
+    "<td><strong>Timed headers</strong></td></tr>" << std::endl <<
+    "<tr><td>Batches (total)</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << sampling.batchNanosPerHeader.mean << "</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << sampling.batchNanosPerHeader.stddev << "</td>" <<
+    "<td>all</td></tr>" << std::endl;
+
+  double sampled = 0;
+  for (std::vector<SampledCategoryEvaluation>::const_iterator iter(sampling.categories.cbegin()); iter != sampling.categories.cend(); ++iter) {
+    html << "<tr><td>Samples (" << iter->name << ")</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << iter->nanosPerSample.mean << "</td>" <<
+      "<td>" << std::setprecision(3) << std::fixed << iter->nanosPerSample.stddev << "</td>" <<
+      "<td>" << std::setprecision(0) << std::fixed << iter->samples.mean << "</td></tr>" << std::endl;
+    sampled += iter->nanosPerSample.mean;
+  }
+  html << "<tr><td>Difference</td>" <<
+    "<td>" << std::setprecision(3) << std::fixed << (sampling.batchNanosPerHeader.mean - sampled) << "</td>" <<
+    "<td></td><td></td></tr>" << std::endl <<
+    "</table><hr />" << std::endl;
+}
+
 void OutputResults::_benchmarkInfo(std::ostringstream& str, const std::string& id, const BenchmarkInfoVector& info) const {
   str << "Benchmark-ID; " << id << std::endl;
 
@@ -689,7 +976,104 @@ void OutputResults::_csvMemory(std::ostringstream& str, const MemEvaluationGroup
   }
 }
 
-void OutputResults::headers(const Generic::PacketHeaderSet& headers) const {
+void OutputResults::_csvScaling(std::ostringstream& str, const ScalingEvaluation& scaling) const {
+  str << "measurement; mean; stddev;" << std::endl;
+  str << "reference_1_thread[Mpps]; " << std::to_string(scaling.referenceMpps.mean) << "; " << 
+    std::to_string(scaling.referenceMpps.stddev) << ";" << std::endl;
+  str << "aggregate_" << scaling.threads << "_threads[Mpps]; " << std::to_string(scaling.aggregateMpps.mean) << "; " << 
+    std::to_string(scaling.aggregateMpps.stddev) << ";" << std::endl;
+  str << "efficiency; " << std::to_string(scaling.efficiency.mean) << "; " << 
+    std::to_string(scaling.efficiency.stddev) << ";" << std::endl;
+
+  unsigned int threadCnt = 1;
+  for (std::vector<MeanValue>::const_iterator iter(scaling.threadMpps.cbegin()); iter != scaling.threadMpps.cend(); ++iter) {
+    str << "thread" << threadCnt++ << "[Mpps]; " << std::to_string(iter->mean) << "; " << 
+      std::to_string(iter->stddev) << ";" << std::endl;
+  }
+}
+
+void OutputResults::_csvUpdates(std::ostringstream& str, const UpdateEvaluation& updates) const {
+  str << "measurement; mean; stddev;" << std::endl;
+  str << "baseline[Mpps]; " << std::to_string(updates.baselineMpps.mean) << "; " << 
+    std::to_string(updates.baselineMpps.stddev) << ";" << std::endl;
+  str << "updating[Mpps]; " << std::to_string(updates.updateMpps.mean) << "; " << 
+    std::to_string(updates.updateMpps.stddev) << ";" << std::endl;
+
+  const RuleUpdateTrace& trace = _benchmark->ruleUpdates.trace;
+  for (unsigned int i = 0; i < updates.latencies.size() && i < trace.size(); ++i) {
+    str << "update" << i << "_" << (trace[i]->type == RuleUpdate::INSERT ? "insert" : "remove") << trace[i]->index << 
+      "[ns]; " << std::to_string(updates.latencies[i].mean) << "; " << std::to_string(updates.latencies[i].stddev) << ";" << std::endl;
+  }
+}
+
+void OutputResults::_csvLatency(std::ostringstream& str, const LatencyEvaluations& latencies) const {
+  str << "category; headers; mean[ns]; p50[ns]; p90[ns]; p99[ns]; p99.9[ns]; max[ns];" << std::endl;
+  for (LatencyEvaluations::const_iterator iter(latencies.cbegin()); iter != latencies.cend(); ++iter) {
+    str << iter->name << "; " << iter->count << "; " << std::to_string(iter->mean) << "; " << 
+      iter->p50 << "; " << iter->p90 << "; " << iter->p99 << "; " << iter->p999 << "; " << iter->max << ";" << std::endl;
+  }
+}
+
+void OutputResults::_csvCounters(std::ostringstream& str, const CounterEvaluation& counters) const {
+  str << "category; event; mean; stddev;" << std::endl;
+  for (std::vector<CounterCategoryEvaluation>::const_iterator iter(counters.categories.cbegin()); iter != counters.categories.cend(); ++iter) {
+    for (size_t i = 0; i < iter->values.size() && i < counters.events.size(); ++i) {
+      str << iter->name << "; " << counters.events[i] << "; " << std::to_string(iter->values[i].mean) << "; " << 
+        std::to_string(iter->values[i].stddev) << ";" << std::endl;
+    }
+  }
+}
+
+void OutputResults::_csvCache(std::ostringstream& str, const CacheEvaluation& cache) const {
+  str << "group; level; hits; hits-stddev; misses; misses-stddev; miss-ratio; miss-ratio-stddev;" << std::endl;
+  for (size_t group = 0; group < cache.groups.size(); ++group) {
+    for (size_t i = 0; i < cache.groups[group].size() && i < cache.levels.size(); ++i) {
+      const CacheLevelEvaluation& level = cache.groups[group][i];
+      str << group << "; " << cache.levels[i] << "; " << std::to_string(level.hits.mean) << "; " << 
+        std::to_string(level.hits.stddev) << "; " << std::to_string(level.misses.mean) << "; " << 
+        std::to_string(level.misses.stddev) << "; " << std::to_string(level.missRatio.mean) << "; " << 
+        std::to_string(level.missRatio.stddev) << ";" << std::endl;
+    }
+  }
+}
+
+void OutputResults::_csvHeap(std::ostringstream& str, const HeapEvaluation& heap, const MemEvaluationGroups& mem) const {
+  double memTraceBytes = memTraceBuildBytes(mem);
+  str << "phase; live[bytes]; live-stddev; peak[bytes]; peak-stddev; allocations; allocations-stddev; " <<
+    "deallocations; deallocations-stddev; memtrace-allocated[bytes];" << std::endl;
+  for (HeapEvaluation::const_iterator iter(heap.cbegin()); iter != heap.cend(); ++iter) {
+    str << iter->name << "; " << std::to_string(iter->liveBytes.mean) << "; " << 
+      std::to_string(iter->liveBytes.stddev) << "; " << std::to_string(iter->peakBytes.mean) << "; " << 
+      std::to_string(iter->peakBytes.stddev) << "; " << std::to_string(iter->allocations.mean) << "; " << 
+      std::to_string(iter->allocations.stddev) << "; " << std::to_string(iter->deallocations.mean) << "; " << 
+      std::to_string(iter->deallocations.stddev) << "; " << 
+      (iter->name == "set rules" && memTraceBytes >= 0 ? std::to_string(memTraceBytes) : "-") << ";" << std::endl;
+  }
+}
+
+void OutputResults::_csvSampling(std::ostringstream& str, const SamplingEvaluation& sampling) const {
+  str << "measurement; mean[ns/header]; stddev; samples;" << std::endl;
+  str << "total; " << std::to_string(sampling.batchNanosPerHeader.mean) << "; " << 
+    std::to_string(sampling.batchNanosPerHeader.stddev) << "; all;" << std::endl;
+  for (std::vector<SampledCategoryEvaluation>::const_iterator iter(sampling.categories.cbegin()); iter != sampling.categories.cend(); ++iter) {
+    str << iter->name << "; " << std::to_string(iter->nanosPerSample.mean) << "; " << 
+      std::to_string(iter->nanosPerSample.stddev) << "; " << std::to_string(iter->samples.mean) << ";" << std::endl;
+  }
+}
+
+void OutputResults::headers(const Generic::PacketHeaderColumns& headers) const {
+  if (_benchmark->rndHeaderConfig.outputBinary) {
+    std::string filename = _resultsDir + _benchmark->id + "_headers.trace";
+    try {
+      Generic::HeaderTraceWriter trace(filename, _benchmark->fieldStructure, true); // append to file, if exists
+      trace.write(headers);
+      trace.close();
+    } catch (const char* ex) {
+      std::cerr << "Failed to write headers to '" << filename << "'. Reason: " << ex << std::endl;
+    }
+    return;
+  }
+
   std::string filename = _resultsDir + _benchmark->id + "_headers.csv";
 
   try {
@@ -697,9 +1081,9 @@ void OutputResults::headers(const Generic::PacketHeaderSet& headers) const {
     
     using namespace Generic;
 
-    for (PacketHeaderSet::const_iterator line = headers.begin(); line != headers.end(); ++line) {
-      for (PacketHeaderLine::const_iterator atom = (*line)->begin(); atom != (*line)->end(); ++atom) {
-        outFile << (*atom)->value << ";";
+    for (PacketHeaderColumns::const_iterator line = headers.begin(); line != headers.end(); ++line) {
+      for (size_t field = 0; field < (*line).size(); ++field) {
+        outFile << (*line)[field] << ";";
       }
       outFile << std::endl;
     }
@@ -723,9 +1107,23 @@ void OutputResults::evaluation(const BenchmarkEvaluation& eval) const {
   _htmlChronoTable(composeHtml, _benchmark->id, eval.chrono);
   _htmlChronoPlots(composeHtml, composeData, composePlots, eval.chrono);
   _htmlMemTables(composeHtml, _benchmark->id, eval.mem);
+  if (eval.heap.size() > 0)
+    _htmlHeap(_benchmark->id, composeHtml, eval.heap, eval.mem);
   _htmlMemPlots(composeHtml, composeData, composePlots, eval.mem);
   if (eval.allIndicesMatch) 
     _htmlHistogram(_benchmark->id, composeHtml, composeData, composePlots, eval.histogram);
+  if (eval.scaling.threads > 0)
+    _htmlScaling(_benchmark->id, composeHtml, composeData, composePlots, eval.scaling);
+  if (eval.updates.latencies.size() > 0)
+    _htmlUpdates(_benchmark->id, composeHtml, eval.updates);
+  if (eval.latencies.size() > 0)
+    _htmlLatency(_benchmark->id, composeHtml, composeData, composePlots, eval.latencies);
+  if (eval.counters.events.size() > 0)
+    _htmlCounters(_benchmark->id, composeHtml, eval.counters);
+  if (eval.cache.levels.size() > 0)
+    _htmlCache(_benchmark->id, composeHtml, eval.cache);
+  if (eval.sampling.rate > 1)
+    _htmlSampling(_benchmark->id, composeHtml, eval.sampling);
   _htmlFooter(composeHtml, _benchmark->id);
   _jsPlotFooter(composePlots);
 
@@ -744,6 +1142,13 @@ void OutputResults::evaluation(const BenchmarkEvaluation& eval) const {
   std::string fileCsvChrono = filePrefix + "_chrono.csv"; 
   std::string fileCsvMatches = filePrefix + "_matches.csv"; 
   std::string fileCsvMem = filePrefix + "_memory.csv"; 
+  std::string fileCsvScaling = filePrefix + "_scaling.csv"; 
+  std::string fileCsvUpdates = filePrefix + "_updates.csv"; 
+  std::string fileCsvLatency = filePrefix + "_latency.csv"; 
+  std::string fileCsvCounters = filePrefix + "_counters.csv"; 
+  std::string fileCsvCache = filePrefix + "_cache.csv"; 
+  std::string fileCsvHeap = filePrefix + "_heap.csv"; 
+  std::string fileCsvSampling = filePrefix + "_sampling.csv"; 
   // and some machine readable benchmark information
   std::string fileInfo = filePrefix + "_info.csv";
   std::string fileLogTags = filePrefix + "_logtags.csv";
@@ -771,12 +1176,63 @@ void OutputResults::evaluation(const BenchmarkEvaluation& eval) const {
 
   // treat match-indices seperately
   if (eval.allIndicesMatch) {
-    _csvMatches(csvMatches, eval.indices);
-    _writeFile(csvMatches, fileCsvMatches);
+    if (_benchmark->outputMatches) { // all indices are only kept on request
+      _csvMatches(csvMatches, eval.indices);
+      _writeFile(csvMatches, fileCsvMatches);
+    }
   }
   else
     std::cout << "Matching indices between headers and rules were not consistent over all testruns. Please check the classification algorithm!" << std::endl;
 
+  // output throughput of concurrent classification, if measured
+  if (eval.scaling.threads > 0) {
+    std::ostringstream csvScaling;
+    _csvScaling(csvScaling, eval.scaling);
+    _writeFile(csvScaling, fileCsvScaling);
+  }
+
+  // output latencies of rule updates, if a trace was replayed
+  if (eval.updates.latencies.size() > 0) {
+    std::ostringstream csvUpdates;
+    _csvUpdates(csvUpdates, eval.updates);
+    _writeFile(csvUpdates, fileCsvUpdates);
+  }
+
+  // output percentiles of lookup latencies, if measured
+  if (eval.latencies.size() > 0) {
+    std::ostringstream csvLatency;
+    _csvLatency(csvLatency, eval.latencies);
+    _writeFile(csvLatency, fileCsvLatency);
+  }
+
+  // output hardware events, if counted
+  if (eval.counters.events.size() > 0) {
+    std::ostringstream csvCounters;
+    _csvCounters(csvCounters, eval.counters);
+    _writeFile(csvCounters, fileCsvCounters);
+  }
+
+  // output simulated cache hits and misses, if a cache was simulated
+  if (eval.cache.levels.size() > 0) {
+    std::ostringstream csvCache;
+    _csvCache(csvCache, eval.cache);
+    _writeFile(csvCache, fileCsvCache);
+  }
+
+  // output heap usage of each phase, if measured
+  if (eval.heap.size() > 0) {
+    std::ostringstream csvHeap;
+    _csvHeap(csvHeap, eval.heap, eval.mem);
+    _writeFile(csvHeap, fileCsvHeap);
+  }
+
+  // output batch and sampled timing, if sampled
+  if (eval.sampling.rate > 1) {
+    std::ostringstream csvSampling;
+    _csvSampling(csvSampling, eval.sampling);
+    _writeFile(csvSampling, fileCsvSampling);
+  }
+
   // output general benchmark information to file
   _writeFile(composeInfo, fileInfo);
 
@@ -1,9 +1,19 @@
 #include <frontend/Shell.hpp>
 #include <iostream>
+#include <cerrno>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <vector>
+#include <sys/wait.h>
+#include <sys/resource.h>
 #include <configuration/Configuration.hpp>
 #include <configuration/LuaConfigurator.hpp>
 #include <configuration/LuaInterpreter.hpp>
+#include <configuration/ConfigurationCache.hpp>
 #include <core/BenchmarkExecutor.hpp>
+#include <core/CpuEnvironment.hpp>
+#include <frontend/IsolatedProcess.hpp>
 
 using namespace Frontend;
 
@@ -12,6 +22,32 @@ void Shell::run() {
   std::shared_ptr<Configuration> config = std::make_shared<Configuration>();
   config->setProgRelativePath(_relativePath);
   config->setProgName(_programName);
+  if (!_readConfiguration(config)) return;
+
+  // assign benchmark ids
+  config->setBenchmarkIds();
+
+  // number of threads given on command line overrides configuration
+  if (_threads > 0) {
+    for (BenchmarkSet::iterator iter(config->getBenchmarkSet().begin()); iter != config->getBenchmarkSet().end(); ++iter)
+      (*iter)->threads = _threads;
+  }
+
+  if (_jobs > 1 || _isolate || _timeout > 0 || _memoryLimit > 0)
+    _runIsolated(config->getBenchmarkSet());
+  else
+    _runSequential(config->getBenchmarkSet());
+
+  std::cout << std::endl << "All benchmarks were executed." << std::endl;
+}
+
+bool Shell::_readConfiguration(std::shared_ptr<Configuration>& config) {
+  std::string cacheDir(_configCache ? ConfigurationCache::defaultDirectory() : "");
+  ConfigurationCache cache(cacheDir, _configFile, _relativePath + _programName);
+  if (!cacheDir.empty() && cache.load(*config)) {
+    std::cout << "configuration was loaded from cache (unchanged since last interpretation)" << std::endl;
+    return true;
+  }
 
   Lua::LuaInterpreter lua;
   lua.setConfigurator(std::make_shared<LuaConfigurator>(config));
@@ -21,33 +57,150 @@ void Shell::run() {
       std::cout << "interpretation of lua-configuration was successful" << std::endl;
     else {
       std::cout << "interpretation of lua-configuration failed" << std::endl;
-      return;
+      return false;
     }
   }
   catch (const char* ex) {
     std::cerr << "Error while interpreting lua-configuration: " << ex << std::endl;
-    return;
+    return false;
   }
 
-  // assign benchmark ids
-  config->setBenchmarkIds();
+  if (!cacheDir.empty() && config->isCacheable() && !cache.store(*config))
+    std::cerr << "Failed to write the configuration to the cache file '" << cache.filename() << "'." << std::endl;
+  return true;
+}
+
+bool Shell::_execute(BenchmarkExecutor& texec, BenchmarkPtr& benchmark) {
+  texec.configure(benchmark);
+  std::cout << std::endl << "starting execution of '" << benchmark->caption << "'..." << std::endl;
+  bool executionSuccess=false;
+  try {
+    executionSuccess = texec.execute();
+  } catch (const char* ex) {
+    std::cerr << "Exception when executing benchmark '" << benchmark->caption << "':" << std::endl << "\t" << ex << std::endl;
+  }
 
+  if (!executionSuccess) 
+    std::cout << "Failed to execute benchmark '" << benchmark->caption << "'. Stop." << std::endl;
+
+  return executionSuccess;
+}
+
+void Shell::_runSequential(BenchmarkSet& benchmarks) {
   // launch each benchmark separately
   BenchmarkExecutor texec(_relativePath, _resultsDir);
-  for (BenchmarkSet::iterator iter(config->getBenchmarkSet().begin()); iter != config->getBenchmarkSet().end(); ++iter) {
-    texec.configure(*iter);
-    std::cout << std::endl << "starting execution of '" << (*iter)->caption << "'..." << std::endl;
-    bool executionSuccess=false;
-    try {
-      executionSuccess = texec.execute();
-    } catch (const char* ex) {
-      std::cerr << "Exception when executing benchmark '" << (*iter)->caption << "':" << std::endl << "\t" << ex << std::endl;
+  if (!_snapshotDir.empty()) texec.setSnapshotDirectory(_snapshotDir);
+  for (BenchmarkSet::iterator iter(benchmarks.begin()); iter != benchmarks.end(); ++iter)
+    _execute(texec, *iter);
+}
+
+void Shell::_runIsolated(BenchmarkSet& benchmarks) {
+  // each running process gets its own cpu, so more processes would disturb each other
+  std::vector<unsigned int> cpus(CpuEnvironment::allowedCpus());
+  unsigned int jobs = _jobs;
+  if (!cpus.empty() && cpus.size() < jobs) {
+    jobs = cpus.size();
+    std::cout << "Only " << jobs << " cpus are available, so at most " << jobs << " benchmarks are executed concurrently." << std::endl;
+  }
+
+  std::vector<bool> slotUsed(jobs, false);
+  std::vector<ProcessResult> results(benchmarks.size());
+  // running processes: pid -> (index of benchmark, slot)
+  std::map<pid_t, std::pair<size_t, unsigned int>> running;
+  std::vector<std::unique_ptr<IsolatedProcess>> processes(benchmarks.size());
+  size_t next = 0;
+
+  while (next < benchmarks.size() || !running.empty()) {
+    if (next < benchmarks.size() && running.size() < jobs) {
+      unsigned int slot = 0;
+      while (slotUsed[slot]) ++slot;
+
+      BenchmarkPtr& benchmark = benchmarks[next];
+      if (jobs > 1 && benchmark->cpuAffinity < 0 && !cpus.empty())
+        benchmark->cpuAffinity = cpus[slot];
+
+      std::cout << "starting execution of '" << benchmark->caption << "' (id " << benchmark->id;
+      if (benchmark->cpuAffinity >= 0) std::cout << ", cpu " << benchmark->cpuAffinity;
+      std::cout << ")..." << std::endl;
+
+      // rules of a file are loaded only once here, so all later processes inherit them
+      try {
+        benchmark->rules->get();
+      } catch (const char* ex) {} // the benchmark fails with the same error in its process
+
+      processes[next].reset(new IsolatedProcess(_timeout, _memoryLimit));
+      bool started = processes[next]->start([this, &benchmark](std::string& message) {
+        BenchmarkExecutor texec(_relativePath, _resultsDir);
+        if (!_snapshotDir.empty()) texec.setSnapshotDirectory(_snapshotDir);
+        texec.configure(benchmark);
+        bool success = texec.execute();
+        if (!success) message = "execution failed";
+        return success;
+      }, _resultsDir + benchmark->id + "_console.txt");
+
+      if (started) {
+        running[processes[next]->getPid()] = std::make_pair(next, slot);
+        slotUsed[slot] = true;
+      }
+      else {
+        results[next].message = "process could not be created";
+        std::cerr << "Failed to start a process for benchmark '" << benchmark->caption << "'. Stop." << std::endl;
+      }
+      ++next;
+      continue;
     }
 
-    if (!executionSuccess) 
-      std::cout << "Failed to execute benchmark '" << (*iter)->caption << "'. Stop." << std::endl;
+    // wait for any process to finish
+    int status = 0;
+    struct rusage usage;
+    pid_t pid = wait4(-1, &status, 0, &usage);
+    if (pid < 0) {
+      if (errno == EINTR) continue;
+      std::cerr << "Failed to wait for the processes of the benchmarks." << std::endl;
+      break;
+    }
+
+    std::map<pid_t, std::pair<size_t, unsigned int>>::iterator found(running.find(pid));
+    if (found == running.end()) continue;
+
+    size_t index = found->second.first;
+    processes[index]->finish(status, usage.ru_maxrss);
+    results[index] = processes[index]->getResult();
+    processes[index].reset();
+
+    const BenchmarkPtr& benchmark = benchmarks[index];
+    if (results[index].outcome == ProcessOutcome::OK)
+      std::cout << "finished execution of '" << benchmark->caption << "' (id " << benchmark->id << ")." << std::endl;
+    else
+      std::cout << "Failed to execute benchmark '" << benchmark->caption << "' (" << 
+        IsolatedProcess::outcomeName(results[index].outcome) << ": " << results[index].message << 
+        ", see " << benchmark->id << "_console.txt). Stop." << std::endl;
+
+    slotUsed[found->second.second] = false;
+    running.erase(found);
   }
 
-  std::cout << std::endl << "All benchmarks were executed." << std::endl;
+  _writeOutcomes(benchmarks, results);
+}
+
+void Shell::_writeOutcomes(const BenchmarkSet& benchmarks, const std::vector<ProcessResult>& results) const {
+  if (benchmarks.empty()) return;
+
+  // ids consist of the timestamp of the configuration and the index of the benchmark
+  const std::string& firstId = benchmarks.front()->id;
+  std::string filename(_resultsDir + firstId.substr(0, firstId.find('-')) + "_outcomes.csv");
+
+  std::ofstream file(filename);
+  if (!file.good()) {
+    std::cerr << "Failed to write the outcomes of the benchmarks to file '" << filename << "'." << std::endl;
+    return;
+  }
+
+  file << "id; caption; outcome; runtime[s]; peak memory[KiB]; message;" << std::endl;
+  for (size_t i = 0; i < benchmarks.size() && i < results.size(); ++i) {
+    file << benchmarks[i]->id << "; " << benchmarks[i]->caption << "; " << IsolatedProcess::outcomeName(results[i].outcome) << "; " << 
+      std::to_string(results[i].seconds) << "; " << results[i].peakMemory << "; " << results[i].message << ";" << std::endl;
+  }
+  std::cout << "Wrote outcomes of all benchmarks to file:" << std::endl << filename << std::endl;
 }
 
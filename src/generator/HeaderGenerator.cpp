@@ -5,6 +5,7 @@
 bool HeaderGenerator::configure(const FieldStructureSet& fields, const RandomHeaderConfiguration& config) {
   _configured = false;
   _generators.clear(); // reset generators
+  _fields = fields;
 
   if (fields.size() != config.seeds.size() || fields.size() != config.distributions.size())
     throw "Field structure does not match amount of random generator seed values or -distributions.";
@@ -37,9 +38,11 @@ void HeaderGenerator::generateHeaders(unsigned int amount, Generic::PacketHeader
   if (!_configured) throw "Please configure the HeaderGenerator before using it.";
   
   output.clear(); // clear before add new headers
+  output.reserve(amount);
 
   for (unsigned int headerCnt = 0; headerCnt < amount; ++headerCnt) { // outer loop
     std::unique_ptr<PacketHeaderLine> headerLine(new PacketHeaderLine);
+    headerLine->reserve(_generators.size());
 
     // iterate over each field
     for (GeneratorSet::iterator iter(_generators.begin()); iter != _generators.end(); ++iter) {
@@ -53,4 +56,24 @@ void HeaderGenerator::generateHeaders(unsigned int amount, Generic::PacketHeader
   }
 }
 
+void HeaderGenerator::generateHeaders(unsigned int amount, Generic::PacketHeaderColumns& output) {
+  using namespace Generic;
+
+  if (!_configured) throw "Please configure the HeaderGenerator before using it.";
+
+  bool sameStructure = (output.fields() == _fields.size());
+  for (size_t field = 0; sameStructure && field < _fields.size(); ++field)
+    sameStructure = (output.fieldBits(field) == _fields[field]);
+  if (!sameStructure) output.setStructure(_fields);
+  output.resize(amount); // all values are overwritten below
+
+  // generators are independent per field, so filling column by column keeps the sequence of values
+  VarValue rndValue;
+  for (size_t field = 0; field < _generators.size(); ++field) {
+    for (unsigned int headerCnt = 0; headerCnt < amount; ++headerCnt) {
+      _generators[field]->getSample(rndValue);
+      output.set(headerCnt, field, rndValue);
+    }
+  }
+}
 
@@ -0,0 +1,78 @@
+#include <generator/HeaderPipeline.hpp>
+#include <system_error>
+
+HeaderPipeline::HeaderPipeline(HeaderGenerator& generator, unsigned int totalHeaders, unsigned int batchSize, unsigned int depth) :
+  _generator(generator), _totalHeaders(totalHeaders), _batchSize(batchSize), _ring(depth), _head(0), _filled(0),
+  _finished(false), _cancelled(false), _error(nullptr), _mutex(), _batchAvailable(), _slotAvailable(), _producer() {
+
+  if (_batchSize == 0) throw "Batch size for header generation has to be at least 1 (HeaderPipeline).";
+  if (depth == 0) throw "At least one batch has to fit into the ring (HeaderPipeline).";
+
+  try {
+    _producer = std::thread(&HeaderPipeline::_produce, this);
+  } catch (const std::system_error&) {
+    throw "Failed to create thread for header generation (HeaderPipeline).";
+  }
+}
+
+HeaderPipeline::~HeaderPipeline() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cancelled = true;
+  }
+  _slotAvailable.notify_all();
+  if (_producer.joinable()) _producer.join();
+}
+
+void HeaderPipeline::_produce() {
+  Generic::PacketHeaderColumns batch;
+  unsigned int headerCnt = 0;
+
+  while (headerCnt < _totalHeaders) {
+    unsigned int amount = (_totalHeaders - headerCnt < _batchSize ? _totalHeaders - headerCnt : _batchSize);
+
+    // generate without holding the lock, this is what runs in parallel to classification
+    try {
+      _generator.generateHeaders(amount, batch);
+    } catch (const char* ex) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _error = ex;
+      break;
+    }
+    headerCnt += amount;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _slotAvailable.wait(lock, [this]() { return _cancelled || _filled < _ring.size(); });
+    if (_cancelled) return;
+
+    _ring[(_head + _filled) % _ring.size()].swap(batch);
+    ++_filled;
+    lock.unlock();
+    _batchAvailable.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _finished = true;
+  }
+  _batchAvailable.notify_one();
+}
+
+bool HeaderPipeline::next(Generic::PacketHeaderColumns& batch) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _batchAvailable.wait(lock, [this]() { return _filled > 0 || _finished; });
+
+  if (_filled == 0) { // all batches were consumed
+    if (_error != nullptr) throw _error;
+    return false;
+  }
+
+  batch.swap(_ring[_head]);
+  _head = (_head + 1) % _ring.size();
+  --_filled;
+  lock.unlock();
+  _slotAvailable.notify_one();
+
+  return true;
+}
+
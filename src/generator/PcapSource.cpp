@@ -0,0 +1,313 @@
+#include <generator/PcapSource.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** magic numbers of pcap files (with micro- or nanosecond timestamps) */
+static const uint32_t PCAP_MAGIC_US = 0xa1b2c3d4;
+static const uint32_t PCAP_MAGIC_NS = 0xa1b23c4d;
+/** block types of pcapng files */
+static const uint32_t PCAPNG_SECTION_HEADER = 0x0a0d0d0a;
+static const uint32_t PCAPNG_BYTE_ORDER = 0x1a2b3c4d;
+static const uint32_t PCAPNG_INTERFACE = 1;
+static const uint32_t PCAPNG_PACKET = 2; // obsolete
+static const uint32_t PCAPNG_SIMPLE_PACKET = 3;
+static const uint32_t PCAPNG_ENHANCED_PACKET = 6;
+
+/** supported link types */
+static const uint16_t LINKTYPE_ETHERNET = 1;
+static const uint16_t LINKTYPE_RAW = 101;
+static const uint16_t LINKTYPE_LINUX_SLL = 113;
+static const uint16_t LINKTYPE_IPV4 = 228;
+
+static const uint16_t ETHERTYPE_IPV4 = 0x0800;
+static const uint16_t ETHERTYPE_VLAN = 0x8100;
+static const uint16_t ETHERTYPE_QINQ = 0x88a8;
+static const uint16_t ETHERTYPE_QINQ_OLD = 0x9100;
+
+static const size_t FIELD_COUNT = (size_t)PcapSource::Field::ZERO + 1;
+
+/** Returns a number in network byte order. */
+static inline uint16_t network16(const uint8_t* data) { return (uint16_t)((data[0] << 8) | data[1]); }
+static inline uint32_t network32(const uint8_t* data) { return ((uint32_t)network16(data) << 16) | network16(data + 2); }
+
+static inline uint16_t swap16(uint16_t val) { return (uint16_t)((val << 8) | (val >> 8)); }
+static inline uint32_t swap32(uint32_t val) { return ((uint32_t)swap16((uint16_t)val) << 16) | swap16((uint16_t)(val >> 16)); }
+
+/** Returns the default packet fields of a header structure with the given number of fields. */
+static std::vector<std::string> defaultFields(size_t fields) {
+  switch (fields) {
+    case 2: return {"src_ip", "dst_ip"};
+    case 4: return {"src_ip", "dst_ip", "src_port", "dst_port"};
+    case 5: return {"src_ip", "dst_ip", "src_port", "dst_port", "protocol"};
+    case 10: return {"src_ip", "dst_ip", "src_port", "dst_port", "protocol", "vlan", "tos", "ttl", "length", "tcp_flags"};
+    default: throw "No default mapping of packet fields exists for this header structure (PcapSource).";
+  }
+}
+
+PcapSource::PcapSource(const PcapConfiguration& config, const std::vector<unsigned int>& structure) : _mapping(nullptr), _mappingSize(0), _fields(), _structure(structure), _replay(config.replay), _pass(0), _passHeaders(0), _pcapng(false), _swapped(false), _offset(0), _linkTypes() {
+  // check the mapping of fields, before the file is mapped
+  std::vector<std::string> names(config.fields.empty() ? defaultFields(structure.size()) : config.fields);
+  if (names.size() != structure.size())
+    throw "Amount of packet fields does not match the header structure (PcapSource).";
+  for (size_t i = 0; i < names.size(); ++i) {
+    Field field;
+    if (!fieldByName(names[i], field)) throw "Unknown packet field in the mapping of fields (PcapSource).";
+    if (structure[i] < fieldBits(field) || structure[i] > 64)
+      throw "Packet field does not fit into the width of its header field (PcapSource).";
+    _fields.push_back(field);
+  }
+
+  int fd = open(config.filename.c_str(), O_RDONLY);
+  if (fd < 0) throw "Failed to open the packet capture (PcapSource).";
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 24) {
+    close(fd);
+    throw "Packet capture is too short (PcapSource).";
+  }
+
+  _mappingSize = st.st_size;
+  void* mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // mapping stays valid
+  if (mapping == MAP_FAILED) throw "Failed to map the packet capture into memory (PcapSource).";
+  _mapping = static_cast<const uint8_t*>(mapping);
+  madvise(mapping, _mappingSize, MADV_SEQUENTIAL); // packets are read in order
+
+  try {
+    _start();
+  } catch (const char* ex) {
+    munmap(mapping, _mappingSize);
+    _mapping = nullptr;
+    throw ex;
+  }
+}
+
+PcapSource::~PcapSource() {
+  if (_mapping) munmap(const_cast<uint8_t*>(_mapping), _mappingSize);
+}
+
+uint16_t PcapSource::_read16(size_t offset) const {
+  uint16_t val;
+  memcpy(&val, _mapping + offset, sizeof(val));
+  return (_swapped ? swap16(val) : val);
+}
+
+uint32_t PcapSource::_read32(size_t offset) const {
+  uint32_t val;
+  memcpy(&val, _mapping + offset, sizeof(val));
+  return (_swapped ? swap32(val) : val);
+}
+
+void PcapSource::_start() {
+  uint32_t magic;
+  memcpy(&magic, _mapping, sizeof(magic));
+  _linkTypes.clear();
+
+  if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS || swap32(magic) == PCAP_MAGIC_US || swap32(magic) == PCAP_MAGIC_NS) {
+    _pcapng = false;
+    _swapped = (magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS);
+    _linkTypes.push_back((uint16_t)_read32(20));
+    _offset = 24; // first record follows the global header
+  }
+  else if (magic == PCAPNG_SECTION_HEADER) {
+    _pcapng = true;
+    _offset = 0; // section header is handled like any other block
+  }
+  else {
+    throw "File is neither a pcap nor a pcapng capture (PcapSource).";
+  }
+}
+
+bool PcapSource::_nextPacket(const uint8_t*& data, size_t& length, uint16_t& linkType) {
+  if (!_pcapng) {
+    if (_mappingSize - _offset < 16) return false; // end of capture (or truncated record)
+    uint32_t captured = _read32(_offset + 8);
+    if (captured > _mappingSize - _offset - 16) return false; // last packet is truncated
+
+    data = _mapping + _offset + 16;
+    length = captured;
+    linkType = _linkTypes.front();
+    _offset += 16 + captured;
+    return true;
+  }
+
+  while (_mappingSize - _offset >= 12) {
+    uint32_t type;
+    memcpy(&type, _mapping + _offset, sizeof(type)); // same in both byte orders for a section header
+
+    if (type == PCAPNG_SECTION_HEADER) { // each section may have another byte order
+      uint32_t byteOrder;
+      memcpy(&byteOrder, _mapping + _offset + 8, sizeof(byteOrder));
+      if (byteOrder != PCAPNG_BYTE_ORDER && swap32(byteOrder) != PCAPNG_BYTE_ORDER)
+        throw "Section of the pcapng capture has an invalid byte order (PcapSource).";
+      _swapped = (byteOrder != PCAPNG_BYTE_ORDER);
+      _linkTypes.clear(); // interfaces belong to a section
+    }
+    else if (_swapped) {
+      type = swap32(type);
+    }
+
+    uint32_t blockLength = _read32(_offset + 4);
+    if (blockLength < 12 || blockLength % 4 != 0 || blockLength > _mappingSize - _offset)
+      throw "Block of the pcapng capture is damaged (PcapSource).";
+    size_t block = _offset;
+    _offset += blockLength;
+
+    if (type == PCAPNG_INTERFACE && blockLength >= 20) {
+      _linkTypes.push_back(_read16(block + 8));
+    }
+    else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_PACKET) && blockLength >= 32) {
+      uint32_t interface = (type == PCAPNG_ENHANCED_PACKET ? _read32(block + 8) : _read16(block + 8));
+      uint32_t captured = _read32(block + 20);
+      if (interface >= _linkTypes.size() || captured > blockLength - 32)
+        throw "Packet block of the pcapng capture is damaged (PcapSource).";
+      data = _mapping + block + 28;
+      length = captured;
+      linkType = _linkTypes[interface];
+      return true;
+    }
+    else if (type == PCAPNG_SIMPLE_PACKET && blockLength >= 16) {
+      if (_linkTypes.empty()) throw "Packet block of the pcapng capture has no interface (PcapSource).";
+      uint32_t original = _read32(block + 8);
+      data = _mapping + block + 12;
+      length = (original < blockLength - 16 ? original : blockLength - 16);
+      linkType = _linkTypes.front();
+      return true;
+    }
+    // other blocks (statistics, name resolution, ...) are skipped
+  }
+  return false;
+}
+
+bool PcapSource::_parse(const uint8_t* data, size_t length, uint16_t linkType, uint64_t* values) {
+  memset(values, 0, FIELD_COUNT * sizeof(uint64_t));
+
+  // link layer
+  size_t offset = 0;
+  uint16_t etherType = ETHERTYPE_IPV4;
+  if (linkType == LINKTYPE_ETHERNET) {
+    if (length < 14) return false;
+    etherType = network16(data + 12);
+    offset = 14;
+    bool tagged = false;
+    while ((etherType == ETHERTYPE_VLAN || etherType == ETHERTYPE_QINQ || etherType == ETHERTYPE_QINQ_OLD) && length >= offset + 4) {
+      if (!tagged) values[(size_t)Field::VLAN] = network16(data + offset) & 0x0fff; // outer tag
+      tagged = true;
+      etherType = network16(data + offset + 2);
+      offset += 4;
+    }
+  }
+  else if (linkType == LINKTYPE_LINUX_SLL) {
+    if (length < 16) return false;
+    etherType = network16(data + 14);
+    offset = 16;
+  }
+  else if (linkType != LINKTYPE_RAW && linkType != LINKTYPE_IPV4) {
+    return false;
+  }
+
+  // network layer
+  if (etherType != ETHERTYPE_IPV4 || length < offset + 20) return false;
+  const uint8_t* ip = data + offset;
+  size_t ipHeader = (ip[0] & 0x0f) * 4;
+  if ((ip[0] >> 4) != 4 || ipHeader < 20) return false;
+
+  values[(size_t)Field::TOS] = ip[1];
+  values[(size_t)Field::LENGTH] = network16(ip + 2);
+  values[(size_t)Field::TTL] = ip[8];
+  values[(size_t)Field::PROTOCOL] = ip[9];
+  values[(size_t)Field::SRC_IP] = network32(ip + 12);
+  values[(size_t)Field::DST_IP] = network32(ip + 16);
+
+  // transport layer (only the first fragment contains it)
+  bool firstFragment = (network16(ip + 6) & 0x1fff) == 0;
+  const uint8_t* transport = ip + ipHeader;
+  size_t available = (length > offset + ipHeader ? length - offset - ipHeader : 0);
+  if (firstFragment && (ip[9] == 6 || ip[9] == 17 || ip[9] == 132) && available >= 4) {
+    values[(size_t)Field::SRC_PORT] = network16(transport);
+    values[(size_t)Field::DST_PORT] = network16(transport + 2);
+    if (ip[9] == 6 && available >= 14)
+      values[(size_t)Field::TCP_FLAGS] = transport[13];
+  }
+  return true;
+}
+
+bool PcapSource::next(Generic::PacketHeaderColumns& batch, size_t count) {
+  if (batch.fields() == _structure.size()) batch.clear(); // keeps the memory of the columns
+  else batch.setStructure(_structure);
+  if (_pass >= _replay || count == 0) return false;
+
+  batch.resize(count);
+  size_t filled = 0;
+  const uint8_t* data;
+  size_t length;
+  uint16_t linkType;
+  uint64_t values[FIELD_COUNT];
+
+  while (filled < count && _pass < _replay) {
+    if (!_nextPacket(data, length, linkType)) { // replay from the first packet
+      if (_passHeaders == 0) _pass = _replay; // capture without any IPv4 packet
+      else ++_pass;
+      _passHeaders = 0;
+      _start();
+      continue;
+    }
+    if (!_parse(data, length, linkType, values)) continue;
+
+    ++_passHeaders;
+    for (size_t field = 0; field < _fields.size(); ++field)
+      batch.put(filled, field, values[(size_t)_fields[field]]);
+    ++filled;
+  }
+
+  batch.resize(filled);
+  return (filled > 0);
+}
+
+void PcapSource::rewind() {
+  _pass = 0;
+  _passHeaders = 0;
+  _start();
+}
+
+unsigned int PcapSource::countPackets(const std::string& filename) {
+  PcapConfiguration config;
+  config.filename = filename;
+  config.fields.push_back("zero");
+  PcapSource source(config, std::vector<unsigned int>(1, 1));
+
+  unsigned int packets = 0;
+  const uint8_t* data;
+  size_t length;
+  uint16_t linkType;
+  uint64_t values[FIELD_COUNT];
+  while (source._nextPacket(data, length, linkType)) {
+    if (_parse(data, length, linkType, values)) ++packets;
+  }
+  return packets;
+}
+
+bool PcapSource::fieldByName(const std::string& name, Field& field) {
+  static const char* names[] = {"src_ip", "dst_ip", "src_port", "dst_port", "protocol", "vlan", "tos", "ttl", "length", "tcp_flags", "zero"};
+  for (size_t i = 0; i < FIELD_COUNT; ++i) {
+    if (name == names[i]) {
+      field = (Field)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+unsigned int PcapSource::fieldBits(Field field) {
+  switch (field) {
+    case Field::SRC_IP: case Field::DST_IP: return 32;
+    case Field::SRC_PORT: case Field::DST_PORT: case Field::LENGTH: return 16;
+    case Field::VLAN: return 12;
+    case Field::ZERO: return 1;
+    default: return 8;
+  }
+}
+
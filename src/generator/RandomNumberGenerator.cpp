@@ -23,6 +23,8 @@ RandomNumberGenerator::RandomNumberGenerator(unsigned int seed, unsigned int bit
     // sanity check
     if (_uniformMinVal > _uniformMaxVal)
       throw "Range for uniform random distribution is invalid (min greater than max)!";
+
+    _uniformRange = (_uniformMaxVal - _uniformMinVal + 1).get_mpz();
   } 
   else if (distrib->getType() == RandomDistribution::CONSTANT) {
     RandomDistConstant* constDist = static_cast<RandomDistConstant*>(distrib.get());
@@ -73,7 +75,8 @@ void RandomNumberGenerator::getSample(Generic::VarValue& value) {
       value = _distribConstant;
       break;
     case DistributionType::UNIFORM:
-      value = (_engineBig.get_z_range(_uniformMaxVal - _uniformMinVal + 1) + _uniformMinVal) & _bitmask;
+      _uniformSample = _engineBig.get_z_range(_uniformRange);
+      value = (Generic::VarValue(_uniformSample) + _uniformMinVal) & _bitmask;
       break;
     case DistributionType::NORMAL:
       value = _distribNormal(_engine32) & _bitmask;
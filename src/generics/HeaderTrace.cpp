@@ -0,0 +1,220 @@
+#include <generics/HeaderTrace.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace Generic {
+
+/** magic number at the beginning of each trace file ("CHTR") */
+static const uint32_t TRACE_MAGIC = 0x52544843;
+/** is increased, if the format of the file changes */
+static const uint32_t TRACE_VERSION = 1;
+
+/** Returns the size of a field inside of a record in bytes. */
+static size_t fieldBytes(unsigned int bits) {
+  if (bits <= 8) return 1;
+  else if (bits <= 16) return 2;
+  else if (bits <= 32) return 4;
+  else if (bits <= 64) return 8;
+  return (bits + 7) / 8;
+}
+
+/** Returns the size of the file header in bytes. */
+static inline size_t headerSize(size_t fields) {
+  return 3 * sizeof(uint32_t) + fields * sizeof(uint32_t);
+}
+
+/** Returns true, if the header set has the given fields. */
+static bool sameStructure(const PacketHeaderColumns& headers, const std::vector<unsigned int>& fieldBits) {
+  if (headers.fields() != fieldBits.size()) return false;
+  for (size_t field = 0; field < fieldBits.size(); ++field) {
+    if (headers.fieldBits(field) != fieldBits[field]) return false;
+  }
+  return true;
+}
+
+static inline void encodeLittleEndian(uint64_t val, size_t bytes, uint8_t* out) {
+  for (size_t i = 0; i < bytes; ++i, val >>= 8)
+    out[i] = (uint8_t)val;
+}
+
+static inline uint64_t decodeLittleEndian(const uint8_t* in, size_t bytes) {
+  uint64_t val = 0;
+  for (size_t i = bytes; i-- > 0;)
+    val = (val << 8) | in[i];
+  return val;
+}
+
+HeaderTraceWriter::HeaderTraceWriter(const std::string& filename, const std::vector<unsigned int>& fieldBits, bool append) : _file(nullptr), _fieldBits(fieldBits), _recordSize(0), _buffer() {
+  for (std::vector<unsigned int>::const_iterator iter(_fieldBits.cbegin()); iter != _fieldBits.cend(); ++iter)
+    _recordSize += fieldBytes(*iter);
+
+  std::vector<uint32_t> header;
+  header.push_back(TRACE_MAGIC);
+  header.push_back(TRACE_VERSION);
+  header.push_back(_fieldBits.size());
+  header.insert(header.end(), _fieldBits.cbegin(), _fieldBits.cend());
+
+  if (append) {
+    _file = fopen(filename.c_str(), "ab+");
+    if (!_file) throw "Failed to open the header trace for appending (HeaderTraceWriter).";
+
+    // an existing file must have the same fields
+    fseek(_file, 0, SEEK_END);
+    if (ftell(_file) > 0) {
+      std::vector<uint32_t> existing(header.size());
+      rewind(_file);
+      if (fread(existing.data(), sizeof(uint32_t), existing.size(), _file) != existing.size() || existing != header) {
+        fclose(_file);
+        _file = nullptr;
+        throw "Existing header trace has another structure (HeaderTraceWriter).";
+      }
+      return;
+    }
+  } else {
+    _file = fopen(filename.c_str(), "wb");
+    if (!_file) throw "Failed to open the header trace for writing (HeaderTraceWriter).";
+  }
+
+  if (fwrite(header.data(), sizeof(uint32_t), header.size(), _file) != header.size()) {
+    fclose(_file);
+    _file = nullptr;
+    throw "Failed to write the header of the trace (HeaderTraceWriter).";
+  }
+}
+
+HeaderTraceWriter::~HeaderTraceWriter() {
+  if (_file) fclose(_file);
+}
+
+void HeaderTraceWriter::write(const PacketHeaderColumns& headers) {
+  if (!_file) throw "Header trace is already closed (HeaderTraceWriter::write).";
+  if (headers.empty()) return;
+  if (!sameStructure(headers, _fieldBits))
+    throw "Header fields do not match the structure of the trace (HeaderTraceWriter::write).";
+
+  _buffer.assign(headers.size() * _recordSize, 0);
+  uint8_t* record = _buffer.data();
+  for (size_t header = 0; header < headers.size(); ++header) {
+    for (size_t field = 0; field < _fieldBits.size(); ++field) {
+      size_t bytes = fieldBytes(_fieldBits[field]);
+      if (_fieldBits[field] <= 64) {
+        encodeLittleEndian(headers.get(header, field), bytes, record);
+      } else { // wide fields are exported with the least significant byte first
+        mpz_class val(headers.value(header, field).get_mpz());
+        if (sgn(val) < 0 || mpz_sizeinbase(val.get_mpz_t(), 256) > bytes)
+          throw "Header value exceeds the width of its field (HeaderTraceWriter::write).";
+        mpz_export(record, nullptr, -1, 1, -1, 0, val.get_mpz_t());
+      }
+      record += bytes;
+    }
+  }
+
+  if (fwrite(_buffer.data(), _recordSize, headers.size(), _file) != headers.size())
+    throw "Failed to write headers to the trace (HeaderTraceWriter::write).";
+}
+
+void HeaderTraceWriter::close() {
+  if (!_file) return;
+  bool failed = (fclose(_file) != 0);
+  _file = nullptr;
+  if (failed) throw "Failed to close the header trace (HeaderTraceWriter::close).";
+}
+
+HeaderTraceReader::HeaderTraceReader(const std::string& filename) : _mapping(nullptr), _mappingSize(0), _records(nullptr), _fieldBits(), _fieldBytes(), _recordSize(0), _size(0), _position(0) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw "Failed to open the header trace (HeaderTraceReader).";
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < headerSize(0)) {
+    close(fd);
+    throw "Header trace is too short (HeaderTraceReader).";
+  }
+
+  _mappingSize = st.st_size;
+  void* mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // mapping stays valid
+  if (mapping == MAP_FAILED) throw "Failed to map the header trace into memory (HeaderTraceReader).";
+  _mapping = static_cast<const uint8_t*>(mapping);
+  madvise(mapping, _mappingSize, MADV_SEQUENTIAL); // records are mostly read in order
+
+  uint32_t magic, version, fields;
+  memcpy(&magic, _mapping, sizeof(uint32_t));
+  memcpy(&version, _mapping + sizeof(uint32_t), sizeof(uint32_t));
+  memcpy(&fields, _mapping + 2 * sizeof(uint32_t), sizeof(uint32_t));
+
+  const char* error = nullptr;
+  if (magic != TRACE_MAGIC || version != TRACE_VERSION)
+    error = "File is not a header trace of this version (HeaderTraceReader).";
+  else if (fields == 0 || _mappingSize < headerSize(fields))
+    error = "Header trace has no valid structure (HeaderTraceReader).";
+
+  if (!error) {
+    for (uint32_t field = 0; field < fields; ++field) {
+      uint32_t bits;
+      memcpy(&bits, _mapping + headerSize(field), sizeof(uint32_t));
+      _fieldBits.push_back(bits);
+      _fieldBytes.push_back(fieldBytes(bits));
+      _recordSize += _fieldBytes.back();
+      if (bits == 0) error = "Header trace has no valid structure (HeaderTraceReader).";
+    }
+  }
+
+  if (!error) {
+    _records = _mapping + headerSize(fields);
+    _size = (_mappingSize - headerSize(fields)) / _recordSize;
+    if (_size * _recordSize != _mappingSize - headerSize(fields))
+      error = "Last record of the header trace is truncated (HeaderTraceReader).";
+  }
+
+  if (error) {
+    munmap(mapping, _mappingSize);
+    _mapping = nullptr;
+    throw error;
+  }
+}
+
+HeaderTraceReader::~HeaderTraceReader() {
+  if (_mapping) munmap(const_cast<uint8_t*>(_mapping), _mappingSize);
+}
+
+void HeaderTraceReader::read(size_t first, size_t count, PacketHeaderColumns& output) const {
+  if (!sameStructure(output, _fieldBits))
+    throw "Header fields do not match the structure of the trace (HeaderTraceReader::read).";
+  if (first >= _size) return;
+  if (count > _size - first) count = _size - first;
+
+  size_t header = output.size();
+  output.resize(header + count);
+
+  const uint8_t* record = _records + first * _recordSize;
+  for (size_t end = header + count; header < end; ++header) {
+    for (size_t field = 0; field < _fieldBits.size(); ++field) {
+      if (_fieldBits[field] <= 64) {
+        uint64_t val = decodeLittleEndian(record, _fieldBytes[field]);
+        if (_fieldBits[field] < 64 && (val >> _fieldBits[field]) != 0)
+          throw "Header value of the trace exceeds the width of its field (HeaderTraceReader::read).";
+        output.put(header, field, val);
+      } else {
+        mpz_class val;
+        mpz_import(val.get_mpz_t(), _fieldBytes[field], -1, 1, -1, 0, record);
+        output.set(header, field, VarValue(val));
+      }
+      record += _fieldBytes[field];
+    }
+  }
+}
+
+bool HeaderTraceReader::next(PacketHeaderColumns& batch, size_t count) {
+  if (sameStructure(batch, _fieldBits)) batch.clear(); // keeps the memory of the columns
+  else batch.setStructure(_fieldBits);
+
+  if (_position >= _size || count == 0) return false;
+  read(_position, count, batch);
+  _position += batch.size();
+  return true;
+}
+
+} // namespace Generic
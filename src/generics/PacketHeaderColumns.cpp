@@ -0,0 +1,148 @@
+#include <generics/PacketHeaderColumns.hpp>
+
+namespace Generic {
+
+PacketHeaderColumns::Column::Column(unsigned int b) : bits(b), bytes(0), data(), wide() {
+  if (bits <= 8) bytes = 1;
+  else if (bits <= 16) bytes = 2;
+  else if (bits <= 32) bytes = 4;
+  else if (bits <= 64) bytes = 8;
+}
+
+PacketHeaderColumns::PacketHeaderColumns(const std::vector<unsigned int>& fieldBits) : _columns(), _size(0), _filled(0) {
+  setStructure(fieldBits);
+}
+
+void PacketHeaderColumns::setStructure(const std::vector<unsigned int>& fieldBits) {
+  _columns.clear();
+  for (std::vector<unsigned int>::const_iterator iter(fieldBits.cbegin()); iter != fieldBits.cend(); ++iter)
+    _columns.push_back(Column(*iter));
+  _size = 0;
+  _filled = 0;
+}
+
+void PacketHeaderColumns::clear() {
+  resize(0);
+}
+
+void PacketHeaderColumns::reserve(size_t headers) {
+  for (std::vector<Column>::iterator col(_columns.begin()); col != _columns.end(); ++col) {
+    if (col->bytes > 0) col->data.reserve(headers * col->bytes);
+    else col->wide.reserve(headers);
+  }
+}
+
+void PacketHeaderColumns::resize(size_t headers) {
+  for (std::vector<Column>::iterator col(_columns.begin()); col != _columns.end(); ++col) {
+    if (col->bytes > 0) col->data.resize(headers * col->bytes, 0);
+    else col->wide.resize(headers);
+  }
+  _size = headers;
+  _filled = _columns.size();
+}
+
+void PacketHeaderColumns::swap(PacketHeaderColumns& other) {
+  _columns.swap(other._columns);
+  std::swap(_size, other._size);
+  std::swap(_filled, other._filled);
+}
+
+VarValue PacketHeaderColumns::value(size_t header, size_t field) const {
+  if (_columns[field].bytes == 0) return _columns[field].wide[header];
+  return VarValue(get(header, field));
+}
+
+void PacketHeaderColumns::set(size_t header, size_t field, const VarValue& val) {
+  Column& col = _columns[field];
+  if (col.bytes == 0) { // values, which fit into 64 bits, fit into a wide field, too
+    if (!val.fits_ulong_p()) {
+      mpz_class wide(val.get_mpz());
+      if (sgn(wide) < 0 || mpz_sizeinbase(wide.get_mpz_t(), 2) > col.bits)
+        throw "Header value exceeds the width of its field (PacketHeaderColumns).";
+    }
+    col.wide[header] = val;
+    return;
+  }
+
+  if (!val.fits_ulong_p() || (col.bits < 64 && val.get_ui() >> col.bits != 0))
+    throw "Header value exceeds the width of its field (PacketHeaderColumns).";
+
+  put(header, field, val.get_ui());
+}
+
+void PacketHeaderColumns::addHeader() {
+  resize(_size + 1);
+  _filled = 0;
+}
+
+void PacketHeaderColumns::addValue(const VarValue& val) {
+  if (_size == 0) throw "No header exists to add a value to (PacketHeaderColumns).";
+  if (_filled >= _columns.size()) throw "Header has more values than fields in its structure (PacketHeaderColumns).";
+
+  set(_size - 1, _filled, val);
+  ++_filled;
+}
+
+void PacketHeaderColumns::append(const PacketHeaderSet& headers) {
+  size_t header = _size, filled = _filled;
+  resize(_size + headers.size());
+
+  try {
+    for (PacketHeaderSet::const_iterator line(headers.cbegin()); line != headers.cend(); ++line, ++header) {
+      if ((*line)->size() != _columns.size())
+        throw "Amount of header values does not match the header structure (PacketHeaderColumns).";
+
+      for (size_t field = 0; field < _columns.size(); ++field)
+        set(header, field, (*line)->at(field)->value);
+    }
+  } catch (...) { // no header is appended, if one of them is invalid
+    resize(_size - headers.size());
+    _filled = filled;
+    throw;
+  }
+}
+
+void PacketHeaderColumns::append(const PacketHeaderColumns& headers) {
+  append(headers, 0, headers._size);
+}
+
+void PacketHeaderColumns::append(const PacketHeaderColumns& headers, size_t first, size_t count) {
+  if (headers._columns.size() != _columns.size())
+    throw "Amount of header fields does not match the header structure (PacketHeaderColumns).";
+  if (first >= headers._size) return;
+  if (count > headers._size - first) count = headers._size - first;
+
+  for (size_t field = 0; field < _columns.size(); ++field) {
+    if (headers._columns[field].bytes != _columns[field].bytes)
+      throw "Width of a header field does not match the header structure (PacketHeaderColumns).";
+  }
+
+  for (size_t field = 0; field < _columns.size(); ++field) {
+    Column& col = _columns[field];
+    const Column& other = headers._columns[field];
+    if (col.bytes > 0)
+      col.data.insert(col.data.end(), other.data.cbegin() + first * col.bytes, other.data.cbegin() + (first + count) * col.bytes);
+    else
+      col.wide.insert(col.wide.end(), other.wide.cbegin() + first, other.wide.cbegin() + first + count);
+  }
+  _size += count;
+  _filled = _columns.size();
+}
+
+void PacketHeaderColumns::toHeaderSet(PacketHeaderSet& output, size_t first, size_t count) const {
+  output.clear();
+  if (first >= _size) return;
+  if (count > _size - first) count = _size - first;
+
+  output.reserve(count);
+  for (size_t header = first; header < first + count; ++header) {
+    std::unique_ptr<PacketHeaderLine> line(new PacketHeaderLine);
+    line->reserve(_columns.size());
+    for (size_t field = 0; field < _columns.size(); ++field)
+      line->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(value(header, field))));
+    output.push_back(std::move(line));
+  }
+}
+
+} // namespace Generic
+
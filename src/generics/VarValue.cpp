@@ -1,15 +1,114 @@
 #include <generics/VarValue.hpp>
 
 namespace Generic {
-Generic::VarValue negateVarValue(const Generic::VarValue& val) {
-  using namespace Generic;
 
+static_assert(sizeof(unsigned long) >= sizeof(uint64_t), "Inline values of VarValue have to fit into an unsigned long of GMP.");
+
+void VarValue::_assign(const mpz_class& val) {
+  if (sgn(val) >= 0 && val.fits_ulong_p()) {
+    _small = val.get_ui();
+    _big.reset();
+  } else {
+    _small = 0;
+    if (_big) *_big = val;
+    else _big.reset(new mpz_class(val));
+  }
+}
+
+void VarValue::_assign(const char* str) {
+  // fast path for plain numbers in decimal, hex ('0x'), binary ('0b') or octal ('0') notation
+  const char* pos = str;
+  unsigned int base = 10;
+  if (pos[0] == '0' && (pos[1] == 'x' || pos[1] == 'X')) { base = 16; pos += 2; }
+  else if (pos[0] == '0' && (pos[1] == 'b' || pos[1] == 'B')) { base = 2; pos += 2; }
+  else if (pos[0] == '0' && pos[1] != '\0') { base = 8; pos += 1; }
+
+  uint64_t value = 0;
+  bool valid = (*pos != '\0');
+  for (; valid && *pos != '\0'; ++pos) {
+    unsigned int digit;
+    if (*pos >= '0' && *pos <= '9') digit = *pos - '0';
+    else if (*pos >= 'a' && *pos <= 'f') digit = *pos - 'a' + 10;
+    else if (*pos >= 'A' && *pos <= 'F') digit = *pos - 'A' + 10;
+    else digit = base;
+
+    valid = (digit < base && !__builtin_mul_overflow(value, base, &value) && !__builtin_add_overflow(value, digit, &value));
+  }
+
+  if (valid) {
+    _small = value;
+    _big.reset();
+  } else { // wide values, whitespaces and signs are left to GMP (which also throws on invalid strings)
+    _assign(mpz_class(str));
+  }
+}
+
+void VarValue::_assignSigned(long long val) {
+  mpz_class big;
+  mpz_set_si(big.get_mpz_t(), (long)val);
+  _assign(big);
+}
+
+void VarValue::_assignDouble(double val) {
+  _assign(mpz_class(val));
+}
+
+mpz_class VarValue::get_mpz() const {
+  if (_big) return *_big;
+  return mpz_class((unsigned long)_small);
+}
+
+VarValue VarValue::_compute(Operation op, const VarValue& lhs, const VarValue& rhs) {
+  const mpz_class left(lhs.get_mpz());
+  const mpz_class right(rhs.get_mpz());
+  mpz_class result;
+
+  if ((op == DIV || op == MOD) && right == 0) throw "Division by zero is not defined (VarValue).";
+
+  switch (op) {
+    case ADD: result = left + right; break;
+    case SUB: result = left - right; break;
+    case MUL: result = left * right; break;
+    case DIV: result = left / right; break;
+    case MOD: result = left % right; break;
+    case AND: result = left & right; break;
+    case OR:  result = left | right; break;
+    case XOR: result = left ^ right; break;
+    case NEG: result = -left; break;
+    case COM: result = ~left; break;
+    default: throw "Given operation is not supported for multiprecision values (VarValue).";
+  }
+  return VarValue(result);
+}
+
+VarValue VarValue::_shift(Operation op, const VarValue& lhs, unsigned long bits) {
+  const mpz_class left(lhs.get_mpz());
+  mpz_class result;
+
+  if (op == SHL) result = left << bits;
+  else result = left >> bits;
+  return VarValue(result);
+}
+
+int VarValue::_compare(const VarValue& lhs, const VarValue& rhs) {
+  return cmp(lhs.get_mpz(), rhs.get_mpz());
+}
+
+std::ostream& operator<<(std::ostream& out, const VarValue& val) {
+  if (val._isSmall()) return out << val._small;
+  return out << *val._big;
+}
+
+VarValue negateVarValue(const VarValue& val) {
   VarValue signbitkiller(1);
   while (signbitkiller <= val) { // leftshift with padding 1s
-    signbitkiller = (signbitkiller << 1) | 1; 
+    signbitkiller = (signbitkiller << 1) | 1;
   }
   signbitkiller = signbitkiller >> 1; // one too much
 
+  if (val.fits_ulong_p() && signbitkiller.fits_ulong_p()) // avoid negative intermediate result of '~'
+    return VarValue(~val.get_ui() & signbitkiller.get_ui());
+
   VarValue result = (~val) & signbitkiller;
   return result;
 }
@@ -29,6 +29,11 @@ end
 
 -- checks, if rules follow specified structure
 function _CATE_checkRules(rules, structure)
+	if (rules.classbench ~= nil) then
+		_CATE_checkClassBench(rules, structure)
+		return
+	end
+
 	for i = 1, #rules do -- iterate over each rule
 		if (#rules[i] ~= #structure) then 
 			error("Validity error! Amount of rule atoms does not match header data structure.") 
@@ -47,6 +52,34 @@ function _CATE_checkRules(rules, structure)
 	end
 end
 
+-- checks a rule set of loadClassBenchRules (its filters are checked while they are parsed)
+function _CATE_checkClassBench(rules, structure)
+	if (type(rules.classbench) ~= "string") then
+		error("Validity error! Path of a ClassBench filter file must be a string.")
+	elseif (#rules > 0) then
+		error("Validity error! Rules can't be added to a rule set of a ClassBench filter file.")
+	elseif (#structure ~= 2 and #structure ~= 4 and #structure ~= 5) then
+		error("Validity error! ClassBench filters need a header structure with 2, 4 or 5 fields.")
+	end
+
+	local file = io.open(rules.classbench, "r")
+	if (file == nil) then
+		error("Validity error! ClassBench filter file '"..rules.classbench.."' can't be opened.")
+	end
+	file:close()
+end
+
+-- returns the number of rules of a rule set
+function _CATE_countRules(rules)
+	if (rules.classbench == nil) then return #rules end
+
+	local count = 0
+	for line in io.lines(rules.classbench) do
+		if (line:find("^%s*@") ~= nil) then count = count + 1 end
+	end
+	return count
+end
+
 -- checks, if configuration for header generation follow structure
 function _CATE_checkHeadersRandom(distributions, structure)
 	if (#distributions ~= #structure) then
@@ -83,26 +116,193 @@ function _CATE_checkRepetitions(repetitions)
 	end
 end
 
+-- checks, if a trace of rule updates follows the structure and stays inside of the rule set
+function _CATE_checkUpdates(trace, rules, structure)
+	if (type(trace) ~= "table" or type(trace[1]) ~= "number" or type(trace[2]) ~= "table") then
+		error("Validity error! A trace of rule updates has to be created with 'createUpdateTrace'.")
+	elseif (trace[1] < 0 or trace[1] ~= math.floor(trace[1])) then
+		error("Validity error! Amount of headers between rule updates must be a non-negative integer.")
+	end
+
+	local size = _CATE_countRules(rules) -- track size of the rule set while updates are applied
+	for i = 1, #trace[2] do
+		local update = trace[2][i]
+		if (type(update[2]) ~= "number" or update[2] < 0 or update[2] ~= math.floor(update[2])) then
+			error("Validity error! Index of a rule update must be a non-negative integer.")
+		end
+
+		if (update[1] == 0) then -- insertion
+			if (update[2] > size) then
+				error("Validity error! Rule is inserted at an index ("..update[2]..") outside of the rule set.")
+			end
+			if (type(update[3]) ~= "table") then
+				error("Validity error! No rule to insert was given.")
+			end
+			_CATE_checkRules({update[3]}, structure)
+			size = size + 1
+		elseif (update[1] == 1) then -- removal
+			if (update[2] >= size) then
+				error("Validity error! Rule is removed at an index ("..update[2]..") outside of the rule set.")
+			end
+			size = size - 1
+		else error("Rule update is of invalid type ("..tostring(update[1])..").") end
+	end
+end
+
+-- returns true, if a number is a positive power of two
+function _CATE_isPowerOfTwo(value)
+	local power = 1
+	while (power < value) do power = power * 2 end
+	return power == value
+end
+
+-- checks the levels of a simulated cache hierarchy
+function _CATE_checkCache(levels)
+	if (type(levels) ~= "table" or #levels == 0) then
+		error("Validity error! A simulated cache needs a table with at least one level (see 'createCacheLevel').")
+	end
+
+	for i = 1, #levels do
+		local level = levels[i]
+		if (type(level) ~= "table" or type(level[1]) ~= "string") then
+			error("Validity error! A cache level has to be created with 'createCacheLevel'.")
+		end
+		for j = 2, 4 do
+			if (type(level[j]) ~= "number" or level[j] < 1 or level[j] ~= math.floor(level[j])) then
+				error("Validity error! Size, ways and line size of cache level '"..level[1].."' must be positive integers.")
+			end
+		end
+		if (not _CATE_isPowerOfTwo(level[4])) then
+			error("Validity error! Line size of cache level '"..level[1].."' must be a power of two.")
+		elseif (level[2] % (level[3] * level[4]) ~= 0) then
+			error("Validity error! Size of cache level '"..level[1].."' must be a multiple of its ways and line size.")
+		elseif (level[5] ~= "lru" and level[5] ~= "plru") then
+			error("Validity error! Replacement policy of cache level '"..level[1].."' must be 'lru' or 'plru'.")
+		elseif (level[5] == "plru" and (level[3] > 64 or not _CATE_isPowerOfTwo(level[3]))) then
+			error("Validity error! Pseudo-LRU of cache level '"..level[1].."' needs a power of two (up to 64) as ways.")
+		end
+	end
+end
+
+-- checks, if optional benchmark settings are known and reasonable
+function _CATE_checkOptions(options, rules, structure)
+	for key, value in pairs(options) do
+		if (key == "threads") then
+			if (type(value) ~= "number" or value < 1 or value ~= math.floor(value)) then
+				error("Validity error! Amount of threads must be a positive integer.")
+			end
+		elseif (key == "warmup") then
+			if (type(value) ~= "number" or value < 0 or value ~= math.floor(value)) then
+				error("Validity error! Amount of warm-up runs must be a non-negative integer.")
+			end
+		elseif (key == "cpu") then
+			if (type(value) ~= "number" or value < 0 or value ~= math.floor(value)) then
+				error("Validity error! Number of the cpu must be a non-negative integer.")
+			end
+		elseif (key == "batch_size") then
+			if (type(value) ~= "number" or value < 1 or value ~= math.floor(value)) then
+				error("Validity error! Batch size for header generation must be a positive integer.")
+			end
+		elseif (key == "native") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for native classification given (expected was 'true' or 'false').")
+			end
+		elseif (key == "matches") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for the output of matches given (expected was 'true' or 'false').")
+			end
+		elseif (key == "sampling") then
+			if (type(value) ~= "number" or value < 1 or value ~= math.floor(value)) then
+				error("Validity error! Sampling rate must be a positive integer.")
+			end
+		elseif (key == "latency") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for latency measurement given (expected was 'true' or 'false').")
+			end
+		elseif (key == "counters") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for hardware counters given (expected was 'true' or 'false').")
+			end
+		elseif (key == "updates") then
+			_CATE_checkUpdates(value, rules, structure)
+		elseif (key == "cache") then
+			_CATE_checkCache(value)
+		elseif (key == "access_trace") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for an access trace given (expected was 'true' or 'false').")
+			end
+		elseif (key == "heap") then
+			if (value ~= true and value ~= false) then
+				error("No valid configuration for measuring the heap given (expected was 'true' or 'false').")
+			end
+		else
+			error("Validity error! Unknown benchmark option ("..tostring(key)..").")
+		end
+	end
+end
+
+-- checks the configuration of a replayed packet capture
+function _CATE_checkPcap(pcap, structure)
+	local names = {src_ip = true, dst_ip = true, src_port = true, dst_port = true, protocol = true,
+		vlan = true, tos = true, ttl = true, length = true, tcp_flags = true, zero = true}
+
+	if (type(pcap[2]) ~= "string") then
+		error("Validity error! Path of a packet capture must be a string.")
+	elseif (type(pcap[3]) ~= "number" or pcap[3] < 1 or pcap[3] ~= math.floor(pcap[3])) then
+		error("Validity error! Number of replays of a packet capture must be a positive integer.")
+	elseif (#pcap[4] > 0 and #pcap[4] ~= #structure) then
+		error("Validity error! Amount of packet fields does not match header data structure.")
+	end
+	for i = 1, #pcap[4] do
+		if (not names[pcap[4][i]]) then
+			error("Validity error! Unknown packet field ("..tostring(pcap[4][i])..").")
+		end
+	end
+end
+
+-- rule and header sets, which were already checked with a structure (sets are shared by benchmarks)
+_CATE_checkedSets = {}
+
+-- returns true, if a set was already checked with the structure (otherwise, it is marked as checked)
+function _CATE_isChecked(set, structure)
+	local key = table.concat(structure, ",")
+	if (_CATE_checkedSets[set] == nil) then _CATE_checkedSets[set] = {} end
+	if (_CATE_checkedSets[set][key]) then return true end
+	_CATE_checkedSets[set][key] = true
+	return false
+end
+
 -- delegates calls to check each element of a benchmark
 function _CATE_checkBenchmark(benchmark)
-	_CATE_checkRules(benchmark[4], benchmark[3])
+	if (not _CATE_isChecked(benchmark[4], benchmark[3])) then
+		_CATE_checkRules(benchmark[4], benchmark[3])
+	end
 
 	-- check if headers are specified explicit or for random generation
 	if (benchmark[5][1] == "random") then
 		if (benchmark[5][2] < 0) then
 			error("Validity error! A negative amount of headers to generate was specified.")
-		elseif (benchmark[5][3] ~= true and benchmark[5][3] ~= false) then
-			error("No valid configuration for output of headers to file given (expected was 'true' or 'false').")
+		elseif (benchmark[5][3] ~= true and benchmark[5][3] ~= false and benchmark[5][3] ~= "binary") then
+			error("No valid configuration for output of headers to file given (expected was 'true', 'false' or 'binary').")
 		else
 			_CATE_checkHeadersRandom(benchmark[5][4], benchmark[3])
 		end
 	elseif (benchmark[5][1] == "exact") then
-		_CATE_checkHeaders(benchmark[5][2], benchmark[3])
+		if (not _CATE_isChecked(benchmark[5][2], benchmark[3])) then
+			_CATE_checkHeaders(benchmark[5][2], benchmark[3])
+		end
+	elseif (benchmark[5][1] == "trace") then
+		if (type(benchmark[5][2]) ~= "string") then
+			error("Validity error! Path of a header trace must be a string.")
+		end
+	elseif (benchmark[5][1] == "pcap") then
+		_CATE_checkPcap(benchmark[5], benchmark[3])
 	else
 		error("Headers were specified in an unknown format.")
 	end
 
 	_CATE_checkRepetitions(benchmark[6])
+	_CATE_checkOptions(benchmark[7], benchmark[4], benchmark[3])
 end
 
 for i = 1, #_CATE_benchmarksuite do
@@ -10,6 +10,34 @@
 -- table with all necessary benchmark information, is filled inside 'register'-funct.
 local _CATE_benchmarksuite = {}
 
+-- files read by the configuration and whether it only depends on them, so the
+-- parsed configuration can be cached by CATE until one of the files changes
+_CATE_sourceFiles = {}
+_CATE_cacheable = true
+do
+	local dofile_, loadfile_, open_, lines_ = dofile, loadfile, io.open, io.lines
+	local function _CATE_addSource(filename)
+		if (filename == nil) then _CATE_cacheable = false -- reads stdin
+		else table.insert(_CATE_sourceFiles, filename) end
+	end
+	function dofile(filename) _CATE_addSource(filename); return dofile_(filename) end
+	function loadfile(filename, ...) _CATE_addSource(filename); return loadfile_(filename, ...) end
+	function io.lines(filename, ...) _CATE_addSource(filename); return lines_(filename, ...) end
+	function io.open(filename, mode)
+		if (mode == nil or string.sub(mode, 1, 1) == "r") then _CATE_addSource(filename) end
+		return open_(filename, mode)
+	end
+
+	-- results of these functions change between runs
+	local function _CATE_uncacheable(lib, name)
+		local func = lib[name]
+		lib[name] = function(...) _CATE_cacheable = false; return func(...) end
+	end
+	for _, name in ipairs({"time", "clock", "date", "getenv", "tmpname", "execute"}) do _CATE_uncacheable(os, name) end
+	for _, name in ipairs({"read", "popen", "input"}) do _CATE_uncacheable(io, name) end
+	_CATE_uncacheable(_G, "require")
+end
+
 -- Helper function to convert ip-string to 32Bit-integer
 function ipv4Toi(ip) 
 	local resultArr = {}
@@ -71,6 +99,10 @@ function addRuleToRuleset(ruleset, rule)
 	return ruleset
 end
 
+-- Rule set of a filter file in the format of ClassBench, which is parsed natively (the structure needs 2, 4 or 5
+-- fields for source/destination address, source/destination port and protocol in this order)
+function loadClassBenchRules(filename) return {classbench = filename} end
+
 function createHeaderset() return {"exact", {}} end
 function addHeaderToHeaderset(headerset, header)	
 	local index = #headerset[2] + 1
@@ -78,6 +110,15 @@ function addHeaderToHeaderset(headerset, header)
 	return headerset
 end
 
+-- Headers of a binary header trace, which are streamed during the benchmark (path relative to the working directory)
+function loadHeaderTrace(filename) return {"trace", filename} end
+
+-- Headers of the IPv4 packets of a pcap or pcapng file, which are streamed during the benchmark. All packets
+-- are classified 'replay' times (default: 1). Optionally, 'fields' names the packet field of each header field
+-- (src_ip, dst_ip, src_port, dst_port, protocol, vlan, tos, ttl, length, tcp_flags or zero).
+function loadPcap(filename, replay, fields) return {"pcap", filename, replay or 1, fields or {}} end
+
+-- Generated headers are written to a file, if output is true (csv) or "binary" (header trace)
 function createRandomHeaders(amount, output, distributions) return {"random", amount, output, distributions} end
 function constantDistribution(value) return {0, value} end
 function uniformDistribution(seed, min, max) return {1, seed, min, max} end
@@ -87,9 +128,30 @@ function exponentialDistribution(seed, lambda) return {4, seed, lambda} end
 function cauchyDistribution(seed, a, b) return {5, seed, b, a} end
 function paretoDistribution(seed, scale, shape, offset) return {6, seed, scale, shape, offset} end
 
--- Add a benchmark run to the current benchmark suite
-function registerBenchmark(caption, algorithm, structure, rules, headers, amount_runs)
+-- Trace of rule updates, which is replayed after the classification (option 'updates' of a benchmark).
+-- Before each update, the given number of headers is classified (default: 0).
+function createUpdateTrace(headers_per_update) return {headers_per_update or 0, {}} end
+function addRuleInsertion(trace, index, rule)
+	trace[2][#trace[2] + 1] = {0, index, rule}
+	return trace
+end
+function addRuleRemoval(trace, index)
+	trace[2][#trace[2] + 1] = {1, index}
+	return trace
+end
+
+-- One level of a simulated cache hierarchy (option 'cache' of a benchmark, a table of levels beginning next to
+-- the CPU): capacity and line size in bytes (default: 64), number of ways and replacement policy ("lru" or "plru")
+function createCacheLevel(name, size, ways, line_size, policy) return {name, size, ways, line_size or 64, policy or "lru"} end
+
+-- A cache hierarchy like one core of a current x86 CPU: 32 KiB L1D (8 ways), 1 MiB L2 (16 ways) and 8 MiB LLC (16 ways)
+function defaultCacheHierarchy()
+	return {createCacheLevel("L1", 32768, 8), createCacheLevel("L2", 1048576, 16), createCacheLevel("LLC", 8388608, 16)}
+end
+
+-- Add a benchmark run to the current benchmark suite (options are optional, e.g. {threads = 4, batch_size = 4096})
+function registerBenchmark(caption, algorithm, structure, rules, headers, amount_runs, options)
 	local index = #_CATE_benchmarksuite + 1
-	_CATE_benchmarksuite[index] = {caption, algorithm, structure, rules, headers, amount_runs}
+	_CATE_benchmarksuite[index] = {caption, algorithm, structure, rules, headers, amount_runs, options or {}}
 end
 
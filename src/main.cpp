@@ -1,8 +1,12 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
 #include <frontend/FilesysHelper.hpp>
 #include <frontend/Shell.hpp>
 #include <frontend/Web.hpp>
+#include <metering/memory/ReuseDistance.hpp>
 
 
 #ifndef VERSION_MAJOR
@@ -22,12 +26,71 @@ void printVersion() {
 }
 
 void printUsage(const std::string& progname) {
-  std::cerr << "Usage:\t" << progname << " <configuration-file> <results-dir>" << std::endl;
+  std::cerr << "Usage:\t" << progname << " [options] <configuration-file> <results-dir>" << std::endl;
+  std::cerr << "\t-t, --threads <n>\tclassify headers of all benchmarks additionally with <n> threads" << std::endl;
+  std::cerr << "\t-j, --jobs <n>\t\texecute up to <n> benchmarks concurrently in separate processes" << std::endl;
+  std::cerr << "\t--isolate\t\texecute each benchmark in a separate process" << std::endl;
+  std::cerr << "\t--timeout <s>\t\tstop each benchmark after <s> seconds (implies --isolate)" << std::endl;
+  std::cerr << "\t--memory-limit <MiB>\tlimit the address space of each benchmark (implies --isolate)" << std::endl;
+  std::cerr << "\t--snapshots <dir>\tbuild classifiers only once and keep their snapshots in <dir>" << std::endl;
+  std::cerr << "\t--no-config-cache\tinterpret the configuration, even if it is cached unchanged" << std::endl;
+  std::cerr << "   or:\t" << progname << " --reuse-report <access-trace> [--line-size <bytes>]" << std::endl;
+  std::cerr << "\tprint a histogram of the reuse distances in an access trace of a benchmark (default: 64 byte lines)" << std::endl;
 
   //std::cerr << "   or:\t" << progname << " -w <port>" << std::endl;
   //std::cerr << "\t-w\tstart as web-server on specified tcp-port <port>" << std::endl;
 }
 
+/**
+ * Parses the positive number following the option at argv[i] and advances i.
+ * Prints an error and returns false, if it is missing or invalid.
+ */
+bool parsePositive(int argc, char *argv[], int& i, const std::string& what, unsigned long& value) {
+  if (i + 1 >= argc) {
+    std::cerr << "Critical error! No " << what << " was specified." << std::endl;
+    return false;
+  }
+  try {
+    value = std::stoul(argv[++i], nullptr, 0);
+  } catch (const std::exception&) {
+    value = 0;
+  }
+  if (value == 0) {
+    std::cerr << "Critical error! The " << what << " must be a positive integer." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Prints the histogram of the reuse distances of all accesses in a trace as csv,
+ * including the share of accesses with at most the distance of each bucket (the
+ * hit ratio of a fully associative LRU cache with this number of lines).
+ */
+bool printReuseReport(const std::string& traceFile, unsigned long lineSize) {
+  try {
+    Memory::AccessTraceReader trace(traceFile);
+    Memory::ReuseDistance reuse(lineSize);
+    reuse.add(trace);
+
+    std::cout << "# reuse distances of '" << traceFile << "' (" << lineSize << " byte lines)" << std::endl;
+    std::cout << "distance-min; distance-max; accesses; share; cumulative-share;" << std::endl;
+    double total = (reuse.accesses() > 0 ? reuse.accesses() : 1);
+    uint64_t cumulative = 0;
+    const std::vector<uint64_t>& buckets = reuse.buckets();
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+      cumulative += buckets[bucket];
+      std::cout << Memory::ReuseDistance::bucketMin(bucket) << "; " << Memory::ReuseDistance::bucketMax(bucket) << "; " <<
+        buckets[bucket] << "; " << std::to_string(buckets[bucket] / total) << "; " << std::to_string(cumulative / total) << ";" << std::endl;
+    }
+    std::cout << "cold; cold; " << reuse.coldAccesses() << "; " << std::to_string(reuse.coldAccesses() / total) << "; 1.000000;" << std::endl;
+  } catch (const char* ex) {
+    std::cerr << "Critical error! " << ex << std::endl;
+    return false;
+  }
+  return true;
+}
+
 int main(int argc, char *argv[]) {
   printVersion();
   
@@ -54,16 +117,73 @@ int main(int argc, char *argv[]) {
 //    else
 //      std::cerr << "Critical error! Port is invalid. Please specify a port-number between 1 and 65535." << std::endl;
 //  }
-  if (argc >= 3) { // try in shell-mode
+  // separate options from positional arguments
+  std::vector<std::string> args;
+  unsigned long threads = 0;
+  unsigned long jobs = 1;
+  unsigned long timeout = 0;
+  unsigned long memoryLimit = 0;
+  bool isolate = false;
+  bool configCache = true;
+  std::string snapshotDir;
+  std::string reuseTrace;
+  unsigned long lineSize = 64;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "--threads" || arg == "-t") {
+      if (!parsePositive(argc, argv, i, "number of threads", threads)) return EXIT_FAILURE;
+    }
+    else if (arg == "--jobs" || arg == "-j") {
+      if (!parsePositive(argc, argv, i, "number of jobs", jobs)) return EXIT_FAILURE;
+    }
+    else if (arg == "--timeout") {
+      if (!parsePositive(argc, argv, i, "timeout", timeout)) return EXIT_FAILURE;
+    }
+    else if (arg == "--memory-limit") {
+      if (!parsePositive(argc, argv, i, "memory limit", memoryLimit)) return EXIT_FAILURE;
+    }
+    else if (arg == "--line-size") {
+      if (!parsePositive(argc, argv, i, "line size", lineSize)) return EXIT_FAILURE;
+    }
+    else if (arg == "--reuse-report") {
+      if (i + 1 >= argc) {
+        std::cerr << "Critical error! No access trace was specified." << std::endl;
+        return EXIT_FAILURE;
+      }
+      reuseTrace = argv[++i];
+    }
+    else if (arg == "--isolate")
+      isolate = true;
+    else if (arg == "--no-config-cache")
+      configCache = false;
+    else if (arg == "--snapshots") {
+      if (i + 1 >= argc) {
+        std::cerr << "Critical error! No directory for snapshots was specified." << std::endl;
+        return EXIT_FAILURE;
+      }
+      snapshotDir = argv[++i];
+      if (!FilesysHelper::checkAndSetDir(snapshotDir, relPath)) {
+        std::cerr << "Critical error! Specified directory for snapshots does not exist." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    else
+      args.push_back(arg);
+  }
+
+  if (!reuseTrace.empty()) // analyze an access trace only
+    return (printReuseReport(reuseTrace, lineSize) ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  if (args.size() >= 2) { // try in shell-mode
     // get config-file
-    std::string configFile(argv[1]);
+    std::string configFile(args[0]);
 		std::cout << "# configuration file: " << configFile << std::endl;
 
-    unsigned int idxResultDir = 2;
+    unsigned int idxResultDir = 1;
     // get results-directory
     std::string resultDir;
-    if (argc >= (int)(idxResultDir + 1)) {
-      resultDir = argv[idxResultDir];
+    if (args.size() >= idxResultDir + 1) {
+      resultDir = args[idxResultDir];
 		  std::cout << "# directory for results: " << resultDir << std::endl;
 
       if (!FilesysHelper::checkAndSetDir(resultDir, relPath)) {
@@ -83,6 +203,13 @@ int main(int argc, char *argv[]) {
     sh.setProgramName(progname);
     sh.setConfigFile(configFile);
     sh.setResultsDir(resultDir);
+    sh.setThreads(threads);
+    sh.setJobs(jobs);
+    sh.setIsolation(isolate);
+    sh.setTimeout(timeout);
+    sh.setMemoryLimit((uint64_t)memoryLimit << 20); // MiB
+    sh.setSnapshotDir(snapshotDir);
+    sh.setConfigCache(configCache);
     sh.run();
   }
   else // wrong usage
@@ -0,0 +1,88 @@
+#include <metering/HeapMeter.hpp>
+#include <new>
+#include <cstdlib>
+#include <malloc.h>
+
+namespace {
+
+/** counters of the active phase of the calling thread (null: thread isn't metered) */
+thread_local HeapCounters* activeCounters = nullptr;
+
+inline void* meteredAlloc(std::size_t size) {
+  void* ptr = malloc(size == 0 ? 1 : size);
+  HeapCounters* counters = activeCounters;
+  if (ptr != nullptr && counters != nullptr) {
+    counters->liveBytes += malloc_usable_size(ptr);
+    if (counters->liveBytes > counters->peakBytes) counters->peakBytes = counters->liveBytes;
+    ++counters->allocations;
+  }
+  return ptr;
+}
+
+/** Calls the new-handler until the allocation succeeds, like the default operator new. */
+inline void* meteredNew(std::size_t size) {
+  void* ptr;
+  while ((ptr = meteredAlloc(size)) == nullptr) {
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) throw std::bad_alloc();
+    handler();
+  }
+  return ptr;
+}
+
+inline void* meteredNewNothrow(std::size_t size) noexcept {
+  try {
+    return meteredNew(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+inline void meteredFree(void* ptr) noexcept {
+  HeapCounters* counters = activeCounters;
+  if (ptr != nullptr && counters != nullptr) {
+    counters->liveBytes -= malloc_usable_size(ptr);
+    ++counters->deallocations;
+  }
+  free(ptr);
+}
+
+} // namespace
+
+/* Replacements of the global allocation functions (also used by the algorithm libraries). */
+void* operator new(std::size_t size) { return meteredNew(size); }
+void* operator new[](std::size_t size) { return meteredNew(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return meteredNewNothrow(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return meteredNewNothrow(size); }
+void operator delete(void* ptr) noexcept { meteredFree(ptr); }
+void operator delete[](void* ptr) noexcept { meteredFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { meteredFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { meteredFree(ptr); }
+
+void HeapMeter::start(const std::string& phase) {
+  if (!_enabled) return;
+  stop(); // phases aren't nested
+
+  size_t index = 0;
+  while (index < _phases.size() && _phases[index].first != phase) ++index;
+  if (index == _phases.size()) _phases.push_back(std::make_pair(phase, HeapCounters()));
+
+  // the list isn't changed anymore, until the phase is stopped
+  _active = true;
+  activeCounters = &_phases[index].second;
+}
+
+void HeapMeter::stop() {
+  if (!_active) return;
+  activeCounters = nullptr;
+  _active = false;
+}
+
+void HeapMeter::getAllResults(HeapResults& results) const {
+  results = _phases;
+}
+
+void HeapMeter::reset() {
+  stop();
+  _phases.clear();
+}
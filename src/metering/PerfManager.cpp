@@ -0,0 +1,131 @@
+#include <metering/PerfManager.hpp>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+namespace {
+
+/** An event, which is requested from the kernel. */
+struct EventType {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+/** Returns the config-value of a read miss in the given cache. */
+constexpr uint64_t cacheReadMiss(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const EventType eventTypes[] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "L1D misses", PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D) },
+  { "LLC misses", PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL) },
+  { "branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { "dTLB misses", PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB) }
+};
+
+int openEvent(const EventType& event) {
+  struct perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.exclude_kernel = 1; // also allowed with perf_event_paranoid = 2
+  attr.exclude_hv = 1;
+  // more events than hardware counters are multiplexed, so values are scaled
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  // count the calling thread on any cpu
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+} // namespace
+
+bool PerfManager::open() {
+  close();
+
+  for (const EventType& event : eventTypes) {
+    int fd = openEvent(event);
+    if (fd >= 0) _counters.push_back(Counter{ event.name, fd });
+    else _error = std::string("perf_event_open failed: ") + std::strerror(errno);
+  }
+
+  if (!_counters.empty()) _error.clear();
+  return isAvailable();
+}
+
+void PerfManager::close() {
+  for (std::vector<Counter>::const_iterator iter(_counters.cbegin()); iter != _counters.cend(); ++iter)
+    ::close(iter->fd);
+  _counters.clear();
+  _categories.clear();
+}
+
+void PerfManager::_read(std::vector<double>& values) const {
+  values.resize(_counters.size());
+
+  for (size_t i = 0; i < _counters.size(); ++i) {
+    uint64_t data[3] = { 0, 0, 0 }; // value, time enabled, time running
+    if (::read(_counters[i].fd, data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0)
+      values[i] = 0;
+    else
+      values[i] = (double)data[0] * data[1] / data[2];
+  }
+}
+
+#else
+
+bool PerfManager::open() {
+  _error = "hardware performance counters are only supported on Linux";
+  return false;
+}
+
+void PerfManager::close() {
+  _categories.clear();
+}
+
+void PerfManager::_read(std::vector<double>& values) const {
+  values.clear();
+}
+
+#endif
+
+void PerfManager::start(const std::string& key) {
+  if (_suspended || _counters.empty()) return;
+
+  Category& category = _categories[key];
+  if (category.totals.empty()) category.totals.resize(_counters.size(), 0);
+  _read(category.startValues);
+}
+
+void PerfManager::stop(const std::string& key) {
+  if (_suspended || _counters.empty()) return;
+
+  std::unordered_map<std::string, Category>::iterator iter(_categories.find(key));
+  if (iter == _categories.end()) throw "Category with the given key doesn't exist (PerfManager::stop).";
+
+  std::vector<double> values;
+  _read(values);
+  Category& category = iter->second;
+  for (size_t i = 0; i < values.size(); ++i) {
+    category.totals[i] += values[i] - category.startValues[i];
+    category.startValues[i] = values[i]; // for lap-like functionality, as in Chronograph
+  }
+}
+
+void PerfManager::getAllResults(PerfResults& results) const {
+  results.events.clear();
+  results.categories.clear();
+
+  for (std::vector<Counter>::const_iterator iter(_counters.cbegin()); iter != _counters.cend(); ++iter)
+    results.events.push_back(iter->name);
+
+  for (auto iter(_categories.cbegin()); iter != _categories.cend(); ++iter)
+    results.categories.push_back(std::make_pair( iter->first, iter->second.totals ));
+}
@@ -0,0 +1,208 @@
+#include <metering/memory/AccessTrace.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace Memory {
+
+/** magic number at the beginning of each access trace ("CATR") */
+static const uint32_t TRACE_MAGIC = 0x52544143;
+/** is increased, if the format of the file changes */
+static const uint32_t TRACE_VERSION = 1;
+/** size of the file header in bytes */
+static const size_t TRACE_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+/** flags of a record */
+static const uint8_t FLAG_WRITE = 0x01;
+static const uint8_t FLAG_BYTES = 0x02;
+static const uint8_t FLAG_GROUP = 0x04;
+static const uint8_t FLAG_HEADER = 0x08;
+
+static inline void encodeVarint(uint64_t val, std::vector<uint8_t>& out) {
+  while (val >= 0x80) {
+    out.push_back((uint8_t)(val | 0x80));
+    val >>= 7;
+  }
+  out.push_back((uint8_t)val);
+}
+
+/** Encodes the difference of two values, so that small negative differences take few bytes, too. */
+static inline void encodeDifference(uint64_t val, uint64_t previous, std::vector<uint8_t>& out) {
+  int64_t diff = (int64_t)(val - previous);
+  encodeVarint(((uint64_t)diff << 1) ^ (uint64_t)(diff >> 63), out);
+}
+
+static inline bool decodeVarint(const uint8_t* in, size_t size, size_t& pos, uint64_t& val) {
+  val = 0;
+  for (unsigned int shift = 0; shift < 64 && pos < size; shift += 7) {
+    uint8_t byte = in[pos++];
+    val |= (uint64_t)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+static inline bool decodeDifference(const uint8_t* in, size_t size, size_t& pos, uint64_t previous, uint64_t& val) {
+  uint64_t zigzag;
+  if (!decodeVarint(in, size, pos, zigzag)) return false;
+  val = previous + ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+  return true;
+}
+
+AccessTraceWriter::AccessTraceWriter(const std::string& filename, size_t bufferRecords) : _file(nullptr), _buffer(), _pending(),
+  _capacity(bufferRecords > 0 ? bufferRecords : 1), _groups(), _header(0), _suspended(false), _records(0), _thread(), _mutex(),
+  _changed(), _stop(false), _failed(false), _last(), _encoded() {
+  _file = fopen(filename.c_str(), "wb");
+  if (!_file) throw "Failed to open the access trace for writing (AccessTraceWriter).";
+
+  uint32_t header[2] = { TRACE_MAGIC, TRACE_VERSION };
+  if (fwrite(header, sizeof(uint32_t), 2, _file) != 2) {
+    fclose(_file);
+    _file = nullptr;
+    throw "Failed to write the header of the access trace (AccessTraceWriter).";
+  }
+
+  _buffer.reserve(_capacity);
+  _pending.reserve(_capacity);
+  _thread = std::thread(&AccessTraceWriter::_run, this);
+}
+
+AccessTraceWriter::~AccessTraceWriter() {
+  try {
+    close();
+  } catch (const char* ex) {}
+}
+
+AccessTraceGroup& AccessTraceWriter::group(unsigned int id) {
+  while (_groups.size() <= id) {
+    AccessTraceGroup group;
+    group.writer = this;
+    group.id = _groups.size();
+    _groups.push_back(group);
+  }
+  return _groups[id];
+}
+
+void AccessTraceWriter::_handOver() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _changed.wait(lock, [this] { return _pending.empty(); });
+  _records += _buffer.size();
+  _buffer.swap(_pending);
+  _changed.notify_all();
+}
+
+void AccessTraceWriter::_run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _changed.wait(lock, [this] { return !_pending.empty() || _stop; });
+    if (_pending.empty()) break; // stopped and nothing left
+
+    // the metered thread doesn't touch pending records, until they are cleared
+    lock.unlock();
+    _encode(_pending);
+    bool failed = (fwrite(_encoded.data(), 1, _encoded.size(), _file) != _encoded.size());
+    lock.lock();
+
+    if (failed) _failed = true;
+    _pending.clear();
+    _changed.notify_all();
+  }
+}
+
+void AccessTraceWriter::_encode(const std::vector<AccessRecord>& records) {
+  _encoded.clear();
+  for (std::vector<AccessRecord>::const_iterator iter(records.cbegin()); iter != records.cend(); ++iter) {
+    uint8_t flags = (iter->write ? FLAG_WRITE : 0);
+    if (iter->bytes != _last.bytes) flags |= FLAG_BYTES;
+    if (iter->group != _last.group) flags |= FLAG_GROUP;
+    if (iter->header != _last.header) flags |= FLAG_HEADER;
+
+    _encoded.push_back(flags);
+    encodeDifference(iter->address, _last.address, _encoded);
+    if (flags & FLAG_BYTES) encodeVarint(iter->bytes, _encoded);
+    if (flags & FLAG_GROUP) encodeVarint(iter->group, _encoded);
+    if (flags & FLAG_HEADER) encodeDifference(iter->header, _last.header, _encoded);
+    _last = *iter;
+  }
+}
+
+void AccessTraceWriter::close() {
+  if (!_file) return;
+
+  if (!_buffer.empty()) _handOver();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+    _changed.notify_all();
+  }
+  _thread.join();
+
+  bool failed = _failed;
+  if (fclose(_file) != 0) failed = true;
+  _file = nullptr;
+  if (failed) throw "Failed to write all records of the access trace (AccessTraceWriter::close).";
+}
+
+AccessTraceReader::AccessTraceReader(const std::string& filename) : _mapping(nullptr), _mappingSize(0), _position(TRACE_HEADER_SIZE), _last() {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) throw "Failed to open the access trace (AccessTraceReader).";
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < TRACE_HEADER_SIZE) {
+    close(fd);
+    throw "Access trace is too short (AccessTraceReader).";
+  }
+
+  _mappingSize = st.st_size;
+  void* mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // mapping stays valid
+  if (mapping == MAP_FAILED) throw "Failed to map the access trace into memory (AccessTraceReader).";
+  _mapping = static_cast<const uint8_t*>(mapping);
+  madvise(mapping, _mappingSize, MADV_SEQUENTIAL);
+
+  uint32_t magic, version;
+  memcpy(&magic, _mapping, sizeof(uint32_t));
+  memcpy(&version, _mapping + sizeof(uint32_t), sizeof(uint32_t));
+  if (magic != TRACE_MAGIC || version != TRACE_VERSION) {
+    munmap(mapping, _mappingSize);
+    _mapping = nullptr;
+    throw "File is not an access trace of this version (AccessTraceReader).";
+  }
+}
+
+AccessTraceReader::~AccessTraceReader() {
+  if (_mapping) munmap(const_cast<uint8_t*>(_mapping), _mappingSize);
+}
+
+bool AccessTraceReader::next(AccessRecord& record) {
+  if (_position >= _mappingSize) return false;
+
+  uint8_t flags = _mapping[_position++];
+  record = _last;
+  record.write = (flags & FLAG_WRITE) != 0;
+  uint64_t val;
+  bool valid = decodeDifference(_mapping, _mappingSize, _position, _last.address, record.address);
+  if (valid && (flags & FLAG_BYTES)) {
+    valid = decodeVarint(_mapping, _mappingSize, _position, val);
+    record.bytes = val;
+  }
+  if (valid && (flags & FLAG_GROUP)) {
+    valid = decodeVarint(_mapping, _mappingSize, _position, val);
+    record.group = val;
+  }
+  if (valid && (flags & FLAG_HEADER))
+    valid = decodeDifference(_mapping, _mappingSize, _position, _last.header, record.header);
+  if (!valid) throw "Last record of the access trace is truncated (AccessTraceReader::next).";
+
+  _last = record;
+  return true;
+}
+
+void AccessTraceReader::rewind() {
+  _position = TRACE_HEADER_SIZE;
+  _last = AccessRecord();
+}
+
+} // namespace Memory
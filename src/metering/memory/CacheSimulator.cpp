@@ -0,0 +1,129 @@
+#include <metering/memory/CacheSimulator.hpp>
+
+using namespace Memory;
+
+CacheSimulator::CacheSimulator(const CacheConfiguration& config) : _levels(), _groups(), _clock(0), _suspended(false) {
+  if (config.empty()) throw "No cache level given for the simulation (CacheSimulator::CacheSimulator).";
+
+  for (CacheConfiguration::const_iterator iter(config.cbegin()); iter != config.cend(); ++iter) {
+    if (iter->lineSize == 0 || (iter->lineSize & (iter->lineSize - 1)) != 0)
+      throw "Line size of a simulated cache level is not a power of two (CacheSimulator::CacheSimulator).";
+    if (iter->ways == 0 || iter->size == 0 || iter->size % ((size_t)iter->ways * iter->lineSize) != 0)
+      throw "Size of a simulated cache level is not a multiple of its ways and line size (CacheSimulator::CacheSimulator).";
+    if (iter->policy == CacheLevelConfiguration::PLRU && (iter->ways > 64 || (iter->ways & (iter->ways - 1)) != 0))
+      throw "Pseudo-LRU needs a power of two (up to 64) as number of ways (CacheSimulator::CacheSimulator).";
+
+    Level level;
+    level.config = *iter;
+    level.sets = iter->size / ((size_t)iter->ways * iter->lineSize);
+    level.lineShift = 0;
+    while (((unsigned int)1 << level.lineShift) < iter->lineSize) ++level.lineShift;
+    level.lines.assign(level.sets * iter->ways, 0);
+    level.states.assign((iter->policy == CacheLevelConfiguration::PLRU ? level.sets : level.sets * iter->ways), 0);
+    _levels.push_back(level);
+  }
+}
+
+void CacheSimulator::_touchPlru(uint64_t& bits, unsigned int ways, unsigned int way) {
+  // walk from the root to the leaf of the way and let each node point to the other half
+  unsigned int node = 1;
+  for (unsigned int half = ways >> 1; half > 0; half >>= 1) {
+    unsigned int right = (way & half) != 0 ? 1 : 0;
+    if (right) bits &= ~((uint64_t)1 << node);
+    else bits |= (uint64_t)1 << node;
+    node = 2 * node + right;
+  }
+}
+
+unsigned int CacheSimulator::_victimPlru(uint64_t bits, unsigned int ways) {
+  unsigned int node = 1;
+  while (node < ways) node = 2 * node + ((bits >> node) & 1);
+  return node - ways;
+}
+
+bool CacheSimulator::_lookup(Level& level, uint64_t line) {
+  const unsigned int ways = level.config.ways;
+  const size_t set = line % level.sets;
+  uint64_t* lines = &level.lines[set * ways];
+
+  unsigned int way = 0;
+  while (way < ways && lines[way] != line + 1) ++way;
+  bool hit = (way < ways);
+
+  if (!hit) {
+    // use an invalid line, before a valid one is replaced
+    way = 0;
+    while (way < ways && lines[way] != 0) ++way;
+    if (way == ways) {
+      if (level.config.policy == CacheLevelConfiguration::PLRU) {
+        way = _victimPlru(level.states[set], ways);
+      } else {
+        const uint64_t* times = &level.states[set * ways];
+        way = 0;
+        for (unsigned int i = 1; i < ways; ++i) 
+          if (times[i] < times[way]) way = i;
+      }
+    }
+    lines[way] = line + 1;
+  }
+
+  if (level.config.policy == CacheLevelConfiguration::PLRU) _touchPlru(level.states[set], ways, way);
+  else level.states[set * ways + way] = ++_clock;
+  return hit;
+}
+
+CacheGroup& CacheSimulator::group(unsigned int id) {
+  while (_groups.size() <= id) {
+    CacheGroup group;
+    group.simulator = this;
+    group.counts.hits.assign(_levels.size(), 0);
+    group.counts.misses.assign(_levels.size(), 0);
+    _groups.push_back(group);
+  }
+  return _groups[id];
+}
+
+void CacheSimulator::access(const void* address, size_t bytes, CacheGroup& group) {
+  if (_suspended || bytes == 0) return;
+
+  // each line of the first level is looked up separately
+  const uint64_t first = reinterpret_cast<uintptr_t>(address);
+  const unsigned int shift = _levels[0].lineShift;
+  for (uint64_t line = first >> shift; line <= (first + bytes - 1) >> shift; ++line) {
+    const uint64_t lineAddress = line << shift;
+    for (size_t i = 0; i < _levels.size(); ++i) {
+      if (_lookup(_levels[i], lineAddress >> _levels[i].lineShift)) {
+        ++group.counts.hits[i];
+        break;
+      }
+      ++group.counts.misses[i];
+    }
+  }
+}
+
+void CacheSimulator::reset() {
+  for (std::vector<Level>::iterator iter(_levels.begin()); iter != _levels.end(); ++iter) {
+    iter->lines.assign(iter->lines.size(), 0);
+    iter->states.assign(iter->states.size(), 0);
+  }
+  _groups.clear();
+  _clock = 0;
+}
+
+void CacheSimulator::getResults(CacheResults& results, unsigned int groups) const {
+  results.levels.clear();
+  for (std::vector<Level>::const_iterator iter(_levels.cbegin()); iter != _levels.cend(); ++iter)
+    results.levels.push_back(iter->config.name);
+
+  results.groups.clear();
+  for (size_t id = 0; id < groups || id < _groups.size(); ++id) {
+    if (id < _groups.size()) {
+      results.groups.push_back(_groups[id].counts);
+    } else {
+      CacheCounts zeros;
+      zeros.hits.assign(_levels.size(), 0);
+      zeros.misses.assign(_levels.size(), 0);
+      results.groups.push_back(zeros);
+    }
+  }
+}
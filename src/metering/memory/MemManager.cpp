@@ -3,44 +3,74 @@
 
 using namespace Memory;
 
+/** Returns the counters of a MemTrace-instance. */
+static inline MemTraceData& getMemTraceData(RegistryItem& item) {
+  return const_cast<MemTraceData&>(static_cast<const MemTraceData&>(item.getData()));
+}
+
+bool MemManager::_isRegistered(const MemTraceData& data) const {
+  return data.index < _mtraces.size() && _mtraces[data.index].data == &data;
+}
+
 void MemManager::reg(RegistryItem& item) {
-  _mtraces.insert(
-    std::make_pair<RegistryItem*, unsigned int&>(&item, _currentGroupId)
-  );
+  MemTraceData& data = getMemTraceData(item);
+  if (_isRegistered(data)) return; // already registered
+
+  data.index = _mtraces.size();
+  _mtraces.push_back(Registered{&data, _currentGroupId});
 
   // trace max. allocation size
-  const MemTraceData& data = static_cast<const MemTraceData&>(item.getData());
   _current->groups[_currentGroupId]->allocMaxBytes += data.allocBytes; 
+  // accesses only pass the backends, if any of them is enabled
+  data.observer = ((_cache || _trace) ? &_observer(_currentGroupId) : nullptr);
 }
 
 void MemManager::dereg(RegistryItem& item) {
   // check, if item is contained in collection
-  if (_mtraces.count(&item) == 0) return; // nothing to do
+  MemTraceData& data = getMemTraceData(item);
+  if (!_isRegistered(data)) return; // nothing to do
 
   // get final values and add them to group values before removing item
-  const MemTraceData& data = static_cast<const MemTraceData&>(item.getData());
-  unsigned int groupId = _mtraces[&item];
-  _current->groupUpdate(groupId, 0, data.totalBytes, data.count, data.wBytes, data.countWrite);
-  _mtraces.erase(&item);
+  _current->groupUpdate(_mtraces[data.index].groupId, 0, data.totalBytes, data.count, data.wBytes, data.countWrite);
+
+  // move last item to the free position
+  _mtraces[data.index] = _mtraces.back();
+  _mtraces[data.index].data->index = data.index;
+  _mtraces.pop_back();
+  data.index = MemTraceData::unregistered;
+  data.observer = nullptr;
 }
 
-void MemManager::checkpoint(unsigned int headers) {
-  _current->headers += headers;
+MemTraceObserver& MemManager::_observer(unsigned int groupId) {
+  while (_observers.size() <= groupId) {
+    _observers.emplace_back();
+    _attachBackends(_observers.size() - 1);
+  }
+  return _observers[groupId];
+}
 
-  // prior to calculations: copy current snapshot for using it as next
-  MemSnapshotPtr copySnapshot(new MemSnapshot(*_current));
+void MemManager::_attachBackends(unsigned int groupId) {
+  _observers[groupId].cache = (_cache ? &_cache->group(groupId) : nullptr);
+  _observers[groupId].trace = (_trace ? &_trace->group(groupId) : nullptr);
+}
 
-  // update current snapshot with stats from all remaining items in collection
+void MemManager::_addRegistered(MemSnapshot& snapshot) const {
   for (auto iter(_mtraces.begin()); iter != _mtraces.end(); ++iter) {
-    const MemTraceData& data = static_cast<const MemTraceData&>( iter->first->getData() );
-    _current->groupUpdate(iter->second, data.allocBytes, data.totalBytes, data.count, data.wBytes, data.countWrite);
+    const MemTraceData& data = *iter->data;
+    snapshot.groups[iter->groupId]->update(data.allocBytes, data.totalBytes, data.count, data.wBytes, data.countWrite);
   }
-  
-  // save snapshot with aggregated values in history
-  _history.push_back( std::move(_current) );
-  
-  // use previous copy as current snapshot
-  _current = std::move(copySnapshot);
+}
+
+void MemManager::checkpoint(unsigned int headers) {
+  if (_suspended) return;
+
+  _current->headers += headers;
+  if (_trace) _trace->setHeader(_current->headers);
+
+  // save copy of the group values with stats from all remaining items in history
+  MemSnapshotPtr snapshot(new MemSnapshot(*_current));
+  _addRegistered(*snapshot);
+  _history.push_back(std::move(snapshot));
 }
 
 void MemManager::groupSwitch(unsigned int id) { 
@@ -58,7 +88,7 @@ void MemManager::getCurrentTotal(MemGroupSnapshotPtr& result) const {
 
   // aggregate all current _mtrace-objects in result-group
   for (auto iter(_mtraces.begin()); iter != _mtraces.end(); ++iter) {
-    const MemTraceData& data = static_cast<const MemTraceData&>( iter->first->getData() );
+    const MemTraceData& data = *iter->data;
     result->update(data.allocBytes, data.totalBytes, data.count, data.wBytes, data.countWrite);
   }
 }
@@ -74,8 +104,8 @@ void MemManager::getCurrentByGroup(unsigned int groupId, MemGroupSnapshotPtr& re
 
   // aggregate all current _mtrace-objects that belong to given group in result-group
   for (auto iter(_mtraces.begin()); iter != _mtraces.end(); ++iter) {
-    if (iter->second == groupId) {
-      const MemTraceData& data = static_cast<const MemTraceData&>( iter->first->getData() );
+    if (iter->groupId == groupId) {
+      const MemTraceData& data = *iter->data;
       result->update(data.allocBytes, data.totalBytes, data.count, data.wBytes, data.countWrite);
     }
   } 
@@ -126,8 +156,35 @@ void MemManager::getMemResultGroups(MemResultGroups& results) const {
   }
 }
 
+void MemManager::getCacheResults(CacheResults& results) const {
+  if (_cache) _cache->getResults(results, _groupsTotal);
+}
+
+void MemManager::setCacheSimulator(std::shared_ptr<CacheSimulator> cache) {
+  _cache = cache;
+  for (unsigned int groupId = 0; groupId < _observers.size(); ++groupId) _attachBackends(groupId);
+}
+
+void MemManager::setAccessTrace(std::shared_ptr<AccessTraceWriter> trace) {
+  _trace = trace;
+  if (_trace) {
+    _trace->setHeader(_current->headers);
+    _trace->setSuspended(_suspended);
+  }
+  for (unsigned int groupId = 0; groupId < _observers.size(); ++groupId) _attachBackends(groupId);
+}
+
 void MemManager::reset() {
+  // remaining instances aren't counted anymore
+  for (auto iter(_mtraces.begin()); iter != _mtraces.end(); ++iter) {
+    MemTraceData& data = *iter->data;
+    data.index = MemTraceData::unregistered;
+    data.observer = nullptr;
+  }
   _mtraces.clear();
+  _observers.clear();
+  if (_cache) _cache->reset();
+  _trace.reset();
   _groupsTotal = 1;
   _currentGroupId = 0;
   _history.clear();
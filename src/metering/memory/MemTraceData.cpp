@@ -1,2 +1,10 @@
 #include <metering/memory/MemTraceData.hpp>
 
+using namespace Memory;
+
+const size_t MemTraceData::unregistered;
+
+void MemTraceObserver::access(const void* address, size_t bytes, bool write) {
+  if (cache) cache->simulator->access(address, bytes, *cache);
+  if (trace) trace->writer->access(address, bytes, write, *trace);
+}
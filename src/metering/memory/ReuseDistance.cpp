@@ -0,0 +1,78 @@
+#include <metering/memory/ReuseDistance.hpp>
+#include <algorithm>
+#include <utility>
+
+using namespace Memory;
+
+/** initial number of accesses in the tree */
+static const size_t TREE_SIZE = 1 << 16;
+
+ReuseDistance::ReuseDistance(unsigned int lineSize) : _lineShift(0), _lastAccess(), _tree(TREE_SIZE + 1, 0), _time(0), _accesses(0), _coldAccesses(0), _buckets() {
+  if (lineSize == 0 || (lineSize & (lineSize - 1)) != 0)
+    throw "Line size for reuse distances is not a power of two (ReuseDistance::ReuseDistance).";
+  while (((unsigned int)1 << _lineShift) < lineSize) ++_lineShift;
+}
+
+void ReuseDistance::_add(uint64_t time, int32_t delta) {
+  for (uint64_t i = time + 1; i < _tree.size(); i += i & (~i + 1))
+    _tree[i] += delta;
+}
+
+uint64_t ReuseDistance::_prefix(uint64_t time) const {
+  uint64_t sum = 0;
+  for (uint64_t i = time + 1; i > 0; i -= i & (~i + 1))
+    sum += _tree[i];
+  return sum;
+}
+
+void ReuseDistance::_compact() {
+  // only the last access of each line is needed, so they are renumbered in their order
+  std::vector<std::pair<uint64_t, uint64_t>> lines; // time, line
+  lines.reserve(_lastAccess.size());
+  for (auto iter(_lastAccess.cbegin()); iter != _lastAccess.cend(); ++iter)
+    lines.push_back(std::make_pair(iter->second, iter->first));
+  std::sort(lines.begin(), lines.end());
+
+  // keep at least half of the tree free for the following accesses
+  _tree.assign(std::max(TREE_SIZE, 2 * lines.size()) + 1, 0);
+  for (_time = 0; _time < lines.size(); ++_time) {
+    _lastAccess[lines[_time].second] = _time;
+    _add(_time, 1);
+  }
+}
+
+void ReuseDistance::_accessLine(uint64_t line) {
+  if (_time + 1 >= _tree.size()) _compact();
+  ++_accesses;
+
+  std::unordered_map<uint64_t, uint64_t>::iterator last = _lastAccess.find(line);
+  if (last == _lastAccess.end()) {
+    ++_coldAccesses;
+    _lastAccess.insert(std::make_pair(line, _time));
+  } else {
+    // lines, whose last access lies between both accesses
+    uint64_t distance = _prefix(_time) - _prefix(last->second);
+    size_t bucket = 0;
+    while (distance > bucketMax(bucket)) ++bucket;
+    if (bucket >= _buckets.size()) _buckets.resize(bucket + 1, 0);
+    ++_buckets[bucket];
+
+    _add(last->second, -1);
+    last->second = _time;
+  }
+  _add(_time++, 1);
+}
+
+void ReuseDistance::access(uint64_t address, uint32_t bytes) {
+  if (bytes == 0) return;
+  for (uint64_t line = address >> _lineShift; line <= (address + bytes - 1) >> _lineShift; ++line)
+    _accessLine(line);
+}
+
+void ReuseDistance::add(AccessTraceReader& trace, int group) {
+  AccessRecord record;
+  while (trace.next(record)) {
+    if (group < 0 || record.group == (uint32_t)group)
+      access(record.address, record.bytes);
+  }
+}
@@ -1,65 +1,87 @@
 #include <metering/time/ChronoManager.hpp>
 
-void ChronoManager::start(std::string key) {
-  if (_chronos.count(key) == 0) {
-    ChronographPtr chrono(new Chronograph);
-    _chronos.insert(
-      std::make_pair( key, std::move(chrono) )
-    );
-  }
-  _chronos[key]->start();
+const Chronograph* ChronoManager::_find(const std::string& key) const {
+  auto iter(_handles.find(key));
+  if (iter == _handles.end() || !_chronos[iter->second].isStarted()) return nullptr;
+  return &_chronos[iter->second];
 }
 
-void ChronoManager::stop(std::string key) {
-  if (_chronos.count(key) > 0) _chronos[key]->stop();
+ChronoHandle ChronoManager::handle(const std::string& key) {
+  auto iter(_handles.find(key));
+  if (iter != _handles.end()) return iter->second;
+
+  _chronos.push_back(Chronograph());
+  _handles.insert( std::make_pair(key, _chronos.size() - 1) );
+  return _chronos.size() - 1;
+}
+
+void ChronoManager::start(const std::string& key) {
+  if (_suspended) return;
+
+  _chronos[handle(key)].start();
+}
+
+void ChronoManager::stop(const std::string& key) {
+  if (_suspended) return;
+
+  auto iter(_handles.find(key));
+  if (iter != _handles.end() && _chronos[iter->second].isStarted()) _chronos[iter->second].stop(_overhead);
   else throw "Stopwatch with the given key doesn't exist (ChronoManager::stop).";
 }
 
+bool ChronoManager::contains(const std::string& key) const {
+  return _find(key) != nullptr;
+}
+
 unsigned int ChronoManager::getTimeSec() {
   unsigned int total = 0;
-  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter)
-    total += iter->second->getTotalSec();
+  for (auto iter(_chronos.cbegin()); iter != _chronos.cend(); ++iter)
+    total += iter->getTotalSec();
   return total;
 }
 
 unsigned int ChronoManager::getTimeMilli() {
   unsigned int total = 0;
-  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter)
-    total += iter->second->getTotalMillisec();
+  for (auto iter(_chronos.cbegin()); iter != _chronos.cend(); ++iter)
+    total += iter->getTotalMillisec();
   return total;
 }
 
 unsigned int ChronoManager::getTimeMicro() {
   unsigned int total = 0;
-  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter)
-    total += iter->second->getTotalMicrosec();
+  for (auto iter(_chronos.cbegin()); iter != _chronos.cend(); ++iter)
+    total += iter->getTotalMicrosec();
   return total;
 }
 
 double ChronoManager::getTimeNano() {
   double total = 0;
-  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter)
-    total += iter->second->getTotalNanosec();
+  for (auto iter(_chronos.cbegin()); iter != _chronos.cend(); ++iter)
+    total += iter->getTotalNanosec();
   return total;
 }
 
-unsigned int ChronoManager::getTimeSec(std::string key) {
-  if (_chronos.count(key) > 0) return _chronos[key]->getTotalSec();
+unsigned int ChronoManager::getTimeSec(const std::string& key) {
+  const Chronograph* chrono = _find(key);
+  if (chrono != nullptr) return chrono->getTotalSec();
   else throw "Stopwatch with the given key doesn't exist (ChronoManager::getTimeSec).";
 }
 
-unsigned int ChronoManager::getTimeMilli(std::string key) {
-  if (_chronos.count(key) > 0) return _chronos[key]->getTotalMillisec();
+unsigned int ChronoManager::getTimeMilli(const std::string& key) {
+  const Chronograph* chrono = _find(key);
+  if (chrono != nullptr) return chrono->getTotalMillisec();
   else throw "Stopwatch with the given key doesn't exist (ChronoManager::getTimeMilli).";
 }
 
-unsigned int ChronoManager::getTimeMicro(std::string key) {
-  if (_chronos.count(key) > 0) return _chronos[key]->getTotalMicrosec();
+unsigned int ChronoManager::getTimeMicro(const std::string& key) {
+  const Chronograph* chrono = _find(key);
+  if (chrono != nullptr) return chrono->getTotalMicrosec();
   else throw "Stopwatch with the given key doesn't exist (ChronoManager::getTimeMicro).";
 }
 
-double ChronoManager::getTimeNano(std::string key) {
-  if (_chronos.count(key) > 0) return _chronos[key]->getTotalNanosec();
+double ChronoManager::getTimeNano(const std::string& key) {
+  const Chronograph* chrono = _find(key);
+  if (chrono != nullptr) return chrono->getTotalNanosec();
   else throw "Stopwatch with the given key doesn't exist (ChronoManager::getTimeNano).";
 }
 
@@ -68,11 +90,61 @@ void ChronoManager::getAllResults(ChronoResults& results, unsigned int divisor)
   if (divisor == 0) throw "The divisor can't be zero (ChronoManager::getAllResults).";
 
   unsigned int groupRes = 0;
-  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter) {
-    groupRes = iter->second->getTotalMicrosec();
+  for (auto iter(_handles.cbegin()); iter != _handles.cend(); ++iter) {
+    const Chronograph& chrono = _chronos[iter->second];
+    if (!chrono.isStarted()) continue; // registered, but not used in this run
+
+    groupRes = chrono.getTotalMicrosec();
     if (divisor != 1) groupRes /= divisor;
     
     results.push_back(std::make_pair( iter->first, groupRes ));
   }
 }
 
+void ChronoManager::setSampling(unsigned int n) {
+  if (n == 0) throw "The sampling rate can't be zero (ChronoManager::setSampling).";
+  _sampleThreshold = (n == 1 ? UINT64_MAX : UINT64_MAX / n);
+  _sampleState = _sampleSeed();
+}
+
+void ChronoManager::getAllSamples(ChronoSamples& samples) const {
+  if (samples.size() > 0) samples.clear();
+
+  for (auto iter(_handles.cbegin()); iter != _handles.cend(); ++iter) {
+    const Chronograph& chrono = _chronos[iter->second];
+    if (chrono.getSkipped() == 0) continue; // not sampled
+
+    ChronoSample sample = { iter->first, chrono.getLaps(), chrono.getSkipped(), chrono.getMeasuredNanosec() };
+    samples.push_back(sample);
+  }
+}
+
+void ChronoManager::reset() {
+  for (auto iter(_chronos.begin()); iter != _chronos.end(); ++iter)
+    iter->reset();
+  _histograms.clear();
+  _sampleState = _sampleSeed(); // same samples in each testrun
+}
+
+void ChronoManager::record(const std::string& key, uint64_t nanos) {
+  if (_suspended) return;
+
+  std::unique_ptr<LatencyHistogram>& histogram = _histograms[key];
+  if (!histogram) histogram.reset(new LatencyHistogram);
+  histogram->record(nanos);
+}
+
+void ChronoManager::record(const std::string& key, const LatencyHistogram& samples) {
+  if (_suspended) return;
+
+  std::unique_ptr<LatencyHistogram>& histogram = _histograms[key];
+  if (!histogram) histogram.reset(new LatencyHistogram);
+  histogram->merge(samples);
+}
+
+void ChronoManager::getAllLatencies(LatencyResults& results) const {
+  if (results.size() > 0) results.clear();
+
+  for (auto iter(_histograms.cbegin()); iter != _histograms.cend(); ++iter)
+    results.push_back(std::make_pair( iter->first, *(iter->second) ));
+}
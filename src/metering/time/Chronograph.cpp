@@ -1,8 +1,15 @@
 #include <metering/time/Chronograph.hpp>
 
-void Chronograph::stop() {
-  auto span = Chronoclock::now() - _start;
-  _total += (double)std::chrono::duration_cast<std::chrono::nanoseconds>(span).count();
-  start(); // for lap-like functionality
-}
+uint64_t Chronograph::calibrate() {
+  const unsigned int samples = 1000;
+  uint64_t overhead = UINT64_MAX;
 
+  // the minimum is taken, so that no real runtime is subtracted later
+  for (unsigned int i = 0; i < samples; ++i) {
+    Chronoclock::time_point first = Chronoclock::now();
+    Chronoclock::time_point second = Chronoclock::now();
+    uint64_t span = std::chrono::duration_cast<std::chrono::nanoseconds>(second - first).count();
+    if (span < overhead) overhead = span;
+  }
+  return overhead;
+}
@@ -0,0 +1,70 @@
+#include <metering/time/LatencyHistogram.hpp>
+#include <cmath>
+
+constexpr unsigned int LatencyHistogram::SUB_BITS;
+constexpr uint64_t LatencyHistogram::SUB_COUNT;
+constexpr uint64_t LatencyHistogram::HALF_COUNT;
+constexpr size_t LatencyHistogram::BUCKETS;
+
+uint64_t LatencyHistogram::_highestValue(size_t bucket) {
+  if (bucket < SUB_COUNT) return bucket;
+
+  unsigned int shift = (bucket - SUB_COUNT) / HALF_COUNT + 1;
+  uint64_t mantissa = (bucket - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+  uint64_t lowest = mantissa << shift;
+  return lowest + ((1ULL << shift) - 1);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t bucket = 0; bucket < BUCKETS; ++bucket)
+    _counts[bucket] += other._counts[bucket];
+
+  _total += other._total;
+  _sum += other._sum;
+  if (other._min < _min) _min = other._min;
+  if (other._max > _max) _max = other._max;
+}
+
+void LatencyHistogram::reset() {
+  for (std::vector<uint64_t>::iterator iter(_counts.begin()); iter != _counts.end(); ++iter)
+    *iter = 0;
+  _total = 0;
+  _min = UINT64_MAX;
+  _max = 0;
+  _sum = 0;
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+  if (_total == 0) return 0;
+  if (percentile < 0) percentile = 0;
+  if (percentile > 100) percentile = 100;
+
+  // number of samples, which have to be covered (at least one)
+  uint64_t target = (uint64_t)std::ceil(percentile * _total / 100.0);
+  if (target == 0) target = 1;
+
+  uint64_t covered = 0;
+  for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+    covered += _counts[bucket];
+    if (covered >= target) {
+      uint64_t value = _highestValue(bucket);
+      return (value < _max ? value : _max); // not beyond the largest sample
+    }
+  }
+  return _max;
+}
+
+void LatencyHistogram::getCdf(std::vector<LatencyCdfPoint>& cdf) const {
+  cdf.clear();
+  if (_total == 0) return;
+
+  uint64_t covered = 0;
+  for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+    if (_counts[bucket] == 0) continue;
+
+    covered += _counts[bucket];
+    uint64_t value = _highestValue(bucket);
+    cdf.push_back(std::make_pair((value < _max ? value : _max), (double)covered / _total));
+  }
+}
+
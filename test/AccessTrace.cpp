@@ -0,0 +1,135 @@
+#include <libunittest/all.hpp>
+#include <metering/memory/AccessTrace.hpp>
+#include <metering/memory/ReuseDistance.hpp>
+#include <metering/memory/MemTrace.hpp>
+#include <metering/memory/MemManager.hpp>
+#include <metering/memory/MemTraceRegistry.hpp>
+#include <cstdio>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace unittest::assertions;
+using namespace Memory;
+
+std::string accessTraceFilename(const std::string& name) {
+  return std::string(P_tmpdir) + "/cate_" + name + "_" + std::to_string(getpid());
+}
+
+TEST(test_accesstrace_records)
+{
+  std::string filename(accessTraceFilename("accesses"));
+  {
+    // a small buffer is handed over to the writing thread many times
+    AccessTraceWriter writer(filename, 7);
+    for (unsigned int i = 0; i < 1000; ++i) {
+      writer.setHeader(i / 100);
+      const void* address = reinterpret_cast<const void*>((uintptr_t)(0x7f0000001000 + (i % 3 == 0 ? -8 * (int)i : 4 * (int)i)));
+      writer.access(address, (i % 5 == 0 ? 8 : 4), (i % 2 == 0), writer.group(i % 4 == 0 ? 2 : 0));
+    }
+    writer.setSuspended(true);
+    writer.access(nullptr, 4, false, writer.group(0));
+    assert_equal(writer.size(), (uint64_t)1000, SPOT);
+    writer.close();
+  }
+
+  AccessTraceReader reader(filename);
+  AccessRecord record;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    assert_true(reader.next(record), SPOT);
+    assert_equal(record.address, (uint64_t)(0x7f0000001000 + (i % 3 == 0 ? -8 * (int)i : 4 * (int)i)), SPOT);
+    assert_equal(record.bytes, (uint32_t)(i % 5 == 0 ? 8 : 4), SPOT);
+    assert_equal(record.write, (i % 2 == 0), SPOT);
+    assert_equal(record.group, (uint32_t)(i % 4 == 0 ? 2 : 0), SPOT);
+    assert_equal(record.header, (uint64_t)(i / 100), SPOT);
+  }
+  assert_false(reader.next(record), SPOT);
+
+  // only changed fields are stored
+  FILE* file = fopen(filename.c_str(), "rb");
+  fseek(file, 0, SEEK_END);
+  assert_true(ftell(file) < 1000 * 6, SPOT);
+  fclose(file);
+
+  reader.rewind();
+  assert_true(reader.next(record), SPOT);
+  assert_equal(record.address, (uint64_t)0x7f0000001000, SPOT);
+  remove(filename.c_str());
+
+  try { // missing file
+    AccessTraceReader missing(filename);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_accesstrace_reuse)
+{
+  ReuseDistance reuse(64);
+  // lines: A B C A B B D A (D spans two lines)
+  const uint64_t lines[] = {0, 1, 2, 0, 1, 1, 3, 0};
+  for (unsigned int i = 0; i < 8; ++i) reuse.access(lines[i] * 64 + 8, (lines[i] == 3 ? 64 : 8));
+
+  assert_equal(reuse.accesses(), (uint64_t)9, SPOT);
+  assert_equal(reuse.coldAccesses(), (uint64_t)5, SPOT);
+  const std::vector<uint64_t>& buckets = reuse.buckets();
+  assert_equal(buckets.size(), (size_t)3, SPOT);
+  assert_equal(buckets[0], (uint64_t)1, SPOT); // B after B
+  assert_equal(buckets[1], (uint64_t)0, SPOT);
+  assert_equal(buckets[2], (uint64_t)3, SPOT); // A and B after 2 lines, A after 3 lines
+  assert_equal(ReuseDistance::bucketMin(3), (uint64_t)4, SPOT);
+  assert_equal(ReuseDistance::bucketMax(3), (uint64_t)7, SPOT);
+
+  // many accesses of a few lines keep their distances, while the tree is compacted
+  ReuseDistance cyclic(64);
+  for (unsigned int i = 0; i < 200000; ++i) cyclic.access((i % 10) * 64, 4);
+  assert_equal(cyclic.coldAccesses(), (uint64_t)10, SPOT);
+  assert_equal(cyclic.buckets().size(), (size_t)5, SPOT);
+  assert_equal(cyclic.buckets()[4], (uint64_t)(200000 - 10), SPOT); // distance 9
+
+  try { // line size isn't a power of two
+    ReuseDistance invalid(48);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+#if !defined(MEMTRACE_DISABLED) && defined(MEMTRACE_BACKENDS)
+TEST(test_accesstrace_memmanager)
+{
+  std::shared_ptr<MemManager> manager = std::make_shared<MemManager>();
+  std::shared_ptr<MemTraceRegistry> memreg = std::make_shared<MemTraceRegistry>(manager);
+  memRegistryPtr = memreg; // for registering MemTrace-instances
+  std::string filename(accessTraceFilename("accesses_manager"));
+  std::shared_ptr<AccessTraceWriter> writer(std::make_shared<AccessTraceWriter>(filename));
+  manager->setAccessTrace(writer);
+
+  {
+    MemTrace<uint32_t> val1(1);
+    manager->groupCreate();
+    MemTrace<uint16_t> val2(2);
+    manager->checkpoint(10);
+    uint32_t read = val1;
+    val2 = (uint16_t)read;
+
+    // accesses after a reset aren't traced anymore
+    manager->reset();
+    val1 = 3;
+  }
+  assert_equal(writer->size(), (uint64_t)4, SPOT);
+  writer->close();
+
+  AccessTraceReader reader(filename);
+  AccessRecord record;
+  const uint32_t groups[] = {0, 1, 0, 1};
+  const bool writes[] = {true, true, false, true};
+  for (unsigned int i = 0; i < 4; ++i) {
+    assert_true(reader.next(record), SPOT);
+    assert_equal(record.group, groups[i], SPOT);
+    assert_equal(record.write, writes[i], SPOT);
+    assert_equal(record.bytes, (uint32_t)(groups[i] == 0 ? sizeof(uint32_t) : sizeof(uint16_t)), SPOT);
+    assert_equal(record.header, (uint64_t)(i < 2 ? 0 : 10), SPOT);
+  }
+  assert_false(reader.next(record), SPOT);
+  remove(filename.c_str());
+}
+#endif
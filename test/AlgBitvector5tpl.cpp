@@ -68,6 +68,37 @@ TEST(test_alg_bv_5tpl_classify_big)
   AlgTestFixtures::evalIndicesSet1024(indices);
 }
 
+TEST(test_alg_bv_5tpl_classify_native)
+{
+  MemChronoSetup setup;
+  AlgTestFixtures::setupMemChrono(setup);
+
+  using namespace Generic;
+
+  RuleSet ruleset;
+  AlgTestFixtures::fillRuleSetBig(ruleset);
+  assert_true(ruleSetIsValid(ruleset), SPOT);
+
+  PacketHeaderSet packets;
+  AlgTestFixtures::fillHeaderSet1024(packets);
+  assert_equal(packets.size(), (unsigned int)1024, SPOT);
+  
+  RuleIndexSet indices;
+  assert_true(indices.empty(), SPOT);
+  
+  std::unique_ptr<Bitvector5tpl> alg(new Bitvector5tpl);
+  try {
+    alg->setMemManager(setup.memMgrPtr);
+    alg->setChronoManager(setup.chrMgrPtr);
+    alg->setRules(ruleset);
+    AlgTestFixtures::classifyNative(*alg, packets, indices);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+
+  AlgTestFixtures::evalIndicesSet1024(indices);
+}
+
 TEST(test_alg_bv_5tpl_ruleadd_empty)
 {
   MemChronoSetup setup;
@@ -80,6 +80,101 @@ TEST(test_alg_hicuts_5tpl_classify_big)
   AlgTestFixtures::evalIndicesSet1024(indices);
 }
 
+TEST(test_alg_hicuts_5tpl_classify_native)
+{
+  MemChronoSetup setup;
+  AlgTestFixtures::setupMemChrono(setup);
+
+  using namespace Generic;
+
+  RuleSet ruleset;
+  AlgTestFixtures::fillRuleSetBig(ruleset);
+  assert_true(ruleSetIsValid(ruleset), SPOT);
+
+  PacketHeaderSet packets;
+  AlgTestFixtures::fillHeaderSet1024(packets);
+  assert_equal(packets.size(), (unsigned int)1024, SPOT);
+  
+  RuleIndexSet indices;
+  assert_true(indices.empty(), SPOT);
+  
+  std::vector<double> params;
+  params.push_back(100.0);
+  params.push_back(4.0); // binth
+  params.push_back(5.0); // spfac
+
+  std::unique_ptr<HiCuts5tpl> alg(new HiCuts5tpl);
+  try {
+    alg->setMemManager(setup.memMgrPtr);
+    alg->setChronoManager(setup.chrMgrPtr);
+    alg->setParameters(params);
+    alg->setRules(ruleset);
+    AlgTestFixtures::classifyNative(*alg, packets, indices);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+
+  AlgTestFixtures::evalIndicesSet1024(indices);
+}
+
+TEST(test_alg_hicuts_5tpl_snapshot)
+{
+  MemChronoSetup setup;
+  AlgTestFixtures::setupMemChrono(setup);
+
+  using namespace Generic;
+
+  RuleSet ruleset;
+  AlgTestFixtures::fillRuleSetBig(ruleset);
+
+  PacketHeaderSet packets;
+  AlgTestFixtures::fillHeaderSet1024(packets);
+  
+  std::vector<double> params;
+  params.push_back(100.0);
+  params.push_back(4.0); // binth
+  params.push_back(5.0); // spfac
+
+  std::vector<uint8_t> image;
+  RuleIndexSet indices;
+  std::unique_ptr<HiCuts5tpl> built(new HiCuts5tpl), loaded(new HiCuts5tpl);
+  assert_true(built->supportsSnapshots(), SPOT);
+  try {
+    built->setMemManager(setup.memMgrPtr);
+    built->setChronoManager(setup.chrMgrPtr);
+    built->setParameters(params);
+    built->setRules(ruleset);
+    built->saveSnapshot(image);
+
+    // restore the trie in another instance instead of constructing it
+    loaded->setMemManager(setup.memMgrPtr);
+    loaded->setChronoManager(setup.chrMgrPtr);
+    loaded->setParameters(params);
+    loaded->loadSnapshot(ruleset, image.data(), image.size());
+    loaded->classify(packets, indices);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+  assert_false(image.empty(), SPOT);
+  AlgTestFixtures::evalIndicesSet1024(indices);
+
+  // loaded trie supports rule updates like a constructed one
+  try {
+    loaded->ruleRemoved(0);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+
+  // a truncated image is rejected
+  std::unique_ptr<HiCuts5tpl> truncated(new HiCuts5tpl);
+  truncated->setMemManager(setup.memMgrPtr);
+  truncated->setChronoManager(setup.chrMgrPtr);
+  try {
+    truncated->loadSnapshot(ruleset, image.data(), image.size() / 2);
+    assert_true(false, SPOT);
+  } catch (char const* ex) {}
+}
+
 TEST(test_alg_hicuts_5tpl_ruleadd_empty)
 {
   MemChronoSetup setup;
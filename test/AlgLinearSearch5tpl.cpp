@@ -69,6 +69,67 @@ TEST(test_alglinsearch_5tpl_classify_big)
   AlgTestFixtures::evalIndicesSet1024(indices);
 }
 
+TEST(test_alglinsearch_5tpl_classify_native)
+{
+  MemChronoSetup setup;
+  AlgTestFixtures::setupMemChrono(setup);
+
+  using namespace Generic;
+
+  RuleSet ruleset;
+  AlgTestFixtures::fillRuleSetBig(ruleset);
+  assert_true(ruleSetIsValid(ruleset), SPOT);
+
+  PacketHeaderSet packets;
+  AlgTestFixtures::fillHeaderSet1024(packets);
+  assert_equal(packets.size(), (unsigned int)1024, SPOT);
+  
+  RuleIndexSet indices;
+  assert_true(indices.empty(), SPOT);
+  
+  std::unique_ptr<LinearSearch5tpl> alg(new LinearSearch5tpl);
+  try {
+    alg->setMemManager(setup.memMgrPtr);
+    alg->setChronoManager(setup.chrMgrPtr);
+    alg->setRules(ruleset);
+    AlgTestFixtures::classifyNative(*alg, packets, indices);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+
+  AlgTestFixtures::evalIndicesSet1024(indices);
+}
+
+TEST(test_alglinsearch_5tpl_convert_protocol)
+{
+  using namespace Generic;
+
+  // the protocol is an 8-bit field
+  PacketHeaderSet packets;
+  std::unique_ptr<PacketHeaderLine> line(new PacketHeaderLine());
+  for (unsigned int value : {1, 2, 3, 4, 256})
+    line->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(value)));
+  packets.push_back(std::move(line));
+
+  LinearSearch5tpl alg;
+  std::vector<uint8_t> tuples(2 * alg.nativeHeaderSize());
+  try {
+    alg.convertHeaders(packets, tuples.data());
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // a wider field in the header structure
+  PacketHeaderColumns columns(std::vector<unsigned int>{32, 32, 16, 16, 16});
+  columns.resize(2);
+  columns.set(0, 4, VarValue(255));
+  alg.convertHeaders(columns, tuples.data());
+  columns.set(1, 4, VarValue(256));
+  try {
+    alg.convertHeaders(columns, tuples.data());
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
 TEST(test_algtuplespace_5tpl_classify_wc)
 {
   MemChronoSetup setup;
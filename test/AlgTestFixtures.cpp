@@ -1,5 +1,6 @@
 #include <test/AlgTestFixtures.hpp>
 #include <memory>
+#include <vector>
 #include <libunittest/all.hpp>
 
 void AlgTestFixtures::fillRuleSetSmall(Generic::RuleSet& ruleset) {
@@ -168,6 +169,32 @@ void AlgTestFixtures::evalIndicesSet1024(Generic::RuleIndexSet& indices) {
   }
 }
 
+void AlgTestFixtures::classifyNative(Base& alg, const Generic::PacketHeaderSet& packets, Generic::RuleIndexSet& indices) {
+  using namespace unittest::assertions;
+
+  assert_true(alg.nativeHeaderSize() > 0, SPOT);
+  std::vector<uint8_t> tuples(packets.size() * alg.nativeHeaderSize());
+  std::vector<uint32_t> out(packets.size());
+
+  alg.convertHeaders(packets, tuples.data());
+  alg.classifyNative(tuples.data(), packets.size(), out.data());
+
+  indices.clear();
+  for (std::vector<uint32_t>::const_iterator iter(out.cbegin()); iter != out.cend(); ++iter)
+    indices.push_back(*iter == Generic::noRuleIsMatchingNative() ? Generic::noRuleIsMatching() : *iter);
+
+  // conversion from columnar headers has to yield the same classification
+  std::vector<unsigned int> fields = { 32, 32, 16, 16, 8 };
+  Generic::PacketHeaderColumns columns(fields);
+  columns.append(packets);
+  std::vector<uint8_t> columnTuples(columns.size() * alg.nativeHeaderSize());
+  std::vector<uint32_t> columnOut(columns.size());
+
+  alg.convertHeaders(columns, columnTuples.data());
+  alg.classifyNative(columnTuples.data(), columns.size(), columnOut.data());
+  assert_true(columnOut == out, SPOT);
+}
+
 void AlgTestFixtures::setupMemChrono(MemChronoSetup& setup) {
   using namespace Memory;
   setup.memMgrPtr = std::make_shared<MemManager>();
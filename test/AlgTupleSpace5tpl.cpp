@@ -319,6 +319,42 @@ TEST(test_algtuplespace_5tpl_classify_big)
   AlgTestFixtures::evalIndicesSet1024(indices);
 }
 
+TEST(test_algtuplespace_5tpl_classify_native)
+{
+  MemChronoSetup setup;
+  AlgTestFixtures::setupMemChrono(setup);
+
+  using namespace Generic;
+
+  RuleSet ruleset;
+  AlgTestFixtures::fillRuleSetBig(ruleset);
+  assert_true(ruleSetIsValid(ruleset), SPOT);
+
+  PacketHeaderSet packets;
+  AlgTestFixtures::fillHeaderSet1024(packets);
+  assert_equal(packets.size(), (unsigned int)1024, SPOT);
+  
+  RuleIndexSet indices;
+  assert_true(indices.empty(), SPOT);
+  
+  std::vector<double> params;
+  params.push_back(1);
+  params.push_back(100);
+
+  std::unique_ptr<TupleSpace5tpl> alg(new TupleSpace5tpl);
+  try {
+    alg->setMemManager(setup.memMgrPtr);
+    alg->setChronoManager(setup.chrMgrPtr);
+    alg->setParameters(params);
+    alg->setRules(ruleset);
+    AlgTestFixtures::classifyNative(*alg, packets, indices);
+  } catch (char const* ex) {
+    assert_true(false, ex, SPOT);
+  }
+
+  AlgTestFixtures::evalIndicesSet1024(indices);
+}
+
 TEST_TIME(test_algtuplespace_5tpl_convert, 5)
 {
   MemChronoSetup setup;
@@ -0,0 +1,142 @@
+#include <libunittest/all.hpp>
+#include <metering/memory/CacheSimulator.hpp>
+#include <metering/memory/MemTrace.hpp>
+#include <metering/memory/MemManager.hpp>
+#include <metering/memory/MemTraceRegistry.hpp>
+#include <cstdint>
+#include <memory>
+
+using namespace unittest::assertions;
+using namespace Memory;
+
+/** Simulates an access of the given bytes at an address, which is never dereferenced. */
+void cacheAccess(CacheSimulator& cache, uintptr_t address, size_t bytes, unsigned int group = 0) {
+  cache.access(reinterpret_cast<const void*>(address), bytes, cache.group(group));
+}
+
+TEST(test_cachesimulator_policies)
+{
+  // two sets with two ways each: lines 0, 2 and 4 share the first set
+  CacheSimulator lru(CacheConfiguration{CacheLevelConfiguration("L1", 256, 2, 64, CacheLevelConfiguration::LRU)});
+  const unsigned int lines[] = {0, 2, 0, 4, 0, 2};
+  for (unsigned int i = 0; i < 6; ++i) cacheAccess(lru, lines[i] * 64, 4);
+  CacheResults results;
+  lru.getResults(results, 1);
+  assert_equal(results.levels.size(), (size_t)1, SPOT);
+  assert_equal(results.levels[0], std::string("L1"), SPOT);
+  assert_equal(results.groups[0].hits[0], (size_t)2, SPOT);
+  assert_equal(results.groups[0].misses[0], (size_t)4, SPOT);
+
+  // a single set with four ways: pseudo-LRU evicts another line than LRU
+  const unsigned int sequence[] = {0, 1, 2, 3, 0, 4, 1, 2};
+  CacheSimulator exact(CacheConfiguration{CacheLevelConfiguration("L1", 256, 4, 64, CacheLevelConfiguration::LRU)});
+  CacheSimulator tree(CacheConfiguration{CacheLevelConfiguration("L1", 256, 4, 64, CacheLevelConfiguration::PLRU)});
+  for (unsigned int i = 0; i < 8; ++i) {
+    cacheAccess(exact, sequence[i] * 64, 1);
+    cacheAccess(tree, sequence[i] * 64, 1);
+  }
+  exact.getResults(results, 1);
+  assert_equal(results.groups[0].hits[0], (size_t)1, SPOT);
+  assert_equal(results.groups[0].misses[0], (size_t)7, SPOT);
+  tree.getResults(results, 1);
+  assert_equal(results.groups[0].hits[0], (size_t)2, SPOT);
+  assert_equal(results.groups[0].misses[0], (size_t)6, SPOT);
+
+  // invalid configurations
+  try { // no level
+    CacheSimulator empty((CacheConfiguration()));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // line size isn't a power of two
+    CacheSimulator line(CacheConfiguration{CacheLevelConfiguration("L1", 384, 2, 48, CacheLevelConfiguration::LRU)});
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // pseudo-LRU needs a power of two as ways
+    CacheSimulator ways(CacheConfiguration{CacheLevelConfiguration("L1", 192, 3, 64, CacheLevelConfiguration::PLRU)});
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_cachesimulator_levels)
+{
+  // a direct-mapped first level with two sets and a larger second level
+  CacheSimulator cache(CacheConfiguration{
+    CacheLevelConfiguration("L1", 128, 1, 64, CacheLevelConfiguration::LRU),
+    CacheLevelConfiguration("L2", 1024, 4, 64, CacheLevelConfiguration::LRU)});
+  cacheAccess(cache, 0, 8);
+  cacheAccess(cache, 128, 8); // replaces the first line in L1 only
+  cacheAccess(cache, 0, 8);
+  cacheAccess(cache, 0, 8);
+
+  CacheResults results;
+  cache.getResults(results, 1);
+  assert_equal(results.levels.size(), (size_t)2, SPOT);
+  assert_equal(results.groups[0].hits[0], (size_t)1, SPOT);
+  assert_equal(results.groups[0].misses[0], (size_t)3, SPOT);
+  assert_equal(results.groups[0].hits[1], (size_t)1, SPOT);
+  assert_equal(results.groups[0].misses[1], (size_t)2, SPOT);
+
+  // an access across a line boundary counts once per line, groups are counted separately
+  cacheAccess(cache, 1000, 48, 1);
+  cache.getResults(results, 3);
+  assert_equal(results.groups.size(), (size_t)3, SPOT);
+  assert_equal(results.groups[1].misses[0], (size_t)2, SPOT);
+  assert_equal(results.groups[2].misses[0], (size_t)0, SPOT);
+  assert_equal(results.groups[0].misses[0], (size_t)3, SPOT);
+
+  // suspended accesses and a reset
+  cache.setSuspended(true);
+  cacheAccess(cache, 4096, 4);
+  cache.getResults(results, 1);
+  assert_equal(results.groups[0].misses[0], (size_t)3, SPOT);
+  cache.setSuspended(false);
+  cache.reset();
+  cacheAccess(cache, 0, 8);
+  cache.getResults(results, 1);
+  assert_equal(results.groups.size(), (size_t)1, SPOT);
+  assert_equal(results.groups[0].hits[0], (size_t)0, SPOT);
+  assert_equal(results.groups[0].misses[1], (size_t)1, SPOT);
+}
+
+#if !defined(MEMTRACE_DISABLED) && defined(MEMTRACE_BACKENDS)
+TEST(test_cachesimulator_memtrace)
+{
+  std::shared_ptr<MemManager> manager = std::make_shared<MemManager>();
+  std::shared_ptr<MemTraceRegistry> memreg = std::make_shared<MemTraceRegistry>(manager);
+  memRegistryPtr = memreg; // for registering MemTrace-instances
+  manager->setCacheSimulator(std::make_shared<CacheSimulator>(CacheConfiguration{
+    CacheLevelConfiguration("L1", 32768, 8, 64, CacheLevelConfiguration::LRU)}));
+
+  CacheResults results;
+  {
+    MemTrace<uint32_t> val1(1); // write misses
+    uint32_t read = val1; // read hits the same line
+    manager->groupCreate();
+    MemTraceBlock<uint8_t> block(256);
+    for (unsigned int i = 0; i < 256; ++i) block[i] = (uint8_t)read;
+
+    manager->getCacheResults(results);
+    assert_equal(results.groups.size(), (size_t)2, SPOT);
+    assert_equal(results.groups[0].hits[0], (size_t)1, SPOT);
+    assert_equal(results.groups[0].misses[0], (size_t)1, SPOT);
+    assert_equal(results.groups[1].hits[0] + results.groups[1].misses[0], (size_t)256, SPOT);
+    assert_true(results.groups[1].misses[0] >= 4 && results.groups[1].misses[0] <= 5, SPOT);
+
+    // accesses aren't simulated while suspended and after a reset
+    manager->setSuspended(true);
+    val1 = 2;
+    manager->setSuspended(false);
+    manager->reset();
+    val1 = 3;
+    manager->getCacheResults(results);
+    assert_equal(results.groups.size(), (size_t)1, SPOT);
+    assert_equal(results.groups[0].misses[0], (size_t)0, SPOT);
+  }
+
+  // without a simulated cache, no levels are reported
+  MemManager plain;
+  CacheResults none;
+  plain.getCacheResults(none);
+  assert_true(none.levels.empty(), SPOT);
+}
+#endif
@@ -198,3 +198,155 @@ TEST(test_chronomanager_allresults)
   assert_true(res2 < res3, SPOT);
   assert_approx_equal(res1, res2 + res3, 500, SPOT);
 }
+
+TEST(test_chronomanager_suspended)
+{
+  ChronoManager mgr;
+  assert_false(mgr.isSuspended(), SPOT);
+
+  mgr.setSuspended(true);
+  mgr.start("abc");
+  doWork();
+  mgr.stop("abc");
+  assert_equal(mgr.getTimeNano(), 0, SPOT);
+  try {
+    mgr.getTimeMicro("abc"); // was never started
+    assert_true(false, SPOT);
+  } catch (const char* ch) {}
+
+  mgr.setSuspended(false);
+  mgr.start("abc");
+  doWork();
+  mgr.stop("abc");
+  assert_true(mgr.getTimeNano("abc") > 0, SPOT);
+}
+
+TEST(test_chronomanager_handles)
+{
+  ChronoManager mgr;
+  ChronoHandle first = mgr.handle("first");
+  ChronoHandle second = mgr.handle("second");
+  assert_true(first != second, SPOT);
+  assert_equal(mgr.handle("first"), first, SPOT); // same name, same stopwatch
+  assert_false(mgr.contains("first"), SPOT); // not started yet
+
+  mgr.start(first);
+  doWork();
+  mgr.stop(first);
+  assert_true(mgr.contains("first"), SPOT);
+  assert_false(mgr.contains("second"), SPOT);
+  assert_true(mgr.getTimeNano("first") > 0, SPOT);
+
+  // handles and names refer to the same stopwatch
+  double before = mgr.getTimeNano("first");
+  mgr.start("first");
+  doWork();
+  mgr.stop(first);
+  assert_true(mgr.getTimeNano("first") > before, SPOT);
+
+  // unused stopwatches aren't part of the results
+  ChronoResults results;
+  mgr.getAllResults(results);
+  assert_equal(results.size(), (size_t)1, SPOT);
+  assert_equal(results[0].first, std::string("first"), SPOT);
+
+  // handles remain valid after a reset
+  mgr.reset();
+  assert_false(mgr.contains("first"), SPOT);
+  mgr.start(second);
+  mgr.stop(second);
+  assert_true(mgr.contains("second"), SPOT);
+  assert_equal(mgr.handle("second"), second, SPOT);
+}
+
+TEST(test_chronomanager_overhead)
+{
+  ChronoManager mgr;
+  assert_true(mgr.getOverhead() < 1000000, SPOT); // reading the clock takes less than a millisecond
+
+  // an empty timespan is (mostly) the cost of reading the clock
+  ChronoHandle empty = mgr.handle("empty");
+  for (unsigned int i = 0; i < 1000; ++i) {
+    mgr.start(empty);
+    mgr.stop(empty);
+  }
+  assert_true(mgr.getTimeNano("empty") < 1000 * 1000.0, SPOT);
+}
+
+TEST(test_chronomanager_sampling)
+{
+  ChronoManager mgr;
+  try {
+    mgr.setSampling(0);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  mgr.setSampling(10);
+  ChronoHandle sampled = mgr.handle("sampled");
+  for (unsigned int i = 0; i < 10000; ++i) {
+    mgr.start(sampled);
+    mgr.stop(sampled);
+  }
+  // stopwatches used by name are always measured
+  mgr.start("named");
+  mgr.stop("named");
+
+  ChronoSamples samples;
+  mgr.getAllSamples(samples);
+  assert_equal(samples.size(), (size_t)1, SPOT);
+  assert_equal(samples[0].name, std::string("sampled"), SPOT);
+  assert_equal(samples[0].laps + samples[0].skipped, (uint64_t)10000, SPOT);
+  assert_approx_equal((double)samples[0].laps, 1000.0, 200.0, SPOT);
+
+  // total is estimated from the samples
+  assert_approx_equal(mgr.getTimeNano("sampled"), samples[0].nanos * 10000 / samples[0].laps, 1.0, SPOT);
+
+  // same samples after a reset
+  uint64_t laps = samples[0].laps;
+  mgr.reset();
+  for (unsigned int i = 0; i < 10000; ++i) {
+    mgr.start(sampled);
+    mgr.stop(sampled);
+  }
+  mgr.getAllSamples(samples);
+  assert_equal(samples[0].laps, laps, SPOT);
+
+  // without sampling, nothing is skipped
+  mgr.setSampling(1);
+  mgr.reset();
+  mgr.start(sampled);
+  mgr.stop(sampled);
+  mgr.getAllSamples(samples);
+  assert_true(samples.empty(), SPOT);
+}
+
+TEST(test_chronomanager_latencies)
+{
+  ChronoManager mgr;
+  mgr.record("lookup", 100);
+  mgr.record("lookup", 300);
+  mgr.setSuspended(true);
+  mgr.record("lookup", 5000); // ignored
+  mgr.setSuspended(false);
+
+  LatencyHistogram other;
+  other.record(200, 2);
+  mgr.record("other", other);
+
+  LatencyResults results;
+  mgr.getAllLatencies(results);
+  assert_equal(results.size(), (size_t)2, SPOT);
+  for (auto iter(results.begin()); iter != results.end(); ++iter) {
+    if (iter->first == "lookup") {
+      assert_equal(iter->second.count(), (uint64_t)2, SPOT);
+      assert_equal(iter->second.maximum(), (uint64_t)300, SPOT);
+    } else {
+      assert_equal(iter->first, std::string("other"), SPOT);
+      assert_equal(iter->second.count(), (uint64_t)2, SPOT);
+    }
+  }
+
+  mgr.reset();
+  mgr.getAllLatencies(results);
+  assert_true(results.empty(), SPOT);
+}
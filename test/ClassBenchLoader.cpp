@@ -0,0 +1,163 @@
+#include <libunittest/all.hpp>
+#include <configuration/ClassBenchLoader.hpp>
+#include <configuration/SharedRuleSet.hpp>
+#include <generics/RuleAtom.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+std::string writeFilters(const std::string& name, const std::string& content) {
+  std::string filename(std::string(P_tmpdir) + "/cate_" + name + "_" + std::to_string(getpid()));
+  std::ofstream file(filename, std::ios::trunc);
+  file << content;
+  return filename;
+}
+
+TEST(test_classbenchloader_atoms)
+{
+  std::string filename(writeFilters("classbench",
+    "@10.0.0.0/8\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\t0x0000/0x0200\n"
+    "\n"
+    "@0.0.0.0/0\t172.16.0.0/12\t1024 : 2048\t53 : 53\t0x00/0x00\t\n"));
+  std::vector<unsigned int> structure {32, 32, 16, 16, 8};
+  RuleSet rules;
+  assert_equal(ClassBenchLoader::load(filename, structure, rules), (size_t)2, SPOT);
+  assert_equal(rules.size(), (size_t)2, SPOT);
+  assert_equal(rules[0]->size(), (size_t)5, SPOT);
+
+  const RuleAtomPrefix* src = dynamic_cast<const RuleAtomPrefix*>((*rules[0])[0].get());
+  assert_true(src != nullptr, SPOT);
+  assert_equal(src->prefix, VarValue(0x0A000000u), SPOT);
+  assert_equal(src->mask, VarValue(0xFF000000u), SPOT);
+  assert_equal(src->width, (size_t)32, SPOT);
+
+  const RuleAtomExact* dst = dynamic_cast<const RuleAtomExact*>((*rules[0])[1].get());
+  assert_true(dst != nullptr, SPOT);
+  assert_equal(dst->value, VarValue(0xC0A80101u), SPOT);
+
+  const RuleAtomRange* srcPort = dynamic_cast<const RuleAtomRange*>((*rules[0])[2].get());
+  assert_true(srcPort != nullptr, SPOT);
+  assert_equal(srcPort->maxValue, VarValue(65535u), SPOT);
+  assert_equal((*rules[0])[3]->getType(), RuleAtom::Type::EXACT, SPOT);
+  assert_equal((*rules[0])[4]->getType(), RuleAtom::Type::EXACT, SPOT);
+
+  // wildcards of address and protocol
+  assert_true((*rules[1])[0]->isWildcard(), SPOT);
+  assert_true((*rules[1])[4]->isWildcard(), SPOT);
+  assert_equal((*rules[1])[2]->getType(), RuleAtom::Type::RANGE, SPOT);
+
+  // wider fields keep their upper bits zero, only the first fields are used
+  RuleSet wide;
+  ClassBenchLoader::load(filename, std::vector<unsigned int>{64, 32, 16, 16}, wide);
+  assert_equal(wide[1]->size(), (size_t)4, SPOT);
+  assert_false((*wide[1])[0]->isWildcard(), SPOT);
+  VarValue min, max;
+  (*wide[0])[0]->toRange(min, max);
+  assert_equal(min, VarValue(0x0A000000u), SPOT);
+  assert_equal(max, VarValue(0x0AFFFFFFu), SPOT);
+
+  remove(filename.c_str());
+}
+
+TEST(test_classbenchloader_chunks)
+{
+  std::string content;
+  for (unsigned int i = 0; i < 20000; ++i) {
+    content += "@10." + std::to_string(i / 256 % 256) + "." + std::to_string(i % 256) + ".0/24\t0.0.0.0/0\t";
+    content += std::to_string(i % 1000) + " : " + std::to_string(i % 1000 + 10) + "\t0 : 65535\t0x11/0xFF\n";
+  }
+  std::string filename(writeFilters("classbench_chunks", content));
+  std::vector<unsigned int> structure {32, 32, 16, 16, 8};
+
+  // rules of parallel chunks keep the order of the file
+  RuleSet rules;
+  assert_equal(ClassBenchLoader::load(filename, structure, rules, 4), (size_t)20000, SPOT);
+  for (unsigned int i = 0; i < 20000; i += 997) {
+    VarValue min, max;
+    (*rules[i])[2]->toRange(min, max);
+    assert_equal(min, VarValue(i % 1000), SPOT);
+    (*rules[i])[0]->toRange(min, max);
+    assert_equal(min, VarValue(0x0A000000u + (i % 65536) * 256), SPOT);
+  }
+  remove(filename.c_str());
+}
+
+TEST(test_classbenchloader_shared)
+{
+  std::string filename(writeFilters("classbench_shared",
+    "@10.0.0.0/8\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\n"
+    "  @0.0.0.0/0\t172.16.0.0/12\t1024 : 2048\t53 : 53\t0x00/0x00\n"));
+  std::vector<unsigned int> structure {32, 32, 16, 16, 8};
+  assert_equal(ClassBenchLoader::count(filename, structure), (size_t)2, SPOT);
+
+  // filters are only counted, until the rules are needed
+  SharedRuleSet rules(filename, structure);
+  assert_false(rules.isLoaded(), SPOT);
+  assert_equal(rules.size(), (size_t)2, SPOT);
+  assert_equal(rules.get().size(), (size_t)2, SPOT);
+  assert_true(rules.isLoaded(), SPOT);
+  remove(filename.c_str());
+
+  // once loaded, the file isn't read again
+  assert_equal(rules.get().size(), (size_t)2, SPOT);
+
+  try { // missing file
+    SharedRuleSet missing(filename, structure);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // a file, which was changed after counting its filters, is rejected by each call
+  filename = writeFilters("classbench_changed", "@10.0.0.0/8\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\n");
+  SharedRuleSet changed(filename, structure, 2);
+  for (unsigned int i = 0; i < 2; ++i) {
+    try {
+      changed.get();
+      assert_true(false, SPOT);
+    } catch (const char* ex) {}
+    assert_false(changed.isLoaded(), SPOT);
+  }
+  remove(filename.c_str());
+}
+
+TEST(test_classbenchloader_invalid)
+{
+  std::vector<unsigned int> structure {32, 32, 16, 16, 8};
+  RuleSet rules;
+  try { // missing file
+    ClassBenchLoader::load(std::string(P_tmpdir) + "/cate_classbench_missing", structure, rules);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  std::string filename(writeFilters("classbench_invalid",
+    "@10.0.0.0/8\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\n"
+    "@10.0.0.0/33\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\n"));
+  try { // prefix length
+    ClassBenchLoader::load(filename, structure, rules);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  assert_true(rules.empty(), SPOT);
+
+  filename = writeFilters("classbench_invalid", "@10.0.0.0/8\t192.168.1.1/32\t90 : 80\t80 : 80\t0x06/0xFF\n");
+  try { // inverted port range
+    ClassBenchLoader::load(filename, structure, rules);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  filename = writeFilters("classbench_invalid", "@10.0.0.0/8\t192.168.1.1/32\t0 : 65535\t80 : 80\t0x06/0xFF\n");
+  try { // a port doesn't fit into 8 bits
+    ClassBenchLoader::load(filename, std::vector<unsigned int>{32, 32, 8, 16, 8}, rules);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // no mapping for 3 fields
+    ClassBenchLoader::load(filename, std::vector<unsigned int>{32, 32, 16}, rules);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  remove(filename.c_str());
+}
+
@@ -0,0 +1,149 @@
+#include <libunittest/all.hpp>
+#include <configuration/ConfigurationCache.hpp>
+#include <generics/RuleAtom.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+void writeCacheFile(const std::string& filename, const std::string& content) {
+  std::ofstream file(filename, std::ios::trunc);
+  file << content;
+}
+
+/** Creates a configuration with two benchmarks, which share their rules and headers. */
+void fillConfiguration(Configuration& config, const std::string& classBenchFile) {
+  std::shared_ptr<SharedRuleSet> rules(std::make_shared<SharedRuleSet>());
+  std::unique_ptr<Rule> rule(new Rule);
+  rule->push_back(std::unique_ptr<RuleAtom>(new RuleAtomPrefix((uint32_t)0x0A000000, (uint32_t)0xFF000000)));
+  rule->push_back(std::unique_ptr<RuleAtom>(new RuleAtomRange(VarValue(1024u), VarValue("0x1ffffffffffffffff"), 72)));
+  rules->edit().push_back(std::move(rule));
+
+  std::shared_ptr<PacketHeaderColumns> headers(std::make_shared<PacketHeaderColumns>(std::vector<unsigned int>{32, 72}));
+  headers->addHeader();
+  headers->addValue(VarValue(0x0A000001u));
+  headers->addValue(VarValue("0x100000000000000ff"));
+
+  for (unsigned int i = 0; i < 2; ++i) {
+    BenchmarkPtr benchmark(std::make_shared<Benchmark>());
+    benchmark->caption = "benchmark " + std::to_string(i);
+    benchmark->algFilename = "../algorithms/lib/LinearSearch5tpl.so";
+    benchmark->algParameter.push_back(1000.5);
+    benchmark->fieldStructure = {32, 72};
+    benchmark->rules = rules;
+    benchmark->headers = headers;
+    benchmark->numberRuns = 3 + i;
+    benchmark->cpuAffinity = -1;
+    benchmark->measureLatency = true;
+    benchmark->cache.push_back(CacheLevelConfiguration("L1", 32768, 8, 64, CacheLevelConfiguration::PLRU));
+    benchmark->traceAccesses = (i == 1);
+    benchmark->measureHeap = (i == 0);
+    config.getBenchmarkSet().push_back(benchmark);
+  }
+
+  // random headers, rule updates and a ClassBench file
+  BenchmarkPtr benchmark(std::make_shared<Benchmark>());
+  benchmark->caption = "random";
+  benchmark->fieldStructure = {32, 32, 16, 16, 8};
+  benchmark->generateHeaders = true;
+  benchmark->rndHeaderConfig.totalHeaders = 5000;
+  benchmark->rndHeaderConfig.batchSize = 256;
+  benchmark->rndHeaderConfig.seeds = {1, 2};
+  VarValue low(10u), high(20u);
+  benchmark->rndHeaderConfig.distributions.push_back(std::unique_ptr<RandomDistribution>(new RandomDistUniform(low, high)));
+  benchmark->rndHeaderConfig.distributions.push_back(std::unique_ptr<RandomDistribution>(new RandomDistPareto(1.5, 2.5, low)));
+  benchmark->rules = std::make_shared<SharedRuleSet>(classBenchFile, benchmark->fieldStructure);
+  benchmark->ruleUpdates.headersPerUpdate = 100;
+  benchmark->ruleUpdates.trace.push_back(std::unique_ptr<RuleUpdate>(new RuleUpdate(RuleUpdate::REMOVE, 0)));
+  benchmark->ruleUpdates.trace.push_back(std::unique_ptr<RuleUpdate>(new RuleUpdate(RuleUpdate::INSERT, 1)));
+  benchmark->ruleUpdates.trace.back()->rule.push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact((uint16_t)80)));
+  config.getBenchmarkSet().push_back(benchmark);
+}
+
+TEST(test_configurationcache_store_load)
+{
+  char dir[] = "/tmp/cate_configcache_XXXXXX";
+  assert_true(mkdtemp(dir) != nullptr, SPOT);
+  std::string script(std::string(dir) + "/suite.lua"), program(std::string(dir) + "/cate");
+  std::string classBench(std::string(dir) + "/filters");
+  writeCacheFile(script, "registerBenchmark(...)\n");
+  writeCacheFile(program, "program");
+  writeCacheFile(classBench, "@10.0.0.0/8\t0.0.0.0/0\t0 : 65535\t80 : 80\t0x06/0xFF\n");
+
+  Configuration config;
+  fillConfiguration(config, classBench);
+  config.addSourceFile(script);
+  config.addDataFile(classBench);
+
+  ConfigurationCache cache(dir, script, program);
+  Configuration loaded;
+  assert_false(cache.load(loaded), SPOT); // nothing stored yet
+  assert_true(cache.store(config), SPOT);
+  assert_true(cache.load(loaded), SPOT);
+
+  const BenchmarkSet& benchmarks = loaded.getBenchmarkSet();
+  assert_equal(benchmarks.size(), (size_t)3, SPOT);
+  assert_equal(loaded.getSourceFiles().size(), (size_t)1, SPOT);
+  assert_equal(loaded.getDataFiles().size(), (size_t)1, SPOT);
+  assert_equal(benchmarks[1]->caption, std::string("benchmark 1"), SPOT);
+  assert_equal(benchmarks[1]->algParameter[0], 1000.5, SPOT);
+  assert_equal(benchmarks[1]->numberRuns, 4u, SPOT);
+  assert_equal(benchmarks[1]->cpuAffinity, -1, SPOT);
+  assert_true(benchmarks[1]->measureLatency, SPOT);
+  assert_equal(benchmarks[1]->cache.size(), (size_t)1, SPOT);
+  assert_equal(benchmarks[1]->cache[0].ways, 8u, SPOT);
+  assert_equal(benchmarks[1]->cache[0].policy, CacheLevelConfiguration::PLRU, SPOT);
+  assert_false(benchmarks[0]->traceAccesses, SPOT);
+  assert_true(benchmarks[1]->traceAccesses, SPOT);
+  assert_true(benchmarks[0]->measureHeap, SPOT);
+  assert_false(benchmarks[1]->measureHeap, SPOT);
+
+  // shared sets are still shared, wide values are kept
+  assert_true(benchmarks[0]->rules == benchmarks[1]->rules, SPOT);
+  assert_true(benchmarks[0]->headers == benchmarks[1]->headers, SPOT);
+  const Rule& rule = *benchmarks[0]->rules->get()[0];
+  VarValue min, max;
+  rule[1]->toRange(min, max);
+  assert_equal(max, VarValue("0x1ffffffffffffffff"), SPOT);
+  assert_equal(rule[0]->getType(), RuleAtom::Type::PREFIX, SPOT);
+  assert_equal(benchmarks[0]->headers->size(), (size_t)1, SPOT);
+  assert_equal(benchmarks[0]->headers->value(0, 1), VarValue("0x100000000000000ff"), SPOT);
+
+  // rules of the ClassBench file are only counted
+  const Benchmark& random = *benchmarks[2];
+  assert_false(random.rules->isLoaded(), SPOT);
+  assert_equal(random.getRuleNumber(), 1u, SPOT);
+  assert_equal(random.getHeaderNumber(), 5000u, SPOT);
+  assert_equal(random.rndHeaderConfig.batchSize, 256u, SPOT);
+  assert_equal(random.rndHeaderConfig.seeds[1], 2u, SPOT);
+  assert_equal(random.rndHeaderConfig.distributions[1]->getType(), RandomDistribution::PARETO, SPOT);
+  assert_equal(static_cast<const RandomDistPareto&>(*random.rndHeaderConfig.distributions[1]).shape, 2.5, SPOT);
+  assert_equal(random.ruleUpdates.headersPerUpdate, 100u, SPOT);
+  assert_equal(random.ruleUpdates.trace[1]->type, RuleUpdate::INSERT, SPOT);
+  assert_equal(random.ruleUpdates.trace[1]->rule.size(), (size_t)1, SPOT);
+
+  // a changed script invalidates the cache
+  writeCacheFile(script, "registerBenchmark(..)\n");
+  Configuration changed;
+  assert_false(cache.load(changed), SPOT);
+  assert_true(changed.getBenchmarkSet().empty(), SPOT);
+
+  // another configuration file uses another cache file
+  ConfigurationCache other(dir, classBench, program);
+  assert_true(other.filename() != cache.filename(), SPOT);
+
+  // a configuration, which depends on more than its files, isn't stored
+  config.setCacheable(false);
+  assert_false(other.store(config), SPOT);
+
+  remove(cache.filename().c_str());
+  remove(script.c_str());
+  remove(program.c_str());
+  remove(classBench.c_str());
+  remove(dir);
+}
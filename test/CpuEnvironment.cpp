@@ -0,0 +1,63 @@
+#include <libunittest/all.hpp>
+#include <core/CpuEnvironment.hpp>
+#include <vector>
+
+using namespace unittest::assertions;
+
+TEST(test_cpuenvironment_pinning)
+{
+  CpuEnvironment env;
+  assert_equal(env.getCpu(), -1, SPOT);
+
+  int cpu = CpuEnvironment::currentCpu();
+  if (cpu < 0) return; // not supported on this system
+
+  std::vector<unsigned int> allowed(CpuEnvironment::allowedCpus());
+  assert_false(allowed.empty(), SPOT);
+
+  assert_true(env.pin(cpu), SPOT);
+  assert_equal(env.getCpu(), cpu, SPOT);
+  assert_equal(CpuEnvironment::currentCpu(), cpu, SPOT);
+  assert_equal(CpuEnvironment::allowedCpus().size(), (size_t)1, SPOT);
+
+  // release and pin again to the same cpu
+  env.release(true);
+  env.repin();
+  assert_equal(CpuEnvironment::currentCpu(), cpu, SPOT);
+
+  // a cpu, which doesn't exist, keeps the former pinning
+  assert_false(env.pin(100000), SPOT);
+  assert_equal(env.getCpu(), cpu, SPOT);
+
+  env.unpin();
+  assert_equal(env.getCpu(), -1, SPOT);
+  assert_true(CpuEnvironment::allowedCpus() == allowed, SPOT);
+}
+
+TEST(test_cpuenvironment_unpin_guard)
+{
+  CpuEnvironment env;
+  int cpu = CpuEnvironment::currentCpu();
+  if (cpu < 0) return; // not supported on this system
+
+  std::vector<unsigned int> allowed(CpuEnvironment::allowedCpus());
+  try { // an exception leaves the scope of the guard
+    CpuUnpinGuard guard(env);
+    assert_true(env.pin(cpu), SPOT);
+    throw "failed benchmark";
+  } catch (const char* ex) {}
+
+  assert_equal(env.getCpu(), -1, SPOT);
+  assert_true(CpuEnvironment::allowedCpus() == allowed, SPOT);
+}
+
+TEST(test_cpuenvironment_properties)
+{
+  int cpu = CpuEnvironment::currentCpu();
+
+  // values depend on the system, but reading them must not fail
+  assert_true(CpuEnvironment::frequencyMHz(cpu) >= 0, SPOT);
+  assert_equal(CpuEnvironment::frequencyMHz(-1), 0, SPOT);
+  assert_true(CpuEnvironment::governor(-1).empty(), SPOT);
+  CpuEnvironment::model();
+}
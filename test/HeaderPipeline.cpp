@@ -0,0 +1,114 @@
+#include <libunittest/all.hpp>
+#include <generator/HeaderPipeline.hpp>
+#include <memory>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+void configureUniform(HeaderGenerator& generator, unsigned int seed) {
+  FieldStructureSet fields;
+  fields.push_back(32);
+  fields.push_back(16);
+
+  RandomHeaderConfiguration rndConfig;
+  VarValue min(0);
+  VarValue max1("0xFFFFFFFF");
+  VarValue max2("0xFFFF");
+  std::unique_ptr<RandomDistribution> distrib1(new RandomDistUniform(min, max1));
+  std::unique_ptr<RandomDistribution> distrib2(new RandomDistUniform(min, max2));
+  rndConfig.distributions.push_back(std::move(distrib1));
+  rndConfig.distributions.push_back(std::move(distrib2));
+  rndConfig.seeds.push_back(seed);
+  rndConfig.seeds.push_back(seed + 1);
+
+  assert_true(generator.configure(fields, rndConfig), SPOT);
+}
+
+/** Pipelined generation has to yield the same headers as a sequential generation. */
+void checkSequence(unsigned int total, unsigned int batchSize, unsigned int depth) {
+  HeaderGenerator sequential, pipelined;
+  configureUniform(sequential, 4711);
+  configureUniform(pipelined, 4711);
+
+  PacketHeaderSet expected;
+  sequential.generateHeaders(total, expected);
+
+  HeaderPipeline pipeline(pipelined, total, batchSize, depth);
+  PacketHeaderColumns batch;
+  unsigned int headerCnt = 0, batchCnt = 0;
+  while (pipeline.next(batch)) {
+    assert_true(batch.size() <= batchSize, SPOT);
+    assert_true(batch.size() > 0, SPOT);
+    for (PacketHeaderColumns::const_iterator hdr(batch.begin()); hdr != batch.end(); ++hdr) {
+      assert_true(headerCnt < total, SPOT);
+      assert_equal((*hdr).size(), (unsigned)2, SPOT);
+      assert_equal((*hdr)[0], expected[headerCnt]->at(0)->value, SPOT);
+      assert_equal((*hdr)[1], expected[headerCnt]->at(1)->value, SPOT);
+      ++headerCnt;
+    }
+    ++batchCnt;
+  }
+  assert_equal(headerCnt, total, SPOT);
+  assert_equal(batchCnt, (total + batchSize - 1) / batchSize, SPOT);
+  assert_false(pipeline.next(batch), SPOT); // stays finished
+}
+
+TEST(test_headerpipeline_sequence)
+{
+  checkSequence(1000, 100, 2);
+  checkSequence(1001, 100, 2);
+  checkSequence(99, 100, 2);
+  checkSequence(500, 1, 1);
+  checkSequence(2000, 64, 8);
+}
+
+TEST(test_headerpipeline_empty)
+{
+  HeaderGenerator generator;
+  configureUniform(generator, 1);
+
+  HeaderPipeline pipeline(generator, 0, 100);
+  PacketHeaderColumns batch;
+  assert_false(pipeline.next(batch), SPOT);
+}
+
+TEST(test_headerpipeline_invalid)
+{
+  HeaderGenerator generator;
+  configureUniform(generator, 1);
+
+  try {
+    HeaderPipeline pipeline(generator, 100, 0);
+    assert_true(false, SPOT);
+  } catch (const char* ch) {}
+  try {
+    HeaderPipeline pipeline(generator, 100, 10, 0);
+    assert_true(false, SPOT);
+  } catch (const char* ch) {}
+}
+
+TEST(test_headerpipeline_error)
+{
+  HeaderGenerator generator; // not configured, generation fails
+  HeaderPipeline pipeline(generator, 100, 10);
+  PacketHeaderColumns batch;
+
+  try {
+    pipeline.next(batch);
+    assert_true(false, SPOT);
+  } catch (const char* ch) {}
+}
+
+TEST(test_headerpipeline_cancel)
+{
+  HeaderGenerator generator;
+  configureUniform(generator, 1);
+
+  { // stop consuming early, producer must not block destruction
+    HeaderPipeline pipeline(generator, 100000, 10, 2);
+    PacketHeaderColumns batch;
+    assert_true(pipeline.next(batch), SPOT);
+    assert_equal(batch.size(), (unsigned)10, SPOT);
+  }
+}
+
@@ -0,0 +1,129 @@
+#include <libunittest/all.hpp>
+#include <generics/HeaderTrace.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+/** Fills a header set with count headers, whose fields depend on the index of each header. */
+void fillTraceHeaders(PacketHeaderColumns& headers, size_t first, size_t count) {
+  for (size_t i = first; i < first + count; ++i) {
+    headers.addHeader();
+    headers.addValue(VarValue((unsigned long)(0x0A000000 + i)));
+    headers.addValue(VarValue((unsigned long)(i % 65536)));
+    headers.addValue(VarValue((unsigned long)(i % 64)));
+    headers.addValue(VarValue(std::string("0x20010db8000000000000000000000000")) + VarValue((unsigned long)i));
+  }
+}
+
+TEST(test_headertrace_write_read)
+{
+  std::string filename(std::string(P_tmpdir) + "/cate_headertrace_" + std::to_string(getpid()) + ".trace");
+  std::vector<unsigned int> structure {32, 16, 6, 128};
+
+  PacketHeaderColumns first(structure), second(structure);
+  fillTraceHeaders(first, 0, 100);
+  fillTraceHeaders(second, 100, 50);
+
+  { // write and append in two steps
+    HeaderTraceWriter writer(filename, structure);
+    writer.write(first);
+    writer.close();
+  }
+  {
+    HeaderTraceWriter writer(filename, structure, true);
+    writer.write(second);
+    writer.close();
+  }
+
+  HeaderTraceReader trace(filename);
+  assert_equal(trace.size(), (size_t)150, SPOT);
+  assert_true(trace.fieldBits() == structure, SPOT);
+
+  // stream in batches and compare with the written headers
+  PacketHeaderColumns batch, all(structure);
+  all.append(first);
+  all.append(second);
+  size_t header = 0, batches = 0;
+  while (trace.next(batch, 64)) {
+    ++batches;
+    for (size_t i = 0; i < batch.size(); ++i, ++header) {
+      for (size_t field = 0; field < structure.size(); ++field)
+        assert_equal(batch.value(i, field), all.value(header, field), SPOT);
+    }
+  }
+  assert_equal(batches, (size_t)3, SPOT);
+  assert_equal(header, (size_t)150, SPOT);
+
+  // random access to a range
+  PacketHeaderColumns range(structure);
+  trace.read(140, 20, range);
+  assert_equal(range.size(), (size_t)10, SPOT);
+  assert_equal(range.get(0, 0), (uint64_t)(0x0A000000 + 140), SPOT);
+
+  // appending with another structure is refused
+  std::vector<unsigned int> other {32, 16, 8, 128};
+  try {
+    HeaderTraceWriter writer(filename, other, true);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  remove(filename.c_str());
+}
+
+TEST(test_headertrace_invalid)
+{
+  std::string filename(std::string(P_tmpdir) + "/cate_headertrace_invalid_" + std::to_string(getpid()) + ".trace");
+  std::vector<unsigned int> structure {32, 16};
+
+  try { // missing file
+    HeaderTraceReader trace(filename);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  PacketHeaderColumns headers(structure);
+  headers.addHeader();
+  headers.addValue(VarValue(1u));
+  headers.addValue(VarValue(2u));
+  {
+    HeaderTraceWriter writer(filename, structure);
+    writer.write(headers);
+  }
+  {
+    HeaderTraceReader trace(filename);
+    assert_equal(trace.size(), (size_t)1, SPOT);
+
+    PacketHeaderColumns wrong(std::vector<unsigned int>{32, 32});
+    try {
+      trace.read(0, 1, wrong);
+      assert_true(false, SPOT);
+    } catch (const char* ex) {}
+  }
+
+  // a truncated record is detected
+  {
+    std::ofstream file(filename, std::ios::app | std::ios::binary);
+    file.put('\x01');
+  }
+  try {
+    HeaderTraceReader trace(filename);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // a file of another format is refused
+  {
+    std::ofstream file(filename, std::ios::trunc | std::ios::binary);
+    file << "1;2;3;4;5;\n";
+  }
+  try {
+    HeaderTraceReader trace(filename);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  remove(filename.c_str());
+}
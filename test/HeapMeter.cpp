@@ -0,0 +1,101 @@
+#include <libunittest/all.hpp>
+#include <metering/HeapMeter.hpp>
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <cstdint>
+
+using namespace unittest::assertions;
+
+TEST(test_heapmeter_disabled)
+{
+  HeapMeter heap; // not enabled: all calls are ignored
+  assert_false(heap.isEnabled(), SPOT);
+
+  heap.start("abc");
+  std::vector<uint32_t> values(100, 1);
+  heap.stop();
+  heap.stop(); // never started
+
+  HeapResults results;
+  heap.getAllResults(results);
+  assert_true(results.empty(), SPOT);
+}
+
+TEST(test_heapmeter_phases)
+{
+  HeapMeter heap;
+  heap.setEnabled(true);
+  std::vector<std::unique_ptr<std::vector<uint32_t>>> kept;
+
+  // capacity is counted, not only the used size
+  heap.start("build");
+  kept.reserve(4);
+  kept.emplace_back(new std::vector<uint32_t>());
+  kept.back()->reserve(1000);
+  kept.back()->push_back(1);
+  heap.stop();
+
+  // allocations outside of a phase aren't counted
+  std::unique_ptr<std::vector<uint32_t>> unmetered(new std::vector<uint32_t>(1000, 2));
+
+  // a temporary allocation only raises the peak
+  heap.start("lookup");
+  {
+    std::vector<uint64_t> temporary(2000, 3);
+    kept.back()->push_back(temporary.back() & 0xFF);
+  }
+  heap.stop();
+
+  // allocations of other threads aren't counted (only the state of the thread may be)
+  heap.start("worker");
+  std::unique_ptr<std::vector<uint32_t>> other;
+  std::thread worker([&other] { other.reset(new std::vector<uint32_t>(1000, 4)); });
+  worker.join();
+  heap.stop();
+
+  // nodes of a map are counted with their overhead
+  heap.start("build");
+  std::map<uint32_t, uint32_t> nodes;
+  for (uint32_t i = 0; i < 10; ++i) nodes[i] = i;
+  heap.stop();
+
+  HeapResults results;
+  heap.getAllResults(results);
+  assert_equal(results.size(), (size_t)3, SPOT);
+
+  // phases are kept in order of their first start, restarted phases are accumulated
+  assert_equal(results[0].first, std::string("build"), SPOT);
+  const HeapCounters& build = results[0].second;
+  assert_equal(build.allocations, (uint64_t)(3 + 10), SPOT);
+  assert_equal(build.deallocations, (uint64_t)0, SPOT);
+  assert_true(build.liveBytes >= (int64_t)(1000 * sizeof(uint32_t) + 10 * 4 * sizeof(uint32_t)), SPOT);
+  assert_true(build.liveBytes < (int64_t)(2000 * sizeof(uint32_t)), SPOT);
+  assert_equal(build.peakBytes, build.liveBytes, SPOT);
+
+  assert_equal(results[1].first, std::string("lookup"), SPOT);
+  const HeapCounters& lookup = results[1].second;
+  assert_equal(lookup.allocations, (uint64_t)1, SPOT);
+  assert_equal(lookup.deallocations, (uint64_t)1, SPOT);
+  assert_equal(lookup.liveBytes, (int64_t)0, SPOT);
+  assert_true(lookup.peakBytes >= (int64_t)(2000 * sizeof(uint64_t)), SPOT);
+
+  assert_equal(results[2].first, std::string("worker"), SPOT);
+  assert_true(results[2].second.allocations <= 1, SPOT);
+  assert_true(results[2].second.liveBytes < (int64_t)(1000 * sizeof(uint32_t)), SPOT);
+
+  // memory allocated before a phase reduces the live bytes, if it is released in it
+  heap.start("release");
+  unmetered.reset(); // the vector and its elements
+  heap.stop();
+  heap.getAllResults(results);
+  assert_equal(results.size(), (size_t)4, SPOT);
+  assert_true(results[3].second.liveBytes <= -(int64_t)(1000 * sizeof(uint32_t)), SPOT);
+  assert_equal(results[3].second.peakBytes, (int64_t)0, SPOT);
+  assert_equal(results[3].second.deallocations, (uint64_t)2, SPOT);
+
+  heap.reset();
+  heap.getAllResults(results);
+  assert_true(results.empty(), SPOT);
+}
@@ -0,0 +1,77 @@
+#include <libunittest/all.hpp>
+#include <frontend/IsolatedProcess.hpp>
+#include <csignal>
+#include <vector>
+#include <unistd.h>
+
+using namespace unittest::assertions;
+
+TEST(test_isolatedprocess_success)
+{
+  IsolatedProcess proc(0, 0);
+  assert_true(proc.start([](std::string&) { return true; }), SPOT);
+  assert_true(proc.getPid() > 0, SPOT);
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::OK, SPOT);
+  assert_equal(proc.getResult().signal, 0, SPOT);
+  assert_true(proc.getResult().message.empty(), SPOT);
+
+  // same object can start another process
+  assert_true(proc.start([](std::string& message) { message = "no headers"; return false; }), SPOT);
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::FAILED, SPOT);
+  assert_equal(proc.getResult().message, std::string("no headers"), SPOT);
+}
+
+TEST(test_isolatedprocess_exception)
+{
+  IsolatedProcess proc(0, 0);
+  proc.start([](std::string&) -> bool { throw "Invalid rule set (Test)."; });
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::FAILED, SPOT);
+  assert_equal(proc.getResult().message, std::string("Invalid rule set (Test)."), SPOT);
+
+  // waiting without a running process
+  try {
+    proc.wait();
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_isolatedprocess_crash)
+{
+  IsolatedProcess proc(0, 0);
+  proc.start([](std::string&) { raise(SIGSEGV); return true; });
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::CRASH, SPOT);
+  assert_equal(proc.getResult().signal, SIGSEGV, SPOT);
+
+  // exiting without a record is a crash, too
+  proc.start([](std::string&) { _exit(0); return true; });
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::CRASH, SPOT);
+  assert_equal(proc.getResult().signal, 0, SPOT);
+}
+
+TEST(test_isolatedprocess_timeout)
+{
+  IsolatedProcess proc(1, 0);
+  proc.start([](std::string&) { while (true) sleep(1); return true; });
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::TIMEOUT, SPOT);
+  assert_true(proc.getResult().seconds >= 0.9, SPOT);
+  assert_equal(std::string(IsolatedProcess::outcomeName(proc.getResult().outcome)), std::string("timeout"), SPOT);
+}
+
+TEST(test_isolatedprocess_memory)
+{
+  IsolatedProcess proc(0, (uint64_t)256 << 20);
+  proc.start([](std::string&) {
+    std::vector<char> huge((size_t)1 << 30, 1); // 1 GiB
+    return huge.back() == 1;
+  });
+  proc.wait();
+  assert_true(proc.getResult().outcome == ProcessOutcome::OOM, SPOT);
+  assert_true(proc.getResult().peakMemory > 0, SPOT);
+}
+
@@ -0,0 +1,71 @@
+#include <libunittest/all.hpp>
+#include <metering/time/LatencyHistogram.hpp>
+#include <vector>
+#include <cstdint>
+
+using namespace unittest::assertions;
+
+TEST(test_latencyhistogram_exact)
+{
+  LatencyHistogram hist;
+  assert_equal(hist.count(), (uint64_t)0, SPOT);
+  assert_equal(hist.valueAtPercentile(50), (uint64_t)0, SPOT);
+
+  // small values are counted exactly
+  for (uint64_t i = 1; i <= 100; ++i)
+    hist.record(i);
+
+  assert_equal(hist.count(), (uint64_t)100, SPOT);
+  assert_equal(hist.minimum(), (uint64_t)1, SPOT);
+  assert_equal(hist.maximum(), (uint64_t)100, SPOT);
+  assert_approx_equal(hist.mean(), 50.5, 0.001, SPOT);
+  assert_equal(hist.valueAtPercentile(50), (uint64_t)50, SPOT);
+  assert_equal(hist.valueAtPercentile(90), (uint64_t)90, SPOT);
+  assert_equal(hist.valueAtPercentile(99.9), (uint64_t)100, SPOT);
+  assert_equal(hist.valueAtPercentile(0), (uint64_t)1, SPOT);
+  assert_equal(hist.valueAtPercentile(100), (uint64_t)100, SPOT);
+
+  hist.reset();
+  assert_equal(hist.count(), (uint64_t)0, SPOT);
+  assert_equal(hist.minimum(), (uint64_t)0, SPOT);
+  assert_equal(hist.maximum(), (uint64_t)0, SPOT);
+}
+
+TEST(test_latencyhistogram_precision)
+{
+  LatencyHistogram hist;
+  const uint64_t values[] = { 130, 1000, 12345, 1000000, 987654321, 1ULL << 40, UINT64_MAX };
+  for (auto value : values) {
+    hist.reset();
+    hist.record(value - 1, 99);
+    hist.record(value);
+
+    uint64_t median = hist.valueAtPercentile(50);
+    assert_true(median >= value - 1, SPOT);
+    assert_true(median - (value - 1) <= (value - 1) / 64, SPOT);
+    assert_equal(hist.valueAtPercentile(100), value, SPOT);
+  }
+}
+
+TEST(test_latencyhistogram_merge_cdf)
+{
+  LatencyHistogram first, second;
+  first.record(10, 3);
+  second.record(2000);
+  second.record(10);
+  first.merge(second);
+
+  assert_equal(first.count(), (uint64_t)5, SPOT);
+  assert_equal(first.minimum(), (uint64_t)10, SPOT);
+  assert_equal(first.maximum(), (uint64_t)2000, SPOT);
+  assert_equal(first.valueAtPercentile(80), (uint64_t)10, SPOT);
+  assert_equal(first.valueAtPercentile(81), (uint64_t)2000, SPOT);
+
+  std::vector<LatencyCdfPoint> cdf;
+  first.getCdf(cdf);
+  assert_equal(cdf.size(), (size_t)2, SPOT);
+  assert_equal(cdf[0].first, (uint64_t)10, SPOT);
+  assert_approx_equal(cdf[0].second, 0.8, 0.0001, SPOT);
+  assert_equal(cdf[1].first, (uint64_t)2000, SPOT);
+  assert_approx_equal(cdf[1].second, 1.0, 0.0001, SPOT);
+}
@@ -98,35 +98,77 @@ TEST(test_luaconfigurator_rules32)
   configurator.addFieldStructure(16);
   configurator.addFieldStructure(32);
 
-  assert_true(cfgPtr->getBenchmarkSet()[0]->rules.empty(), SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[0]->rules->get().empty(), SPOT);
   
   // add first rule with 32 bit values
   configurator.addRule();
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules.size(), (unsigned)1, SPOT);
-  assert_true(cfgPtr->getBenchmarkSet()[0]->rules[0]->empty(), SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get().size(), (unsigned)1, SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->empty(), SPOT);
 
   configurator.addRuleAtomExact(333444);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->size(), (unsigned)1, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(0)->getType(), Generic::RuleAtom::EXACT, SPOT);
-  Generic::RuleAtomExact* atom1 = static_cast<Generic::RuleAtomExact*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(0).get());
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->size(), (unsigned)1, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(0)->getType(), Generic::RuleAtom::EXACT, SPOT);
+  Generic::RuleAtomExact* atom1 = static_cast<Generic::RuleAtomExact*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(0).get());
   assert_equal(atom1->value, (unsigned)333444, SPOT);
 
   configurator.addRuleAtomRange(1000, 9999);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->size(), (unsigned)2, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(1)->getType(), Generic::RuleAtom::RANGE, SPOT);
-  Generic::RuleAtomRange* atom2 = static_cast<Generic::RuleAtomRange*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(1).get());
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->size(), (unsigned)2, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(1)->getType(), Generic::RuleAtom::RANGE, SPOT);
+  Generic::RuleAtomRange* atom2 = static_cast<Generic::RuleAtomRange*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(1).get());
   assert_equal(atom2->minValue, (unsigned)1000, SPOT);
   assert_equal(atom2->maxValue, (unsigned)9999, SPOT);
 
   configurator.addRuleAtomPrefix(0xA88E3000, 0xFFFF0000);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->size(), (unsigned)3, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(2)->getType(), Generic::RuleAtom::PREFIX, SPOT);
-  Generic::RuleAtomPrefix* atom3 = static_cast<Generic::RuleAtomPrefix*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(2).get());
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->size(), (unsigned)3, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(2)->getType(), Generic::RuleAtom::PREFIX, SPOT);
+  Generic::RuleAtomPrefix* atom3 = static_cast<Generic::RuleAtomPrefix*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(2).get());
   assert_equal(atom3->prefix, (unsigned)0xA88E3000, SPOT);
   assert_equal(atom3->mask, (unsigned)0xFFFF0000, SPOT);
 }
 
 
+TEST(test_luaconfigurator_ruleupdates)
+{
+  std::shared_ptr<Configuration> cfgPtr = std::make_shared<Configuration>();
+  LuaConfigurator configurator(cfgPtr);
+  configurator.addBenchmark();
+  configurator.addFieldStructure(32);
+  configurator.addFieldStructure(16);
+
+  configurator.addRule();
+  configurator.addRuleAtomExact(1);
+  configurator.addRuleAtomExact(2);
+
+  const RuleUpdateConfiguration& updates = cfgPtr->getBenchmarkSet()[0]->ruleUpdates;
+  assert_equal(updates.headersPerUpdate, (unsigned)0, SPOT);
+  assert_true(updates.trace.empty(), SPOT);
+
+  configurator.setRuleUpdateInterval(100);
+  configurator.addRuleInsertion(1);
+  configurator.addRuleAtomRange(5, 10); // atoms belong to the inserted rule
+  configurator.addRuleAtomPrefix(0x80, 0xFF00);
+  configurator.addRuleRemoval(0);
+
+  assert_equal(updates.headersPerUpdate, (unsigned)100, SPOT);
+  assert_equal(updates.trace.size(), (unsigned)2, SPOT);
+  assert_equal(updates.trace[0]->type, RuleUpdate::INSERT, SPOT);
+  assert_equal(updates.trace[0]->index, (uint32_t)1, SPOT);
+  assert_equal(updates.trace[0]->rule.size(), (unsigned)2, SPOT);
+  assert_equal(updates.trace[0]->rule[0]->getType(), Generic::RuleAtom::RANGE, SPOT);
+  assert_equal(updates.trace[0]->rule[1]->getType(), Generic::RuleAtom::PREFIX, SPOT);
+  assert_equal(updates.trace[1]->type, RuleUpdate::REMOVE, SPOT);
+  assert_equal(updates.trace[1]->index, (uint32_t)0, SPOT);
+  assert_true(updates.trace[1]->rule.empty(), SPOT);
+
+  // the rule set itself is unchanged, until another rule is added
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get().size(), (unsigned)1, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->size(), (unsigned)2, SPOT);
+  configurator.addRule();
+  configurator.addRuleAtomExact(3);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[1]->size(), (unsigned)1, SPOT);
+  assert_equal(updates.trace[0]->rule.size(), (unsigned)2, SPOT);
+}
+
 TEST(test_luaconfigurator_rules64)
 {
   std::shared_ptr<Configuration> cfgPtr = std::make_shared<Configuration>();
@@ -138,12 +180,12 @@ TEST(test_luaconfigurator_rules64)
   configurator.addFieldStructure(64);
   configurator.addFieldStructure(64);
 
-  assert_true(cfgPtr->getBenchmarkSet()[0]->rules.empty(), SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[0]->rules->get().empty(), SPOT);
 
   // add second rule with 64 bit values
   configurator.addRule();
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules.size(), (unsigned)1, SPOT);
-  assert_true(cfgPtr->getBenchmarkSet()[0]->rules[0]->empty(), SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get().size(), (unsigned)1, SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->empty(), SPOT);
 
   std::string values1 = "0x1234567887654321";
   std::string values2 = "0x8888444422221111";
@@ -153,14 +195,14 @@ TEST(test_luaconfigurator_rules64)
   configurator.addRuleAtomRange(values1, values2);
   configurator.addRuleAtomPrefix(values1, values3);
 
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->size(), (unsigned)3, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(0)->getType(), Generic::RuleAtom::EXACT, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(1)->getType(), Generic::RuleAtom::RANGE, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(2)->getType(), Generic::RuleAtom::PREFIX, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->size(), (unsigned)3, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(0)->getType(), Generic::RuleAtom::EXACT, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(1)->getType(), Generic::RuleAtom::RANGE, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(2)->getType(), Generic::RuleAtom::PREFIX, SPOT);
 
-  Generic::RuleAtomExact* atom21 = static_cast<Generic::RuleAtomExact*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(0).get());
-  Generic::RuleAtomRange* atom22 = static_cast<Generic::RuleAtomRange*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(1).get());
-  Generic::RuleAtomPrefix* atom23 = static_cast<Generic::RuleAtomPrefix*>(cfgPtr->getBenchmarkSet()[0]->rules[0]->at(2).get());
+  Generic::RuleAtomExact* atom21 = static_cast<Generic::RuleAtomExact*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(0).get());
+  Generic::RuleAtomRange* atom22 = static_cast<Generic::RuleAtomRange*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(1).get());
+  Generic::RuleAtomPrefix* atom23 = static_cast<Generic::RuleAtomPrefix*>(cfgPtr->getBenchmarkSet()[0]->rules->get()[0]->at(2).get());
 
   double cmp1 = 1.3117684671392817E18;
   double cmp2 = 9.838188445411971E18;
@@ -179,29 +221,30 @@ TEST(test_luaconfigurator_headers)
   std::shared_ptr<Configuration> cfgPtr = std::make_shared<Configuration>();
   LuaConfigurator configurator(cfgPtr);
   configurator.addBenchmark();
+  configurator.addFieldStructure(32);
+  configurator.addFieldStructure(64);
+  configurator.addFieldStructure(64);
 
-  assert_true(cfgPtr->getBenchmarkSet()[0]->headers.empty(), SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[0]->headers->empty(), SPOT);
   
   // add first header
   configurator.addHeader();
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers.size(), (unsigned)1, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->size(), (unsigned)0, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->size(), (unsigned)1, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->fields(), (unsigned)3, SPOT);
   
   configurator.addHeaderValue(1234);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->size(), (unsigned)1, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->at(0)->value.get_ui(), (unsigned)1234, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->get(0, 0), (unsigned)1234, SPOT);
 
   configurator.addHeaderValue(42);
   configurator.addHeaderValue(0xAFFE0BAD);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->size(), (unsigned)3, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->at(1)->value.get_ui(), (unsigned)42, SPOT);
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[0]->at(2)->value.get_ui(), (unsigned)0xAFFE0BAD, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->get(0, 1), (unsigned)42, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->get(0, 2), (unsigned)0xAFFE0BAD, SPOT);
 
   // add second header
   configurator.addHeader();
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers.size(), (unsigned)2, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers->size(), (unsigned)2, SPOT);
 
-  std::string values1 = "0x1234567887654321";
+  std::string values1 = "0x12345678";
   std::string values2 = "0x8888444422221111";
   std::string values3 = "0xFFFFFF0000000000";
 
@@ -209,14 +252,54 @@ TEST(test_luaconfigurator_headers)
   configurator.addHeaderValue(values2);
   configurator.addHeaderValue(values3);
 
-  assert_equal(cfgPtr->getBenchmarkSet()[0]->headers[1]->size(), (unsigned)3, SPOT);
-  
-  double cmp1 = 1.3117684671392817E18;
+  double cmp1 = 3.05419896E8;
   double cmp2 = 9.838188445411971E18;
   double cmp3 = 1.8446742974197924E19;
-  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers[1]->at(0)->value.get_d(), cmp1, 0.999, SPOT);
-  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers[1]->at(1)->value.get_d(), cmp2, 0.999, SPOT);
-  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers[1]->at(2)->value.get_d(), cmp3, 0.999, SPOT);
+  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers->value(1, 0).get_d(), cmp1, 0.999, SPOT);
+  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers->value(1, 1).get_d(), cmp2, 0.999, SPOT);
+  assert_approx_equal(cfgPtr->getBenchmarkSet()[0]->headers->value(1, 2).get_d(), cmp3, 0.999, SPOT);
+
+  // more values than fields
+  try {
+    configurator.addHeaderValue(values1);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_luaconfigurator_shared_sets)
+{
+  std::shared_ptr<Configuration> cfgPtr = std::make_shared<Configuration>();
+  LuaConfigurator configurator(cfgPtr);
+  int rulesTable = 0, headersTable = 0; // stand-ins for the identity of Lua tables
+  std::string value("0x1234");
+
+  // first benchmark converts the sets
+  configurator.addBenchmark();
+  configurator.addFieldStructure(32);
+  assert_false(configurator.shareRules(&rulesTable), SPOT);
+  configurator.addRule();
+  configurator.addRuleAtomExact(42);
+  assert_false(configurator.shareHeaders(&headersTable), SPOT);
+  configurator.addHeader();
+  configurator.addHeaderValue(value);
+
+  // second benchmark with the same structure shares them
+  configurator.addBenchmark();
+  configurator.addFieldStructure(32);
+  assert_true(configurator.shareRules(&rulesTable), SPOT);
+  assert_true(configurator.shareHeaders(&headersTable), SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[1]->rules == cfgPtr->getBenchmarkSet()[0]->rules, SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[1]->headers == cfgPtr->getBenchmarkSet()[0]->headers, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[1]->getRuleNumber(), (unsigned)1, SPOT);
+  assert_equal(cfgPtr->getBenchmarkSet()[1]->getHeaderNumber(), (unsigned)1, SPOT);
+
+  // atoms of another structure have other widths, so the same tables are converted again
+  configurator.addBenchmark();
+  configurator.addFieldStructure(64);
+  assert_false(configurator.shareRules(&rulesTable), SPOT);
+  assert_false(configurator.shareHeaders(&headersTable), SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[2]->rules != cfgPtr->getBenchmarkSet()[0]->rules, SPOT);
+  assert_true(cfgPtr->getBenchmarkSet()[2]->rules->get().empty(), SPOT);
 }
 
 TEST(test_luaconfigurator_fullrelpath)
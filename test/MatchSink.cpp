@@ -0,0 +1,108 @@
+#include <libunittest/all.hpp>
+#include <evaluation/MatchSink.hpp>
+#include <generics/Snapshot.hpp>
+#include <vector>
+#include <cstdint>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+TEST(test_matchsink_hits)
+{
+  MatchSink sink(4, false);
+  assert_equal(sink.size(), (uint64_t)0, SPOT);
+  assert_equal(sink.getDigest(), MatchSink::emptyDigest(), SPOT);
+
+  RuleIndexSet indices;
+  indices.push_back(2);
+  indices.push_back(0);
+  indices.push_back(noRuleIsMatching());
+  indices.push_back(2);
+  sink.add(indices);
+  sink.add(3);
+
+  assert_equal(sink.size(), (uint64_t)5, SPOT);
+  assert_equal(sink.getNoMatch(), (uint64_t)1, SPOT);
+  assert_equal(sink.getHits().size(), (size_t)4, SPOT);
+  assert_equal(sink.getHits()[0], (uint64_t)1, SPOT);
+  assert_equal(sink.getHits()[1], (uint64_t)0, SPOT);
+  assert_equal(sink.getHits()[2], (uint64_t)2, SPOT);
+  assert_equal(sink.getHits()[3], (uint64_t)1, SPOT);
+  assert_false(sink.keepsIndices(), SPOT);
+  assert_true(sink.getIndices().empty(), SPOT);
+
+  try { // index beyond rule set
+    sink.add(4);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  sink.clear();
+  assert_equal(sink.size(), (uint64_t)0, SPOT);
+  assert_equal(sink.getNoMatch(), (uint64_t)0, SPOT);
+  assert_equal(sink.getHits()[2], (uint64_t)0, SPOT);
+  assert_equal(sink.getDigest(), MatchSink::emptyDigest(), SPOT);
+}
+
+TEST(test_matchsink_digest)
+{
+  MatchSink batched(10, false), single(10, true), reordered(10, false), shorter(10, false);
+  RuleIndexSet indices;
+  for (unsigned int i = 0; i < 100; ++i)
+    indices.push_back(i % 7 == 0 ? noRuleIsMatching() : i % 10);
+
+  batched.add(RuleIndexSet(indices.cbegin(), indices.cbegin() + 30));
+  batched.add(RuleIndexSet(indices.cbegin() + 30, indices.cend()));
+  for (RuleIndexSet::const_iterator iter(indices.cbegin()); iter != indices.cend(); ++iter)
+    single.add(*iter);
+
+  // digest only depends on the index stream, not on the batches
+  assert_true(batched.sameMatches(single), SPOT);
+  assert_true(single.keepsIndices(), SPOT);
+  assert_true(single.getIndices() == indices, SPOT);
+
+  // same matches per rule, but different order
+  std::swap(indices[1], indices[2]);
+  reordered.add(indices);
+  assert_false(batched.sameMatches(reordered), SPOT);
+  assert_true(batched.getHits() == reordered.getHits(), SPOT);
+
+  indices.pop_back();
+  shorter.add(indices);
+  assert_false(reordered.sameMatches(shorter), SPOT);
+
+  // each index is folded in byte by byte (least significant first)
+  MatchSink one; // without a rule set, any index is accepted
+  one.add(0x0102);
+  const uint8_t bytes[8] = { 0x02, 0x01, 0, 0, 0, 0, 0, 0 };
+  assert_equal(one.getDigest(), fnv1a(MatchSink::emptyDigest(), bytes, sizeof(bytes)), SPOT);
+}
+
+TEST(test_matchsink_native)
+{
+  MatchSink generic(3, false), native(3, true);
+  RuleIndexSet indices;
+  std::vector<uint32_t> nativeIndices;
+  for (unsigned int i = 0; i < 20; ++i) {
+    indices.push_back(i % 4 == 3 ? noRuleIsMatching() : i % 4);
+    nativeIndices.push_back(i % 4 == 3 ? noRuleIsMatchingNative() : i % 4);
+  }
+
+  generic.add(indices);
+  native.add(nativeIndices.data(), nativeIndices.size());
+
+  assert_true(generic.sameMatches(native), SPOT);
+  assert_equal(native.getNoMatch(), (uint64_t)5, SPOT);
+  assert_true(native.getIndices() == indices, SPOT);
+}
+
+TEST(test_matchsink_norules)
+{
+  MatchSink sink; // without rules, no matches per rule are counted
+  sink.add(42);
+  sink.add(noRuleIsMatching());
+
+  assert_equal(sink.size(), (uint64_t)2, SPOT);
+  assert_true(sink.getHits().empty(), SPOT);
+  assert_false(sink.getDigest() == MatchSink::emptyDigest(), SPOT);
+}
+
@@ -553,3 +553,22 @@ TEST(test_memmanager_reset)
 }
 
 
+
+TEST(test_memmanager_suspended)
+{
+  MemManager m;
+  TestItem item1(0xa110c, 0xaccA11, 0xacc123, 64, 4);
+  assert_false(m.isSuspended(), SPOT);
+
+  m.reg(item1);
+  m.setSuspended(true);
+  m.checkpoint(42);
+  assert_equal(m.getCurrentHeaderCount(), (unsigned)0, SPOT);
+  assert_equal(m.getHistorySize(), (unsigned)0, SPOT);
+
+  m.setSuspended(false);
+  m.checkpoint(8);
+  assert_equal(m.getCurrentHeaderCount(), (unsigned)8, SPOT);
+  assert_equal(m.getHistorySize(), (unsigned)1, SPOT);
+  m.dereg(item1);
+}
@@ -582,3 +582,101 @@ TEST(test_memtrace_array)
 }
 #endif
 
+
+#ifndef MEMTRACE_DISABLED
+/** A pair of values, which is registered only once. */
+struct ExamplePair {
+  MemTraceRegion region;
+  MemTraceShared<uint32_t> first;
+  MemTraceShared<uint16_t> second;
+
+  ExamplePair(uint32_t a, uint16_t b) : region(sizeof(uint32_t) + sizeof(uint16_t)), first(region, a), second(region, b) {}
+};
+
+TEST(test_memtrace_region)
+{
+  std::shared_ptr<MemManager> manager = std::make_shared<MemManager>();
+  std::shared_ptr<MemTraceRegistry> memreg = std::make_shared<MemTraceRegistry>(manager);
+  memRegistryPtr = memreg; // for registering MemTrace-instances
+
+  {
+    ExamplePair pair1(1, 2), pair2(3, 4);
+    assert_allocBytes(2*(sizeof(uint32_t) + sizeof(uint16_t)), manager, SPOT);
+    assert_accWriteCnt(4, manager, SPOT);
+
+    pair1.first = pair2.first; // one read and one write
+    assert_equal((uint32_t)pair1.first, 3u, SPOT);
+    assert_accCnt(7, manager, SPOT);
+    assert_accWriteB(3*sizeof(uint32_t) + 2*sizeof(uint16_t), manager, SPOT);
+  }
+  assert_allocBytes(0, manager, SPOT);
+  assert_allocMax(2*(sizeof(uint32_t) + sizeof(uint16_t)), manager, SPOT);
+
+  manager->reset();
+  {
+    // same accounting as an array of traced values
+    MemTraceBlock<uint32_t> block(1000);
+    assert_equal(block.size(), (size_t)1000, SPOT);
+    assert_allocBytes(1000*sizeof(uint32_t), manager, SPOT);
+    assert_accCnt(0, manager, SPOT);
+
+    for (size_t i = 0; i < block.size(); ++i) block[i] = i;
+    block[7] |= 0x100;
+    block[8] &= 0x1;
+    assert_equal((uint32_t)block[7], 0x107u, SPOT);
+    assert_equal((uint32_t)block[8], 0u, SPOT);
+    assert_accCnt(1000 + 4 + 2, manager, SPOT);
+    assert_accWriteCnt(1000 + 2, manager, SPOT);
+
+    // reallocation replaces the allocated bytes but keeps the accesses
+    block.reset(10);
+    assert_equal((uint32_t)block[9], 0u, SPOT);
+    assert_allocBytes(10*sizeof(uint32_t), manager, SPOT);
+    assert_allocMax(1010*sizeof(uint32_t), manager, SPOT);
+    assert_accCnt(1000 + 4 + 2 + 1, manager, SPOT);
+  }
+  assert_allocBytes(0, manager, SPOT);
+  assert_accWriteCnt(1000 + 2, manager, SPOT);
+}
+#endif
+
+#ifndef MEMTRACE_DISABLED
+TEST(test_memtrace_checkpoint)
+{
+  std::shared_ptr<MemManager> manager = std::make_shared<MemManager>();
+  std::shared_ptr<MemTraceRegistry> memreg = std::make_shared<MemTraceRegistry>(manager);
+  memRegistryPtr = memreg; // for registering MemTrace-instances
+
+  MemGroupSnapshotPtr msnap;
+  {
+    MemTrace<uint32_t> val1(1);
+    manager->groupCreate();
+    MemTrace<uint16_t> val2(2);
+    manager->checkpoint(10);
+
+    // accesses after a checkpoint are only part of later snapshots
+    val1 = 3;
+    val2 = 4;
+    manager->checkpoint(10);
+    manager->getPastRecordByGroup(0, 0, msnap);
+    assert_equal(msnap->accWriteCount, (size_t)1, SPOT);
+    manager->getPastRecordByGroup(1, 0, msnap);
+    assert_equal(msnap->accWriteCount, (size_t)2, SPOT);
+    manager->getPastRecordByGroup(1, 1, msnap);
+    assert_equal(msnap->allocBytes, sizeof(uint16_t), SPOT);
+    assert_equal(msnap->accWriteBytes, 2*sizeof(uint16_t), SPOT);
+
+    manager->getCurrentByGroup(0, msnap);
+    assert_equal(msnap->allocBytes, sizeof(uint32_t), SPOT);
+    assert_equal(msnap->accWriteCount, (size_t)2, SPOT);
+
+    // instances, which survive a reset, aren't counted anymore
+    manager->reset();
+    val1 = 5;
+    assert_allocBytes(0, manager, SPOT);
+    assert_accCnt(0, manager, SPOT);
+  }
+  assert_allocBytes(0, manager, SPOT);
+  assert_allocMax(0, manager, SPOT);
+}
+#endif
@@ -0,0 +1,173 @@
+#include <libunittest/all.hpp>
+#include <generics/PacketHeaderColumns.hpp>
+#include <memory>
+#include <vector>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+std::vector<unsigned int> createStructure() {
+  std::vector<unsigned int> fields;
+  fields.push_back(32);
+  fields.push_back(16);
+  fields.push_back(8);
+  fields.push_back(48);
+  fields.push_back(128);
+  return fields;
+}
+
+TEST(test_packetheadercolumns_values)
+{
+  PacketHeaderColumns headers(createStructure());
+  assert_true(headers.empty(), SPOT);
+  assert_equal(headers.fields(), (size_t)5, SPOT);
+  assert_equal(headers.fieldBits(3), (unsigned)48, SPOT);
+
+  headers.addHeader();
+  headers.addValue(VarValue(0xAFFE0BAD));
+  headers.addValue(VarValue(0xFFFF));
+  headers.addValue(VarValue(17));
+  headers.addValue(VarValue("0xFFFFFFFFFFFF"));
+  headers.addValue(VarValue("0xABCD12345678FEDA1234567890123456"));
+  try { // more values than fields
+    headers.addValue(VarValue(1));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  headers.addHeader(); // all fields are zero
+  assert_equal(headers.size(), (size_t)2, SPOT);
+
+  assert_equal(headers.get(0, 0), (uint64_t)0xAFFE0BAD, SPOT);
+  assert_equal(headers.get(0, 1), (uint64_t)0xFFFF, SPOT);
+  assert_equal(headers.get(0, 2), (uint64_t)17, SPOT);
+  assert_equal(headers.get(0, 3), (uint64_t)0xFFFFFFFFFFFF, SPOT);
+  assert_equal(headers.get(0, 4), (uint64_t)UINT64_MAX, SPOT); // saturated
+  assert_true(headers.value(0, 4) == VarValue("0xABCD12345678FEDA1234567890123456"), SPOT);
+  for (size_t field = 0; field < headers.fields(); ++field)
+    assert_equal(headers.get(1, field), (uint64_t)0, SPOT);
+
+  try { // exceeds element type of field
+    headers.set(1, 1, VarValue(0x10000));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // fits into the element type, but exceeds the bits of the field
+    headers.set(1, 3, VarValue("0x1000000000000"));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // wide field
+    headers.set(1, 4, VarValue("0x100000000000000000000000000000000"));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // negative value in a wide field
+    headers.set(1, 4, VarValue(-1));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  headers.set(1, 4, VarValue("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"));
+
+  // a field, which is narrower than its element type
+  std::vector<unsigned int> narrow(1, 12);
+  PacketHeaderColumns narrowHeaders(narrow);
+  narrowHeaders.resize(1);
+  narrowHeaders.set(0, 0, VarValue(0xFFF));
+  try {
+    narrowHeaders.set(0, 0, VarValue(0x1000));
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_packetheadercolumns_iterator)
+{
+  PacketHeaderColumns headers(createStructure());
+  headers.resize(10);
+  for (size_t hdr = 0; hdr < 10; ++hdr)
+    headers.set(hdr, 1, VarValue((unsigned long)hdr * 3));
+
+  size_t count = 0;
+  for (PacketHeaderColumns::const_iterator iter(headers.begin()); iter != headers.end(); ++iter, ++count) {
+    assert_equal((*iter).index(), count, SPOT);
+    assert_equal((*iter).size(), (size_t)5, SPOT);
+    assert_equal((*iter).get(1), (uint64_t)(count * 3), SPOT);
+    assert_true((*iter)[1] == VarValue((unsigned long)count * 3), SPOT);
+  }
+  assert_equal(count, (size_t)10, SPOT);
+}
+
+TEST(test_packetheadercolumns_lines)
+{
+  std::vector<unsigned int> fields;
+  fields.push_back(32);
+  fields.push_back(16);
+
+  PacketHeaderSet lines;
+  for (unsigned int i = 0; i < 100; ++i) {
+    std::unique_ptr<PacketHeaderLine> line(new PacketHeaderLine());
+    line->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(i * 1000)));
+    line->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(i)));
+    lines.push_back(std::move(line));
+  }
+
+  PacketHeaderColumns headers(fields);
+  headers.append(lines);
+  assert_equal(headers.size(), (size_t)100, SPOT);
+
+  PacketHeaderColumns copy(fields);
+  copy.append(headers);
+  copy.append(headers);
+  assert_equal(copy.size(), (size_t)200, SPOT);
+
+  PacketHeaderSet converted;
+  copy.toHeaderSet(converted, 90, 20); // spans both appended sets
+  assert_equal(converted.size(), (size_t)20, SPOT);
+  for (unsigned int i = 0; i < 20; ++i) {
+    unsigned int expected = (90 + i) % 100;
+    assert_equal(converted[i]->size(), (size_t)2, SPOT);
+    assert_equal(converted[i]->at(0)->value, expected * 1000, SPOT);
+    assert_equal(converted[i]->at(1)->value, expected, SPOT);
+  }
+
+  copy.toHeaderSet(converted, 195, 20); // limited to the end
+  assert_equal(converted.size(), (size_t)5, SPOT);
+  copy.toHeaderSet(converted, 200, 20);
+  assert_true(converted.empty(), SPOT);
+
+  copy.clear();
+  assert_true(copy.empty(), SPOT);
+  assert_equal(copy.fields(), (size_t)2, SPOT);
+
+  copy.append(headers, 95, 3); // range of headers
+  copy.append(headers, 98, 10); // limited to the end
+  copy.append(headers, 100, 10);
+  assert_equal(copy.size(), (size_t)5, SPOT);
+  for (unsigned int i = 0; i < 5; ++i) {
+    assert_equal(copy.get(i, 0), (uint64_t)((95 + i) * 1000), SPOT);
+    assert_equal(copy.get(i, 1), (uint64_t)(95 + i), SPOT);
+  }
+
+  // an invalid header in the middle: none of them is appended
+  std::unique_ptr<PacketHeaderLine> invalid(new PacketHeaderLine());
+  invalid->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(1u)));
+  invalid->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(0x10000u)));
+  lines.insert(lines.begin() + 50, std::move(invalid));
+  try {
+    copy.append(lines);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  assert_equal(copy.size(), (size_t)5, SPOT);
+  assert_equal(copy.get(4, 1), (uint64_t)99, SPOT);
+
+  // a field of another width: none of the columns is extended
+  std::vector<unsigned int> wider(fields);
+  wider[1] = 32;
+  PacketHeaderColumns other(wider);
+  other.resize(3);
+  try {
+    copy.append(other);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  assert_equal(copy.size(), (size_t)5, SPOT);
+  copy.append(headers, 0, 1); // columns are still aligned
+  assert_equal(copy.get(5, 0), (uint64_t)0, SPOT);
+  assert_equal(copy.get(5, 1), (uint64_t)0, SPOT);
+  assert_equal(copy.get(4, 0), (uint64_t)99000, SPOT);
+}
+
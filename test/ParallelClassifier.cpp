@@ -0,0 +1,107 @@
+#include <libunittest/all.hpp>
+#include <core/ParallelClassifier.hpp>
+#include <generics/Base.hpp>
+#include <memory>
+#include <vector>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+/** Stub algorithm, which returns the first header value as index of the matched rule. */
+class EchoAlgorithm : public Base {
+public:
+  size_t throwOnValue;
+
+  EchoAlgorithm() : throwOnValue(0) {}
+
+  void classify(const PacketHeaderSet& data, RuleIndexSet& indices) override {
+    for (PacketHeaderSet::const_iterator iter(data.cbegin()); iter != data.cend(); ++iter) {
+      size_t value = (*iter)->front()->value.get_ui();
+      if (throwOnValue > 0 && value == throwOnValue) throw "EchoAlgorithm failed.";
+      indices.push_back(value);
+    }
+  }
+  void setRules(const RuleSet&) override {}
+  void ruleAdded(uint32_t, const Rule&) override {}
+  void ruleRemoved(uint32_t) override {}
+  void setParameters(const std::vector<double>&) override {}
+  void reset() override {}
+};
+
+void fillHeaders(PacketHeaderSet& headers, unsigned int amount) {
+  for (unsigned int i = 1; i <= amount; ++i) {
+    std::unique_ptr<PacketHeaderLine> line(new PacketHeaderLine());
+    line->push_back(std::unique_ptr<PacketHeaderAtom>(new PacketHeaderAtom(i)));
+    headers.push_back(std::move(line));
+  }
+}
+
+void checkOrder(unsigned int threads, unsigned int amount) {
+  EchoAlgorithm alg;
+  PacketHeaderSet headers;
+  fillHeaders(headers, amount);
+
+  ParallelClassifier pc(&alg, threads);
+  RuleIndexSet indices;
+  double aggregateMpps = -1;
+  std::vector<double> threadMpps;
+  pc.classify(headers, indices, aggregateMpps, threadMpps);
+
+  assert_equal(indices.size(), (size_t)amount, SPOT);
+  assert_equal(headers.size(), (size_t)amount, SPOT);
+  for (unsigned int i = 0; i < amount; ++i) {
+    assert_equal(indices[i], (size_t)(i + 1), SPOT);
+    assert_true(headers[i].get() != nullptr, SPOT); // header was restored
+    assert_equal(headers[i]->front()->value.get_ui(), (unsigned long)(i + 1), SPOT);
+  }
+  assert_equal(threadMpps.size(), (size_t)threads, SPOT);
+  assert_true(aggregateMpps >= 0, SPOT);
+}
+
+TEST(test_parallelclassifier_order)
+{
+  checkOrder(1, 1000);
+  checkOrder(3, 1000);
+  checkOrder(8, 1001);
+}
+
+TEST(test_parallelclassifier_fewheaders)
+{
+  checkOrder(4, 3); // one worker stays idle
+  checkOrder(2, 0);
+}
+
+TEST(test_parallelclassifier_invalid)
+{
+  EchoAlgorithm alg;
+  try {
+    ParallelClassifier pc(nullptr, 2);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try {
+    ParallelClassifier pc(&alg, 0);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
+
+TEST(test_parallelclassifier_exception)
+{
+  EchoAlgorithm alg;
+  alg.throwOnValue = 77;
+  PacketHeaderSet headers;
+  fillHeaders(headers, 100);
+
+  ParallelClassifier pc(&alg, 4);
+  RuleIndexSet indices;
+  double aggregateMpps = 0;
+  std::vector<double> threadMpps;
+  try {
+    pc.classify(headers, indices, aggregateMpps, threadMpps);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // headers are restored even on failure
+  assert_equal(headers.size(), (size_t)100, SPOT);
+  for (unsigned int i = 0; i < 100; ++i)
+    assert_equal(headers[i]->front()->value.get_ui(), (unsigned long)(i + 1), SPOT);
+}
@@ -0,0 +1,217 @@
+#include <libunittest/all.hpp>
+#include <generator/PcapSource.hpp>
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+typedef std::vector<uint8_t> Bytes;
+
+void putNetwork(Bytes& bytes, uint32_t val, size_t size) {
+  for (size_t i = size; i-- > 0;) bytes.push_back((uint8_t)(val >> (8 * i)));
+}
+
+void putHost(Bytes& bytes, uint32_t val, size_t size) {
+  for (size_t i = 0; i < size; ++i) bytes.push_back((uint8_t)(val >> (8 * i)));
+}
+
+/** Returns an Ethernet frame with an IPv4 packet (and an optional VLAN tag). */
+Bytes ethernetPacket(uint32_t src, uint32_t dst, uint16_t srcPort, uint16_t dstPort, uint8_t protocol, int vlan = -1) {
+  Bytes frame(12, 0xee); // mac addresses
+  if (vlan >= 0) {
+    putNetwork(frame, 0x8100, 2);
+    putNetwork(frame, vlan, 2);
+  }
+  putNetwork(frame, 0x0800, 2);
+
+  putNetwork(frame, 0x45, 1); // version, header length
+  putNetwork(frame, 0x10, 1); // tos
+  putNetwork(frame, 40, 2); // total length
+  putNetwork(frame, 0, 4); // identification, fragment offset
+  putNetwork(frame, 64, 1); // ttl
+  putNetwork(frame, protocol, 1);
+  putNetwork(frame, 0, 2); // checksum
+  putNetwork(frame, src, 4);
+  putNetwork(frame, dst, 4);
+  putNetwork(frame, srcPort, 2);
+  putNetwork(frame, dstPort, 2);
+  putNetwork(frame, 0, 4); // sequence number
+  putNetwork(frame, 0, 4); // acknowledgment number
+  putNetwork(frame, 0x5012, 2); // data offset, flags (SYN, ACK)
+  putNetwork(frame, 0, 6);
+  return frame;
+}
+
+/** Returns an Ethernet frame with an IPv6 packet, which is skipped. */
+Bytes ipv6Packet() {
+  Bytes frame(12, 0xee);
+  putNetwork(frame, 0x86dd, 2);
+  frame.resize(frame.size() + 40, 0x60);
+  return frame;
+}
+
+std::string writeCapture(const std::string& name, const Bytes& bytes) {
+  std::string filename(std::string(P_tmpdir) + "/cate_" + name + "_" + std::to_string(getpid()));
+  std::ofstream file(filename, std::ios::trunc | std::ios::binary);
+  file.write((const char*)bytes.data(), bytes.size());
+  return filename;
+}
+
+/** Returns a pcap file with the given Ethernet frames. */
+Bytes pcapFile(const std::vector<Bytes>& frames) {
+  Bytes file;
+  putHost(file, 0xa1b2c3d4, 4);
+  putHost(file, 2, 2);
+  putHost(file, 4, 2);
+  putHost(file, 0, 8);
+  putHost(file, 65535, 4);
+  putHost(file, 1, 4); // Ethernet
+  for (std::vector<Bytes>::const_iterator frame(frames.cbegin()); frame != frames.cend(); ++frame) {
+    putHost(file, 0, 8); // timestamp
+    putHost(file, frame->size(), 4);
+    putHost(file, frame->size(), 4);
+    file.insert(file.end(), frame->cbegin(), frame->cend());
+  }
+  return file;
+}
+
+/** Returns a pcapng file in big endian with the given Ethernet frames. */
+Bytes pcapngFile(const std::vector<Bytes>& frames) {
+  Bytes file;
+  putNetwork(file, 0x0a0d0d0a, 4); // section header
+  putNetwork(file, 28, 4);
+  putNetwork(file, 0x1a2b3c4d, 4);
+  putNetwork(file, 1, 2);
+  putNetwork(file, 0, 2);
+  putNetwork(file, 0xffffffff, 4);
+  putNetwork(file, 0xffffffff, 4);
+  putNetwork(file, 28, 4);
+
+  putNetwork(file, 1, 4); // interface description
+  putNetwork(file, 20, 4);
+  putNetwork(file, 1, 2); // Ethernet
+  putNetwork(file, 0, 2);
+  putNetwork(file, 65535, 4);
+  putNetwork(file, 20, 4);
+
+  for (std::vector<Bytes>::const_iterator frame(frames.cbegin()); frame != frames.cend(); ++frame) {
+    uint32_t padded = (frame->size() + 3) / 4 * 4;
+    putNetwork(file, 6, 4); // enhanced packet
+    putNetwork(file, 32 + padded, 4);
+    putNetwork(file, 0, 4); // interface
+    putNetwork(file, 0, 8); // timestamp
+    putNetwork(file, frame->size(), 4);
+    putNetwork(file, frame->size(), 4);
+    file.insert(file.end(), frame->cbegin(), frame->cend());
+    file.resize(file.size() + padded - frame->size(), 0);
+    putNetwork(file, 32 + padded, 4);
+  }
+  return file;
+}
+
+std::vector<Bytes> testFrames() {
+  std::vector<Bytes> frames;
+  frames.push_back(ethernetPacket(0x0A000001, 0x0A0A0001, 1234, 80, 6));
+  frames.push_back(ipv6Packet());
+  frames.push_back(ethernetPacket(0xC0A80001, 0xC0A80002, 53, 5353, 17, 42));
+  return frames;
+}
+
+TEST(test_pcapsource_pcap)
+{
+  std::string filename(writeCapture("pcap", pcapFile(testFrames())));
+  assert_equal(PcapSource::countPackets(filename), 2u, SPOT);
+
+  PcapConfiguration config;
+  config.filename = filename;
+  config.replay = 3;
+  std::vector<unsigned int> structure {32, 32, 16, 16, 8};
+  PcapSource source(config, structure);
+
+  PacketHeaderColumns batch;
+  assert_true(source.next(batch, 4), SPOT); // replays the capture within a batch
+  assert_equal(batch.size(), (size_t)4, SPOT);
+  assert_equal(batch.get(0, 0), (uint64_t)0x0A000001, SPOT);
+  assert_equal(batch.get(0, 1), (uint64_t)0x0A0A0001, SPOT);
+  assert_equal(batch.get(0, 2), (uint64_t)1234, SPOT);
+  assert_equal(batch.get(0, 3), (uint64_t)80, SPOT);
+  assert_equal(batch.get(0, 4), (uint64_t)6, SPOT);
+  assert_equal(batch.get(1, 0), (uint64_t)0xC0A80001, SPOT);
+  assert_equal(batch.get(1, 3), (uint64_t)5353, SPOT);
+  assert_equal(batch.get(1, 4), (uint64_t)17, SPOT);
+  assert_equal(batch.get(2, 0), (uint64_t)0x0A000001, SPOT);
+
+  assert_true(source.next(batch, 4), SPOT);
+  assert_equal(batch.size(), (size_t)2, SPOT);
+  assert_false(source.next(batch, 4), SPOT);
+
+  source.rewind();
+  assert_true(source.next(batch, 10), SPOT);
+  assert_equal(batch.size(), (size_t)6, SPOT);
+
+  remove(filename.c_str());
+}
+
+TEST(test_pcapsource_pcapng_fields)
+{
+  std::string filename(writeCapture("pcapng", pcapngFile(testFrames())));
+  assert_equal(PcapSource::countPackets(filename), 2u, SPOT);
+
+  PcapConfiguration config;
+  config.filename = filename;
+  config.fields = {"dst_port", "vlan", "tcp_flags", "ttl"};
+  PcapSource source(config, std::vector<unsigned int>{32, 32, 32, 32});
+
+  PacketHeaderColumns batch;
+  assert_true(source.next(batch, 10), SPOT);
+  assert_equal(batch.size(), (size_t)2, SPOT);
+  assert_equal(batch.get(0, 0), (uint64_t)80, SPOT);
+  assert_equal(batch.get(0, 1), (uint64_t)0, SPOT);
+  assert_equal(batch.get(0, 2), (uint64_t)0x12, SPOT);
+  assert_equal(batch.get(0, 3), (uint64_t)64, SPOT);
+  assert_equal(batch.get(1, 0), (uint64_t)5353, SPOT);
+  assert_equal(batch.get(1, 1), (uint64_t)42, SPOT);
+  assert_equal(batch.get(1, 2), (uint64_t)0, SPOT); // no TCP
+  assert_false(source.next(batch, 10), SPOT);
+
+  // an ip address doesn't fit into 16 bits
+  config.fields = {"src_ip", "dst_port"};
+  try {
+    PcapSource narrow(config, std::vector<unsigned int>{16, 16});
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // no default mapping for 3 fields
+  config.fields.clear();
+  try {
+    PcapSource unknown(config, std::vector<unsigned int>{32, 32, 16});
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  remove(filename.c_str());
+}
+
+TEST(test_pcapsource_invalid)
+{
+  std::string filename(writeCapture("nocapture", Bytes(64, 0x55)));
+  try {
+    PcapSource::countPackets(filename);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  remove(filename.c_str());
+
+  // capture without IPv4 packets yields no headers
+  filename = writeCapture("noipv4", pcapFile(std::vector<Bytes>(2, ipv6Packet())));
+  PcapConfiguration config;
+  config.filename = filename;
+  config.replay = 5;
+  PcapSource source(config, std::vector<unsigned int>{32, 32});
+  PacketHeaderColumns batch;
+  assert_false(source.next(batch, 10), SPOT);
+  remove(filename.c_str());
+}
@@ -0,0 +1,55 @@
+#include <libunittest/all.hpp>
+#include <metering/PerfManager.hpp>
+
+using namespace unittest::assertions;
+
+TEST(test_perfmanager_unavailable)
+{
+  PerfManager perf; // not opened: all calls are ignored
+  assert_false(perf.isAvailable(), SPOT);
+  assert_false(perf.getError().empty(), SPOT);
+
+  perf.start("abc");
+  perf.stop("abc");
+  perf.stop("never started");
+
+  PerfResults results;
+  perf.getAllResults(results);
+  assert_true(results.events.empty(), SPOT);
+  assert_true(results.categories.empty(), SPOT);
+}
+
+TEST(test_perfmanager_counting)
+{
+  PerfManager perf;
+  if (!perf.open()) { // e.g. in a container: degrades gracefully
+    assert_false(perf.getError().empty(), SPOT);
+    return;
+  }
+  assert_true(perf.getError().empty(), SPOT);
+
+  volatile unsigned int sum = 0;
+  perf.start("work");
+  for (unsigned int i = 0; i < 100000; ++i) sum += i;
+  perf.stop("work");
+
+  perf.setSuspended(true);
+  perf.start("suspended");
+  perf.setSuspended(false);
+
+  PerfResults results;
+  perf.getAllResults(results);
+  assert_false(results.events.empty(), SPOT);
+  assert_equal(results.categories.size(), (size_t)1, SPOT);
+  assert_equal(results.categories[0].first, std::string("work"), SPOT);
+  assert_equal(results.categories[0].second.size(), results.events.size(), SPOT);
+
+  try {
+    perf.stop("unknown");
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  perf.reset();
+  perf.getAllResults(results);
+  assert_true(results.categories.empty(), SPOT);
+}
@@ -0,0 +1,101 @@
+#include <libunittest/all.hpp>
+#include <core/SnapshotCache.hpp>
+#include <generics/Snapshot.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace unittest::assertions;
+using namespace Generic;
+
+/** Stub algorithm, whose classifier is just a number derived from the rule set. */
+class CountingAlgorithm : public Base {
+public:
+  uint32_t classifier;
+  unsigned int builds;
+  unsigned int loads;
+
+  CountingAlgorithm() : classifier(0), builds(0), loads(0) {}
+
+  void classify(const PacketHeaderSet&, RuleIndexSet&) override {}
+  void setRules(const RuleSet& ruleset) override { classifier = ruleset.size() * 7 + 1; ++builds; }
+  bool supportsSnapshots() const override { return true; }
+  void saveSnapshot(std::vector<uint8_t>& image) const override {
+    SnapshotWriter writer(image);
+    writer.write<uint32_t>(classifier);
+  }
+  void loadSnapshot(const RuleSet&, const uint8_t* image, size_t size) override {
+    SnapshotReader reader(image, size);
+    classifier = reader.read<uint32_t>();
+    ++loads;
+  }
+  void ruleAdded(uint32_t, const Rule&) override {}
+  void ruleRemoved(uint32_t) override {}
+  void setParameters(const std::vector<double>&) override {}
+  void reset() override { classifier = 0; }
+};
+
+void addRule(RuleSet& ruleset, uint16_t port) {
+  std::unique_ptr<Rule> rule(new Rule);
+  rule->push_back(std::unique_ptr<RuleAtom>(new RuleAtomPrefix((uint32_t)0x0A000000, (uint32_t)0xFF000000)));
+  rule->push_back(std::unique_ptr<RuleAtom>(new RuleAtomExact((uint16_t)port)));
+  ruleset.push_back(std::move(rule));
+}
+
+TEST(test_snapshotcache_key)
+{
+  RuleSet rules, otherRules;
+  addRule(rules, 80);
+  addRule(rules, 443);
+  addRule(otherRules, 80);
+  addRule(otherRules, 8080);
+  std::vector<double> params(1, 100.0), otherParams(1, 200.0);
+
+  uint64_t key = SnapshotCache::key("lib/HiCuts5tpl.so", params, rules);
+  assert_equal(key, SnapshotCache::key("lib/HiCuts5tpl.so", params, rules), SPOT);
+  assert_true(key != SnapshotCache::key("lib/HiCuts4tpl.so", params, rules), SPOT);
+  assert_true(key != SnapshotCache::key("lib/HiCuts5tpl.so", otherParams, rules), SPOT);
+  std::vector<double> closeParams(1, 100.0000001); // differs beyond 6 significant digits
+  assert_true(key != SnapshotCache::key("lib/HiCuts5tpl.so", closeParams, rules), SPOT);
+  assert_true(key != SnapshotCache::key("lib/HiCuts5tpl.so", params, otherRules), SPOT);
+}
+
+TEST(test_snapshotcache_store_load)
+{
+  char dir[] = "/tmp/cate_snapshots_XXXXXX";
+  assert_true(mkdtemp(dir) != nullptr, SPOT);
+  SnapshotCache cache(dir);
+
+  RuleSet rules;
+  addRule(rules, 80);
+  addRule(rules, 443);
+  uint64_t key = SnapshotCache::key("CountingAlgorithm", std::vector<double>(), rules);
+
+  CountingAlgorithm built, loaded;
+  assert_false(cache.load(key, loaded, rules), SPOT); // nothing stored yet
+  assert_equal(loaded.loads, 0u, SPOT);
+
+  built.setRules(rules);
+  assert_true(cache.store(key, built), SPOT);
+  assert_true(cache.load(key, loaded, rules), SPOT);
+  assert_equal(loaded.classifier, built.classifier, SPOT);
+  assert_equal(loaded.loads, 1u, SPOT);
+  assert_equal(loaded.builds, 0u, SPOT);
+
+  // a snapshot of another key isn't used
+  assert_false(cache.load(key + 1, loaded, rules), SPOT);
+
+  // a damaged snapshot is ignored
+  {
+    std::fstream file(cache.filename(key), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put('\x55');
+  }
+  assert_false(cache.load(key, loaded, rules), SPOT);
+  assert_equal(loaded.loads, 1u, SPOT);
+
+  remove(cache.filename(key).c_str());
+  remove(dir);
+}
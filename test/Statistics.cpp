@@ -185,3 +185,34 @@ TEST(test_statistics_histogram_unsorted)
 }
 
 
+
+TEST(test_statistics_histogram_times)
+{
+  Histogram hist(3);
+  hist.occured(1, 5);
+  hist.occured(2); hist.occured(2, 3);
+  hist.occured(0, 0);
+
+  std::vector<HistogramPair> result;
+  hist.getSorted(result);
+
+  assert_equal(result.size(), (unsigned)3, SPOT);
+  assert_equal(result[0].first, (unsigned)1, SPOT);
+  assert_equal(result[0].second, (unsigned)5, SPOT);
+  assert_equal(result[1].first, (unsigned)2, SPOT);
+  assert_equal(result[1].second, (unsigned)4, SPOT);
+  assert_equal(result[2].first, (unsigned)0, SPOT);
+  assert_equal(result[2].second, (unsigned)0, SPOT);
+
+  try {
+    hist.occured(3, 1);
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+
+  // hit counts of large header sets aren't truncated
+  hist.occured(0, (uint64_t)UINT32_MAX + 2);
+  result.clear();
+  hist.getSorted(result);
+  assert_equal(result[0].first, (unsigned)0, SPOT);
+  assert_equal(result[0].second, (uint64_t)UINT32_MAX + 2, SPOT);
+}
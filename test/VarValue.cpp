@@ -1,5 +1,6 @@
 #include <libunittest/all.hpp>
 #include <generics/VarValue.hpp>
+#include <stdexcept>
 
 using namespace unittest::assertions;
 using namespace Generic;
@@ -107,3 +108,79 @@ TEST(test_varvalue_comparison)
   assert_true(var128lt8 < var8, SPOT);
 }
 
+TEST(test_varvalue_spill)
+{
+  VarValue max64("0xFFFFFFFFFFFFFFFF");
+  VarValue one(1);
+  assert_true(max64.fits_ulong_p(), SPOT);
+
+  VarValue sum = max64 + one; // leaves inline representation
+  assert_false(sum.fits_ulong_p(), SPOT);
+  assert_true(sum == VarValue("0x10000000000000000"), SPOT);
+  assert_true(sum > max64, SPOT);
+  assert_true(sum - one == max64, SPOT); // back to inline representation
+  assert_true((sum - one).fits_ulong_p(), SPOT);
+
+  VarValue shifted = one << 64;
+  assert_true(shifted == sum, SPOT);
+  assert_true((shifted >> 64) == one, SPOT);
+  assert_true((max64 * VarValue(2)) == (max64 << 1), SPOT);
+
+  VarValue diff = one - VarValue(2); // negative values are not inline
+  assert_false(diff.fits_ulong_p(), SPOT);
+  assert_true(diff < VarValue(0), SPOT);
+  assert_true(diff + VarValue(2) == one, SPOT);
+  assert_true((~VarValue(0)) == VarValue(-1), SPOT);
+}
+
+TEST(test_varvalue_parse)
+{
+  assert_equal(VarValue("0").get_ui(), 0UL, SPOT);
+  assert_equal(VarValue("4711").get_ui(), 4711UL, SPOT);
+  assert_equal(VarValue("0xaBc").get_ui(), 0xABCUL, SPOT);
+  assert_equal(VarValue("0b101").get_ui(), 5UL, SPOT);
+  assert_equal(VarValue("017").get_ui(), 15UL, SPOT);
+  assert_equal(VarValue(" 12").get_ui(), 12UL, SPOT); // handled by GMP
+  assert_true(VarValue("18446744073709551616") == (VarValue(1) << 64), SPOT);
+  assert_true(VarValue(42.9) == 42, SPOT);
+
+  try {
+    VarValue invalid("0xZZ");
+    assert_true(false, SPOT);
+  } catch (const std::invalid_argument& ex) {}
+}
+
+TEST(test_varvalue_negate)
+{
+  assert_equal(negateVarValue(VarValue(0xF0)).get_ui(), 0x0FUL, SPOT);
+  assert_equal(negateVarValue(VarValue(0x5)).get_ui(), 0x2UL, SPOT);
+  VarValue wide("0xF0000000000000000");
+  assert_true(negateVarValue(wide) == VarValue("0x0FFFFFFFFFFFFFFFF"), SPOT);
+}
+
+TEST(test_varvalue_division)
+{
+  VarValue zero(0);
+  VarValue wide("0x10000000000000000");
+  assert_true(VarValue(17) / VarValue(5) == VarValue(3), SPOT);
+  assert_true(VarValue(17) % VarValue(5) == VarValue(2), SPOT);
+  assert_true(wide / VarValue(16) == VarValue("0x1000000000000000"), SPOT);
+
+  try { // inline values
+    VarValue(17) / zero;
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try {
+    VarValue(17) % zero;
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try { // spilled values
+    wide / zero;
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+  try {
+    VarValue val(-5);
+    val %= zero;
+    assert_true(false, SPOT);
+  } catch (const char* ex) {}
+}
@@ -0,0 +1,77 @@
+# Compares the mean construction time of the benchmarks in two result directories
+# (e.g. of examples/construction-acl1-1K.lua with a baseline and a changed build).
+# Benchmarks are paired by their position in the configuration. The exit code is 1,
+# if a benchmark constructs its classifier slower than the given tolerance allows.
+#
+# usage: python compare_construction.py <baseline-dir> <results-dir> [tolerance, default 0.1]
+from __future__ import print_function
+import sys
+import os
+import re
+
+CATEGORIES = ("construct trie", "convert classifier")
+
+
+def read_benchmarks(directory):
+    benchmarks = {}
+    for name in os.listdir(directory):
+        match = re.match(r"^\d+-(\d+)_chrono\.csv$", name)
+        if not match:
+            continue
+        path = os.path.join(directory, name)
+        benchmarks[int(match.group(1))] = (read_algorithm(path.replace("_chrono", "_info")), read_means(path))
+    return benchmarks
+
+
+def read_algorithm(path):
+    if not os.path.exists(path):
+        return "?"
+    with open(path, "r") as f:
+        for line in f:
+            parts = [p.strip() for p in line.split(";")]
+            if parts[0] == "algorithm":
+                return os.path.basename(parts[1])
+    return "?"
+
+
+def read_means(path):
+    means = {}
+    with open(path, "r") as f:
+        lines = f.readlines()
+    columns = [c.strip() for c in lines[0].split(";")]
+    mean = columns.index("mean[us]")
+    for line in lines[1:]:
+        parts = [p.strip() for p in line.split(";")]
+        if parts[0] in CATEGORIES:
+            means[parts[0]] = float(parts[mean])
+    return means
+
+
+def main(baseDir, newDir, tolerance):
+    base = read_benchmarks(baseDir)
+    new = read_benchmarks(newDir)
+    regressions = 0
+    print("benchmark; algorithm; category; baseline[us]; new[us]; change")
+    for idx in sorted(set(base) & set(new)):
+        algorithm, baseMeans = base[idx]
+        for category in CATEGORIES:
+            if category not in baseMeans or category not in new[idx][1]:
+                continue
+            before, after = baseMeans[category], new[idx][1][category]
+            change = (after - before) / before if before > 0 else 0.0
+            flag = ""
+            if change > tolerance:
+                flag = " (regression)"
+                regressions += 1
+            print("%d; %s; %s; %.0f; %.0f; %+.1f%%%s" % (idx, algorithm, category, before, after, change * 100, flag))
+    if regressions > 0:
+        print("%d construction times exceed the tolerance of %.0f%%!" % (regressions, tolerance * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("usage: python %s <baseline-dir> <results-dir> [tolerance]" % sys.argv[0])
+        sys.exit(2)
+    sys.exit(main(sys.argv[1], sys.argv[2], float(sys.argv[3]) if len(sys.argv) > 3 else 0.1))